@@ -107,16 +107,19 @@ LOCAL_STATIC_LIBRARIES += cocos_extension_static
 
 # opengl bindings depend on GFXUtils "_JSB_GL_CHECK"
 LOCAL_SRC_FILES += \
-renderer/gfx/GFXUtils.cpp
+renderer/gfx/GFXUtils.cpp \
+renderer/gfx/GFXNull.cpp
 
 ifeq ($(USE_GFX_RENDERER),1)
 LOCAL_SRC_FILES += \
 renderer/Types.cpp \
+renderer/Profiler.cpp \
 renderer/gfx/DeviceGraphics.cpp \
 renderer/gfx/FrameBuffer.cpp \
 renderer/gfx/GFX.cpp \
 renderer/gfx/GraphicsHandle.cpp \
 renderer/gfx/IndexBuffer.cpp \
+renderer/gfx/BufferRing.cpp \
 renderer/gfx/Program.cpp \
 renderer/gfx/RenderBuffer.cpp \
 renderer/gfx/RenderTarget.cpp \
@@ -134,6 +137,7 @@ renderer/renderer/Light.cpp \
 renderer/renderer/Model.cpp \
 renderer/renderer/Pass.cpp \
 renderer/renderer/ProgramLib.cpp \
+renderer/renderer/ProgramCache.cpp \
 renderer/renderer/Scene.cpp \
 renderer/renderer/Technique.cpp \
 renderer/renderer/View.cpp \
@@ -154,12 +158,15 @@ renderer/scene/assembler/MeshAssembler.cpp \
 renderer/scene/assembler/Particle3DAssembler.cpp \
 renderer/scene/MeshBuffer.cpp \
 renderer/scene/ModelBatcher.cpp \
+renderer/scene/StaticBatch.cpp \
 renderer/scene/NodeProxy.cpp \
 renderer/scene/RenderFlow.cpp \
 renderer/scene/StencilManager.cpp \
 renderer/scene/MemPool.cpp \
+renderer/scene/MathKernel.cpp \
 renderer/scene/NodeMemPool.cpp \
-renderer/scene/ParallelTask.cpp \
+renderer/scene/JobSystem.cpp \
+renderer/scene/DynamicAtlasManager.cpp \
 renderer/memop/RecyclePool.hpp \
 renderer/renderer/EffectVariant.cpp \
 renderer/renderer/EffectBase.cpp \
@@ -27,6 +27,12 @@
 #include <cfloat>
 #include <cassert>
 #include <array>
+#include <string.h>
+#include <string>
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+#include <EGL/egl.h>
+#endif
 
 NS_CC_BEGIN
 
@@ -57,6 +63,13 @@ namespace
     bool __premultiplyAlpha = false;
 
     GLuint __currentOffScreenFbo = 0;
+
+    // -1 means not checked yet.
+    int __instancingSupported = -1;
+    GLuint __vertexAttribDivisors[MAX_ATTRIBUTE_UNIT] = {0};
+    int __programBinarySupported = -1;
+    int __mapBufferRangeSupported = -1;
+    int __fenceSyncSupported = -1;
 }
 
 
@@ -69,7 +82,15 @@ void ccInvalidateStateCache()
     
     __enabledVertexAttribArrayFlag = 0;
     for (int i = 0; i < MAX_ATTRIBUTE_UNIT; ++i)
+    {
         __enabledVertexAttribArrayInfo[i] = VertexAttributePointerInfo();
+        // Unknown state, so that the next divisor is always applied.
+        __vertexAttribDivisors[i] = (GLuint)-1;
+    }
+    __instancingSupported = -1;
+    __programBinarySupported = -1;
+    __mapBufferRangeSupported = -1;
+    __fenceSyncSupported = -1;
 
     _currentUnpackAlignment = -1;
     __unpackFlipY = false;
@@ -117,6 +138,8 @@ BoundTextureInfo* getBoundTextureInfo(uint32_t textureUnit)
 
 void ccBindFramebuffer(GLenum target,GLuint buffer)
 {
+#if !CC_USE_GFX_NULL
+    // The null driver runs without an application and its main frame buffer.
     if(Application::getInstance()->isDownsampleEnabled())
     {
         if(target == GL_FRAMEBUFFER && buffer == Application::getInstance()->getMainFBO())
@@ -124,6 +147,7 @@ void ccBindFramebuffer(GLenum target,GLuint buffer)
             buffer = __currentOffScreenFbo;
         }
     }
+#endif
 
     glBindFramebuffer(target , buffer);
 }
@@ -265,6 +289,373 @@ const VertexAttributePointerInfo* getVertexAttribPointerInfo(GLuint index)
     return &__enabledVertexAttribArrayInfo[index];
 }
 
+/****************************************************************************************
+ Instancing related
+ ***************************************************************************************/
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+// Not all NDK headers declare the instanced functions, so they are loaded at runtime.
+typedef void (GL_APIENTRY *CCPFNGLVERTEXATTRIBDIVISORPROC)(GLuint index, GLuint divisor);
+typedef void (GL_APIENTRY *CCPFNGLDRAWELEMENTSINSTANCEDPROC)(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instanceCount);
+typedef void (GL_APIENTRY *CCPFNGLDRAWARRAYSINSTANCEDPROC)(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount);
+
+namespace
+{
+    CCPFNGLVERTEXATTRIBDIVISORPROC __glVertexAttribDivisor = nullptr;
+    CCPFNGLDRAWELEMENTSINSTANCEDPROC __glDrawElementsInstanced = nullptr;
+    CCPFNGLDRAWARRAYSINSTANCEDPROC __glDrawArraysInstanced = nullptr;
+
+    bool loadInstancingFunctions(const char* suffix)
+    {
+        std::string postfix = suffix;
+        __glVertexAttribDivisor = (CCPFNGLVERTEXATTRIBDIVISORPROC)eglGetProcAddress(("glVertexAttribDivisor" + postfix).c_str());
+        __glDrawElementsInstanced = (CCPFNGLDRAWELEMENTSINSTANCEDPROC)eglGetProcAddress(("glDrawElementsInstanced" + postfix).c_str());
+        __glDrawArraysInstanced = (CCPFNGLDRAWARRAYSINSTANCEDPROC)eglGetProcAddress(("glDrawArraysInstanced" + postfix).c_str());
+        return __glVertexAttribDivisor && __glDrawElementsInstanced && __glDrawArraysInstanced;
+    }
+}
+#endif
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID || CC_TARGET_PLATFORM == CC_PLATFORM_IOS || CC_TARGET_PLATFORM == CC_PLATFORM_MAC
+static bool hasGLExtension(const char* name)
+{
+    const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+    return extensions && strstr(extensions, name) != nullptr;
+}
+#endif
+
+static bool checkInstancingSupported()
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    const char* version = (const char*)glGetString(GL_VERSION);
+    if (version && strstr(version, "OpenGL ES 3") && loadInstancingFunctions(""))
+        return true;
+    if (hasGLExtension("GL_EXT_instanced_arrays") && loadInstancingFunctions("EXT"))
+        return true;
+    if (hasGLExtension("GL_ANGLE_instanced_arrays") && loadInstancingFunctions("ANGLE"))
+        return true;
+    return false;
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_IOS
+    return hasGLExtension("GL_EXT_instanced_arrays");
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_MAC
+    return hasGLExtension("GL_ARB_instanced_arrays") && hasGLExtension("GL_ARB_draw_instanced");
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    return glVertexAttribDivisor != nullptr && glDrawElementsInstanced != nullptr && glDrawArraysInstanced != nullptr;
+#else
+    return false;
+#endif
+}
+
+bool ccIsInstancingSupported()
+{
+    if (__instancingSupported < 0)
+    {
+        __instancingSupported = checkInstancingSupported() ? 1 : 0;
+    }
+    return __instancingSupported == 1;
+}
+
+void ccVertexAttribDivisor(GLuint index, GLuint divisor)
+{
+    assert(index < MAX_ATTRIBUTE_UNIT);
+    if (index >= MAX_ATTRIBUTE_UNIT)
+        return;
+
+    if (__vertexAttribDivisors[index] == divisor)
+        return;
+
+    __vertexAttribDivisors[index] = divisor;
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    __glVertexAttribDivisor(index, divisor);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_IOS
+    glVertexAttribDivisorEXT(index, divisor);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_MAC
+    glVertexAttribDivisorARB(index, divisor);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    glVertexAttribDivisor(index, divisor);
+#endif
+}
+
+void ccDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instanceCount)
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    __glDrawElementsInstanced(mode, count, type, indices, instanceCount);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_IOS
+    glDrawElementsInstancedEXT(mode, count, type, indices, instanceCount);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_MAC
+    glDrawElementsInstancedARB(mode, count, type, indices, instanceCount);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    glDrawElementsInstanced(mode, count, type, indices, instanceCount);
+#endif
+}
+
+void ccDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount)
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    __glDrawArraysInstanced(mode, first, count, instanceCount);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_IOS
+    glDrawArraysInstancedEXT(mode, first, count, instanceCount);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_MAC
+    glDrawArraysInstancedARB(mode, first, count, instanceCount);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    glDrawArraysInstanced(mode, first, count, instanceCount);
+#endif
+}
+
+/****************************************************************************************
+ Program binary related
+ ***************************************************************************************/
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+typedef void (GL_APIENTRY *CCPFNGLGETPROGRAMBINARYPROC)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, GLvoid* binary);
+typedef void (GL_APIENTRY *CCPFNGLPROGRAMBINARYPROC)(GLuint program, GLenum binaryFormat, const GLvoid* binary, GLsizei length);
+typedef void (GL_APIENTRY *CCPFNGLPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+
+namespace
+{
+    CCPFNGLGETPROGRAMBINARYPROC __glGetProgramBinary = nullptr;
+    CCPFNGLPROGRAMBINARYPROC __glProgramBinary = nullptr;
+    CCPFNGLPROGRAMPARAMETERIPROC __glProgramParameteri = nullptr;
+
+    bool loadProgramBinaryFunctions(const char* suffix)
+    {
+        std::string postfix = suffix;
+        __glGetProgramBinary = (CCPFNGLGETPROGRAMBINARYPROC)eglGetProcAddress(("glGetProgramBinary" + postfix).c_str());
+        __glProgramBinary = (CCPFNGLPROGRAMBINARYPROC)eglGetProcAddress(("glProgramBinary" + postfix).c_str());
+        // The retrievable hint only exists in GLES3.
+        __glProgramParameteri = postfix.empty() ? (CCPFNGLPROGRAMPARAMETERIPROC)eglGetProcAddress("glProgramParameteri") : nullptr;
+        return __glGetProgramBinary && __glProgramBinary;
+    }
+}
+#endif
+
+static bool checkProgramBinarySupported()
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    const char* version = (const char*)glGetString(GL_VERSION);
+    bool loaded = (version && strstr(version, "OpenGL ES 3") && loadProgramBinaryFunctions("")) ||
+                  (hasGLExtension("GL_OES_get_program_binary") && loadProgramBinaryFunctions("OES"));
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    bool loaded = glGetProgramBinary != nullptr && glProgramBinary != nullptr;
+#else
+    // iOS and Mac contexts have no program binary support.
+    bool loaded = false;
+#endif
+    if (!loaded)
+        return false;
+
+    // Some drivers expose the functions without any binary format.
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    return formatCount > 0;
+}
+
+bool ccIsProgramBinarySupported()
+{
+    if (__programBinarySupported < 0)
+    {
+        __programBinarySupported = checkProgramBinarySupported() ? 1 : 0;
+    }
+    return __programBinarySupported == 1;
+}
+
+void ccGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, GLvoid* binary)
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    __glGetProgramBinary(program, bufSize, length, binaryFormat, binary);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    glGetProgramBinary(program, bufSize, length, binaryFormat, binary);
+#endif
+}
+
+void ccProgramBinary(GLuint program, GLenum binaryFormat, const GLvoid* binary, GLsizei length)
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    __glProgramBinary(program, binaryFormat, binary, length);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    glProgramBinary(program, binaryFormat, binary, length);
+#endif
+}
+
+void ccProgramBinaryRetrievableHint(GLuint program)
+{
+    if (!ccIsProgramBinarySupported())
+        return;
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    if (__glProgramParameteri)
+        __glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    if (glProgramParameteri)
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+}
+
+/****************************************************************************************
+ Buffer mapping related
+ ***************************************************************************************/
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+typedef GLvoid* (GL_APIENTRY *CCPFNGLMAPBUFFERRANGEPROC)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+typedef GLboolean (GL_APIENTRY *CCPFNGLUNMAPBUFFERPROC)(GLenum target);
+
+namespace
+{
+    CCPFNGLMAPBUFFERRANGEPROC __glMapBufferRange = nullptr;
+    CCPFNGLUNMAPBUFFERPROC __glUnmapBuffer = nullptr;
+
+    bool loadMapBufferRangeFunctions(const char* mapName, const char* unmapName)
+    {
+        __glMapBufferRange = (CCPFNGLMAPBUFFERRANGEPROC)eglGetProcAddress(mapName);
+        __glUnmapBuffer = (CCPFNGLUNMAPBUFFERPROC)eglGetProcAddress(unmapName);
+        return __glMapBufferRange && __glUnmapBuffer;
+    }
+}
+#endif
+
+static bool checkMapBufferRangeSupported()
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    const char* version = (const char*)glGetString(GL_VERSION);
+    // The EXT extension has no unmap function of its own, it relies on GL_OES_mapbuffer.
+    return (version && strstr(version, "OpenGL ES 3") && loadMapBufferRangeFunctions("glMapBufferRange", "glUnmapBuffer")) ||
+           (hasGLExtension("GL_EXT_map_buffer_range") && loadMapBufferRangeFunctions("glMapBufferRangeEXT", "glUnmapBufferOES"));
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    return glMapBufferRange != nullptr && glUnmapBuffer != nullptr;
+#else
+    // Orphaning is as fast as mapping on iOS and Mac drivers.
+    return false;
+#endif
+}
+
+bool ccIsMapBufferRangeSupported()
+{
+    if (__mapBufferRangeSupported < 0)
+    {
+        __mapBufferRangeSupported = checkMapBufferRangeSupported() ? 1 : 0;
+    }
+    return __mapBufferRangeSupported == 1;
+}
+
+GLvoid* ccMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    return __glMapBufferRange(target, offset, length, access);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    return glMapBufferRange(target, offset, length, access);
+#else
+    return nullptr;
+#endif
+}
+
+bool ccUnmapBuffer(GLenum target)
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    return __glUnmapBuffer(target) == GL_TRUE;
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    return glUnmapBuffer(target) == GL_TRUE;
+#else
+    return false;
+#endif
+}
+
+/****************************************************************************************
+ Fence sync related
+ ***************************************************************************************/
+
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+#ifndef GL_ALREADY_SIGNALED
+#define GL_ALREADY_SIGNALED 0x911A
+#endif
+#ifndef GL_CONDITION_SATISFIED
+#define GL_CONDITION_SATISFIED 0x911C
+#endif
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID && !CC_USE_GFX_NULL
+typedef void* (GL_APIENTRY *CCPFNGLFENCESYNCPROC)(GLenum condition, GLbitfield flags);
+typedef GLenum (GL_APIENTRY *CCPFNGLCLIENTWAITSYNCPROC)(void* sync, GLbitfield flags, uint64_t timeout);
+typedef void (GL_APIENTRY *CCPFNGLDELETESYNCPROC)(void* sync);
+
+namespace
+{
+    CCPFNGLFENCESYNCPROC __glFenceSync = nullptr;
+    CCPFNGLCLIENTWAITSYNCPROC __glClientWaitSync = nullptr;
+    CCPFNGLDELETESYNCPROC __glDeleteSync = nullptr;
+}
+#endif
+
+static bool checkFenceSyncSupported()
+{
+#if CC_USE_GFX_NULL
+    return renderer::GFXNull::isFenceSyncSupported();
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    const char* version = (const char*)glGetString(GL_VERSION);
+    if (!version || !strstr(version, "OpenGL ES 3"))
+        return false;
+    __glFenceSync = (CCPFNGLFENCESYNCPROC)eglGetProcAddress("glFenceSync");
+    __glClientWaitSync = (CCPFNGLCLIENTWAITSYNCPROC)eglGetProcAddress("glClientWaitSync");
+    __glDeleteSync = (CCPFNGLDELETESYNCPROC)eglGetProcAddress("glDeleteSync");
+    return __glFenceSync && __glClientWaitSync && __glDeleteSync;
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    return glFenceSync != nullptr && glClientWaitSync != nullptr && glDeleteSync != nullptr;
+#else
+    // Mapping is not used on iOS and Mac, so nothing needs to be fenced.
+    return false;
+#endif
+}
+
+bool ccIsFenceSyncSupported()
+{
+    if (__fenceSyncSupported < 0)
+    {
+        __fenceSyncSupported = checkFenceSyncSupported() ? 1 : 0;
+    }
+    return __fenceSyncSupported == 1;
+}
+
+void* ccFenceSync()
+{
+#if CC_USE_GFX_NULL
+    return ccNullFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    return __glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    return (void*)glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#else
+    return nullptr;
+#endif
+}
+
+bool ccClientWaitSync(void* sync, uint64_t timeout)
+{
+    GLenum result = 0;
+#if CC_USE_GFX_NULL
+    result = ccNullClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    result = __glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    result = glClientWaitSync((GLsync)sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+#endif
+    return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+void ccDeleteSync(void* sync)
+{
+    if (!sync)
+        return;
+#if CC_USE_GFX_NULL
+    ccNullDeleteSync(sync);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    __glDeleteSync(sync);
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    glDeleteSync((GLsync)sync);
+#endif
+}
+
 /****************************************************************************************
  Other functions.
  ***************************************************************************************/
@@ -81,6 +81,59 @@ void ccDisableVertexAttribArray(GLuint index);
 void ccVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const GLvoid*);
 const VertexAttributePointerInfo* getVertexAttribPointerInfo(GLuint index);
 
+// Instanced drawing, it is core in GLES3, and comes from GL_EXT/ANGLE/ARB_instanced_arrays otherwise.
+// Only use the functions below when ccIsInstancingSupported() returns true.
+bool ccIsInstancingSupported();
+void ccVertexAttribDivisor(GLuint index, GLuint divisor);
+void ccDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instanceCount);
+void ccDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount);
+
+// Program binaries, they are core in GLES3 and come from GL_OES/ARB_get_program_binary otherwise.
+// Only use the functions below when ccIsProgramBinarySupported() returns true.
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+bool ccIsProgramBinarySupported();
+void ccGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, GLvoid* binary);
+void ccProgramBinary(GLuint program, GLenum binaryFormat, const GLvoid* binary, GLsizei length);
+// Asks the driver to keep the binary of a program which will be linked, it does nothing if not needed.
+void ccProgramBinaryRetrievableHint(GLuint program);
+
+// Buffer mapping, it is core in GLES3 and comes from GL_EXT_map_buffer_range/ARB_map_buffer_range otherwise.
+// Only use the functions below when ccIsMapBufferRangeSupported() returns true.
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_INVALIDATE_RANGE_BIT
+#define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#endif
+#ifndef GL_MAP_INVALIDATE_BUFFER_BIT
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+#endif
+#ifndef GL_MAP_UNSYNCHRONIZED_BIT
+#define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#endif
+bool ccIsMapBufferRangeSupported();
+// Returns nullptr if the driver fails to map the range.
+GLvoid* ccMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+// Returns false if the data store was corrupted while mapped, the content must be uploaded again.
+bool ccUnmapBuffer(GLenum target);
+
+// Fence syncs, they are core in GLES3 and come from ARB_sync on desktop GL.
+// Only use the functions below when ccIsFenceSyncSupported() returns true, a sync object is passed as an opaque pointer.
+bool ccIsFenceSyncSupported();
+// Inserts a fence after the commands issued so far, returns nullptr if the driver fails to create it.
+void* ccFenceSync();
+// Flushes the commands and waits until the fence is signaled or the timeout in nanoseconds expires, returns true if it is signaled.
+bool ccClientWaitSync(void* sync, uint64_t timeout);
+void ccDeleteSync(void* sync);
+
 //  Converts pixel if unpackFlipY or premultiplyAlpha is true.
 void ccFlipYOrPremultiptyAlphaIfNeeded(GLenum format, GLsizei width, GLsizei height, uint32_t pixelBytes, GLvoid* pixels);
 
@@ -113,6 +113,17 @@ THE SOFTWARE.
 #define CC_ENABLE_GL_STATE_CACHE 1
 #endif
 
+/** @def CC_USE_GFX_NULL
+ * If enabled, the GL functions called by the renderer and the gfx layer are replaced by a null driver.
+ * The null driver needs no GL context, it records draw calls, state changes and uploaded bytes and discards everything else,
+ * so the native renderer can be measured on a machine without GPU. See renderer/gfx/GFXNull.h.
+ *
+ * Default value: Disabled by default
+ */
+#ifndef CC_USE_GFX_NULL
+#define CC_USE_GFX_NULL 0
+#endif
+
 /** @def CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
  * If enabled, the texture coordinates will be calculated by using this formula:
  * - texCoord.left = (rect.origin.x*2+1) / (texture.wide*2);
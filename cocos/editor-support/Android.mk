@@ -90,6 +90,8 @@ spine/VertexEffect.cpp \
 spine-creator-support/AttachmentVertices.cpp \
 spine-creator-support/SkeletonAnimation.cpp \
 spine-creator-support/SkeletonDataMgr.cpp \
+spine-creator-support/SpineAllocator.cpp \
+spine-creator-support/MappedFile.cpp \
 spine-creator-support/SkeletonRenderer.cpp \
 spine-creator-support/spine-cocos2dx.cpp \
 spine-creator-support/VertexEffectDelegate.cpp \
@@ -110,6 +112,7 @@ dragonbones/animation/TimelineState.cpp \
 dragonbones/animation/WorldClock.cpp \
 dragonbones/armature/Armature.cpp \
 dragonbones/armature/Bone.cpp \
+dragonbones/armature/ArmaturePose.cpp \
 dragonbones/armature/Constraint.cpp \
 dragonbones/armature/DeformVertices.cpp \
 dragonbones/armature/Slot.cpp \
@@ -97,6 +97,38 @@ void MeshBuffer::uploadIB()
     glIB->update(0, _ib.getBuffer(), length);
 }
 
+bool MeshBuffer::appendSegment(const IOBuffer& vb, std::size_t vbStart, std::size_t vbEnd,
+                               const IOBuffer& ib, std::size_t ibStart, std::size_t ibEnd, int& indexOffset)
+{
+    std::size_t vbLen = vbEnd - vbStart;
+    std::size_t ibLen = ibEnd - ibStart;
+    if (vbLen > MAX_VERTEX_BUFFER_SIZE * _vertexFormat * sizeof(float))
+    {
+        return false;
+    }
+    
+    // All vertices must be in one buffer, since they share the same index range.
+    _vb.checkSpace(vbLen, true);
+    _ib.checkSpace(ibLen, true);
+    
+    std::size_t vertexBytes = _vertexFormat * sizeof(float);
+    int vertexOffset = (int)(_vb.getCurPos() / vertexBytes) - (int)(vbStart / vertexBytes);
+    indexOffset = (int)(_ib.getCurPos() / sizeof(unsigned short)) - (int)(ibStart / sizeof(unsigned short));
+    
+    memcpy(_vb.getCurBuffer(), vb.getBuffer() + vbStart, vbLen);
+    
+    const unsigned short* srcIndices = (const unsigned short*)(ib.getBuffer() + ibStart);
+    unsigned short* dstIndices = (unsigned short*)_ib.getCurBuffer();
+    for (std::size_t i = 0, n = ibLen / sizeof(unsigned short); i < n; i++)
+    {
+        dstIndices[i] = (unsigned short)(srcIndices[i] + vertexOffset);
+    }
+    
+    _vb.move((int)vbLen);
+    _ib.move((int)ibLen);
+    return true;
+}
+
 void MeshBuffer::next()
 {
     _bufferPos++;
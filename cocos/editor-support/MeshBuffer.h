@@ -56,6 +56,21 @@ public:
         return _ib;
     }
     
+    /**
+     * @brief Appends vertices and indices generated in other buffers, indices are rebased to the appended vertices.
+     * If the current vertex buffer has no space, it is uploaded and the next one is used.
+     * @param[in] vb Source vertex buffer, which has the same vertex format.
+     * @param[in] vbStart Begin of the vertices in bytes.
+     * @param[in] vbEnd End of the vertices in bytes.
+     * @param[in] ib Source index buffer, its indices are relative to the beginning of vb.
+     * @param[in] ibStart Begin of the indices in bytes.
+     * @param[in] ibEnd End of the indices in bytes.
+     * @param[out] indexOffset How many indices the source ones are moved by, it can be negative.
+     * @return false if the vertices are too many to fit into one vertex buffer.
+     */
+    bool appendSegment(const IOBuffer& vb, std::size_t vbStart, std::size_t vbEnd,
+                       const IOBuffer& ib, std::size_t ibStart, std::size_t ibEnd, int& indexOffset);
+    
     void uploadVB();
     void uploadIB();
     void reset();
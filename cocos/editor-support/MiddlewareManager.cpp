@@ -24,9 +24,65 @@
 #include "MiddlewareManager.h"
 #include "base/CCGLUtils.h"
 #include "scripting/js-bindings/jswrapper/SeApi.h"
+#include "renderer/scene/JobSystem.hpp"
 #include <algorithm>
 
+// Initial size of the buffers of a render segment, they grow on demand.
+#define INIT_SEGMENT_BUFFER_SIZE 65536
+// Split parallel middlewares into about this many render segments per thread.
+#define SEGMENTS_PER_THREAD 4
+
+using namespace cocos2d::renderer;
+
 MIDDLEWARE_BEGIN
+
+RenderSegment::~RenderSegment()
+{
+    for (auto it : _vbMap)
+    {
+        delete it.second;
+    }
+    for (auto it : _ibMap)
+    {
+        delete it.second;
+    }
+    _vbMap.clear();
+    _ibMap.clear();
+}
+
+IOBuffer& RenderSegment::getVB(int format)
+{
+    IOBuffer* vb = _vbMap[format];
+    if (!vb)
+    {
+        vb = new IOBuffer(INIT_SEGMENT_BUFFER_SIZE);
+        _vbMap[format] = vb;
+    }
+    return *vb;
+}
+
+IOBuffer& RenderSegment::getIB(int format)
+{
+    IOBuffer* ib = _ibMap[format];
+    if (!ib)
+    {
+        ib = new IOBuffer(INIT_SEGMENT_BUFFER_SIZE);
+        _ibMap[format] = ib;
+    }
+    return *ib;
+}
+
+void RenderSegment::reset()
+{
+    for (auto it : _vbMap)
+    {
+        it.second->reset();
+    }
+    for (auto it : _ibMap)
+    {
+        it.second->reset();
+    }
+}
     
 MiddlewareManager* MiddlewareManager::_instance = nullptr;
 
@@ -46,6 +102,19 @@ MiddlewareManager::~MiddlewareManager()
         }
     }
     _mbMap.clear();
+    
+    for (auto segment : _segments)
+    {
+        delete segment;
+    }
+    _segments.clear();
+    
+    // Editors may outlive the manager, let them be added to the next one.
+    for (auto editor : _updateList)
+    {
+        if (editor) editor->_timerIndex = -1;
+    }
+    _updateList.clear();
 }
 
 MeshBuffer* MiddlewareManager::getMeshBuffer(int format)
@@ -59,35 +128,37 @@ MeshBuffer* MiddlewareManager::getMeshBuffer(int format)
     return mb;
 }
 
-void MiddlewareManager::_clearRemoveList()
+void MiddlewareManager::_compactUpdateList()
 {
-    for (std::size_t i = 0; i < _removeList.size(); i++)
+    if (_removedCount == 0) return;
+    
+    std::size_t count = 0;
+    for (std::size_t i = 0, n = _updateList.size(); i < n; i++)
     {
-        auto editor = _removeList[i];
-        auto it = std::find(_updateList.begin(), _updateList.end(), editor);
-        if (it != _updateList.end())
+        auto editor = _updateList[i];
+        if (editor)
         {
-            _updateList.erase(it);
+            editor->_timerIndex = (int)count;
+            _updateList[count++] = editor;
         }
     }
-    
-    _removeList.clear();
+    _updateList.resize(count);
+    _removedCount = 0;
 }
 
 void MiddlewareManager::update(float dt)
 {
     isUpdating = true;
     
+    _parallelList.clear();
     for (std::size_t i = 0, n = _updateList.size(); i < n; i++)
     {
         auto editor = _updateList[i];
-        if (_removeList.size() > 0)
+        if (!editor) continue;
+        
+        if (_parallelEnabled && editor->isParallelSupported())
         {
-            auto removeIt = std::find(_removeList.begin(), _removeList.end(), editor);
-            if (removeIt == _removeList.end())
-            {
-                editor->update(dt);
-            }
+            _parallelList.push_back(i);
         }
         else
         {
@@ -95,9 +166,69 @@ void MiddlewareManager::update(float dt)
         }
     }
     
+    if (!_parallelList.empty())
+    {
+        isParallelUpdating = true;
+        JobSystem::getInstance()->parallelFor(0, _parallelList.size(), 1, [this, dt](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; i++)
+            {
+                // Serial updates above may have removed it.
+                auto editor = _updateList[_parallelList[i]];
+                if (editor) editor->update(dt);
+            }
+        });
+        isParallelUpdating = false;
+        
+        // Callbacks may remove any middleware, so check the list every time.
+        for (auto index : _parallelList)
+        {
+            auto editor = _updateList[index];
+            if (editor) editor->postUpdate();
+        }
+    }
+    
     isUpdating = false;
     
-    _clearRemoveList();
+    _compactUpdateList();
+}
+
+void MiddlewareManager::_prepareRender(float dt)
+{
+    _preparedList.assign(_updateList.size(), 0);
+    _parallelList.clear();
+    for (std::size_t i = 0, n = _updateList.size(); i < n; i++)
+    {
+        auto editor = _updateList[i];
+        if (editor && editor->isParallelSupported())
+        {
+            _parallelList.push_back(i);
+            _preparedList[i] = 1;
+        }
+    }
+    if (_parallelList.empty()) return;
+    
+    // Every segment takes a continuous range of the list, so the result does not depend on scheduling.
+    auto jobSystem = JobSystem::getInstance();
+    std::size_t count = _parallelList.size();
+    std::size_t segmentCount = std::min(count, (std::size_t)(jobSystem->getConcurrency() * SEGMENTS_PER_THREAD));
+    while (_segments.size() < segmentCount)
+    {
+        _segments.push_back(new RenderSegment());
+    }
+    
+    jobSystem->parallelFor(0, segmentCount, 1, [this, dt, count, segmentCount](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t s = begin; s < end; s++)
+        {
+            auto segment = _segments[s];
+            segment->reset();
+            for (std::size_t i = s * count / segmentCount, n = (s + 1) * count / segmentCount; i < n; i++)
+            {
+                _updateList[_parallelList[i]]->prepareRender(dt, *segment);
+            }
+        }
+    });
 }
 
 void MiddlewareManager::render(float dt)
@@ -113,27 +244,29 @@ void MiddlewareManager::render(float dt)
     
     isRendering = true;
     
+    if (_parallelEnabled)
+    {
+        _prepareRender(dt);
+    }
+    
+    // Merge in render order, so the vertices are the same as serial mode.
     auto isOrderDirty = false;
     uint32_t maxRenderOrder = 0;
     for (std::size_t i = 0, n = _updateList.size(); i < n; i++)
     {
         auto editor = _updateList[i];
-        uint32_t renderOrder = maxRenderOrder;
-        if (_removeList.size() > 0)
+        if (!editor) continue;
+        
+        if (_parallelEnabled && i < _preparedList.size() && _preparedList[i])
         {
-            auto removeIt = std::find(_removeList.begin(), _removeList.end(), editor);
-            if (removeIt == _removeList.end())
-            {
-                editor->render(dt);
-                renderOrder = editor->getRenderOrder();
-            }
+            editor->commitRender(dt);
         }
         else
         {
             editor->render(dt);
-            renderOrder = editor->getRenderOrder();
         }
         
+        uint32_t renderOrder = editor->getRenderOrder();
         if (maxRenderOrder > renderOrder)
         {
             isOrderDirty =  true;
@@ -156,7 +289,7 @@ void MiddlewareManager::render(float dt)
         }
     }
     
-    _clearRemoveList();
+    _compactUpdateList();
     
     if (isOrderDirty)
     {
@@ -164,37 +297,29 @@ void MiddlewareManager::render(float dt)
         {
             return it1->getRenderOrder() < it2->getRenderOrder();
         });
+        for (std::size_t i = 0, n = _updateList.size(); i < n; i++)
+        {
+            _updateList[i]->_timerIndex = (int)i;
+        }
     }
 }
 
 void MiddlewareManager::addTimer(IMiddleware* editor)
 {
-    auto it0 = std::find(_updateList.begin(), _updateList.end(), editor);
-    if (it0 != _updateList.end()) {
-        return;
-    }
+    if (editor->_timerIndex >= 0) return;
     
-    auto it1 = std::find(_removeList.begin(), _removeList.end(), editor);
-    if (it1 != _removeList.end())
-    {
-        _removeList.erase(it1);
-    }
+    editor->_timerIndex = (int)_updateList.size();
     _updateList.push_back(editor);
 }
 
 void MiddlewareManager::removeTimer(IMiddleware* editor)
 {
-    if (isUpdating || isRendering)
-    {
-        _removeList.push_back(editor);
-    }
-    else
-    {
-        auto it = std::find(_updateList.begin(), _updateList.end(), editor);
-        if (it != _updateList.end())
-        {
-            _updateList.erase(it);
-        }
-    }
+    auto index = editor->_timerIndex;
+    if (index < 0 || index >= (int)_updateList.size() || _updateList[index] != editor) return;
+    
+    // Leave a hole instead of erasing, traverse may be in progress.
+    _updateList[index] = nullptr;
+    editor->_timerIndex = -1;
+    _removedCount++;
 }
 MIDDLEWARE_END
@@ -31,6 +31,24 @@
 
 MIDDLEWARE_BEGIN
 
+/**
+ * Vertex and index buffers of one parallel render job, there is a pair of buffers for every vertex format.
+ * Middlewares append vertices to the segment on a worker thread,
+ * and then MiddlewareManager merges them into the MeshBuffer in render order.
+ */
+class RenderSegment {
+public:
+    RenderSegment() {}
+    ~RenderSegment();
+    
+    IOBuffer& getVB(int format);
+    IOBuffer& getIB(int format);
+    void reset();
+private:
+    std::map<int, IOBuffer*> _vbMap;
+    std::map<int, IOBuffer*> _ibMap;
+};
+
 /**
  * All middleware must implement IMiddleware interface.
  */
@@ -41,6 +59,29 @@ public:
     virtual void update(float dt) = 0;
     virtual void render(float dt) = 0;
     virtual uint32_t getRenderOrder() const = 0;
+    
+    /**
+     * Whether update and prepareRender can run on a worker thread in parallel mode,
+     * the middleware must only touch the objects owned by itself there.
+     */
+    virtual bool isParallelSupported() const { return false; }
+    /**
+     * Called on the main thread in render order after the parallel update,
+     * callbacks deferred by the update should be raised here.
+     */
+    virtual void postUpdate() {}
+    /**
+     * Generates vertices and indices into the segment, it runs on a worker thread.
+     */
+    virtual void prepareRender(float dt, RenderSegment& segment) {}
+    /**
+     * Merges the prepared vertices into the MeshBuffer and updates render data, it runs on the main thread in render order.
+     */
+    virtual void commitRender(float dt) {}
+private:
+    friend class MiddlewareManager;
+    // Position in the update list of MiddlewareManager, -1 means not in the list.
+    int _timerIndex = -1;
 };
 
 /**
@@ -100,19 +141,36 @@ public:
     
     MeshBuffer* getMeshBuffer(int format);
     
+    /**
+     * @brief Enables parallel mode, middlewares which support it are updated and generate vertices on worker threads.
+     */
+    void setParallelEnabled(bool enabled) { _parallelEnabled = enabled; }
+    bool isParallelEnabled() const { return _parallelEnabled; }
+    
     MiddlewareManager();
     ~MiddlewareManager();
     
     // If manager is traversing _updateMap, will set the flag untill traverse is finished.
     bool isRendering = false;
     bool isUpdating = false;
+    // True while middlewares are updated on worker threads, callbacks must be deferred to postUpdate.
+    bool isParallelUpdating = false;
 private:
-    void _clearRemoveList();
+    void _compactUpdateList();
+    void _prepareRender(float dt);
 private:
+    // Removed middlewares leave null in the list, it is compacted after traverse.
     std::vector<IMiddleware*> _updateList;
-    std::vector<IMiddleware*> _removeList;
+    std::size_t _removedCount = 0;
     std::map<int, MeshBuffer*> _mbMap;
     
+    bool _parallelEnabled = false;
+    // Indices in _updateList of middlewares running on worker threads.
+    std::vector<std::size_t> _parallelList;
+    // Whether the middleware at the same index of _updateList is prepared by a parallel job.
+    std::vector<uint8_t> _preparedList;
+    std::vector<RenderSegment*> _segments;
+    
     static MiddlewareManager* _instance;
 };
 MIDDLEWARE_END
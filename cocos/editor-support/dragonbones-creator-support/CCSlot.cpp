@@ -312,6 +312,9 @@ void CCSlot::_updateMesh()
             weightFloatOffset += 65536; // Fixed out of bouds bug. 
         }
 
+        // Bone matrices are read from the pose of the armature if the bones were updated by it.
+        const auto pose = _armature->_getSolvedPose();
+
         for (
             std::size_t i = 0, iB = weightData->offset + (unsigned)BinaryOffset::WeigthBoneIndices + bones.size(), iV = (std::size_t)weightFloatOffset, iF = 0;
             i < vertexCount;
@@ -326,7 +329,6 @@ void CCSlot::_updateMesh()
                 const auto bone = bones[boneIndex];
                 if (bone != nullptr) 
                 {
-                    const auto& matrix = bone->globalTransformMatrix;
                     const auto weight = floatArray[iV++];
                     auto xL = floatArray[iV++] * scale;
                     auto yL = floatArray[iV++] * scale;
@@ -337,8 +339,18 @@ void CCSlot::_updateMesh()
                         yL += deformVertices[iF++];
                     }
 
-                    xG += (matrix.a * xL + matrix.c * yL + matrix.tx) * weight;
-                    yG += (matrix.b * xL + matrix.d * yL + matrix.ty) * weight;
+                    if (pose != nullptr)
+                    {
+                        const auto k = bone->_poseIndex;
+                        xG += (pose->a[k] * xL + pose->c[k] * yL + pose->tx[k]) * weight;
+                        yG += (pose->b[k] * xL + pose->d[k] * yL + pose->ty[k]) * weight;
+                    }
+                    else
+                    {
+                        const auto& matrix = bone->globalTransformMatrix;
+                        xG += (matrix.a * xL + matrix.c * yL + matrix.tx) * weight;
+                        yG += (matrix.b * xL + matrix.d * yL + matrix.ty) * weight;
+                    }
                 }
             }
 
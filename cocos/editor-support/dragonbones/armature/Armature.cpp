@@ -69,6 +69,9 @@ void Armature::_onClear()
     _flipY = false;
     _cacheFrameIndex = -1;
     _bones.clear();
+    _pose.clear();
+    _poseSupported = false;
+    _poseSolved = false;
     _slots.clear();
     _constraints.clear();
     _actions.clear();
@@ -111,6 +114,61 @@ void Armature::_sortZOrder(const int16_t* slotIndices, unsigned offset)
     }
 }
 
+bool Armature::_updateBonePoses()
+{
+    const auto count = _bones.size();
+    if (_pose.size() != count)
+    {
+        _pose.resize(count);
+        _poseSupported = true;
+        _poseSolved = false;
+
+        for (const auto bone : _bones)
+        {
+            bone->_poseIndex = -1;
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto bone = _bones[i];
+            const auto parent = bone->getParent();
+            const auto boneData = bone->_boneData;
+            bone->_poseIndex = (int)i;
+
+            if (parent == nullptr)
+            {
+                _pose.parents[i] = -1;
+                continue;
+            }
+
+            // The parent must be solved before its child, and the child must inherit all of its matrix.
+            _pose.parents[i] = parent->_poseIndex;
+            if (parent->_poseIndex < 0 || !boneData->inheritTranslation || !boneData->inheritRotation || !boneData->inheritScale)
+            {
+                _poseSupported = false;
+            }
+        }
+    }
+
+    // Cached frames and constraints are updated bone by bone.
+    if (!_poseSupported || _cacheFrameIndex >= 0 || !_constraints.empty())
+    {
+        _poseSolved = false;
+        return false;
+    }
+
+    const auto flipX = _flipX;
+    const auto flipY = _flipY == DragonBones::yDown;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        _bones[i]->_updatePose(_pose, i, flipX, flipY, _poseSolved);
+    }
+
+    _poseSolved = true;
+    return true;
+}
+
 void Armature::_addBone(Bone* value)
 {
     if (std::find(_bones.begin(), _bones.end(), value) == _bones.end())
@@ -210,9 +268,12 @@ void Armature::advanceTime(float passedTime)
     // Update bones and slots.
     if (_cacheFrameIndex < 0 || _cacheFrameIndex != prevCacheFrameIndex)
     {
-        for (const auto bone : _bones)
+        if (!_updateBonePoses())
         {
-            bone->update(_cacheFrameIndex);
+            for (const auto bone : _bones)
+            {
+                bone->update(_cacheFrameIndex);
+            }
         }
 
         for (const auto slot : _slots)
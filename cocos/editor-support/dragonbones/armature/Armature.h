@@ -27,6 +27,7 @@
 #include "../animation/IAnimatable.h"
 #include "../model/ArmatureData.h"
 #include "IArmatureProxy.h"
+#include "ArmaturePose.h"
 
 DRAGONBONES_NAMESPACE_BEGIN
 /**
@@ -116,6 +117,9 @@ protected:
     void* _display;
     WorldClock* _clock;
     void* _replacedTexture;
+    ArmaturePose _pose;
+    bool _poseSupported;
+    bool _poseSolved;
 
 public:
     Armature() :
@@ -138,6 +142,19 @@ private:
     void _sortSlots();
 
 public:
+    /**
+     * @internal
+     * - Update the bones in the pose, returns false if they must be updated one by one by Bone::update.
+     */
+    bool _updateBonePoses();
+    /**
+     * @internal
+     * - The pose of the bones if they were updated by it, nullptr if they were updated by Bone::update.
+     */
+    inline const ArmaturePose* _getSolvedPose() const
+    {
+        return _poseSolved ? &_pose : nullptr;
+    }
     /**
      * @internal
      */
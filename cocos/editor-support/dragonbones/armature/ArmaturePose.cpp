@@ -0,0 +1,21 @@
+#include "ArmaturePose.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+void ArmaturePose::resize(std::size_t count)
+{
+    parents.resize(count, -1);
+    a.resize(count);
+    b.resize(count);
+    c.resize(count);
+    d.resize(count);
+    tx.resize(count);
+    ty.resize(count);
+}
+
+void ArmaturePose::clear()
+{
+    resize(0);
+}
+
+DRAGONBONES_NAMESPACE_END
@@ -0,0 +1,118 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2012-2018 DragonBones team and other contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef DRAGONBONES_ARMATUREPOSE_H
+#define DRAGONBONES_ARMATUREPOSE_H
+
+#include "../core/DragonBones.h"
+#include "../geom/Matrix.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+/**
+ * @internal
+ * - Global matrices of the bones of an armature in structure of arrays.
+ * Bones are stored in the order of the armature bones, a parent is always stored before its children,
+ * so the hierarchy is solved by one forward loop. While Armature::_getSolvedPose returns the pose, it holds
+ * the same matrices as Bone::globalTransformMatrix, readers of many bones read them from the arrays.
+ */
+class ArmaturePose
+{
+public:
+    // Index of the parent bone, -1 for root bones.
+    std::vector<int> parents;
+    // Global matrix.
+    std::vector<float> a;
+    std::vector<float> b;
+    std::vector<float> c;
+    std::vector<float> d;
+    std::vector<float> tx;
+    std::vector<float> ty;
+
+public:
+    std::size_t size() const { return parents.size(); }
+    void resize(std::size_t count);
+    void clear();
+    /**
+     * - Set the global matrix of a bone which is not concatenated by concatParent.
+     */
+    inline void setGlobal(std::size_t index, const Matrix& matrix)
+    {
+        // Read before writing, the arrays may alias the matrix for the compiler.
+        const auto aM = matrix.a;
+        const auto bM = matrix.b;
+        const auto cM = matrix.c;
+        const auto dM = matrix.d;
+        const auto txM = matrix.tx;
+        const auto tyM = matrix.ty;
+
+        a[index] = aM;
+        b[index] = bM;
+        c[index] = cM;
+        d[index] = dM;
+        tx[index] = txM;
+        ty[index] = tyM;
+    }
+    /**
+     * - Concat the local matrix of a bone with the global matrix of its parent, same as Matrix::concat,
+     * the result is set to the global matrix of the bone and to the matrix.
+     */
+    inline void concatParent(std::size_t index, const Matrix& local, Matrix& matrix)
+    {
+        const auto parent = parents[index];
+        const auto aA = local.a;
+        const auto bA = local.b;
+        const auto cA = local.c;
+        const auto dA = local.d;
+        const auto txA = local.tx;
+        const auto tyA = local.ty;
+        const auto aB = a[parent];
+        const auto bB = b[parent];
+        const auto cB = c[parent];
+        const auto dB = d[parent];
+        const auto txB = tx[parent];
+        const auto tyB = ty[parent];
+
+        const auto aC = aA * aB + bA * cB;
+        const auto bC = aA * bB + bA * dB;
+        const auto cC = cA * aB + dA * cB;
+        const auto dC = cA * bB + dA * dB;
+        const auto txC = aB * txA + cB * tyA + txB;
+        const auto tyC = dB * tyA + bB * txA + tyB;
+
+        a[index] = aC;
+        b[index] = bC;
+        c[index] = cC;
+        d[index] = dC;
+        tx[index] = txC;
+        ty[index] = tyC;
+        matrix.a = aC;
+        matrix.b = bC;
+        matrix.c = cC;
+        matrix.d = dC;
+        matrix.tx = txC;
+        matrix.ty = tyC;
+    }
+};
+
+DRAGONBONES_NAMESPACE_END
+#endif // DRAGONBONES_ARMATUREPOSE_H
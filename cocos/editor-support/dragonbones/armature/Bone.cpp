@@ -2,6 +2,7 @@
 #include "../geom/Matrix.h"
 #include "../geom/Transform.h"
 #include "Armature.h"
+#include "ArmaturePose.h"
 #include "Slot.h"
 #include "Constraint.h"
 #include "../animation/AnimationState.h"
@@ -25,14 +26,12 @@ void Bone::_onClear()
     _boneData = nullptr;
     _parent = nullptr;
     _cachedFrameIndices = nullptr;
+    _poseIndex = -1;
 }
 
-void Bone::_updateGlobalTransformMatrix(bool isCache)
+bool Bone::_composeGlobalTransform()
 {
-    const auto flipX = _armature->getFlipX();
-    const auto flipY = _armature->getFlipY() == DragonBones::yDown;
     auto inherit = _parent != nullptr;
-    auto rotation = 0.0f;
 
     if (offsetMode == OffsetMode::Additive) 
     {
@@ -92,6 +91,53 @@ void Bone::_updateGlobalTransformMatrix(bool isCache)
         }
     }
 
+    return inherit;
+}
+
+void Bone::_flipGlobalTransform(bool flipX, bool flipY)
+{
+    if (flipX || flipY) 
+    {
+        if (flipX) 
+        {
+            global.x = -global.x;
+        }
+
+        if (flipY) 
+        {
+            global.y = -global.y;
+        }
+
+        auto rotation = 0.0f;
+        if (flipX && flipY) 
+        {
+            rotation = global.rotation + Transform::PI;
+        }
+        else 
+        {
+            if (flipX) 
+            {
+                rotation = Transform::PI - global.rotation;
+            }
+            else 
+            {
+                rotation = -global.rotation;
+            }
+
+            global.skew += Transform::PI;
+        }
+
+        global.rotation = rotation;
+    }
+}
+
+void Bone::_updateGlobalTransformMatrix(bool isCache)
+{
+    const auto flipX = _armature->getFlipX();
+    const auto flipY = _armature->getFlipY() == DragonBones::yDown;
+    const auto inherit = _composeGlobalTransform();
+    auto rotation = 0.0f;
+
     if (inherit) 
     {
         const auto& parentMatrix = _parent->globalTransformMatrix;
@@ -224,39 +270,7 @@ void Bone::_updateGlobalTransformMatrix(bool isCache)
     }
     else 
     {
-        if (flipX || flipY) 
-        {
-            if (flipX) 
-            {
-                global.x = -global.x;
-            }
-
-            if (flipY) 
-            {
-                global.y = -global.y;
-            }
-
-            if (flipX && flipY) 
-            {
-                rotation = global.rotation + Transform::PI;
-            }
-            else 
-            {
-                if (flipX) 
-                {
-                    rotation = Transform::PI - global.rotation;
-                }
-                else 
-                {
-                    rotation = -global.rotation;
-                }
-
-                global.skew += Transform::PI;
-            }
-
-            global.rotation = rotation;
-        }
-
+        _flipGlobalTransform(flipX, flipY);
         global.toMatrix(globalTransformMatrix);
     }
 }
@@ -380,6 +394,54 @@ void Bone::update(int cacheFrameIndex)
     _localDirty = true;
 }
 
+void Bone::_updatePose(ArmaturePose& pose, std::size_t index, bool flipX, bool flipY, bool isPoseSolved)
+{
+    // Same as update without cache and constraints, the parent matrix is read from the pose.
+    _blendState.dirty = false;
+
+    if (_transformDirty || (_parent != nullptr && _parent->_childrenTransformDirty)) // Dirty.
+    {
+        _transformDirty = false;
+        _childrenTransformDirty = true;
+        _cachedFrameIndex = -1;
+
+        if (_localDirty)
+        {
+            if (_composeGlobalTransform())
+            {
+                Matrix local;
+                global.toMatrix(local);
+                pose.concatParent(index, local, globalTransformMatrix);
+                global.x = globalTransformMatrix.tx;
+                global.y = globalTransformMatrix.ty;
+                _globalDirty = true;
+            }
+            else
+            {
+                _flipGlobalTransform(flipX, flipY);
+                global.toMatrix(globalTransformMatrix);
+                pose.setGlobal(index, globalTransformMatrix);
+            }
+        }
+        else
+        {
+            pose.setGlobal(index, globalTransformMatrix);
+        }
+    }
+    else
+    {
+        _childrenTransformDirty = false;
+
+        // The matrix is in the pose already if the previous update was solved by the pose.
+        if (!isPoseSolved)
+        {
+            pose.setGlobal(index, globalTransformMatrix);
+        }
+    }
+
+    _localDirty = true;
+}
+
 void Bone::updateByConstraint()
 {
     if (_localDirty) 
@@ -93,6 +93,11 @@ public:
      * @internal
      */
     std::vector<int>* _cachedFrameIndices;
+    /**
+     * @internal
+     * - Index of the bone in the pose of the armature.
+     */
+    int _poseIndex;
 
 protected:
     bool _localDirty;
@@ -105,6 +110,8 @@ protected:
 
 protected:
     void _onClear() override;
+    bool _composeGlobalTransform();
+    void _flipGlobalTransform(bool flipX, bool flipY);
     void _updateGlobalTransformMatrix(bool isCache);
 
 public:
@@ -120,6 +127,10 @@ public:
      * @internal
      */
     void updateByConstraint();
+    /**
+     * @internal
+     */
+    void _updatePose(ArmaturePose& pose, std::size_t index, bool flipX, bool flipY, bool isPoseSolved);
     /**
      * - Forces the bone to update the transform in the next frame.
      * When the bone is not animated or its animation state is finished, the bone will not continue to update,
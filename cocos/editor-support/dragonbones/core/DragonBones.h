@@ -408,6 +408,7 @@ class TextureData;
 
 class IArmatureProxy;
 class Armature;
+class ArmaturePose;
 class TransformObject;
 class Bone;
 class Slot;
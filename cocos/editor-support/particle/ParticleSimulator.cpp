@@ -30,6 +30,7 @@
 #include "middleware-adapter.h"
 #include "renderer/scene/assembler/CustomAssembler.hpp"
 #include "math/Vec2.h"
+#include "renderer/scene/JobSystem.hpp"
 
 USING_NS_MW;
 
@@ -39,6 +40,8 @@ NS_CC_BEGIN
 static ParticlePool _pool;
 // particleSystem max step delta time
 static const float _maxParticleDeltaTime = 0.0333f;  
+// minimum particle count stepped by one job
+#define PARTICLE_JOB_COUNT 256
 
 void Particle::reset()
 {
@@ -215,6 +218,81 @@ void ParticleSimulator::onDisable()
     MiddlewareManager::getInstance()->removeTimer(this);
 }
 
+void ParticleSimulator::updateParticle(Particle& particle, float dt)
+{
+    particle.timeToLive -= dt;
+    if (particle.timeToLive <= 0)
+    {
+        return;
+    }
+    
+    cocos2d::Vec3 tpa;
+    cocos2d::Vec3 tpb;
+    cocos2d::Vec3 tpc;
+    
+    // Mode A: gravity, direction, tangential accel & radial accel
+    if (emitterMode == EmitterMode::GRAVITY)
+    {
+        auto& tmp = tpc;
+        auto& radial = tpa;
+        auto& tangential = tpb;
+
+        // radial acceleration
+        if (particle.pos.x || particle.pos.y)
+        {
+            radial.set(particle.pos);
+            radial.normalize();
+        }
+        tangential.set(radial);
+        radial.scale(particle.radialAccel);
+
+        // tangential acceleration
+        auto newy = tangential.x;
+        tangential.x = -tangential.y;
+        tangential.y = newy;
+
+        tangential.scale(particle.tangentialAccel);
+
+        tmp.set(radial);
+        tmp.add(tangential);
+        tmp.add(_gravity.x, _gravity.y, _gravity.z);
+        tmp.scale(dt);
+        particle.dir.add(tmp);
+
+        tmp.set(particle.dir);
+        tmp.scale(dt);
+        particle.pos.add(tmp);
+    }
+    // Mode B: radius movement
+    else
+    {
+        // Update the angle and radius of the particle.
+        particle.angle += particle.degreesPerSecond * dt;
+        particle.radius += particle.deltaRadius * dt;
+
+        particle.pos.x = -cos(particle.angle) * particle.radius;
+        particle.pos.y = -sin(particle.angle) * particle.radius;
+    }
+
+    // color
+    auto& color = particle.color;
+    auto& deltaColor = particle.deltaColor;
+    color.r = clampf(color.r + deltaColor.r * dt, 0, 255);
+    color.g = clampf(color.g + deltaColor.g * dt, 0, 255);
+    color.b = clampf(color.b + deltaColor.b * dt, 0, 255);
+    color.a = clampf(color.a + deltaColor.a * dt, 0, 255);
+
+    // size
+    particle.size += particle.deltaSize * dt;
+    if (particle.size < 0)
+    {
+        particle.size = 0;
+    }
+
+    // angle
+    particle.rotation += particle.deltaRotation * dt;
+}
+
 void ParticleSimulator::render(float dt)
 {
     dt = dt > _maxParticleDeltaTime ? _maxParticleDeltaTime : dt;
@@ -295,79 +373,22 @@ void ParticleSimulator::render(float dt)
     uint32_t indexStart = (uint32_t)ib.getCurPos()/sizeof(unsigned short);
     uint32_t indexCount = 0;
     
+    // Particles are independent of each other, so step them on the job system first.
+    auto jobSystem = renderer::JobSystem::getInstance();
+    jobSystem->parallelFor(0, particleSize, PARTICLE_JOB_COUNT, [this, dt](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; i++)
+        {
+            updateParticle(*_particles[i], dt);
+        }
+    });
+    
     while (particleIdx < particleSize)
     {
-        // Reset temporary vectors
-        tpa.x = tpa.y = tpb.x = tpb.y = tpc.x = tpc.y = 0;
-        
         auto& particle = *_particles[particleIdx];
         
         // life
-        particle.timeToLive -= dt;
         if (particle.timeToLive > 0)
         {
-            // Mode A: gravity, direction, tangential accel & radial accel
-            if (emitterMode == EmitterMode::GRAVITY)
-            {
-                auto& tmp = tpc;
-                auto& radial = tpa;
-                auto& tangential = tpb;
-                
-                // radial acceleration
-                if (particle.pos.x || particle.pos.y)
-                {
-                    radial.set(particle.pos);
-                    radial.normalize();
-                }
-                tangential.set(radial);
-                radial.scale(particle.radialAccel);
-                
-                // tangential acceleration
-                auto newy = tangential.x;
-                tangential.x = -tangential.y;
-                tangential.y = newy;
-                
-                tangential.scale(particle.tangentialAccel);
-                
-                tmp.set(radial);
-                tmp.add(tangential);
-                tmp.add(_gravity.x, _gravity.y, _gravity.z);
-                tmp.scale(dt);
-                particle.dir.add(tmp);
-                
-                tmp.set(particle.dir);
-                tmp.scale(dt);
-                particle.pos.add(tmp);
-            }
-            // Mode B: radius movement
-            else
-            {
-                // Update the angle and radius of the particle.
-                particle.angle += particle.degreesPerSecond * dt;
-                particle.radius += particle.deltaRadius * dt;
-                
-                particle.pos.x = -cos(particle.angle) * particle.radius;
-                particle.pos.y = -sin(particle.angle) * particle.radius;
-            }
-            
-            // color
-            auto& color = particle.color;
-            auto& deltaColor = particle.deltaColor;
-            color.r = clampf(color.r + deltaColor.r * dt, 0, 255);
-            color.g = clampf(color.g + deltaColor.g * dt, 0, 255);
-            color.b = clampf(color.b + deltaColor.b * dt, 0, 255);
-            color.a = clampf(color.a + deltaColor.a * dt, 0, 255);
-            
-            // size
-            particle.size += particle.deltaSize * dt;
-            if (particle.size < 0)
-            {
-                particle.size = 0;
-            }
-            
-            // angle
-            particle.rotation += particle.deltaRotation * dt;
-            
             // update values in quad buffer
             auto& newPos = tpa;
             if (positionType == PositionType::FREE || positionType == PositionType::RELATIVE)
@@ -228,6 +228,8 @@ public:
         _endColorVar.a = a;
     }
     
+private:
+    void updateParticle(Particle& particle, float dt);
 private:
     std::vector<Particle*>          _particles;
     bool                            _active = false;
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "MappedFile.h"
+#include "platform/CCFileUtils.h"
+
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32) && (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT)
+#define SPINE_MAPPED_FILE_ENABLED 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#define SPINE_MAPPED_FILE_ENABLED 0
+#endif
+
+USING_NS_CC;
+
+namespace spine {
+    MappedFile::~MappedFile () {
+        close();
+    }
+    
+    bool MappedFile::open (const std::string& path) {
+        close();
+        
+        auto fileUtils = FileUtils::getInstance();
+        std::string fullPath = fileUtils->fullPathForFilename(path);
+        if (fullPath.empty()) return false;
+        
+        if (map(fullPath)) return true;
+        
+        _data = fileUtils->getDataFromFile(fullPath);
+        if (_data.isNull()) return false;
+        _bytes = _data.getBytes();
+        _size = (std::size_t)_data.getSize();
+        return true;
+    }
+    
+    bool MappedFile::map (const std::string& fullPath) {
+        close();
+#if SPINE_MAPPED_FILE_ENABLED
+        // Relative paths are resolved inside the package, they can't be opened directly.
+        if (fullPath[0] != '/') return false;
+        
+        int fd = ::open(fullPath.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        
+        void* addr = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping stays valid after the descriptor is closed.
+        ::close(fd);
+        if (addr == MAP_FAILED) return false;
+        
+        _bytes = (const unsigned char*)addr;
+        _size = (std::size_t)st.st_size;
+        _mapped = true;
+        return true;
+#else
+        return false;
+#endif
+    }
+    
+    void MappedFile::close () {
+#if SPINE_MAPPED_FILE_ENABLED
+        if (_mapped) {
+            munmap((void*)_bytes, _size);
+        }
+#endif
+        _data.clear();
+        _bytes = nullptr;
+        _size = 0;
+        _mapped = false;
+    }
+}
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#pragma once
+
+#include "base/CCData.h"
+#include <string>
+
+namespace spine {
+
+/**
+ * Read only view of a skeleton data file.
+ * Files on the file system, e.g. in the writable path, are memory mapped so SkeletonBinary reads them without a copy
+ * of the file, other files, e.g. assets in an android apk, are loaded into memory. It only saves the file copy,
+ * SkeletonBinary still builds every object of the skeleton data from the bytes, with the same allocations as a file
+ * read into memory. Skeleton data is not used in place from the file.
+ */
+class MappedFile {
+public:
+    MappedFile () {}
+    ~MappedFile ();
+    
+    // Opens the file, path is resolved by FileUtils.
+    bool open (const std::string& path);
+    void close ();
+    
+    const unsigned char* getBytes () const { return _bytes; }
+    std::size_t getSize () const { return _size; }
+    bool isMapped () const { return _mapped; }
+private:
+    // Maps the file of an absolute path, returns false if it can't be mapped, e.g. on Windows.
+    bool map (const std::string& fullPath);
+    
+    MappedFile (const MappedFile&) = delete;
+    MappedFile& operator= (const MappedFile&) = delete;
+private:
+    const unsigned char* _bytes = nullptr;
+    std::size_t _size = 0;
+    bool _mapped = false;
+    // Content of the file if it can not be mapped.
+    cocos2d::Data _data;
+};
+
+}
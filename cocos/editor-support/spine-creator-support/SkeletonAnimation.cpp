@@ -147,14 +147,27 @@ SkeletonAnimation::~SkeletonAnimation () {
 void SkeletonAnimation::update (float deltaTime) {
 	if (!_skeleton) return;
     if (!_paused) {
+        // Listeners call into script, so events are raised by postUpdate on the main thread.
+        bool deferEvents = cocos2d::middleware::MiddlewareManager::getInstance()->isParallelUpdating;
+        if (deferEvents) _state->disableQueue();
         deltaTime *= _timeScale * GlobalTimeScale;
         if (_ownsSkeleton) _skeleton->update(deltaTime);
         _state->update(deltaTime);
         _state->apply(*_skeleton);
         _skeleton->updateWorldTransform();
+        if (deferEvents) _state->enableQueue();
     }
 }
 
+bool SkeletonAnimation::isParallelSupported () const {
+    // Shared skeleton is posed by every animation which uses it.
+    return _ownsSkeleton && SkeletonRenderer::isParallelSupported();
+}
+
+void SkeletonAnimation::postUpdate () {
+    if (_state) _state->drainQueue();
+}
+
 void SkeletonAnimation::setAnimationStateData (AnimationStateData* stateData) {
     CCASSERT(stateData, "stateData cannot be null.");
 
@@ -28,8 +28,13 @@
  *****************************************************************************/
 
 #include "SkeletonCache.h"
+#include "SkeletonCacheMgr.h"
 #include "spine-creator-support/AttachmentVertices.h"
 #include "renderer/gfx/Texture.h"
+#include <float.h>
+
+// Max value of a quantized component of PackedVertex.
+#define PACKED_VERTEX_MAX 65535.0f
 
 USING_NS_CC;
 USING_NS_MW;
@@ -45,13 +50,27 @@ namespace spine {
     }
     
     SkeletonCache::SegmentData::~SegmentData () {
-        CC_SAFE_RELEASE_NULL(_texture);
+        if (_textureRetained) CC_SAFE_RELEASE(_texture);
+        _texture = nullptr;
     }
     
     void SkeletonCache::SegmentData::setTexture (cocos2d::middleware::Texture2D* value) {
         CC_SAFE_RETAIN(value);
-        CC_SAFE_RELEASE(_texture);
+        if (_textureRetained) CC_SAFE_RELEASE(_texture);
+        _texture = value;
+        _textureRetained = true;
+    }
+    
+    void SkeletonCache::SegmentData::setUnretainedTexture (cocos2d::middleware::Texture2D* value) {
+        if (_textureRetained) CC_SAFE_RELEASE(_texture);
         _texture = value;
+        _textureRetained = false;
+    }
+    
+    void SkeletonCache::SegmentData::retainTexture () {
+        if (_textureRetained) return;
+        CC_SAFE_RETAIN(_texture);
+        _textureRetained = true;
     }
     
     cocos2d::middleware::Texture2D* SkeletonCache::SegmentData::getTexture () const {
@@ -121,6 +140,13 @@ namespace spine {
     std::size_t SkeletonCache::FrameData::getSegmentCount () const {
         return _segments.size();
     }
+    
+    std::size_t SkeletonCache::FrameData::getBytes () const {
+        return sizeof(FrameData) + vb.getCapacity() + ib.getCapacity()
+            + _bones.size() * (sizeof(BoneData) + sizeof(BoneData*))
+            + _colors.size() * (sizeof(ColorData) + sizeof(ColorData*))
+            + _segments.size() * (sizeof(SegmentData) + sizeof(SegmentData*));
+    }
 
     SkeletonCache::AnimationData::AnimationData () {
         
@@ -128,6 +154,7 @@ namespace spine {
 
     SkeletonCache::AnimationData::~AnimationData () {
         reset();
+        SkeletonCacheMgr::removeAnimationData(this);
     }
     
     void SkeletonCache::AnimationData::reset () {
@@ -137,6 +164,11 @@ namespace spine {
         _frames.clear();
         _isComplete = false;
         _totalTime = 0.0f;
+        if (_inLRU) SkeletonCacheMgr::subCacheBytes(_bytes);
+        _bytes = 0;
+        _baking = false;
+        _retainedFrameCount = 0;
+        _generation++;
     }
     
     bool SkeletonCache::AnimationData::needUpdate (int toFrameIdx) const {
@@ -177,6 +209,7 @@ namespace spine {
     }
     
     SkeletonCache::AnimationData* SkeletonCache::buildAnimationData (const std::string& animationName) {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
         AnimationData* aniData = nullptr;
         auto it = _animationCaches.find(animationName);
         if (it == _animationCaches.end()) {
@@ -185,7 +218,9 @@ namespace spine {
             
             aniData = new AnimationData();
             aniData->_animationName = animationName;
+            aniData->_cache = this;
             _animationCaches[animationName] = aniData;
+            SkeletonCacheMgr::getInstance()->addAnimationData(aniData);
         } else {
             aniData = it->second;
         }
@@ -193,6 +228,7 @@ namespace spine {
     }
     
     SkeletonCache::AnimationData* SkeletonCache::getAnimationData (const std::string& animationName) {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
         auto it = _animationCaches.find(animationName);
         if (it == _animationCaches.end()) {
             return nullptr;
@@ -210,18 +246,28 @@ namespace spine {
     }
     
     void SkeletonCache::updateToFrame (const std::string& animationName, int toFrameIdx/*= -1*/) {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        bakeFrames(animationName, toFrameIdx, -1);
+    }
+    
+    bool SkeletonCache::bakeNextFrames (const std::string& animationName, int frameCount) {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        return bakeFrames(animationName, -1, frameCount);
+    }
+    
+    bool SkeletonCache::bakeFrames (const std::string& animationName, int toFrameIdx, int maxFrameCount) {
         auto it = _animationCaches.find(animationName);
         if (it == _animationCaches.end()) {
-            return;
+            return false;
         }
         
         AnimationData* animationData = it->second;
-        if (!animationData || !animationData->needUpdate(toFrameIdx)) {
-            return;
+        if (!animationData || animationData->_baking || !animationData->needUpdate(toFrameIdx)) {
+            return false;
         }
         
         if (_curAnimationName != animationName) {
-            updateToFrame(_curAnimationName);
+            bakeFrames(_curAnimationName, -1, -1);
             _curAnimationName = animationName;
         }
         
@@ -234,7 +280,101 @@ namespace spine {
             update(FrameTime);
             renderAnimationFrame(animationData);
             animationData->_totalTime += FrameTime;
-        } while (animationData->needUpdate(toFrameIdx));
+        } while (animationData->needUpdate(toFrameIdx) && --maxFrameCount != 0);
+        
+        return animationData->needUpdate(toFrameIdx);
+    }
+    
+    SkeletonCache* SkeletonCache::createBaker (const std::string& animationName) {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        auto it = _animationCaches.find(animationName);
+        if (!_skeleton || _uuid.empty() || it == _animationCaches.end()) return nullptr;
+        
+        AnimationData* animationData = it->second;
+        if (animationData->_baking || !animationData->needUpdate(-1)) return nullptr;
+        
+        // The baker starts from the current skin and attachments, attachments set by setAttachment are kept.
+        auto baker = new SkeletonCache();
+        baker->_isBaker = true;
+        baker->initWithUUID(_uuid);
+        Skeleton* bakerSkeleton = baker->_skeleton;
+        bakerSkeleton->setSkin(_skeleton->getSkin());
+        auto& slots = _skeleton->getSlots();
+        auto& bakerSlots = bakerSkeleton->getSlots();
+        for (std::size_t i = 0, n = std::min(slots.size(), bakerSlots.size()); i < n; i++) {
+            bakerSlots[i]->setAttachment(slots[i]->getAttachment());
+        }
+        
+        // Frames of the baker are counted when they are taken by this cache.
+        AnimationData* bakerData = baker->buildAnimationData(animationName);
+        SkeletonCacheMgr::removeAnimationData(bakerData);
+        
+        // The animation is drawn from the first frame while the rest are baked.
+        bakeFrames(animationName, 0, -1);
+        if (!animationData->needUpdate(-1)) {
+            baker->release();
+            return nullptr;
+        }
+        
+        animationData->_baking = true;
+        baker->_bakeGeneration = animationData->_generation;
+        return baker;
+    }
+    
+    bool SkeletonCache::takeBakedFrames (SkeletonCache* baker, const std::string& animationName) {
+        // The baker is only used by the baking thread, it needs no lock.
+        auto bakerIt = baker->_animationCaches.find(animationName);
+        if (bakerIt == baker->_animationCaches.end()) return false;
+        AnimationData* bakerData = bakerIt->second;
+        auto& bakerFrames = bakerData->_frames;
+        
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        auto it = _animationCaches.find(animationName);
+        if (it == _animationCaches.end()) return false;
+        AnimationData* animationData = it->second;
+        if (!animationData->_baking || animationData->_generation != baker->_bakeGeneration) return false;
+        
+        // Frames are the same whoever bakes them, so the baker's frames go on after the ones of this cache.
+        auto& frames = animationData->_frames;
+        std::size_t bytes = 0;
+        for (std::size_t i = frames.size(), n = bakerFrames.size(); i < n && bakerFrames[i]; i++) {
+            bytes += bakerFrames[i]->getBytes();
+            frames.push_back(bakerFrames[i]);
+            bakerFrames[i] = nullptr;
+        }
+        animationData->_bytes += bytes;
+        if (animationData->_inLRU) SkeletonCacheMgr::addCacheBytes(bytes);
+        
+        if (!bakerData->needUpdate(-1) && frames.size() == bakerFrames.size()) {
+            animationData->_isComplete = bakerData->_isComplete;
+            animationData->_totalTime = bakerData->_totalTime;
+        }
+        return true;
+    }
+    
+    void SkeletonCache::retainBakedTextures (const std::string& animationName) {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        auto it = _animationCaches.find(animationName);
+        if (it == _animationCaches.end()) return;
+        
+        AnimationData* animationData = it->second;
+        auto& frames = animationData->_frames;
+        for (std::size_t i = animationData->_retainedFrameCount, n = frames.size(); i < n; i++) {
+            for (auto segmentData : frames[i]->_segments) {
+                segmentData->retainTexture();
+            }
+        }
+        animationData->_retainedFrameCount = frames.size();
+    }
+    
+    void SkeletonCache::releaseBaker (SkeletonCache* baker, const std::string& animationName) {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        retainBakedTextures(animationName);
+        auto it = _animationCaches.find(animationName);
+        if (it != _animationCaches.end() && it->second->_generation == baker->_bakeGeneration) {
+            it->second->_baking = false;
+        }
+        baker->release();
     }
     
     void SkeletonCache::renderAnimationFrame (AnimationData* animationData) {
@@ -255,8 +395,10 @@ namespace spine {
         Color4F darkColor;
         
         AttachmentVertices* attachmentVertices = nullptr;
-        middleware::IOBuffer& vb = frameData->vb;
-        middleware::IOBuffer& ib = frameData->ib;
+        middleware::IOBuffer& vb = _bakeVB;
+        middleware::IOBuffer& ib = _bakeIB;
+        vb.reset();
+        ib.reset();
         
         // vertex size int bytes with two color
         int vbs2 = sizeof(V2F_T2F_C4B_C4B);
@@ -288,7 +430,11 @@ namespace spine {
             }
             
             SegmentData* segmentData = frameData->buildSegmentData(materialLen);
-            segmentData->setTexture(texture);
+            if (_isBaker) {
+                segmentData->setUnretainedTexture(texture);
+            } else {
+                segmentData->setTexture(texture);
+            }
             segmentData->blendMode = slot->getData().getBlendMode();
             
             // save new segment count pos field
@@ -536,6 +682,50 @@ namespace spine {
             ColorData* preColorData = frameData->buildColorData(colorCount - 1);
             preColorData->vertexFloatOffset = (int) vb.getCurPos() / sizeof(float);
         }
+        
+        packFrame(frameData);
+        std::size_t bytes = frameData->getBytes();
+        animationData->_bytes += bytes;
+        if (animationData->_inLRU) SkeletonCacheMgr::addCacheBytes(bytes);
+    }
+    
+    void SkeletonCache::packFrame (FrameData* frameData) {
+        std::size_t vertexCount = _bakeVB.length() / sizeof(V2F_T2F_C4B_C4B);
+        const V2F_T2F_C4B_C4B* srcVertices = (const V2F_T2F_C4B_C4B*)_bakeVB.getBuffer();
+        
+        float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+        for (std::size_t i = 0; i < vertexCount; i++) {
+            const auto& pos = srcVertices[i].vertex;
+            minX = std::min(minX, pos.x);
+            minY = std::min(minY, pos.y);
+            maxX = std::max(maxX, pos.x);
+            maxY = std::max(maxY, pos.y);
+        }
+        if (vertexCount == 0) minX = minY = maxX = maxY = 0;
+        frameData->positionMin.set(minX, minY);
+        frameData->positionStep.set((maxX - minX) / PACKED_VERTEX_MAX, (maxY - minY) / PACKED_VERTEX_MAX);
+        
+        const Vec2& step = frameData->positionStep;
+        float scaleX = step.x > 0 ? 1.0f / step.x : 0;
+        float scaleY = step.y > 0 ? 1.0f / step.y : 0;
+        std::size_t vbSize = vertexCount * sizeof(PackedVertex);
+        frameData->vb.resize(vbSize);
+        frameData->vb.reset();
+        PackedVertex* dstVertices = (PackedVertex*)frameData->vb.getBuffer();
+        for (std::size_t i = 0; i < vertexCount; i++) {
+            const auto& src = srcVertices[i];
+            auto& dst = dstVertices[i];
+            dst.x = (uint16_t)((src.vertex.x - minX) * scaleX + 0.5f);
+            dst.y = (uint16_t)((src.vertex.y - minY) * scaleY + 0.5f);
+            dst.u = (uint16_t)(clampf(src.texCoord.u, 0, 1) * PACKED_VERTEX_MAX + 0.5f);
+            dst.v = (uint16_t)(clampf(src.texCoord.v, 0, 1) * PACKED_VERTEX_MAX + 0.5f);
+        }
+        frameData->vb.move((int)vbSize);
+        
+        std::size_t ibSize = _bakeIB.length();
+        frameData->ib.resize(ibSize);
+        frameData->ib.reset();
+        frameData->ib.writeBytes((const char*)_bakeIB.getBuffer(), ibSize);
     }
     
     void SkeletonCache::onAnimationStateEvent (TrackEntry* entry, EventType type, Event* event) {
@@ -553,12 +743,14 @@ namespace spine {
     }
     
     void SkeletonCache::resetAllAnimationData() {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
         for (auto it = _animationCaches.begin(); it != _animationCaches.end(); it++) {
             it->second->reset();
         }
     }
     
     void SkeletonCache::resetAnimationData(const std::string& animationName) {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
         for (auto it = _animationCaches.begin(); it != _animationCaches.end(); it++) {
             if (it->second->_animationName == animationName) {
                 it->second->reset();
@@ -33,6 +33,8 @@
 #include "IOBuffer.h"
 #include "middleware-adapter.h"
 #include <vector>
+#include <list>
+#include <mutex>
 
 namespace spine {
     class SkeletonCache: public SkeletonAnimation {
@@ -43,6 +45,7 @@ namespace spine {
             SegmentData ();
             ~SegmentData ();
             
+            // Retains the texture, only on the main thread.
             void setTexture (cocos2d::middleware::Texture2D* value);
             cocos2d::middleware::Texture2D* getTexture () const;
         public:
@@ -50,19 +53,34 @@ namespace spine {
             int vertexFloatCount = 0;
             int blendMode = 0;
         private:
+            // The baking thread keeps the texture without retaining it, it is retained by the main thread later.
+            void setUnretainedTexture (cocos2d::middleware::Texture2D* value);
+            void retainTexture ();
+            
             cocos2d::middleware::Texture2D* _texture = nullptr;
+            bool _textureRetained = false;
         };
         
         struct BoneData {
             cocos2d::Mat4 globalTransformMatrix;
         };
         
+        // The color is used until vertexFloatOffset, offset is counted in floats of unpacked two color vertices.
         struct ColorData {
             cocos2d::Color4F finalColor;
             cocos2d::Color4F darkColor;
             int vertexFloatOffset = 0;
         };
         
+        // Baked vertex, position is quantized in the bounds of the frame and uv in [0, 1],
+        // color is restored from ColorData.
+        struct PackedVertex {
+            uint16_t x = 0;
+            uint16_t y = 0;
+            uint16_t u = 0;
+            uint16_t v = 0;
+        };
+        
         struct FrameData {
             friend class SkeletonCache;
             
@@ -84,6 +102,17 @@ namespace spine {
                 return _segments;
             }
             std::size_t getSegmentCount () const;
+            
+            // Memory held by the frame in bytes.
+            std::size_t getBytes () const;
+            
+            // Unpacks position of the vertex.
+            inline float getX (const PackedVertex& vertex) const {
+                return positionMin.x + vertex.x * positionStep.x;
+            }
+            inline float getY (const PackedVertex& vertex) const {
+                return positionMin.y + vertex.y * positionStep.y;
+            }
         private:
             // if segment data is empty, it will build new one.
             SegmentData* buildSegmentData (std::size_t index);
@@ -97,11 +126,15 @@ namespace spine {
             std::vector<SegmentData*> _segments;
         public:
             cocos2d::middleware::IOBuffer ib;
+            // Array of PackedVertex.
             cocos2d::middleware::IOBuffer vb;
+            cocos2d::Vec2 positionMin;
+            cocos2d::Vec2 positionStep;
         };
         
         struct AnimationData {
             friend class SkeletonCache;
+            friend class SkeletonCacheMgr;
             
             AnimationData ();
             ~AnimationData ();
@@ -111,6 +144,8 @@ namespace spine {
             std::size_t getFrameCount () const;
             
             bool isComplete () const { return _isComplete; }
+            // The frames are baked by the thread of SkeletonCacheMgr, the cache does not bake them itself then.
+            bool isBaking () const { return _baking; }
             bool needUpdate (int toFrameIdx) const;
         private:
             // if frame is empty, it will build new one.
@@ -120,6 +155,20 @@ namespace spine {
             bool _isComplete = false;
             float _totalTime = 0.0f;
             std::vector<FrameData*> _frames;
+            
+            SkeletonCache* _cache = nullptr;
+            // Bytes of all frames.
+            std::size_t _bytes = 0;
+            // Position in the LRU list of SkeletonCacheMgr and the frame it was used last.
+            std::list<AnimationData*>::iterator _lruIt;
+            bool _inLRU = false;
+            uint32_t _useTick = 0;
+            
+            bool _baking = false;
+            // Frames before it have their textures retained.
+            std::size_t _retainedFrameCount = 0;
+            // Increased by reset, frames baked for an older generation are dropped.
+            uint32_t _generation = 0;
         };
         
         SkeletonCache ();
@@ -132,18 +181,42 @@ namespace spine {
         virtual void onAnimationStateEvent (TrackEntry* entry, EventType type, Event* event) override;
         
         void updateToFrame (const std::string& animationName, int toFrameIdx = -1);
+        // Bakes at most frameCount frames of the animation, returns true if the animation needs more frames.
+        bool bakeNextFrames (const std::string& animationName, int frameCount);
+        // Creates a cache with the skin and attachments of this one, it bakes the animation on the thread of SkeletonCacheMgr
+        // while this one is drawn. The first frame is baked here. Returns nullptr if the animation needs no more frames.
+        SkeletonCache* createBaker (const std::string& animationName);
+        // Moves the frames of the baker which follow the frames of this cache, it only locks this cache while moving them.
+        // Returns false if the animation was reset since the baker was created.
+        bool takeBakedFrames (SkeletonCache* baker, const std::string& animationName);
+        // Retains textures of the frames moved in from the baker, only on the main thread.
+        void retainBakedTextures (const std::string& animationName);
+        // Ends baking on the thread and releases the baker.
+        void releaseBaker (SkeletonCache* baker, const std::string& animationName);
+        // The frames are read on the main thread and moved in by the thread of SkeletonCacheMgr, lock it before touching animation data.
+        std::recursive_mutex& getMutex () { return _mutex; }
         // if animation data is empty, it will build new one.
         AnimationData* buildAnimationData (const std::string& animationName);
         AnimationData* getAnimationData (const std::string& animationName);
         void resetAllAnimationData();
         void resetAnimationData(const std::string& animationName);
     private:
+        bool bakeFrames (const std::string& animationName, int toFrameIdx, int maxFrameCount);
         void renderAnimationFrame (AnimationData* animationData);
+        void packFrame (FrameData* frameData);
     public:
         static float FrameTime;
         static float MaxCacheTime;
     private:
         std::string _curAnimationName = "";
         std::map<std::string, AnimationData*> _animationCaches;
+        std::recursive_mutex _mutex;
+        // The baker runs on the thread of SkeletonCacheMgr, it does not retain the textures of its frames.
+        bool _isBaker = false;
+        // Generation of the animation data the baker was created for.
+        uint32_t _bakeGeneration = 0;
+        // Unpacked vertices and indices of the frame being baked.
+        cocos2d::middleware::IOBuffer _bakeVB;
+        cocos2d::middleware::IOBuffer _bakeIB;
     };
 }
@@ -44,7 +44,9 @@ static const std::string textureKey = "texture";
 
 namespace spine {
     
-    SkeletonCacheAnimation::SkeletonCacheAnimation (const std::string& uuid, bool isShare) {
+    SkeletonCacheAnimation::SkeletonCacheAnimation (const std::string& uuid, bool isShare)
+    : _uuid(uuid)
+    , _isShare(isShare) {
         if (isShare) {
             _skeletonCache = SkeletonCacheMgr::getInstance()->buildSkeletonCache(uuid);
             _skeletonCache->retain();
@@ -74,14 +76,20 @@ namespace spine {
     }
     
     void SkeletonCacheAnimation::update(float dt) {
+        // Paused animations are still drawn, their frames must not be evicted.
+        auto cacheMgr = SkeletonCacheMgr::getInstance();
+        if (_animationData) cacheMgr->touch(_animationData);
         if (_paused) return;
         
+        std::lock_guard<std::recursive_mutex> lock(_skeletonCache->getMutex());
+        
         auto gTimeScale = SkeletonAnimation::GlobalTimeScale;
         dt *= _timeScale * gTimeScale;
         
         if (_isAniComplete) {
             if (_animationQueue.empty() && !_headAnimation) {
-                if (_animationData && !_animationData->isComplete()) {
+                // The rest frames are baked by the background thread if async bake is enabled.
+                if (_animationData && !_animationData->isComplete() && !cacheMgr->isAsyncBakeEnabled()) {
                     _skeletonCache->updateToFrame(_animationName);
                 }
                 return;
@@ -106,6 +114,14 @@ namespace spine {
         
         if (!_animationData) return;
         
+        // The background thread bakes the frames, the animation waits on its last baked frame until they are moved in.
+        int nextFrameIdx = floor((_accTime + dt) / SkeletonCache::FrameTime);
+        if (_animationData->isBaking() && !_animationData->isComplete() && nextFrameIdx >= (int)_animationData->getFrameCount()) {
+            cacheMgr->addMiss();
+            _curFrameIndex = (int)_animationData->getFrameCount() - 1;
+            return;
+        }
+        
         if (_accTime <= 0.00001 && _playCount == 0) {
             if (_startListener) {
                 _startListener(_animationName);
@@ -114,8 +130,11 @@ namespace spine {
         
         _accTime += dt;
         int frameIdx = floor(_accTime / SkeletonCache::FrameTime);
-        if (!_animationData->isComplete()) {
+        if (!_animationData->isComplete() && frameIdx >= (int)_animationData->getFrameCount()) {
+            cacheMgr->addMiss();
             _skeletonCache->updateToFrame(_animationName, frameIdx);
+        } else {
+            cacheMgr->addHit();
         }
         
         int finalFrameIndex = (int)_animationData->getFrameCount() - 1;
@@ -153,6 +172,7 @@ namespace spine {
         assembler->setUseModel(!_batch);
         
         if (!_animationData) return;
+        std::lock_guard<std::recursive_mutex> lock(_skeletonCache->getMutex());
         SkeletonCache::FrameData* frameData = _animationData->getFrameData(_curFrameIndex);
         if (!frameData) return;
         
@@ -194,11 +214,13 @@ namespace spine {
         Color4B darkColor;
         float tempR = 0.0f, tempG = 0.0f, tempB = 0.0f, tempA = 0.0f;
         float multiplier = 1.0f;
-        int srcVertexBytesOffset = 0;
-        int srcVertexBytes = 0;
+        int srcVertexIndex = 0;
+        int srcVertexFloatOffset = 0;
+        int vertexCount = 0;
         int vertexBytes = 0;
-        int vertexFloats = 0;
-        int tintBytes = 0;
+        const SkeletonCache::PackedVertex* srcVertices = (const SkeletonCache::PackedVertex*)srcVB.getBuffer();
+        const float uvStep = 1.0f / 65535.0f;
+        cocos2d::Vec3 point;
         int srcIndexBytesOffset = 0;
         int indexBytes = 0;
         GLuint textureHandle = 0;
@@ -208,18 +230,9 @@ namespace spine {
         float* dstVertexBuffer = nullptr;
         unsigned int* dstColorBuffer = nullptr;
         unsigned short* dstIndexBuffer = nullptr;
-        bool needColor = false;
         BlendFactor curBlendSrc = BlendFactor::ONE;
         BlendFactor curBlendDst = BlendFactor::ZERO;
         
-        if (abs(_nodeColor.r - 1.0f) > 0.0001f ||
-            abs(_nodeColor.g - 1.0f) > 0.0001f ||
-            abs(_nodeColor.b - 1.0f) > 0.0001f ||
-            abs(_nodeColor.a - 1.0f) > 0.0001f ||
-            _premultipliedAlpha) {
-            needColor = true;
-        }
-        
         auto handleColor = [&](SkeletonCache::ColorData* colorData){
             tempA = colorData->finalColor.a * _nodeColor.a;
             multiplier = _premultipliedAlpha ? tempA / 255 : 1;
@@ -242,73 +255,43 @@ namespace spine {
         
         for (std::size_t segIndex = 0, segLen = segments.size(); segIndex < segLen; segIndex++) {
             auto segment = segments[segIndex];
-            srcVertexBytes = segment->vertexFloatCount * sizeof(float);
-            if (!_useTint) {
-                tintBytes = segment->vertexFloatCount / vs2 * sizeof(float);
-                vertexBytes = srcVertexBytes - tintBytes;
-                vertexFloats = vertexBytes / sizeof(float);
-            } else {
-                vertexBytes = srcVertexBytes;
-                vertexFloats = segment->vertexFloatCount;
-            }
+            vertexCount = segment->vertexFloatCount / vs2;
+            vertexBytes = vertexCount * vbs;
 
-            // fill vertex buffer
+            // fill vertex buffer, baked vertices are packed and colors are restored from color data
             vb.checkSpace(vertexBytes, true);
             dstVertexOffset = (int)vb.getCurPos() / vbs;
             dstVertexBuffer = (float*)vb.getCurBuffer();
             dstColorBuffer = (unsigned int*)vb.getCurBuffer();
-            if (!_useTint) {
-                char* srcBuffer = (char*)srcVB.getBuffer() + srcVertexBytesOffset;
-                for (std::size_t srcBufferIdx = 0; srcBufferIdx < srcVertexBytes; srcBufferIdx += vbs2) {
-                    vb.writeBytes(srcBuffer + srcBufferIdx, vbs);
+            for (int vertexIndex = 0; vertexIndex < vertexCount; vertexIndex++, srcVertexFloatOffset += vs2) {
+                const auto& srcVertex = srcVertices[srcVertexIndex + vertexIndex];
+                float* dstVertex = dstVertexBuffer + vertexIndex * vs;
+                point.set(frameData->getX(srcVertex), frameData->getY(srcVertex), 0.0f);
+                // batch handle
+                if (_batch) {
+                    nodeWorldMat.transformPoint(&point);
                 }
-            } else {
-                vb.writeBytes((char*)srcVB.getBuffer() + srcVertexBytesOffset, vertexBytes);
-            }
-            
-            // batch handle
-            if (_batch) {
-                cocos2d::Vec3* point = nullptr;
-                float tempZ = 0.0f;
-                for (auto posIndex = 0; posIndex < vertexFloats; posIndex += vs)
-                {
-                    point = (cocos2d::Vec3*)(dstVertexBuffer + posIndex);
-                    tempZ = point->z;
-                    point->z = 0;
-                    nodeWorldMat.transformPoint(point);
-                    point->z = tempZ;
+                dstVertex[0] = point.x;
+                dstVertex[1] = point.y;
+                dstVertex[2] = srcVertex.u * uvStep;
+                dstVertex[3] = srcVertex.v * uvStep;
+                
+                // handle vertex color
+                if (srcVertexFloatOffset >= maxVFOffset) {
+                    nowColor = colors[colorOffset++];
+                    handleColor(nowColor);
+                    maxVFOffset = nowColor->vertexFloatOffset;
                 }
-            }
-            
-            // handle vertex color
-            if (needColor) {
-                int srcVertexFloatOffset = srcVertexBytesOffset / sizeof(float);
+                unsigned int* dstColor = dstColorBuffer + vertexIndex * vs;
+                memcpy(dstColor + 4, &finalColor, sizeof(finalColor));
                 if (_useTint) {
-                    for (auto colorIndex = 0; colorIndex < vertexFloats; colorIndex += vs, srcVertexFloatOffset += vs2)
-                    {
-                        if (srcVertexFloatOffset >= maxVFOffset) {
-                            nowColor = colors[colorOffset++];
-                            handleColor(nowColor);
-                            maxVFOffset = nowColor->vertexFloatOffset;
-                        }
-                        memcpy(dstColorBuffer + colorIndex + 4, &finalColor, sizeof(finalColor));
-                        memcpy(dstColorBuffer + colorIndex + 5, &darkColor, sizeof(darkColor));
-                    }
-                } else {
-                    for (auto colorIndex = 0; colorIndex < vertexFloats; colorIndex += vs, srcVertexFloatOffset += vs2)
-                    {
-                        if (srcVertexFloatOffset >= maxVFOffset) {
-                            nowColor = colors[colorOffset++];
-                            handleColor(nowColor);
-                            maxVFOffset = nowColor->vertexFloatOffset;
-                        }
-                        memcpy(dstColorBuffer + colorIndex + 4, &finalColor, sizeof(finalColor));
-                    }
+                    memcpy(dstColor + 5, &darkColor, sizeof(darkColor));
                 }
             }
+            vb.move(vertexBytes);
             
-            // move src vertex buffer offset
-            srcVertexBytesOffset += srcVertexBytes;
+            // move src vertex offset
+            srcVertexIndex += vertexCount;
             
             // fill index buffer
             indexBytes = segment->indexCount * sizeof(unsigned short);
@@ -403,13 +386,28 @@ namespace spine {
     }
     
     void SkeletonCacheAnimation::setSkin (const std::string& skinName) {
+        if (_isShare) {
+            // Every skin has its own shared cache, so skins don't reset the frames of each other.
+            auto skeletonCache = SkeletonCacheMgr::getInstance()->buildSkeletonCache(_uuid, skinName);
+            if (skeletonCache == nullptr || skeletonCache == _skeletonCache) return;
+            skeletonCache->retain();
+            _skeletonCache->release();
+            _skeletonCache = skeletonCache;
+            if (_animationData) {
+                std::lock_guard<std::recursive_mutex> lock(_skeletonCache->getMutex());
+                _animationData = _skeletonCache->buildAnimationData(_animationName);
+                SkeletonCacheMgr::getInstance()->requestBake(_skeletonCache, _animationName);
+            }
+            return;
+        }
+        
+        std::lock_guard<std::recursive_mutex> lock(_skeletonCache->getMutex());
         _skeletonCache->setSkin(skinName);
         _skeletonCache->resetAllAnimationData();
     }
 
     void SkeletonCacheAnimation::setSkin (const char* skinName) {
-        _skeletonCache->setSkin(skinName);
-        _skeletonCache->resetAllAnimationData();
+        setSkin(std::string(skinName ? skinName : ""));
     }
     
     Attachment* SkeletonCacheAnimation::getAttachment (const std::string& slotName, const std::string& attachmentName) const {
@@ -417,12 +415,14 @@ namespace spine {
     }
     
     bool SkeletonCacheAnimation::setAttachment (const std::string& slotName, const std::string& attachmentName) {
+        std::lock_guard<std::recursive_mutex> lock(_skeletonCache->getMutex());
         auto ret = _skeletonCache->setAttachment(slotName, attachmentName);
         _skeletonCache->resetAllAnimationData();
         return ret;
     }
     
     bool SkeletonCacheAnimation::setAttachment (const std::string& slotName, const char* attachmentName) {
+        std::lock_guard<std::recursive_mutex> lock(_skeletonCache->getMutex());
         auto ret = _skeletonCache->setAttachment(slotName, attachmentName);
         _skeletonCache->resetAllAnimationData();
         return ret;
@@ -471,6 +471,7 @@ namespace spine {
         _playTimes = loop ? 0 : 1;
         _animationName = name;
         _animationData = _skeletonCache->buildAnimationData(_animationName);
+        SkeletonCacheMgr::getInstance()->requestBake(_skeletonCache, _animationName);
         _isAniComplete = false;
         _accTime = 0.0f;
         _playCount = 0;
@@ -537,18 +538,21 @@ namespace spine {
     
     void SkeletonCacheAnimation::setToSetupPose () {
         if (_skeletonCache) {
+            std::lock_guard<std::recursive_mutex> lock(_skeletonCache->getMutex());
             _skeletonCache->setToSetupPose();
         }
     }
     
     void SkeletonCacheAnimation::setBonesToSetupPose () {
         if (_skeletonCache) {
+            std::lock_guard<std::recursive_mutex> lock(_skeletonCache->getMutex());
             _skeletonCache->setBonesToSetupPose();
         }
     }
     
     void SkeletonCacheAnimation::setSlotsToSetupPose () {
         if (_skeletonCache) {
+            std::lock_guard<std::recursive_mutex> lock(_skeletonCache->getMutex());
             _skeletonCache->setSlotsToSetupPose();
         }
     }
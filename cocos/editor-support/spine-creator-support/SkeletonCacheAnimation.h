@@ -108,6 +108,8 @@ namespace spine {
         CacheFrameEvent _endListener = nullptr;
         CacheFrameEvent _completeListener = nullptr;
         
+        std::string _uuid = "";
+        bool _isShare = false;
         SkeletonCache* _skeletonCache = nullptr;
         SkeletonCache::AnimationData* _animationData = nullptr;
         int _curFrameIndex = -1;
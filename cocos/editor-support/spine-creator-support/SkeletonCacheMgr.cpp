@@ -28,24 +28,162 @@
  *****************************************************************************/
 
 #include "SkeletonCacheMgr.h"
+#include "base/CCThreadPool.h"
+
+// Default budget of baked frames.
+#define SKELETON_CACHE_MAX_BYTES (64 * 1024 * 1024)
+// Frames baked by the background thread before they are moved into the cache.
+#define BAKE_FRAMES_PER_TAKE 4
+
+USING_NS_CC;
 
 namespace spine {
     SkeletonCacheMgr* SkeletonCacheMgr::_instance = nullptr;
-    SkeletonCache* SkeletonCacheMgr::buildSkeletonCache(const std::string& uuid) {
-        SkeletonCache* animation = _caches.at(uuid);
+    
+    SkeletonCacheMgr::SkeletonCacheMgr ()
+    : _maxCacheBytes(SKELETON_CACHE_MAX_BYTES)
+    , _cacheBytes(0) {
+        _threadPool = ThreadPool::newSingleThreadPool();
+        middleware::MiddlewareManager::getInstance()->addTimer(this);
+    }
+    
+    SkeletonCacheMgr::~SkeletonCacheMgr () {
+        // Waits for the pending bake requests.
+        delete _threadPool;
+        _threadPool = nullptr;
+        for (auto& request : _bakedRequests) {
+            request.cache->releaseBaker(request.baker, request.animationName);
+            request.cache->release();
+        }
+        _bakedRequests.clear();
+        _bakingRequests.clear();
+        
+        for (auto animationData : _lruList) {
+            animationData->_inLRU = false;
+        }
+        _lruList.clear();
+        _caches.clear();
+        middleware::MiddlewareManager::getInstance()->removeTimer(this);
+    }
+    
+    SkeletonCache* SkeletonCacheMgr::buildSkeletonCache (const std::string& uuid, const std::string& skinName) {
+        std::string key = skinName.empty() ? uuid : uuid + "|" + skinName;
+        SkeletonCache* animation = _caches.at(key);
         if (!animation) {
             animation = new SkeletonCache();
             animation->initWithUUID(uuid);
-            _caches.insert(uuid, animation);
+            if (!skinName.empty()) {
+                animation->setSkin(skinName);
+            }
+            _caches.insert(key, animation);
             animation->autorelease();
         }
         return animation;
     }
     
     void SkeletonCacheMgr::removeSkeletonCache (const std::string& uuid) {
-        auto it = _caches.find(uuid);
-        if (it != _caches.end()) {
-            _caches.erase(it);
+        std::string prefix = uuid + "|";
+        for (auto it = _caches.begin(); it != _caches.end();) {
+            const std::string& key = it->first;
+            if (key == uuid || key.compare(0, prefix.size(), prefix) == 0) {
+                it = _caches.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+    
+    void SkeletonCacheMgr::requestBake (SkeletonCache* cache, const std::string& animationName) {
+        if (!_asyncBake || !cache) return;
+        
+        SkeletonCache* baker = cache->createBaker(animationName);
+        if (!baker) return;
+        
+        cache->retain();
+        _bakingRequests.push_back({ cache, baker, animationName });
+        _threadPool->pushTask([this, cache, baker, animationName](int /*threadId*/) {
+            // The main thread waits for the lock of the cache only while baked frames are moved in.
+            bool needMore = true;
+            while (needMore) {
+                needMore = baker->bakeNextFrames(animationName, BAKE_FRAMES_PER_TAKE);
+                if (!cache->takeBakedFrames(baker, animationName)) break;
+            }
+            
+            std::lock_guard<std::mutex> lock(_bakedMutex);
+            _bakedRequests.push_back({ cache, baker, animationName });
+        });
+    }
+    
+    void SkeletonCacheMgr::touch (SkeletonCache::AnimationData* animationData) {
+        if (!animationData->_inLRU) return;
+        animationData->_useTick = _tick;
+        if (animationData->_lruIt != _lruList.begin()) {
+            _lruList.splice(_lruList.begin(), _lruList, animationData->_lruIt);
+        }
+    }
+    
+    void SkeletonCacheMgr::addAnimationData (SkeletonCache::AnimationData* animationData) {
+        if (animationData->_inLRU) return;
+        _lruList.push_front(animationData);
+        animationData->_lruIt = _lruList.begin();
+        animationData->_useTick = _tick;
+        animationData->_inLRU = true;
+        _cacheBytes += animationData->_bytes;
+    }
+    
+    void SkeletonCacheMgr::removeAnimationData (SkeletonCache::AnimationData* animationData) {
+        if (!_instance || !animationData->_inLRU) return;
+        _instance->_lruList.erase(animationData->_lruIt);
+        _instance->_cacheBytes -= animationData->_bytes;
+        animationData->_inLRU = false;
+    }
+    
+    void SkeletonCacheMgr::addCacheBytes (std::size_t bytes) {
+        if (_instance) _instance->_cacheBytes += bytes;
+    }
+    
+    void SkeletonCacheMgr::subCacheBytes (std::size_t bytes) {
+        if (_instance) _instance->_cacheBytes -= bytes;
+    }
+    
+    void SkeletonCacheMgr::update (float dt) {
+        _tick++;
+        
+        std::vector<BakeRequest> bakedRequests;
+        {
+            std::lock_guard<std::mutex> lock(_bakedMutex);
+            bakedRequests.swap(_bakedRequests);
+        }
+        for (auto& request : bakedRequests) {
+            for (auto it = _bakingRequests.begin(); it != _bakingRequests.end(); it++) {
+                if (it->baker == request.baker) {
+                    _bakingRequests.erase(it);
+                    break;
+                }
+            }
+            request.cache->releaseBaker(request.baker, request.animationName);
+            request.cache->release();
+        }
+        // Reference counts are not thread safe, the baking thread leaves the textures to the main thread.
+        for (auto& request : _bakingRequests) {
+            request.cache->retainBakedTextures(request.animationName);
+        }
+        
+        trim();
+    }
+    
+    void SkeletonCacheMgr::trim () {
+        if (_maxCacheBytes == 0) return;
+        
+        // Animations used in the last two frames are kept, their frames may be rendered now.
+        for (auto it = _lruList.rbegin(); it != _lruList.rend() && _cacheBytes > _maxCacheBytes; it++) {
+            auto animationData = *it;
+            if (_tick - animationData->_useTick < 2) break;
+            // Frames are still moved in by the background thread.
+            if (animationData->_baking) continue;
+            
+            std::lock_guard<std::recursive_mutex> lock(animationData->_cache->getMutex());
+            if (animationData->_bytes > 0) animationData->reset();
         }
     }
 }
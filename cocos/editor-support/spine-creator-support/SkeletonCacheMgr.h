@@ -30,10 +30,23 @@
 #pragma once
 #include "SkeletonCache.h"
 #include "base/CCMap.h"
+#include "MiddlewareManager.h"
+#include <atomic>
+
+namespace cocos2d {
+    class ThreadPool;
+}
 
 namespace spine {
 
-class SkeletonCacheMgr {
+/**
+ * Store of baked animations shared by all SkeletonCacheAnimation.
+ * Baked frames are keyed by skeleton uuid, skin, animation name and frame index, 
+ * animations are evicted in least recently used order when their bytes exceed the budget.
+ * Animations are baked ahead on a background thread by a private copy of the skeleton, the frames are moved into the shared cache
+ * under a short lock. The main thread does not bake an animation while it is baked on the thread.
+ */
+class SkeletonCacheMgr : public cocos2d::middleware::IMiddleware {
 public:
     static SkeletonCacheMgr* getInstance () {
         if (_instance == nullptr) {
@@ -49,11 +62,73 @@ public:
         }
     }
     
+    SkeletonCacheMgr ();
+    virtual ~SkeletonCacheMgr ();
+    
+    // Removes shared caches of all skins of the skeleton.
     void removeSkeletonCache (const std::string& uuid);
-    SkeletonCache* buildSkeletonCache (const std::string& uuid);
+    SkeletonCache* buildSkeletonCache (const std::string& uuid, const std::string& skinName = "");
+    
+    /**
+     * Sets the budget of baked frames in bytes, 0 means no limit.
+     */
+    void setMaxCacheBytes (std::size_t bytes) { _maxCacheBytes = bytes; }
+    std::size_t getMaxCacheBytes () const { return _maxCacheBytes; }
+    std::size_t getCacheBytes () const { return _cacheBytes; }
+    
+    // Hit means the frame to play is baked, miss means it is baked on demand.
+    uint32_t getHitCount () const { return _hitCount; }
+    uint32_t getMissCount () const { return _missCount; }
+    void resetStats () { _hitCount = 0; _missCount = 0; }
+    void addHit () { _hitCount++; }
+    void addMiss () { _missCount++; }
+    
+    void setAsyncBakeEnabled (bool enabled) { _asyncBake = enabled; }
+    bool isAsyncBakeEnabled () const { return _asyncBake; }
+    /**
+     * Bakes all frames of the animation on the background thread, the first frame is baked now.
+     */
+    void requestBake (SkeletonCache* cache, const std::string& animationName);
+    
+    // Marks the animation as used in this frame.
+    void touch (SkeletonCache::AnimationData* animationData);
+    void addAnimationData (SkeletonCache::AnimationData* animationData);
+    // Static since animation data of unshared caches may outlive the manager, bytes are added on the baking thread.
+    static void removeAnimationData (SkeletonCache::AnimationData* animationData);
+    static void addCacheBytes (std::size_t bytes);
+    static void subCacheBytes (std::size_t bytes);
+    
+    // Retains textures of baked frames, releases finished bake requests and evicts animations over budget, animations being baked are not evicted.
+    virtual void update (float dt) override;
+    virtual void render (float dt) override {}
+    virtual uint32_t getRenderOrder () const override { return 0; }
+private:
+    void trim ();
 private:
     static SkeletonCacheMgr* _instance;
     cocos2d::Map<std::string, SkeletonCache*> _caches;
+    
+    std::size_t _maxCacheBytes = 0;
+    std::atomic<std::size_t> _cacheBytes;
+    uint32_t _hitCount = 0;
+    uint32_t _missCount = 0;
+    
+    // Front is the most recently used.
+    std::list<SkeletonCache::AnimationData*> _lruList;
+    uint32_t _tick = 0;
+    
+    bool _asyncBake = true;
+    cocos2d::ThreadPool* _threadPool = nullptr;
+    struct BakeRequest {
+        SkeletonCache* cache;
+        SkeletonCache* baker;
+        std::string animationName;
+    };
+    // Caches are retained by pending requests, and released with their bakers on the main thread after baked.
+    std::mutex _bakedMutex;
+    std::vector<BakeRequest> _bakedRequests;
+    // Requests being baked, only used by the main thread which retains the textures of the frames moved in.
+    std::vector<BakeRequest> _bakingRequests;
 };
 
 }
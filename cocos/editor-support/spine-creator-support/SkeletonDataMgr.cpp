@@ -57,11 +57,18 @@ public:
             delete attachmentLoader;
             attachmentLoader = nullptr;
         }
+        
+        // Frees all blocks of the data at once.
+        if (arena) {
+            delete arena;
+            arena = nullptr;
+        }
     }
     
     SkeletonData* data = nullptr;
     Atlas* atlas = nullptr;
     AttachmentLoader* attachmentLoader = nullptr;
+    SpineArena* arena = nullptr;
     std::vector<int> texturesIndex;
     std::string _uuid;
 };
@@ -73,7 +80,7 @@ bool SkeletonDataMgr::hasSkeletonData (const std::string& uuid) {
     return it != _dataMap.end();
 }
 
-void SkeletonDataMgr::setSkeletonData (const std::string& uuid, SkeletonData* data, Atlas* atlas, AttachmentLoader* attachmentLoader, const std::vector<int>& texturesIndex) {
+void SkeletonDataMgr::setSkeletonData (const std::string& uuid, SkeletonData* data, Atlas* atlas, AttachmentLoader* attachmentLoader, const std::vector<int>& texturesIndex, SpineArena* arena) {
     auto it = _dataMap.find(uuid);
     if (it != _dataMap.end()) {
         releaseByUUID(uuid);
@@ -82,6 +89,7 @@ void SkeletonDataMgr::setSkeletonData (const std::string& uuid, SkeletonData* da
     info->data = data;
     info->atlas = atlas;
     info->attachmentLoader = attachmentLoader;
+    info->arena = arena;
     info->texturesIndex = texturesIndex;
     _dataMap[uuid] = info;
 }
@@ -34,6 +34,7 @@
 #include "spine/SkeletonData.h"
 #include "base/CCRef.h"
 #include "spine/spine.h"
+#include "SpineAllocator.h"
 #include <vector>
 #include <functional>
 
@@ -61,10 +62,18 @@ public:
     SkeletonDataMgr () {}
     virtual ~SkeletonDataMgr () {}
     bool hasSkeletonData (const std::string& uuid);
-    void setSkeletonData (const std::string& uuid, SkeletonData* data, Atlas* atlas, AttachmentLoader* attachmentLoader, const std::vector<int>& texturesIndex);
+    // If arena is not null, the data, atlas and attachment loader are allocated in it, it is freed after them.
+    void setSkeletonData (const std::string& uuid, SkeletonData* data, Atlas* atlas, AttachmentLoader* attachmentLoader, const std::vector<int>& texturesIndex, SpineArena* arena = nullptr);
     SkeletonData* retainByUUID (const std::string& uuid);
     void releaseByUUID (const std::string& uuid);
     
+    // Statistics of SpineAllocator, which allocates all spine objects.
+    uint32_t getAllocCount () const { return SpineAllocator::getAllocCount(); }
+    uint32_t getFreeCount () const { return SpineAllocator::getFreeCount(); }
+    std::size_t getAllocBytes () const { return SpineAllocator::getBytes(); }
+    std::size_t getPeakAllocBytes () const { return SpineAllocator::getPeakBytes(); }
+    void resetPeakAllocBytes () { SpineAllocator::resetPeakBytes(); }
+    
     typedef std::function<void(int)> destroyCallback;
     void setDestroyCallback(destroyCallback callback)
     {
@@ -37,6 +37,7 @@
 #include "renderer/renderer/Technique.h"
 #include "renderer/scene/assembler/CustomAssembler.hpp"
 #include "SkeletonDataMgr.h"
+#include "MappedFile.h"
 #include "renderer/gfx/Texture.h"
 #include "spine-creator-support/AttachUtil.h"
 
@@ -229,7 +230,11 @@ void SkeletonRenderer::initWithBinaryFile (const std::string& skeletonDataFile,
     
     SkeletonBinary binary(_attachmentLoader);
     binary.setScale(scale);
-    SkeletonData* skeletonData = binary.readSkeletonDataFile(skeletonDataFile.c_str());
+    MappedFile file;
+    SkeletonData* skeletonData = nullptr;
+    if (file.open(skeletonDataFile)) {
+        skeletonData = binary.readSkeletonData(file.getBytes(), (int)file.getSize());
+    }
     CCASSERT(skeletonData, !binary.getError().isEmpty() ? binary.getError().buffer() : "Error reading skeleton data.");
     
     _ownsSkeleton = true;
@@ -246,7 +251,11 @@ void SkeletonRenderer::initWithBinaryFile (const std::string& skeletonDataFile,
     
     SkeletonBinary binary(_attachmentLoader);
     binary.setScale(scale);
-    SkeletonData* skeletonData = binary.readSkeletonDataFile(skeletonDataFile.c_str());
+    MappedFile file;
+    SkeletonData* skeletonData = nullptr;
+    if (file.open(skeletonDataFile)) {
+        skeletonData = binary.readSkeletonData(file.getBytes(), (int)file.getSize());
+    }
     CCASSERT(skeletonData, !binary.getError().isEmpty() ? binary.getError().buffer() : "Error reading skeleton data.");
     
     _ownsSkeleton = true;
@@ -274,11 +283,77 @@ void SkeletonRenderer::render (float deltaTime) {
     auto mgr = MiddlewareManager::getInstance();
     if (!mgr->isRendering) return;
     
+    middleware::MeshBuffer* mb = mgr->getMeshBuffer(_useTint ? VF_XYUVCC : VF_XYUVC);
+    if (!fillVertices(mb, mb->getVB(), mb->getIB())) return;
+    commitMaterials(0, nullptr, nullptr);
+    
+    // Synchronize attach node transform
+    if (_attachUtil)
+    {
+        _attachUtil->syncAttachedNode(_nodeProxy, _skeleton);
+    }
+}
+
+bool SkeletonRenderer::isParallelSupported () const {
+    // Vertex effect may be shared, and debug buffer is a script object.
+    return !_effectDelegate && !_debugSlots && !_debugBones && !_debugMesh;
+}
+
+void SkeletonRenderer::prepareRender (float deltaTime, middleware::RenderSegment& segment) {
+    _prepared = false;
+    if (!_nodeProxy || !_effect || !_skeleton || !_nodeProxy->getAssembler()) {
+        return;
+    }
+    
+    auto vertexFormat = _useTint ? VF_XYUVCC : VF_XYUVC;
+    _segmentVB = &segment.getVB(vertexFormat);
+    _segmentIB = &segment.getIB(vertexFormat);
+    _segmentVBStart = _segmentVB->getCurPos();
+    _segmentIBStart = _segmentIB->getCurPos();
+    _prepared = fillVertices(nullptr, *_segmentVB, *_segmentIB);
+    _segmentVBEnd = _segmentVB->getCurPos();
+    _segmentIBEnd = _segmentIB->getCurPos();
+}
+
+void SkeletonRenderer::commitRender (float deltaTime) {
+    if (!_nodeProxy || !_effect) {
+        return;
+    }
+    
+    CustomAssembler* assembler = (CustomAssembler*)_nodeProxy->getAssembler();
+    if (assembler == nullptr) {
+        return;
+    }
+    assembler->reset();
+    assembler->setUseModel(!_batch);
+    
+    if (!_prepared) return;
+    _prepared = false;
+    
+    auto mgr = MiddlewareManager::getInstance();
+    middleware::MeshBuffer* mb = mgr->getMeshBuffer(_useTint ? VF_XYUVCC : VF_XYUVC);
+    int indexOffset = 0;
+    if (!mb->appendSegment(*_segmentVB, _segmentVBStart, _segmentVBEnd, *_segmentIB, _segmentIBStart, _segmentIBEnd, indexOffset)) {
+        // Too many vertices for one buffer, fill again and let the buffer split them.
+        render(deltaTime);
+        return;
+    }
+    commitMaterials(indexOffset, mb->getGLVB(), mb->getGLIB());
+    
+    // Synchronize attach node transform
+    if (_attachUtil)
+    {
+        _attachUtil->syncAttachedNode(_nodeProxy, _skeleton);
+    }
+}
+
+bool SkeletonRenderer::fillVertices (middleware::MeshBuffer* mb, middleware::IOBuffer& vb, middleware::IOBuffer& ib) {
+    _materials.clear();
     _nodeColor.a = _nodeProxy->getRealOpacity() / (float)255;
     
 	// If opacity is 0,then return.
     if (_skeleton->getColor().a == 0) {
-        return;
+        return false;
     }
 	
 	// color range is [0.0, 1.0]
@@ -286,10 +361,6 @@ void SkeletonRenderer::render (float deltaTime) {
     Color4F darkColor;
     AttachmentVertices* attachmentVertices = nullptr;
     bool inRange = _startSlotIndex != -1 || _endSlotIndex != -1 ? false : true;
-    auto vertexFormat = _useTint? VF_XYUVCC : VF_XYUVC;
-	middleware::MeshBuffer* mb = mgr->getMeshBuffer(vertexFormat);
-    middleware::IOBuffer& vb = mb->getVB();
-    middleware::IOBuffer& ib = mb->getIB();
     
     // vertex size int bytes with one color
     int vbs1 = sizeof(V2F_T2F_C4B);
@@ -304,9 +375,6 @@ void SkeletonRenderer::render (float deltaTime) {
 	int vbSize = 0;
     int ibSize = 0;
 
-    BlendFactor curBlendSrc = BlendFactor::ONE;
-    BlendFactor curBlendDst = BlendFactor::ZERO;
-    int curBlendMode = -1;
     int preBlendMode = -1;
     GLuint preTextureIndex = -1;
     GLuint curTextureIndex = -1;
@@ -314,7 +382,6 @@ void SkeletonRenderer::render (float deltaTime) {
 	int preISegWritePos = -1;
     int curISegLen = 0;
     
-    int materialLen = 0;
     Slot* slot = nullptr;
     int isFull = 0;
     
@@ -331,68 +398,28 @@ void SkeletonRenderer::render (float deltaTime) {
     auto flush = [&]() {
         // fill pre segment count field
         if (preISegWritePos != -1) {
-            assembler->updateIARange(materialLen - 1, preISegWritePos, curISegLen);
-        }
-
-        // prepare to fill new segment field
-        curBlendMode = slot->getData().getBlendMode();
-        switch (curBlendMode) {
-            case BlendMode_Additive:
-                curBlendSrc = _premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA;
-                curBlendDst = BlendFactor::ONE;
-                break;
-            case BlendMode_Multiply:
-                curBlendSrc = BlendFactor::DST_COLOR;
-                curBlendDst = BlendFactor::ONE_MINUS_SRC_ALPHA;
-                break;
-            case BlendMode_Screen:
-                curBlendSrc = BlendFactor::ONE;
-                curBlendDst = BlendFactor::ONE_MINUS_SRC_COLOR;
-                break;
-            default:
-                curBlendSrc = _premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA;
-                curBlendDst = BlendFactor::ONE_MINUS_SRC_ALPHA;
-        }
-        
-        double curHash = curTextureIndex + (curBlendMode << 16) + ((int)_useTint << 24) + ((int)_batch << 25) + ((int)_effect->getHash() << 26);
-        EffectVariant* renderEffect = assembler->getEffect(materialLen);
-        bool needUpdate = false;
-        if (renderEffect) {
-            double renderHash = renderEffect->getHash();
-            if (abs(renderHash - curHash) >= 0.01) {
-                needUpdate = true;
-            }
-        }
-        else {
-            auto effect = new cocos2d::renderer::EffectVariant();
-            effect->autorelease();
-            effect->copy(_effect);
-
-            assembler->updateEffect(materialLen, effect);
-            renderEffect = effect;
-            needUpdate = true;
+            _materials.back().indexCount = curISegLen;
         }
         
-        if (needUpdate) {
-            renderEffect->setProperty(textureKey, texture->getNativeTexture());
-            renderEffect->setBlend(true, BlendOp::ADD, curBlendSrc, curBlendDst,
-                           BlendOp::ADD, curBlendSrc, curBlendDst);
-        }
-
-        renderEffect->updateHash(curHash);
-		
+        MaterialRecord material;
+        material.texture = texture;
+        material.textureIndex = curTextureIndex;
+        material.blendMode = slot->getData().getBlendMode();
         // save new segment count pos field
         preISegWritePos = (int)ib.getCurPos() / sizeof(unsigned short);
-        // save new segment vb and ib
-        assembler->updateIABuffer(materialLen, mb->getGLVB(), mb->getGLIB());
+        material.indexStart = preISegWritePos;
+        // save new segment vb and ib, a render segment gets them when it is merged
+        if (mb) {
+            material.glVB = mb->getGLVB();
+            material.glIB = mb->getGLIB();
+        }
+        _materials.push_back(material);
         // reset pre blend mode to current
-        preBlendMode = (int)slot->getData().getBlendMode();
+        preBlendMode = material.blendMode;
         // reset pre texture index to current
         preTextureIndex = curTextureIndex;
         // reset index segmentation count
         curISegLen = 0;
-        // material length increased
-        materialLen++;
     };
     
     VertexEffect* effect = nullptr;
@@ -846,8 +873,8 @@ void SkeletonRenderer::render (float deltaTime) {
     
     if (effect) effect->end();
     
-	if (preISegWritePos != -1) {
-		assembler->updateIARange(materialLen - 1, preISegWritePos, curISegLen);
+    if (preISegWritePos != -1) {
+        _materials.back().indexCount = curISegLen;
     }
 
     if (_debugBones) {
@@ -876,10 +903,64 @@ void SkeletonRenderer::render (float deltaTime) {
         _debugBuffer->writeFloat32(DebugType::None);
     }
     
-    // Synchronize attach node transform
-    if (_attachUtil)
-    {
-        _attachUtil->syncAttachedNode(_nodeProxy, _skeleton);
+    return true;
+}
+
+void SkeletonRenderer::commitMaterials (int indexOffset, cocos2d::renderer::VertexBuffer* glVB, cocos2d::renderer::IndexBuffer* glIB) {
+    CustomAssembler* assembler = (CustomAssembler*)_nodeProxy->getAssembler();
+    BlendFactor curBlendSrc = BlendFactor::ONE;
+    BlendFactor curBlendDst = BlendFactor::ZERO;
+    
+    for (int materialIndex = 0, n = (int)_materials.size(); materialIndex < n; materialIndex++) {
+        auto& material = _materials[materialIndex];
+        int curBlendMode = material.blendMode;
+        switch (curBlendMode) {
+            case BlendMode_Additive:
+                curBlendSrc = _premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA;
+                curBlendDst = BlendFactor::ONE;
+                break;
+            case BlendMode_Multiply:
+                curBlendSrc = BlendFactor::DST_COLOR;
+                curBlendDst = BlendFactor::ONE_MINUS_SRC_ALPHA;
+                break;
+            case BlendMode_Screen:
+                curBlendSrc = BlendFactor::ONE;
+                curBlendDst = BlendFactor::ONE_MINUS_SRC_COLOR;
+                break;
+            default:
+                curBlendSrc = _premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA;
+                curBlendDst = BlendFactor::ONE_MINUS_SRC_ALPHA;
+        }
+        
+        double curHash = material.textureIndex + (curBlendMode << 16) + ((int)_useTint << 24) + ((int)_batch << 25) + ((int)_effect->getHash() << 26);
+        EffectVariant* renderEffect = assembler->getEffect(materialIndex);
+        bool needUpdate = false;
+        if (renderEffect) {
+            double renderHash = renderEffect->getHash();
+            if (abs(renderHash - curHash) >= 0.01) {
+                needUpdate = true;
+            }
+        }
+        else {
+            auto effect = new cocos2d::renderer::EffectVariant();
+            effect->autorelease();
+            effect->copy(_effect);
+
+            assembler->updateEffect(materialIndex, effect);
+            renderEffect = effect;
+            needUpdate = true;
+        }
+        
+        if (needUpdate) {
+            renderEffect->setProperty(textureKey, material.texture->getNativeTexture());
+            renderEffect->setBlend(true, BlendOp::ADD, curBlendSrc, curBlendDst,
+                           BlendOp::ADD, curBlendSrc, curBlendDst);
+        }
+
+        renderEffect->updateHash(curHash);
+        
+        assembler->updateIABuffer(materialIndex, glVB ? glVB : material.glVB, glIB ? glIB : material.glIB);
+        assembler->updateIARange(materialIndex, material.indexStart + indexOffset, material.indexCount);
     }
 }
 
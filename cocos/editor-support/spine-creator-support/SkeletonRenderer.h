@@ -62,6 +62,9 @@ namespace spine {
         virtual void render (float deltaTime) override;
         virtual cocos2d::Rect getBoundingBox () const;
         virtual uint32_t getRenderOrder() const override;
+        virtual bool isParallelSupported() const override;
+        virtual void prepareRender (float deltaTime, cocos2d::middleware::RenderSegment& segment) override;
+        virtual void commitRender (float deltaTime) override;
         
         Skeleton* getSkeleton() const;
 
@@ -145,6 +148,37 @@ namespace spine {
         virtual void initialize ();
     protected:
         void setSkeletonData (SkeletonData* skeletonData, bool ownsSkeletonData);
+        /**
+         * Fills vertices and indices into the buffers and records the materials, mb is null if they are a render segment.
+         * Returns false if there is nothing to render.
+         */
+        bool fillVertices (cocos2d::middleware::MeshBuffer* mb, cocos2d::middleware::IOBuffer& vb, cocos2d::middleware::IOBuffer& ib);
+        /**
+         * Updates effects and input assemblers by the recorded materials, glVB and glIB override the recorded buffers if not null.
+         */
+        void commitMaterials (int indexOffset, cocos2d::renderer::VertexBuffer* glVB, cocos2d::renderer::IndexBuffer* glIB);
+        
+        // Render state of one material, recorded while filling vertices.
+        struct MaterialRecord
+        {
+            cocos2d::middleware::Texture2D* texture = nullptr;
+            uint32_t textureIndex = 0;
+            int blendMode = 0;
+            int indexStart = 0;
+            int indexCount = 0;
+            cocos2d::renderer::VertexBuffer* glVB = nullptr;
+            cocos2d::renderer::IndexBuffer* glIB = nullptr;
+        };
+        std::vector<MaterialRecord> _materials;
+        
+        // Range of vertices and indices prepared in a render segment.
+        bool                _prepared = false;
+        cocos2d::middleware::IOBuffer* _segmentVB = nullptr;
+        cocos2d::middleware::IOBuffer* _segmentIB = nullptr;
+        std::size_t         _segmentVBStart = 0;
+        std::size_t         _segmentVBEnd = 0;
+        std::size_t         _segmentIBStart = 0;
+        std::size_t         _segmentIBEnd = 0;
         
         bool                _ownsSkeletonData = false;
         bool                _ownsSkeleton = false;
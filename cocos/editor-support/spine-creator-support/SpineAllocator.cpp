@@ -0,0 +1,242 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "SpineAllocator.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Size of the header before every block, it keeps blocks aligned as malloc does.
+#define BLOCK_HEADER_SIZE 16
+// Pooled blocks are multiples of the granularity, up to the max size.
+#define POOL_GRANULARITY 16
+#define POOL_MAX_BLOCK_SIZE 256
+#define POOL_COUNT (POOL_MAX_BLOCK_SIZE / POOL_GRANULARITY)
+#define POOL_PAGE_SIZE (64 * 1024)
+#define ARENA_CHUNK_SIZE (64 * 1024)
+
+namespace spine {
+    
+    enum BlockKind : uint16_t {
+        BLOCK_HEAP = 0x5EA0,
+        BLOCK_POOL,
+        BLOCK_ARENA
+    };
+    
+    struct BlockHeader {
+        uint32_t size;
+        uint16_t kind;
+        uint16_t poolIndex;
+        uint32_t reserved[2];
+    };
+    static_assert(sizeof(BlockHeader) == BLOCK_HEADER_SIZE, "Block header must keep blocks aligned.");
+    
+    static inline BlockHeader* getHeader (void* ptr) {
+        return (BlockHeader*)((char*)ptr - BLOCK_HEADER_SIZE);
+    }
+    
+    // Fixed size blocks of one size, freed blocks are linked through their first bytes.
+    struct BlockPool {
+        std::mutex mutex;
+        void* freeList = nullptr;
+        char* cur = nullptr;
+        size_t remain = 0;
+        
+        void* alloc (size_t blockSize) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (freeList) {
+                void* block = freeList;
+                freeList = *(void**)block;
+                return block;
+            }
+            if (remain < blockSize) {
+                // Pages are kept for the whole run, they are reused by later skeletons.
+                cur = (char*)::malloc(POOL_PAGE_SIZE);
+                if (!cur) return nullptr;
+                remain = POOL_PAGE_SIZE;
+            }
+            void* block = cur;
+            cur += blockSize;
+            remain -= blockSize;
+            return block;
+        }
+        
+        void free (void* block) {
+            std::lock_guard<std::mutex> lock(mutex);
+            *(void**)block = freeList;
+            freeList = block;
+        }
+    };
+    
+    static BlockPool _pools[POOL_COUNT];
+    static thread_local SpineArena* _currentArena = nullptr;
+    
+    std::atomic<uint32_t> SpineAllocator::_allocCount(0);
+    std::atomic<uint32_t> SpineAllocator::_freeCount(0);
+    std::atomic<size_t> SpineAllocator::_bytes(0);
+    std::atomic<size_t> SpineAllocator::_peakBytes(0);
+    
+    SpineArena::SpineArena (size_t chunkSize)
+    : _chunkSize(chunkSize > 0 ? chunkSize : ARENA_CHUNK_SIZE) {
+    }
+    
+    SpineArena::~SpineArena () {
+        for (auto chunk : _chunks) {
+            ::free(chunk);
+        }
+        _chunks.clear();
+    }
+    
+    void* SpineArena::alloc (size_t size) {
+        size = (size + BLOCK_HEADER_SIZE - 1) & ~(size_t)(BLOCK_HEADER_SIZE - 1);
+        if (size > _remain) {
+            // Large blocks get a chunk of their own, so the current chunk is not wasted.
+            bool large = size > _chunkSize / 4;
+            size_t chunkSize = large ? size : _chunkSize;
+            char* chunk = (char*)::malloc(chunkSize);
+            if (!chunk) return nullptr;
+            _chunks.push_back(chunk);
+            _bytes += chunkSize;
+            if (large) {
+                _usedBytes += size;
+                return chunk;
+            }
+            _cur = chunk;
+            _remain = chunkSize;
+        }
+        void* block = _cur;
+        _cur += size;
+        _remain -= size;
+        _usedBytes += size;
+        return block;
+    }
+    
+    SpineAllocator::ArenaScope::ArenaScope (SpineArena* arena) {
+        _prevArena = _currentArena;
+        _currentArena = arena;
+    }
+    
+    SpineAllocator::ArenaScope::~ArenaScope () {
+        _currentArena = _prevArena;
+    }
+    
+    void SpineAllocator::addBytes (size_t size) {
+        size_t bytes = _bytes += size;
+        size_t peak = _peakBytes;
+        while (bytes > peak && !_peakBytes.compare_exchange_weak(peak, bytes)) {}
+    }
+    
+    void* SpineAllocator::allocBlock (size_t size, bool zero) {
+        if (size == 0) return nullptr;
+        
+        size_t totalSize = size + BLOCK_HEADER_SIZE;
+        BlockHeader* header = nullptr;
+        uint16_t kind = BLOCK_HEAP;
+        uint16_t poolIndex = 0;
+        if (_currentArena) {
+            header = (BlockHeader*)_currentArena->alloc(totalSize);
+            kind = BLOCK_ARENA;
+        } else if (size <= POOL_MAX_BLOCK_SIZE) {
+            poolIndex = (uint16_t)((size - 1) / POOL_GRANULARITY);
+            header = (BlockHeader*)_pools[poolIndex].alloc((poolIndex + 1) * POOL_GRANULARITY + BLOCK_HEADER_SIZE);
+            kind = BLOCK_POOL;
+        } else {
+            header = (BlockHeader*)::malloc(totalSize);
+        }
+        if (!header) return nullptr;
+        
+        header->size = (uint32_t)size;
+        header->kind = kind;
+        header->poolIndex = poolIndex;
+        void* ptr = (char*)header + BLOCK_HEADER_SIZE;
+        if (zero) memset(ptr, 0, size);
+        
+        _allocCount++;
+        addBytes(size);
+        return ptr;
+    }
+    
+    void* SpineAllocator::alloc (size_t size) {
+        return allocBlock(size, false);
+    }
+    
+    void* SpineAllocator::calloc (size_t size) {
+        return allocBlock(size, true);
+    }
+    
+    void* SpineAllocator::realloc (void* ptr, size_t size) {
+        if (!ptr) return allocBlock(size, false);
+        if (size == 0) {
+            free(ptr);
+            return nullptr;
+        }
+        
+        BlockHeader* header = getHeader(ptr);
+        size_t oldSize = header->size;
+        // Pooled blocks grow in place while they fit in the block.
+        if (header->kind == BLOCK_POOL && !_currentArena && size <= (size_t)(header->poolIndex + 1) * POOL_GRANULARITY) {
+            if (size > oldSize) addBytes(size - oldSize);
+            else _bytes -= oldSize - size;
+            header->size = (uint32_t)size;
+            return ptr;
+        }
+        if (header->kind == BLOCK_HEAP && !_currentArena && size > POOL_MAX_BLOCK_SIZE) {
+            header = (BlockHeader*)::realloc(header, size + BLOCK_HEADER_SIZE);
+            if (!header) return nullptr;
+            if (size > oldSize) addBytes(size - oldSize);
+            else _bytes -= oldSize - size;
+            header->size = (uint32_t)size;
+            return (char*)header + BLOCK_HEADER_SIZE;
+        }
+        
+        void* newPtr = allocBlock(size, false);
+        if (!newPtr) return nullptr;
+        memcpy(newPtr, ptr, oldSize < size ? oldSize : size);
+        free(ptr);
+        return newPtr;
+    }
+    
+    void SpineAllocator::free (void* ptr) {
+        if (!ptr) return;
+        
+        BlockHeader* header = getHeader(ptr);
+        _freeCount++;
+        _bytes -= header->size;
+        switch (header->kind) {
+            case BLOCK_POOL:
+                _pools[header->poolIndex].free(header);
+                break;
+            case BLOCK_HEAP:
+                ::free(header);
+                break;
+            default:
+                // Arena blocks are freed with the arena.
+                break;
+        }
+    }
+}
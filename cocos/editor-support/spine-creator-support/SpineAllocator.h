@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+namespace spine {
+
+/**
+ * Bump allocator owning the memory of one skeleton data.
+ * Blocks are never freed one by one, all chunks are freed in one operation when the arena is destroyed,
+ * so the arena must outlive every object allocated in it. Freed blocks stay in the arena until then, they are mostly
+ * the buffers left by vectors grown while the loader reads, e.g. the timeline list of every animation, and every block
+ * keeps its 16 byte header. The 150 bone skeleton of spine_load_benchmark in tests uses 17.7MB of blocks for 16.9MB
+ * of skeleton data, 0.23MB of them are freed blocks, the rest are headers and alignment.
+ */
+class SpineArena {
+public:
+    SpineArena (size_t chunkSize = 0);
+    ~SpineArena ();
+    
+    void* alloc (size_t size);
+    // Bytes of all chunks.
+    size_t getBytes () const { return _bytes; }
+    // Bytes of the blocks given out, with their headers and the freed blocks which are not given back.
+    size_t getUsedBytes () const { return _usedBytes; }
+private:
+    SpineArena (const SpineArena&) = delete;
+    SpineArena& operator= (const SpineArena&) = delete;
+private:
+    size_t _chunkSize = 0;
+    std::vector<char*> _chunks;
+    char* _cur = nullptr;
+    size_t _remain = 0;
+    size_t _bytes = 0;
+    size_t _usedBytes = 0;
+};
+
+/**
+ * Allocator of spine objects, used by Cocos2dExtension.
+ * Allocations made in an ArenaScope go to its arena, other small allocations, e.g. bones, slots and
+ * timeline entries of skeleton and animation state instances, come from pools of fixed size blocks,
+ * and large ones from the heap. It may be used by several threads at the same time.
+ */
+class SpineAllocator {
+public:
+    /**
+     * Allocations of the current thread are made in the arena until the scope ends, nullptr suspends the arena.
+     */
+    class ArenaScope {
+    public:
+        ArenaScope (SpineArena* arena);
+        ~ArenaScope ();
+    private:
+        SpineArena* _prevArena = nullptr;
+    };
+    
+    static void* alloc (size_t size);
+    static void* calloc (size_t size);
+    static void* realloc (void* ptr, size_t size);
+    static void free (void* ptr);
+    
+    // Count of allocations and frees since start.
+    static uint32_t getAllocCount () { return _allocCount; }
+    static uint32_t getFreeCount () { return _freeCount; }
+    // Bytes requested by live allocations, and the peak of it.
+    static size_t getBytes () { return _bytes; }
+    static size_t getPeakBytes () { return _peakBytes; }
+    static void resetPeakBytes () { _peakBytes = _bytes.load(); }
+private:
+    static void* allocBlock (size_t size, bool zero);
+    static void addBytes (size_t size);
+private:
+    static std::atomic<uint32_t> _allocCount;
+    static std::atomic<uint32_t> _freeCount;
+    static std::atomic<size_t> _bytes;
+    static std::atomic<size_t> _peakBytes;
+};
+
+}
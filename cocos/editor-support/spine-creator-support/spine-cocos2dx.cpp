@@ -146,26 +146,66 @@ void Cocos2dTextureLoader::unload(void* texture) {
     }
 }
 
+namespace {
+    // Buffer of FileUtils::getContents allocated by SpineAllocator.
+    class SpineFileBuffer : public ResizableBuffer {
+    public:
+        ~SpineFileBuffer() {
+            SpineAllocator::free(data);
+        }
+        virtual void resize(size_t newSize) override {
+            // One more byte terminates json text.
+            data = (char*)SpineAllocator::realloc(data, newSize + 1);
+            size = data ? newSize : 0;
+            if (data) data[newSize] = '\0';
+        }
+        virtual void* buffer() const override {
+            return data;
+        }
+        char* take() {
+            char* ret = data;
+            data = nullptr;
+            size = 0;
+            return ret;
+        }
+        char* data = nullptr;
+        size_t size = 0;
+    };
+}
+
 Cocos2dExtension::Cocos2dExtension() : DefaultSpineExtension() { }
     
 Cocos2dExtension::~Cocos2dExtension() { }
 
 char *Cocos2dExtension::_readFile(const spine::String &path, int *length) {
     *length = 0;
-    Data data = FileUtils::getInstance()->getDataFromFile(FileUtils::getInstance()->fullPathForFilename(path.buffer()));
-    if (data.isNull()) return 0;
+    // The file is read into a block of the extension directly, so it can be freed by the extension without copy.
+    SpineFileBuffer buffer;
+    auto fileUtils = FileUtils::getInstance();
+    if (fileUtils->getContents(fileUtils->fullPathForFilename(path.buffer()), &buffer) != FileUtils::Status::OK) return 0;
 
-    char *ret = (char*)malloc(sizeof(unsigned char) * data.getSize());
-    memcpy(ret, (char*)data.getBytes(), data.getSize());
-    *length = (int)data.getSize();
-    return ret;
+    *length = (int)buffer.size;
+    return buffer.take();
 }
 
 SpineExtension *spine::getDefaultExtension () {
     return new Cocos2dExtension();
 }
 
+void *Cocos2dExtension::_alloc(size_t size, const char *file, int line) {
+    return SpineAllocator::alloc(size);
+}
+
+void *Cocos2dExtension::_calloc(size_t size, const char *file, int line) {
+    return SpineAllocator::calloc(size);
+}
+
+void *Cocos2dExtension::_realloc(void *ptr, size_t size, const char *file, int line) {
+    return SpineAllocator::realloc(ptr, size);
+}
+
 void Cocos2dExtension::_free(void *mem, const char *file, int line) {
+    if (!mem) return;
     _spineObjectDisposeCallback(mem);
-    DefaultSpineExtension::_free(mem, file, line);
+    SpineAllocator::free(mem);
 }
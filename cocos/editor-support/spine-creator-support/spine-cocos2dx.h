@@ -36,6 +36,7 @@
 #include "spine-creator-support/SkeletonCacheMgr.h"
 #include "spine-creator-support/SkeletonCacheAnimation.h"
 #include "spine-creator-support/AttachUtil.h"
+#include "spine-creator-support/SpineAllocator.h"
 #include "middleware-adapter.h"
 
 namespace spine {
@@ -69,6 +70,10 @@ namespace spine {
         
         virtual void _free(void *mem, const char *file, int line);
     protected:
+        // Memory comes from SpineAllocator.
+        virtual void *_alloc(size_t size, const char *file, int line);
+        virtual void *_calloc(size_t size, const char *file, int line);
+        virtual void *_realloc(void *ptr, size_t size, const char *file, int line);
         virtual char *_readFile(const String &path, int *length);
     };
     
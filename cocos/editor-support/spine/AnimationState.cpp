@@ -629,6 +629,9 @@ void AnimationState::disableQueue() {
 void AnimationState::enableQueue() {
 	_queue->_drainDisabled = false;
 }
+void AnimationState::drainQueue() {
+	_queue->drain();
+}
 
 Animation *AnimationState::getEmptyAnimation() {
 	static Vector<Timeline *> timelines;
@@ -150,6 +150,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	}
 
 	int numStrings = readVarint(input, true);
+	skeletonData->_strings.ensureCapacity(numStrings);
 	for (int i = 0; i < numStrings; i++)
 		skeletonData->_strings.add(readString(input));
 
@@ -29,6 +29,7 @@ THE SOFTWARE.
 /// @cond DO_NOT_SHOW
 
 #include "platform/CCPlatformConfig.h"
+#include "base/ccConfig.h"
 
 #ifndef GL_TEXTURE_MIN_LOD
 #define GL_TEXTURE_MIN_LOD 0x813A
@@ -113,6 +114,10 @@ THE SOFTWARE.
 #include "platform/linux/CCGL-linux.h"
 #endif
 
+#if CC_USE_GFX_NULL
+#include "renderer/gfx/GFXNull.h"
+#endif
+
 /// @endcond
 #endif /* __PLATFORM_CCPLATFORMDEFINE_H__*/
 
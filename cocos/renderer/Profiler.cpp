@@ -0,0 +1,179 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "Profiler.h"
+
+#if CC_ENABLE_PROFILERS
+
+#include "platform/CCFileUtils.h"
+#include <chrono>
+#include <stdio.h>
+
+RENDERER_BEGIN
+
+Profiler* Profiler::_instance = nullptr;
+
+Profiler::Profiler()
+: _enabled(false)
+, _ringCount(0)
+{
+    for (int i = 0; i < (int)ProfileStage::COUNT; i++)
+    {
+        _stageTimes[i] = 0;
+    }
+}
+
+uint64_t Profiler::now()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* Profiler::getStageName(ProfileStage stage)
+{
+    switch (stage)
+    {
+        case ProfileStage::FRAME: return "Frame";
+        case ProfileStage::LOCAL_MATRIX: return "LocalMatrix";
+        case ProfileStage::WORLD_MATRIX: return "WorldMatrix";
+        case ProfileStage::MIDDLEWARE_UPDATE: return "MiddlewareUpdate";
+        case ProfileStage::MIDDLEWARE_RENDER: return "MiddlewareRender";
+        case ProfileStage::TRAVERSAL: return "Traversal";
+        case ProfileStage::BATCH_FLUSH: return "BatchFlush";
+        case ProfileStage::BUFFER_UPLOAD: return "BufferUpload";
+        case ProfileStage::SORT: return "Sort";
+        case ProfileStage::DRAW: return "Draw";
+        case ProfileStage::GL_COMMIT: return "GLCommit";
+        default: return "Unknown";
+    }
+}
+
+Profiler::ThreadRing* Profiler::getThreadRing()
+{
+    auto tid = std::this_thread::get_id();
+    int count = _ringCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; i++)
+    {
+        if (_rings[i]->threadID == tid) return _rings[i];
+    }
+
+    // Only the calling thread adds its own ring, so it can not be added by others meanwhile.
+    std::lock_guard<std::mutex> lock(_ringsMutex);
+    count = _ringCount.load(std::memory_order_relaxed);
+    if (count >= PROFILER_MAX_THREAD_COUNT) return nullptr;
+
+    ThreadRing* ring = new ThreadRing();
+    ring->threadID = tid;
+    ring->head.store(0, std::memory_order_relaxed);
+    for (int i = 0; i < (int)ProfileStage::COUNT; i++)
+    {
+        ring->totals[i].store(0, std::memory_order_relaxed);
+    }
+    _rings[count] = ring;
+    _ringCount.store(count + 1, std::memory_order_release);
+    return ring;
+}
+
+void Profiler::record(ProfileStage stage, uint64_t begin, uint64_t end)
+{
+    ThreadRing* ring = getThreadRing();
+    if (ring == nullptr) return;
+
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    Sample& sample = ring->samples[head % PROFILER_RING_SIZE];
+    sample.begin = begin;
+    sample.end = end;
+    sample.stage = stage;
+    ring->head.store(head + 1, std::memory_order_release);
+
+    // Single writer, no read-modify-write is needed.
+    auto& total = ring->totals[(int)stage];
+    total.store(total.load(std::memory_order_relaxed) + (end - begin), std::memory_order_relaxed);
+}
+
+void Profiler::endFrame()
+{
+    uint64_t totals[(int)ProfileStage::COUNT] = {0};
+    int count = _ringCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; i++)
+    {
+        for (int j = 0; j < (int)ProfileStage::COUNT; j++)
+        {
+            totals[j] += _rings[i]->totals[j].exchange(0, std::memory_order_relaxed);
+        }
+    }
+
+    for (int j = 0; j < (int)ProfileStage::COUNT; j++)
+    {
+        _stageTimes[j] = totals[j] / 1000000.0f;
+    }
+}
+
+float Profiler::getStageTime(ProfileStage stage) const
+{
+    if (stage >= ProfileStage::COUNT) return 0;
+    return _stageTimes[(int)stage];
+}
+
+std::string Profiler::getChromeTrace() const
+{
+    std::string trace = "{\"traceEvents\":[";
+    char event[192];
+    bool first = true;
+    int count = _ringCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; i++)
+    {
+        const ThreadRing* ring = _rings[i];
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t start = head > PROFILER_RING_SIZE ? head - PROFILER_RING_SIZE : 0;
+        for (uint64_t j = start; j < head; j++)
+        {
+            const Sample& sample = ring->samples[j % PROFILER_RING_SIZE];
+            // Complete events, timestamps are in microseconds.
+            snprintf(event, sizeof(event), "%s{\"name\":\"%s\",\"cat\":\"renderer\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                     first ? "" : ",", getStageName(sample.stage), i, sample.begin / 1000.0, (sample.end - sample.begin) / 1000.0);
+            trace += event;
+            first = false;
+        }
+    }
+    trace += "]}";
+    return trace;
+}
+
+bool Profiler::dumpChromeTrace(const std::string& path) const
+{
+    return cocos2d::FileUtils::getInstance()->writeStringToFile(getChromeTrace(), path);
+}
+
+void Profiler::clear()
+{
+    int count = _ringCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; i++)
+    {
+        _rings[i]->head.store(0, std::memory_order_release);
+    }
+}
+
+RENDERER_END
+
+#endif // CC_ENABLE_PROFILERS
@@ -0,0 +1,195 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "Macro.h"
+#include "base/ccConfig.h"
+#include <stdint.h>
+#include <string>
+
+#if CC_ENABLE_PROFILERS
+#include <thread>
+#include <atomic>
+#include <mutex>
+
+// Samples kept by every thread, older samples are overwritten.
+#define PROFILER_RING_SIZE 4096
+// Upper bound of threads which may record samples, samples of the threads beyond it are dropped.
+#define PROFILER_MAX_THREAD_COUNT 32
+#endif
+
+RENDERER_BEGIN
+
+/**
+ *  @brief Stages of a native render flow frame, the time of a stage includes the stages nested in it.
+ */
+enum class ProfileStage : uint8_t
+{
+    FRAME = 0,
+    LOCAL_MATRIX,
+    WORLD_MATRIX,
+    MIDDLEWARE_UPDATE,
+    MIDDLEWARE_RENDER,
+    TRAVERSAL,
+    BATCH_FLUSH,
+    BUFFER_UPLOAD,
+    SORT,
+    DRAW,
+    GL_COMMIT,
+    COUNT
+};
+
+#if CC_ENABLE_PROFILERS
+
+/**
+ *  @brief Collects timed samples of the render flow stages.\n
+ *  Every thread records into its own ring buffer without lock, the rings are only read between frames.
+ *  Samples are recorded by RENDERER_PROFILE_SCOPE. The profiler only exists if CC_ENABLE_PROFILERS is 1, otherwise nothing is compiled.
+ */
+class Profiler
+{
+public:
+    static Profiler* getInstance()
+    {
+        // Never destroyed, worker threads may still hold their rings at exit.
+        if (_instance == nullptr)
+        {
+            _instance = new Profiler();
+        }
+        return _instance;
+    }
+
+    /**
+     *  @brief Enables or disables recording, it is disabled by default.
+     */
+    void setEnabled(bool enabled) { _enabled = enabled; }
+    /**
+     *  @brief Is recording enabled.
+     */
+    static bool isEnabled() { return _instance != nullptr && _instance->_enabled; }
+    /**
+     *  @brief Gets a monotonic timestamp in nanoseconds.
+     */
+    static uint64_t now();
+    /**
+     *  @brief Gets the name of a stage, it is used as the event name in the trace.
+     */
+    static const char* getStageName(ProfileStage stage);
+
+    /**
+     *  @brief Records a sample to the ring of the calling thread.
+     */
+    void record(ProfileStage stage, uint64_t begin, uint64_t end);
+    /**
+     *  @brief Finishes the frame recorded since the last call, the stage times of it can be got by getStageTime.
+     *  It must not run while other threads are recording.
+     */
+    void endFrame();
+    /**
+     *  @brief Gets the time in milliseconds spent in a stage by all threads in the last finished frame.
+     */
+    float getStageTime(ProfileStage stage) const;
+    /**
+     *  @brief Serializes the samples kept in the rings in the Chrome trace event format, it can be loaded by chrome://tracing.
+     *  It must not run while other threads are recording.
+     */
+    std::string getChromeTrace() const;
+    /**
+     *  @brief Writes the Chrome trace to a file.
+     *  @param[in] path Full path of the file.
+     */
+    bool dumpChromeTrace(const std::string& path) const;
+    /**
+     *  @brief Drops all samples in the rings.
+     */
+    void clear();
+private:
+    struct Sample
+    {
+        uint64_t begin;
+        uint64_t end;
+        ProfileStage stage;
+    };
+
+    struct ThreadRing
+    {
+        std::thread::id threadID;
+        // Only written by the owner thread.
+        std::atomic<uint64_t> head;
+        std::atomic<uint64_t> totals[(int)ProfileStage::COUNT];
+        Sample samples[PROFILER_RING_SIZE];
+    };
+
+    Profiler();
+    ThreadRing* getThreadRing();
+private:
+    static Profiler* _instance;
+
+    std::atomic<bool> _enabled;
+    // Rings are appended under the mutex and read without it, so published rings never move.
+    std::mutex _ringsMutex;
+    ThreadRing* _rings[PROFILER_MAX_THREAD_COUNT];
+    std::atomic<int> _ringCount;
+
+    float _stageTimes[(int)ProfileStage::COUNT];
+};
+
+/**
+ *  @brief Records the lifetime of itself as a sample of the stage if the profiler is enabled.
+ */
+class ProfileScope
+{
+public:
+    ProfileScope(ProfileStage stage)
+    : _stage(stage)
+    , _recording(Profiler::isEnabled())
+    , _begin(_recording ? Profiler::now() : 0)
+    {
+    }
+
+    ~ProfileScope()
+    {
+        if (_recording)
+        {
+            Profiler::getInstance()->record(_stage, _begin, Profiler::now());
+        }
+    }
+private:
+    ProfileStage _stage;
+    bool _recording;
+    uint64_t _begin;
+};
+
+#endif // CC_ENABLE_PROFILERS
+
+RENDERER_END
+
+#if CC_ENABLE_PROFILERS
+#define RENDERER_PROFILE_CONCAT_IMPL(a, b) a##b
+#define RENDERER_PROFILE_CONCAT(a, b) RENDERER_PROFILE_CONCAT_IMPL(a, b)
+#define RENDERER_PROFILE_SCOPE(stage) cocos2d::renderer::ProfileScope RENDERER_PROFILE_CONCAT(__profileScope, __LINE__)(cocos2d::renderer::ProfileStage::stage)
+#else
+#define RENDERER_PROFILE_SCOPE(stage)
+#endif
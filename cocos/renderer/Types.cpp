@@ -44,6 +44,11 @@ const char* ATTRIB_NAME_UV4 = "a_uv4";
 const char* ATTRIB_NAME_UV5 = "a_uv5";
 const char* ATTRIB_NAME_UV6 = "a_uv6";
 const char* ATTRIB_NAME_UV7 = "a_uv7";
+const char* ATTRIB_NAME_MAT_WORLD0 = "a_matWorld0";
+const char* ATTRIB_NAME_MAT_WORLD1 = "a_matWorld1";
+const char* ATTRIB_NAME_MAT_WORLD2 = "a_matWorld2";
+const char* ATTRIB_NAME_MAT_WORLD3 = "a_matWorld3";
+const char* ATTRIB_NAME_INSTANCE_COLOR = "a_instanceColor";
 
 const size_t ATTRIB_NAME_POSITION_HASH = std::hash<std::string>{}(ATTRIB_NAME_POSITION);
 const size_t ATTRIB_NAME_NORMAL_HASH = std::hash<std::string>{}(ATTRIB_NAME_NORMAL);
@@ -63,6 +68,11 @@ const size_t ATTRIB_NAME_UV4_HASH = std::hash<std::string>{}(ATTRIB_NAME_UV4);
 const size_t ATTRIB_NAME_UV5_HASH = std::hash<std::string>{}(ATTRIB_NAME_UV5);
 const size_t ATTRIB_NAME_UV6_HASH = std::hash<std::string>{}(ATTRIB_NAME_UV6);
 const size_t ATTRIB_NAME_UV7_HASH = std::hash<std::string>{}(ATTRIB_NAME_UV7);
+const size_t ATTRIB_NAME_MAT_WORLD0_HASH = std::hash<std::string>{}(ATTRIB_NAME_MAT_WORLD0);
+const size_t ATTRIB_NAME_MAT_WORLD1_HASH = std::hash<std::string>{}(ATTRIB_NAME_MAT_WORLD1);
+const size_t ATTRIB_NAME_MAT_WORLD2_HASH = std::hash<std::string>{}(ATTRIB_NAME_MAT_WORLD2);
+const size_t ATTRIB_NAME_MAT_WORLD3_HASH = std::hash<std::string>{}(ATTRIB_NAME_MAT_WORLD3);
+const size_t ATTRIB_NAME_INSTANCE_COLOR_HASH = std::hash<std::string>{}(ATTRIB_NAME_INSTANCE_COLOR);
 
 Rect Rect::ZERO;
 
@@ -152,6 +152,11 @@ extern const char* ATTRIB_NAME_UV4;
 extern const char* ATTRIB_NAME_UV5;
 extern const char* ATTRIB_NAME_UV6;
 extern const char* ATTRIB_NAME_UV7;
+extern const char* ATTRIB_NAME_MAT_WORLD0;
+extern const char* ATTRIB_NAME_MAT_WORLD1;
+extern const char* ATTRIB_NAME_MAT_WORLD2;
+extern const char* ATTRIB_NAME_MAT_WORLD3;
+extern const char* ATTRIB_NAME_INSTANCE_COLOR;
 
 extern const size_t ATTRIB_NAME_POSITION_HASH;
 extern const size_t ATTRIB_NAME_NORMAL_HASH;
@@ -171,6 +176,11 @@ extern const size_t ATTRIB_NAME_UV4_HASH;
 extern const size_t ATTRIB_NAME_UV5_HASH;
 extern const size_t ATTRIB_NAME_UV6_HASH;
 extern const size_t ATTRIB_NAME_UV7_HASH;
+extern const size_t ATTRIB_NAME_MAT_WORLD0_HASH;
+extern const size_t ATTRIB_NAME_MAT_WORLD1_HASH;
+extern const size_t ATTRIB_NAME_MAT_WORLD2_HASH;
+extern const size_t ATTRIB_NAME_MAT_WORLD3_HASH;
+extern const size_t ATTRIB_NAME_INSTANCE_COLOR_HASH;
 
 // vertex attribute type
 enum class AttribType : uint16_t
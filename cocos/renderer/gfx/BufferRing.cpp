@@ -0,0 +1,116 @@
+/****************************************************************************
+ Copyright (c) 2018 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "BufferRing.h"
+#include "VertexFormat.h"
+#include "base/CCGLUtils.h"
+
+RENDERER_BEGIN
+
+BufferRing::BufferRing(DeviceGraphics* device, VertexFormat* format)
+: _device(device)
+, _format(format)
+{
+    CC_SAFE_RETAIN(_format);
+    addSlot();
+}
+
+BufferRing::~BufferRing()
+{
+    while (!_slots.empty())
+    {
+        removeSlot();
+    }
+    CC_SAFE_RELEASE(_format);
+}
+
+void BufferRing::addSlot()
+{
+    _slots.emplace_back();
+    Slot& slot = _slots.back();
+    slot.vbs.pushBack(VertexBuffer::create(_device, _format, Usage::DYNAMIC, nullptr, 0, 0));
+    slot.ib = IndexBuffer::create(_device, IndexFormat::UINT16, Usage::DYNAMIC, nullptr, 0, 0);
+    slot.ib->retain();
+}
+
+void BufferRing::removeSlot()
+{
+    Slot& slot = _slots.back();
+    for (std::size_t i = 0, n = slot.vbs.size(); i < n; i++)
+    {
+        slot.vbs.at(i)->destroy();
+    }
+    slot.ib->destroy();
+    slot.ib->release();
+    ccDeleteSync(slot.fence);
+    _slots.pop_back();
+}
+
+void BufferRing::advance(std::size_t size)
+{
+    if (size < 1) size = 1;
+    
+    // The draw calls of the current slot are issued, the fence is signaled when they are finished.
+    bool fenced = size >= UNSYNCHRONIZED_SIZE && ccIsFenceSyncSupported();
+    Slot& current = _slots[_index];
+    ccDeleteSync(current.fence);
+    current.fence = fenced ? ccFenceSync() : nullptr;
+    current.unfenced = current.fence == nullptr;
+    
+    while (_slots.size() > size)
+    {
+        removeSlot();
+    }
+    _index = (_index + 1) % size;
+    while (_slots.size() <= _index)
+    {
+        addSlot();
+    }
+    _vbPos = 0;
+    
+    // A new slot has never been drawn, a fenced one is safe once its fence is signaled.
+    Slot& next = _slots[_index];
+    bool finished = !next.unfenced;
+    if (next.fence)
+    {
+        finished = ccClientWaitSync(next.fence, FENCE_TIMEOUT);
+        ccDeleteSync(next.fence);
+        next.fence = nullptr;
+    }
+    next.unfenced = false;
+    _unsynchronized = fenced && finished;
+}
+
+VertexBuffer* BufferRing::nextVertexBuffer()
+{
+    _vbPos++;
+    auto& vbs = _slots[_index].vbs;
+    if ((ssize_t)_vbPos >= vbs.size())
+    {
+        vbs.pushBack(VertexBuffer::create(_device, _format, Usage::DYNAMIC, nullptr, 0, 0));
+    }
+    return vbs.at(_vbPos);
+}
+
+RENDERER_END
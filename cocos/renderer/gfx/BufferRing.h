@@ -0,0 +1,133 @@
+/****************************************************************************
+ Copyright (c) 2018 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include "../Macro.h"
+#include "base/CCVector.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+
+RENDERER_BEGIN
+
+/**
+ * @addtogroup gfx
+ * @{
+ */
+
+class DeviceGraphics;
+class VertexFormat;
+
+/**
+ * BufferRing keeps the dynamic vertex and index buffers of a batch, one slot of buffers for every frame in flight.
+ * A frame only writes the buffers of its own slot, so uploads don't overwrite buffers still read by the draw calls of the previous frames.
+ * If fence syncs are supported and the ring is large enough, a slot is fenced when the ring leaves it and the fence is waited before the slot is written again,
+ * only then the buffers of the slot may be mapped without synchronization.
+ */
+class BufferRing final
+{
+public:
+    /**
+     * The ring size from which slots are fenced, a fence is then waited about size - 1 frames after it is inserted and rarely blocks.
+     */
+    static const std::size_t UNSYNCHRONIZED_SIZE = 3;
+    /**
+     * Waits on a fence time out after it, then the slot is written with synchronization.
+     */
+    static const uint64_t FENCE_TIMEOUT = 100000000;
+    
+    /**
+     * Creates the ring with one slot, the other slots are created when the ring advances.
+     * @param[in] device DeviceGraphics pointer.
+     * @param[in] format The vertex format of the vertex buffers.
+     */
+    BufferRing(DeviceGraphics* device, VertexFormat* format);
+    ~BufferRing();
+    
+    /**
+     * Moves to the next slot, it should be called after the draw calls of the current slot are issued.
+     * @param[in] size The ring size, slots are created or destroyed to match it, at least 1.
+     */
+    void advance(std::size_t size);
+    /**
+     * Moves to the next vertex buffer of the current slot, it is created if the slot hasn't got enough buffers yet.
+     * Used when the vertex data of a frame exceeds the size of one buffer, the buffers are reused in the following frames.
+     */
+    VertexBuffer* nextVertexBuffer();
+    
+    /**
+     * Gets the vertex buffer in use.
+     */
+    VertexBuffer* getVertexBuffer() const { return _slots[_index].vbs.at(_vbPos); }
+    /**
+     * Gets the position of the vertex buffer in use within the current slot.
+     */
+    std::size_t getVertexBufferPos() const { return _vbPos; }
+    /**
+     * Gets the index buffer of the current slot.
+     */
+    IndexBuffer* getIndexBuffer() const { return _slots[_index].ib; }
+    /**
+     * Gets the count of slots.
+     */
+    std::size_t getSize() const { return _slots.size(); }
+    /**
+     * Gets the index of the current slot.
+     */
+    std::size_t getIndex() const { return _index; }
+    /**
+     * Gets the count of vertex buffers in a slot.
+     */
+    std::size_t getVertexBufferCount(std::size_t slot) const { return _slots[slot].vbs.size(); }
+    /**
+     * Whether the buffers of the current slot can be written without synchronization, the GPU is known to have finished reading them.
+     */
+    bool isUnsynchronized() const { return _unsynchronized; }
+private:
+    struct Slot
+    {
+        cocos2d::Vector<VertexBuffer*> vbs;
+        IndexBuffer* ib = nullptr;
+        // Signaled when the draw calls of the slot are finished.
+        void* fence = nullptr;
+        // The slot was left without a fence, the draw calls reading it may be in flight.
+        bool unfenced = false;
+    };
+    
+    void addSlot();
+    void removeSlot();
+    
+    DeviceGraphics* _device = nullptr;
+    VertexFormat* _format = nullptr;
+    std::vector<Slot> _slots;
+    std::size_t _index = 0;
+    std::size_t _vbPos = 0;
+    bool _unsynchronized = false;
+};
+
+// end of gfx group
+/// @}
+
+RENDERER_END
@@ -31,6 +31,7 @@
 #include "RenderTarget.h"
 #include "Program.h"
 #include "GFXUtils.h"
+#include "../Profiler.h"
 
 #include "platform/CCPlatformConfig.h"
 #include "base/CCGLUtils.h"
@@ -40,6 +41,9 @@ RENDERER_BEGIN
 static_assert(sizeof(int) == sizeof(GLint), "ERROR: GLint isn't equal to int!");
 static_assert(sizeof(float) == sizeof(GLfloat), "ERROR: GLfloat isn't equal to float!");
 
+// Issues a GL call which changes the pipeline states and counts it.
+#define STATE_GL_CHECK(_call) do { ++_stateCalls; GL_CHECK(_call); } while (false)
+
 namespace
 {
     void attach(GLenum location, const RenderTarget* target)
@@ -147,6 +151,20 @@ void DeviceGraphics::setScissor(int x, int y, int w, int h)
     }
 }
 
+void DeviceGraphics::enableScissorTest()
+{
+    if (_scissorTest) return;
+    _scissorTest = true;
+    GL_CHECK(glEnable(GL_SCISSOR_TEST));
+}
+
+void DeviceGraphics::disableScissorTest()
+{
+    if (!_scissorTest) return;
+    _scissorTest = false;
+    GL_CHECK(glDisable(GL_SCISSOR_TEST));
+}
+
 void DeviceGraphics::clear(uint8_t flags, Color4F *color, double depth, int32_t stencil)
 {
     GLbitfield mask = 0;
@@ -324,6 +342,12 @@ void DeviceGraphics::setVertexBuffer(int stream, VertexBuffer* buffer, int start
     }
 }
 
+void DeviceGraphics::setInstanceBuffer(int stream, VertexBuffer* buffer, int start /*= 0*/)
+{
+    setVertexBuffer(stream, buffer, start);
+    _nextState->setVertexBufferDivisor(stream, 1);
+}
+
 void DeviceGraphics::setIndexBuffer(IndexBuffer *buffer)
 {
     _nextState->setIndexBuffer(buffer);
@@ -372,10 +396,42 @@ void DeviceGraphics::setPrimitiveType(PrimitiveType type)
 
 void DeviceGraphics::draw(size_t base, GLsizei count)
 {
-    commitBlendStates();
-    commitDepthStates();
-    commitStencilStates();
-    commitCullMode();
+    commitDraw(base, count, 0);
+}
+
+void DeviceGraphics::drawInstanced(size_t base, GLsizei count, GLsizei instanceCount)
+{
+    if (!_caps.instancing)
+    {
+        RENDERER_LOGW("Instanced drawing is not supported.");
+        _nextState->reset();
+        return;
+    }
+    commitDraw(base, count, instanceCount);
+}
+
+bool DeviceGraphics::setPipelineState(uint32_t id)
+{
+    _nextState->pipelineID = id;
+    return id != 0 && id == _currentState->pipelineID;
+}
+
+void DeviceGraphics::commitDraw(size_t base, GLsizei count, GLsizei instanceCount)
+{
+    RENDERER_PROFILE_SCOPE(GL_COMMIT);
+    if (_nextState->pipelineID != 0 && _nextState->pipelineID == _currentState->pipelineID)
+    {
+        // Same pipeline states as the last draw, the caller did not set them again.
+        _nextState->copyPipelineStates(*_currentState);
+        _skippedStateCommits++;
+    }
+    else
+    {
+        commitBlendStates();
+        commitDepthStates();
+        commitStencilStates();
+        commitCullMode();
+    }
     commitVertexBuffer();
     
     auto nextIndexBuffer = _nextState->getIndexBuffer();
@@ -401,23 +457,59 @@ void DeviceGraphics::draw(size_t base, GLsizei count)
     commitTextures();
     
     //commit uniforms
-    const auto& uniformsInfo = _nextState->getProgram()->getUniforms();
-    for (const auto& uniformInfo : uniformsInfo)
+    Program* program = _nextState->getProgram();
+    const auto& uniformsInfo = program->getUniforms();
+    auto& slots = program->_uniformSlots;
+    if (program->_uniformSlotsCount != _uniforms.size())
     {
-        auto iter = _uniforms.find(uniformInfo.hashName);
-        if (_uniforms.end() == iter)
+        slots.resize(uniformsInfo.size());
+        for (std::size_t i = 0, n = uniformsInfo.size(); i < n; ++i)
+        {
+            auto iter = _uniformSlots.find(uniformsInfo[i].hashName);
+            slots[i] = _uniformSlots.end() == iter ? -1 : iter->second;
+        }
+        program->_uniformSlotsCount = _uniforms.size();
+    }
+    
+    for (std::size_t i = 0, n = uniformsInfo.size(); i < n; ++i)
+    {
+        int slot = slots[i];
+        if (slot < 0)
             continue;
         
-        auto& uniform = iter->second;
+        auto& uniform = _uniforms[slot];
         if (!programDirty && !uniform.dirty)
             continue;
         
         uniform.dirty = false;
-        uniformInfo.setUniform(uniform.value, uniform.elementType, uniform.count);
+        uniformsInfo[i].setUniform(uniform.value, uniform.elementType, uniform.count);
     }
     
     // draw primitives
-    if (nextIndexBuffer)
+    if (instanceCount > 0)
+    {
+        if (nextIndexBuffer)
+        {
+            GL_CHECK(ccDrawElementsInstanced(ENUM_CLASS_TO_GLENUM(_nextState->primitiveType),
+                                             count,
+                                             ENUM_CLASS_TO_GLENUM(nextIndexBuffer->getFormat()),
+                                             (GLvoid *)(base * nextIndexBuffer->getBytesPerIndex()),
+                                             instanceCount));
+        }
+        else
+        {
+            GL_CHECK(ccDrawArraysInstanced(ENUM_CLASS_TO_GLENUM(_nextState->primitiveType), (GLint)base, count, instanceCount));
+        }
+
+        // Restore divisors at once, other GL users do not know about them.
+        for (auto location : _instancedAttributes)
+        {
+            GL_CHECK(ccVertexAttribDivisor(location, 0));
+        }
+        _instancedAttributes.clear();
+        _attributesDirty = true;
+    }
+    else if (nextIndexBuffer)
     {
         GL_CHECK(glDrawElements(ENUM_CLASS_TO_GLENUM(_nextState->primitiveType),
                        count,
@@ -440,14 +532,15 @@ void DeviceGraphics::draw(size_t base, GLsizei count)
 
 void DeviceGraphics::setUniform(size_t hashName, const void* v, size_t bytes, UniformElementType elementType, size_t uniformCount)
 {
-    auto iter = _uniforms.find(hashName);
-    if (iter == _uniforms.end())
+    auto iter = _uniformSlots.find(hashName);
+    if (iter == _uniformSlots.end())
     {
-        _uniforms[hashName] = Uniform(v, bytes, elementType, uniformCount);
+        _uniformSlots[hashName] = (int)_uniforms.size();
+        _uniforms.push_back(Uniform(v, bytes, elementType, uniformCount));
     }
     else
     {
-        auto& uniform = iter->second;
+        auto& uniform = _uniforms[iter->second];
         uniform.dirty = true;
         uniform.setValue(v, bytes, uniformCount);
     }
@@ -612,8 +705,10 @@ void DeviceGraphics::initCaps()
     GL_CHECK(glGetIntegerv(GL_MAX_DRAW_BUFFERS, &_caps.maxDrawBuffers));
 #endif
 
-    RENDERER_LOGD("Device caps: maxVextexTextures: %d, maxFragUniforms: %d, maxTextureUints: %d, maxVertexAttributes: %d, maxDrawBuffers: %d, maxColorAttatchments: %d",
-             _caps.maxVextexTextures, _caps.maxFragUniforms, _caps.maxTextureUnits, _caps.maxVertexAttributes, _caps.maxDrawBuffers, _caps.maxColorAttatchments);
+    _caps.instancing = ccIsInstancingSupported();
+
+    RENDERER_LOGD("Device caps: maxVextexTextures: %d, maxFragUniforms: %d, maxTextureUints: %d, maxVertexAttributes: %d, maxDrawBuffers: %d, maxColorAttatchments: %d, instancing: %d",
+             _caps.maxVextexTextures, _caps.maxFragUniforms, _caps.maxTextureUnits, _caps.maxVertexAttributes, _caps.maxDrawBuffers, _caps.maxColorAttatchments, _caps.instancing);
 }
 
 void DeviceGraphics::initStates()
@@ -646,6 +741,11 @@ void DeviceGraphics::initStates()
     GL_CHECK(glDisable(GL_SCISSOR_TEST));
 }
 
+void DeviceGraphics::restoreFrameBuffer()
+{
+    GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, _frameBuffer ? _frameBuffer->getHandle() : _defaultFbo));
+}
+
 void DeviceGraphics::restoreTexture(uint32_t index)
 {
     auto texture = _currentState->getTexture(index);
@@ -671,18 +771,18 @@ void DeviceGraphics::commitBlendStates()
     {
         if (!_nextState->blend)
         {
-            glDisable(GL_BLEND);
+            STATE_GL_CHECK(glDisable(GL_BLEND));
             return;
         }
 
-        glEnable(GL_BLEND);
+        STATE_GL_CHECK(glEnable(GL_BLEND));
         
         if (_nextState->blendSrc == BlendFactor::CONSTANT_COLOR ||
             _nextState->blendSrc == BlendFactor::ONE_MINUS_CONSTANT_COLOR ||
             _nextState->blendDst == BlendFactor::CONSTANT_COLOR ||
             _nextState->blendDst == BlendFactor::ONE_MINUS_CONSTANT_COLOR)
         {
-            GL_CHECK(glBlendColor((_nextState->blendColor >> 24) / 255.f,
+            STATE_GL_CHECK(glBlendColor((_nextState->blendColor >> 24) / 255.f,
                          (_nextState->blendColor >> 16 & 0xff) / 255.f,
                          (_nextState->blendColor >> 8 & 0xff) / 255.f,
                          (_nextState->blendColor & 0xff) / 255.f));
@@ -691,18 +791,18 @@ void DeviceGraphics::commitBlendStates()
         
         if (_nextState->blendSeparation)
         {
-            GL_CHECK(glBlendFuncSeparate(ENUM_CLASS_TO_GLENUM(_nextState->blendSrc),
+            STATE_GL_CHECK(glBlendFuncSeparate(ENUM_CLASS_TO_GLENUM(_nextState->blendSrc),
                                 ENUM_CLASS_TO_GLENUM(_nextState->blendDst),
                                 ENUM_CLASS_TO_GLENUM(_nextState->blendSrcAlpha),
                                 ENUM_CLASS_TO_GLENUM(_nextState->blendDstAlpha)));
-            GL_CHECK(glBlendEquationSeparate(ENUM_CLASS_TO_GLENUM(_nextState->blendEq),
+            STATE_GL_CHECK(glBlendEquationSeparate(ENUM_CLASS_TO_GLENUM(_nextState->blendEq),
                                     ENUM_CLASS_TO_GLENUM(_nextState->blendAlphaEq)));
         }
         else
         {
-            GL_CHECK(glBlendFunc(ENUM_CLASS_TO_GLENUM(_nextState->blendSrc),
+            STATE_GL_CHECK(glBlendFunc(ENUM_CLASS_TO_GLENUM(_nextState->blendSrc),
                         ENUM_CLASS_TO_GLENUM(_nextState->blendDst)));
-            GL_CHECK(glBlendEquation(ENUM_CLASS_TO_GLENUM(_nextState->blendEq)));
+            STATE_GL_CHECK(glBlendEquation(ENUM_CLASS_TO_GLENUM(_nextState->blendEq)));
         }
         
         return;
@@ -712,27 +812,27 @@ void DeviceGraphics::commitBlendStates()
         return;
     
     if (_currentState->blendColor != _nextState->blendColor)
-        glBlendColor((_nextState->blendColor >> 24) / 255.f,
+        STATE_GL_CHECK(glBlendColor((_nextState->blendColor >> 24) / 255.f,
                      (_nextState->blendColor >> 16 & 0xff) / 255.f,
                      (_nextState->blendColor >> 8 & 0xff) / 255.f,
-                     (_nextState->blendColor & 0xff) / 255.f);
+                     (_nextState->blendColor & 0xff) / 255.f));
     
     if (_currentState->blendSeparation != _nextState->blendSeparation)
     {
         if (_nextState->blendSeparation)
         {
-            GL_CHECK(glBlendFuncSeparate(ENUM_CLASS_TO_GLENUM(_nextState->blendSrc),
+            STATE_GL_CHECK(glBlendFuncSeparate(ENUM_CLASS_TO_GLENUM(_nextState->blendSrc),
                                 ENUM_CLASS_TO_GLENUM(_nextState->blendDst),
                                 ENUM_CLASS_TO_GLENUM(_nextState->blendSrcAlpha),
                                 ENUM_CLASS_TO_GLENUM(_nextState->blendDstAlpha)));
-            GL_CHECK(glBlendEquationSeparate(ENUM_CLASS_TO_GLENUM(_nextState->blendEq),
+            STATE_GL_CHECK(glBlendEquationSeparate(ENUM_CLASS_TO_GLENUM(_nextState->blendEq),
                                     ENUM_CLASS_TO_GLENUM(_nextState->blendAlphaEq)));
         }
         else
         {
-            GL_CHECK(glBlendFunc(ENUM_CLASS_TO_GLENUM(_nextState->blendSrc),
+            STATE_GL_CHECK(glBlendFunc(ENUM_CLASS_TO_GLENUM(_nextState->blendSrc),
                         ENUM_CLASS_TO_GLENUM(_nextState->blendDst)));
-            GL_CHECK(glBlendEquation(ENUM_CLASS_TO_GLENUM(_nextState->blendEq)));
+            STATE_GL_CHECK(glBlendEquation(ENUM_CLASS_TO_GLENUM(_nextState->blendEq)));
         }
         
         return;
@@ -745,7 +845,7 @@ void DeviceGraphics::commitBlendStates()
             _currentState->blendSrcAlpha != _nextState->blendSrcAlpha ||
             _currentState->blendDstAlpha != _nextState->blendDstAlpha)
         {
-            GL_CHECK(glBlendFuncSeparate(ENUM_CLASS_TO_GLENUM(_nextState->blendSrc),
+            STATE_GL_CHECK(glBlendFuncSeparate(ENUM_CLASS_TO_GLENUM(_nextState->blendSrc),
                                 ENUM_CLASS_TO_GLENUM(_nextState->blendDst),
                                 ENUM_CLASS_TO_GLENUM(_nextState->blendSrcAlpha),
                                 ENUM_CLASS_TO_GLENUM(_nextState->blendDstAlpha)));
@@ -755,7 +855,7 @@ void DeviceGraphics::commitBlendStates()
     if (_currentState->blendEq != _nextState->blendEq ||
         _currentState->blendAlphaEq != _nextState->blendAlphaEq)
     {
-        GL_CHECK(glBlendEquationSeparate(ENUM_CLASS_TO_GLENUM(_nextState->blendEq),
+        STATE_GL_CHECK(glBlendEquationSeparate(ENUM_CLASS_TO_GLENUM(_nextState->blendEq),
                                 ENUM_CLASS_TO_GLENUM(_nextState->blendAlphaEq)));
     }
     else
@@ -763,13 +863,13 @@ void DeviceGraphics::commitBlendStates()
         if (_currentState->blendSrc != _nextState->blendSrc ||
             _currentState->blendDst != _nextState->blendDst)
         {
-            GL_CHECK(glBlendFunc(ENUM_CLASS_TO_GLENUM(_nextState->blendSrc),
+            STATE_GL_CHECK(glBlendFunc(ENUM_CLASS_TO_GLENUM(_nextState->blendSrc),
                         ENUM_CLASS_TO_GLENUM(_nextState->blendDst)));
         }
         
         if (_currentState->blendEq != _nextState->blendEq)
         {
-            GL_CHECK(glBlendEquation(ENUM_CLASS_TO_GLENUM(_nextState->blendEq)));
+            STATE_GL_CHECK(glBlendEquation(ENUM_CLASS_TO_GLENUM(_nextState->blendEq)));
         }
     }
 }
@@ -780,20 +880,20 @@ void DeviceGraphics::commitDepthStates()
     {
         if (!_nextState->depthTest)
         {
-            glDisable(GL_DEPTH_TEST);
+            STATE_GL_CHECK(glDisable(GL_DEPTH_TEST));
             return;
         }
         
-        GL_CHECK(glEnable(GL_DEPTH_TEST));
-        GL_CHECK(glDepthFunc(ENUM_CLASS_TO_GLENUM(_nextState->depthFunc)));
-        GL_CHECK(glDepthMask(_nextState->depthWrite ? GL_TRUE : GL_FALSE));
+        STATE_GL_CHECK(glEnable(GL_DEPTH_TEST));
+        STATE_GL_CHECK(glDepthFunc(ENUM_CLASS_TO_GLENUM(_nextState->depthFunc)));
+        STATE_GL_CHECK(glDepthMask(_nextState->depthWrite ? GL_TRUE : GL_FALSE));
         
         return;
     }
     
     if (_currentState->depthWrite != _nextState->depthWrite)
     {
-        GL_CHECK(glDepthMask(_nextState->depthWrite ? GL_TRUE : GL_FALSE));
+        STATE_GL_CHECK(glDepthMask(_nextState->depthWrite ? GL_TRUE : GL_FALSE));
     }
     
     if (!_nextState->depthTest)
@@ -803,8 +903,8 @@ void DeviceGraphics::commitDepthStates()
             _nextState->depthTest = true;
             _nextState->depthFunc = DepthFunc::ALWAYS;
             
-            GL_CHECK(glEnable(GL_DEPTH_TEST));
-            GL_CHECK(glDepthFunc(ENUM_CLASS_TO_GLENUM(_nextState->depthFunc)));
+            STATE_GL_CHECK(glEnable(GL_DEPTH_TEST));
+            STATE_GL_CHECK(glDepthFunc(ENUM_CLASS_TO_GLENUM(_nextState->depthFunc)));
         }
         
         return;
@@ -812,7 +912,7 @@ void DeviceGraphics::commitDepthStates()
     
     if (_currentState->depthFunc != _nextState->depthFunc)
     {
-        GL_CHECK(glDepthFunc(ENUM_CLASS_TO_GLENUM(_nextState->depthFunc)));
+        STATE_GL_CHECK(glDepthFunc(ENUM_CLASS_TO_GLENUM(_nextState->depthFunc)));
     }
 }
 
@@ -822,40 +922,40 @@ void DeviceGraphics::commitStencilStates()
     {
         if (!_nextState->stencilTest)
         {
-            glDisable(GL_STENCIL_TEST);
+            STATE_GL_CHECK(glDisable(GL_STENCIL_TEST));
             return;
         }
         
-        glEnable(GL_STENCIL_TEST);
+        STATE_GL_CHECK(glEnable(GL_STENCIL_TEST));
         
         if (_nextState->stencilSeparation)
         {
-            GL_CHECK(glStencilFuncSeparate(GL_FRONT,
+            STATE_GL_CHECK(glStencilFuncSeparate(GL_FRONT,
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilFuncFront),
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilRefFront),
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilMaskFront)));
-            GL_CHECK(glStencilMaskSeparate(GL_FRONT, ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskFront)));
-            GL_CHECK(glStencilOpSeparate(GL_FRONT,
+            STATE_GL_CHECK(glStencilMaskSeparate(GL_FRONT, ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskFront)));
+            STATE_GL_CHECK(glStencilOpSeparate(GL_FRONT,
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilFailOpFront),
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilZFailOpFront),
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilZPassOpFront)));
-            GL_CHECK(glStencilFuncSeparate(GL_BACK,
+            STATE_GL_CHECK(glStencilFuncSeparate(GL_BACK,
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilFuncBack),
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilRefBack),
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilMaskBack)));
-            GL_CHECK(glStencilMaskSeparate(GL_BACK, ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskBack)));
-            GL_CHECK(glStencilOpSeparate(GL_BACK,
+            STATE_GL_CHECK(glStencilMaskSeparate(GL_BACK, ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskBack)));
+            STATE_GL_CHECK(glStencilOpSeparate(GL_BACK,
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilFailOpBack),
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilZFailOpBack),
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilZPassOpBack)));
         }
         else
         {
-            GL_CHECK(glStencilFunc(ENUM_CLASS_TO_GLENUM(_nextState->stencilFuncFront),
+            STATE_GL_CHECK(glStencilFunc(ENUM_CLASS_TO_GLENUM(_nextState->stencilFuncFront),
                           ENUM_CLASS_TO_GLENUM(_nextState->stencilRefFront),
                           ENUM_CLASS_TO_GLENUM(_nextState->stencilMaskFront)));
-            GL_CHECK(glStencilMask(ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskFront)));
-            GL_CHECK(glStencilOp(ENUM_CLASS_TO_GLENUM(_nextState->stencilFailOpFront),
+            STATE_GL_CHECK(glStencilMask(ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskFront)));
+            STATE_GL_CHECK(glStencilOp(ENUM_CLASS_TO_GLENUM(_nextState->stencilFailOpFront),
                         ENUM_CLASS_TO_GLENUM(_nextState->stencilZFailOpFront),
                         ENUM_CLASS_TO_GLENUM(_nextState->stencilZPassOpFront)));
         }
@@ -871,34 +971,34 @@ void DeviceGraphics::commitStencilStates()
         if (_nextState->stencilSeparation)
         {
             // front
-            GL_CHECK(glStencilFuncSeparate(GL_FRONT,
+            STATE_GL_CHECK(glStencilFuncSeparate(GL_FRONT,
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilFuncFront),
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilRefFront),
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilMaskFront)));
-            GL_CHECK(glStencilMaskSeparate(GL_FRONT, ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskFront)));
-            GL_CHECK(glStencilOpSeparate(GL_FRONT,
+            STATE_GL_CHECK(glStencilMaskSeparate(GL_FRONT, ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskFront)));
+            STATE_GL_CHECK(glStencilOpSeparate(GL_FRONT,
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilFailOpFront),
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilZFailOpFront),
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilZPassOpFront)));
             
             // back
-            GL_CHECK(glStencilFuncSeparate(GL_BACK,
+            STATE_GL_CHECK(glStencilFuncSeparate(GL_BACK,
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilFuncBack),
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilRefBack),
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilMaskBack)));
-            GL_CHECK(glStencilMaskSeparate(GL_BACK, ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskBack)));
-            GL_CHECK(glStencilOpSeparate(GL_BACK,
+            STATE_GL_CHECK(glStencilMaskSeparate(GL_BACK, ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskBack)));
+            STATE_GL_CHECK(glStencilOpSeparate(GL_BACK,
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilFailOpBack),
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilZFailOpBack),
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilZPassOpBack)));
         }
         else
         {
-            GL_CHECK(glStencilFunc(ENUM_CLASS_TO_GLENUM(_nextState->stencilFuncFront),
+            STATE_GL_CHECK(glStencilFunc(ENUM_CLASS_TO_GLENUM(_nextState->stencilFuncFront),
                           ENUM_CLASS_TO_GLENUM(_nextState->stencilRefFront),
                           ENUM_CLASS_TO_GLENUM(_nextState->stencilMaskFront)));
-            GL_CHECK(glStencilMask(ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskFront)));
-            GL_CHECK(glStencilOp(ENUM_CLASS_TO_GLENUM(_nextState->stencilFailOpFront),
+            STATE_GL_CHECK(glStencilMask(ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskFront)));
+            STATE_GL_CHECK(glStencilOp(ENUM_CLASS_TO_GLENUM(_nextState->stencilFailOpFront),
                         ENUM_CLASS_TO_GLENUM(_nextState->stencilZFailOpFront),
                         ENUM_CLASS_TO_GLENUM(_nextState->stencilZPassOpFront)));
         }
@@ -913,20 +1013,20 @@ void DeviceGraphics::commitStencilStates()
             _currentState->stencilRefFront != _nextState->stencilRefFront ||
             _currentState->stencilMaskFront != _nextState->stencilMaskFront)
         {
-            GL_CHECK(glStencilFuncSeparate(GL_FRONT,
+            STATE_GL_CHECK(glStencilFuncSeparate(GL_FRONT,
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilFuncFront),
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilRefFront),
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilMaskFront)));
         }
         if (_currentState->stencilWriteMaskFront != _nextState->stencilWriteMaskFront)
         {
-            GL_CHECK(glStencilMaskSeparate(GL_FRONT, ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskFront)));
+            STATE_GL_CHECK(glStencilMaskSeparate(GL_FRONT, ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskFront)));
         }
         if (_currentState->stencilFailOpFront != _nextState->stencilFailOpFront ||
             _currentState->stencilZFailOpFront != _nextState->stencilZFailOpFront ||
             _currentState->stencilZPassOpFront != _nextState->stencilZPassOpFront)
         {
-            GL_CHECK(glStencilOpSeparate(GL_FRONT,
+            STATE_GL_CHECK(glStencilOpSeparate(GL_FRONT,
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilFailOpFront),
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilZFailOpFront),
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilZPassOpFront)));
@@ -937,18 +1037,18 @@ void DeviceGraphics::commitStencilStates()
             _currentState->stencilRefBack != _nextState->stencilRefBack ||
             _currentState->stencilMaskBack != _nextState->stencilMaskBack)
         {
-            GL_CHECK(glStencilFuncSeparate(GL_BACK,
+            STATE_GL_CHECK(glStencilFuncSeparate(GL_BACK,
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilFuncBack),
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilRefBack),
                                   ENUM_CLASS_TO_GLENUM(_nextState->stencilMaskBack)));
         }
         if (_currentState->stencilWriteMaskBack != _nextState->stencilWriteMaskBack)
-            GL_CHECK(glStencilMaskSeparate(GL_BACK, ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskBack)));
+            STATE_GL_CHECK(glStencilMaskSeparate(GL_BACK, ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskBack)));
         if (_currentState->stencilFailOpBack != _nextState->stencilFailOpBack ||
             _currentState->stencilZFailOpBack != _nextState->stencilZFailOpBack ||
             _currentState->stencilZPassOpBack != _nextState->stencilZPassOpBack)
         {
-            GL_CHECK(glStencilOpSeparate(GL_BACK,
+            STATE_GL_CHECK(glStencilOpSeparate(GL_BACK,
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilFailOpBack),
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilZFailOpBack),
                                 ENUM_CLASS_TO_GLENUM(_nextState->stencilZPassOpBack)));
@@ -960,21 +1060,21 @@ void DeviceGraphics::commitStencilStates()
             _currentState->stencilRefFront != _nextState->stencilRefFront ||
             _currentState->stencilMaskFront != _nextState->stencilMaskFront)
         {
-            GL_CHECK(glStencilFunc(ENUM_CLASS_TO_GLENUM(_nextState->stencilFuncFront),
+            STATE_GL_CHECK(glStencilFunc(ENUM_CLASS_TO_GLENUM(_nextState->stencilFuncFront),
                           ENUM_CLASS_TO_GLENUM(_nextState->stencilRefFront),
                           ENUM_CLASS_TO_GLENUM(_nextState->stencilMaskFront)));
         }
         
         if (_currentState->stencilWriteMaskFront != _nextState->stencilWriteMaskFront)
         {
-            GL_CHECK(glStencilMask(ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskFront)));
+            STATE_GL_CHECK(glStencilMask(ENUM_CLASS_TO_GLENUM(_nextState->stencilWriteMaskFront)));
         }
         
         if (_currentState->stencilFailOpFront != _nextState->stencilFailOpFront ||
             _currentState->stencilZFailOpFront != _nextState->stencilZFailOpFront ||
             _currentState->stencilZPassOpFront != _nextState->stencilZPassOpFront)
         {
-            GL_CHECK(glStencilOp(ENUM_CLASS_TO_GLENUM(_nextState->stencilFailOpFront),
+            STATE_GL_CHECK(glStencilOp(ENUM_CLASS_TO_GLENUM(_nextState->stencilFailOpFront),
                         ENUM_CLASS_TO_GLENUM(_nextState->stencilZFailOpFront),
                         ENUM_CLASS_TO_GLENUM(_nextState->stencilZPassOpFront)));
         }
@@ -988,12 +1088,12 @@ void DeviceGraphics::commitCullMode()
     
     if (_nextState->cullMode == CullMode::NONE)
     {
-        GL_CHECK(glDisable(GL_CULL_FACE));
+        STATE_GL_CHECK(glDisable(GL_CULL_FACE));
         return;
     }
     
-    GL_CHECK(glEnable(GL_CULL_FACE));
-    GL_CHECK(glCullFace(ENUM_CLASS_TO_GLENUM(_nextState->cullMode)));
+    STATE_GL_CHECK(glEnable(GL_CULL_FACE));
+    STATE_GL_CHECK(glCullFace(ENUM_CLASS_TO_GLENUM(_nextState->cullMode)));
 }
 void DeviceGraphics::commitVertexBuffer()
 {
@@ -1003,7 +1103,8 @@ void DeviceGraphics::commitVertexBuffer()
         return;
     }
     
-    bool attrsDirty = false;
+    bool attrsDirty = _attributesDirty;
+    _attributesDirty = false;
     if (_currentState->maxStream != _nextState->maxStream)
         attrsDirty = true;
     else if (_currentState->getProgram() != _nextState->getProgram())
@@ -1013,7 +1114,8 @@ void DeviceGraphics::commitVertexBuffer()
         for (int i = 0; i < _nextState->maxStream + 1; ++i)
         {
             if (_currentState->getVertexBuffer(i) != _nextState->getVertexBuffer(i) ||
-                _currentState->getVertexBufferOffset(i) != _nextState->getVertexBufferOffset(i))
+                _currentState->getVertexBufferOffset(i) != _nextState->getVertexBufferOffset(i) ||
+                _currentState->getVertexBufferDivisor(i) != _nextState->getVertexBufferDivisor(i))
             {
                 attrsDirty = true;
                 break;
@@ -1035,17 +1137,16 @@ void DeviceGraphics::commitVertexBuffer()
             GL_CHECK(ccBindBuffer(GL_ARRAY_BUFFER, vb->getHandle()));
             
             auto vboffset = _nextState->getVertexBufferOffset(i);
+            auto divisor = _nextState->getVertexBufferDivisor(i);
             const auto& attributes = _nextState->getProgram()->getAttributes();
             auto usedAttriLen = attributes.size();
             for (int j = 0; j < usedAttriLen; ++j)
             {
                 const auto& attr = attributes[j];
                 const auto* el = vb->getFormat().getElement(attr.hashName);
+                // The attribute may be provided by another stream.
                 if (!el || !el->isValid())
-                {
-                    RENDERER_LOGW("Can not find vertex attribute: %s", attr.name.c_str());
                     continue;
-                }
                 
                 if (0 == _enabledAtrributes[attr.location])
                 {
@@ -1061,6 +1162,21 @@ void DeviceGraphics::commitVertexBuffer()
                                       el->normalize,
                                       el->stride,
                                       (GLvoid*)(el->offset + vboffset * el->stride)));
+
+                if (divisor > 0)
+                {
+                    GL_CHECK(ccVertexAttribDivisor(attr.location, divisor));
+                    _instancedAttributes.push_back(attr.location);
+                }
+            }
+        }
+
+        const auto& attributes = _nextState->getProgram()->getAttributes();
+        for (const auto& attr : attributes)
+        {
+            if (0 == _newAttributes[attr.location])
+            {
+                RENDERER_LOGW("Can not find vertex attribute: %s", attr.name.c_str());
             }
         }
         
@@ -66,6 +66,7 @@ public:
         int maxVertexAttributes;
         int maxDrawBuffers;
         int maxColorAttatchments;
+        bool instancing;
     };
     
     struct Uniform
@@ -108,6 +109,14 @@ public:
      * Sets scissor clipping area
      */
     void setScissor(int x, int y, int w, int h);
+    /**
+     * Enables scissor test, it takes effect immediately instead of on the next draw
+     */
+    void enableScissorTest();
+    /**
+     * Disables scissor test, it takes effect immediately instead of on the next draw
+     */
+    void disableScissorTest();
 
     /**
      * Clear with flags, including color, depth and stencil,
@@ -197,6 +206,11 @@ public:
      * Sets the vertex buffer
      */
     void setVertexBuffer(int stream, VertexBuffer* buffer, int start = 0);
+    /**
+     * Sets the per instance vertex buffer, its attributes advance once per instance, start is counted in instances.
+     * It only takes effect in drawInstanced.
+     */
+    void setInstanceBuffer(int stream, VertexBuffer* buffer, int start = 0);
     /**
      * Sets the index buffer
      */
@@ -296,15 +310,38 @@ public:
      * Draw elements using the current gl states
      */
     void draw(size_t base, GLsizei count);
+    /**
+     * Draw instanceCount instances of elements using the current gl states, only available if supportsInstancing returns true
+     */
+    void drawInstanced(size_t base, GLsizei count, GLsizei instanceCount);
+    /**
+     * Whether hardware instancing is supported
+     */
+    bool supportsInstancing() const { return _caps.instancing; }
+    /**
+     * Sets the id of blend, depth, stencil and cull states used by the next draw, 0 means unknown.
+     * Equal ids must mean equal states, see Pass::getStateID.
+     * Returns true if it matches the states of the last draw, then the caller can skip setting these states
+     * and the draw skips committing them.
+     */
+    bool setPipelineState(uint32_t id);
 
     /**
-     * Resets the draw call counter to 0
+     * Resets the draw call counter and the pipeline state counters to 0
      */
-    void resetDrawCalls() { _drawCalls = 0; };
+    void resetDrawCalls() { _drawCalls = 0; _stateCalls = 0; _skippedStateCommits = 0; };
     /**
      * Gets current draw call counts
      */
     uint32_t getDrawCalls() const { return _drawCalls; };
+    /**
+     * Gets the count of GL calls issued to change blend, depth, stencil and cull states
+     */
+    uint32_t getStateCalls() const { return _stateCalls; };
+    /**
+     * Gets the count of draws which skipped committing blend, depth, stencil and cull states by a matching pipeline state hash
+     */
+    uint32_t getSkippedStateCommits() const { return _skippedStateCommits; };
     
     inline const Capacity& getCapacity() const { return _caps; }
     
@@ -316,7 +353,9 @@ private:
     inline void initStates();
     inline void initCaps();
     void restoreTexture(uint32_t index);
+    void restoreFrameBuffer();
     void restoreIndexBuffer();
+    void commitDraw(size_t base, GLsizei count, GLsizei instanceCount);
 
     inline void commitBlendStates();
     inline void commitDepthStates();
@@ -334,8 +373,11 @@ private:
     int _sy;
     int _sw;
     int _sh;
+    bool _scissorTest = false;
     
     uint32_t _drawCalls = 0;
+    uint32_t _stateCalls = 0;
+    uint32_t _skippedStateCommits = 0;
 
     int _defaultFbo;
     
@@ -345,7 +387,12 @@ private:
     FrameBuffer *_frameBuffer;
     std::vector<int> _enabledAtrributes;
     std::vector<int> _newAttributes;
-    std::unordered_map<size_t, Uniform> _uniforms;
+    std::vector<int> _instancedAttributes;
+    // Set after an instanced draw, since the attribute divisors are restored.
+    bool _attributesDirty = false;
+    // Uniform values are never removed, so the index in _uniforms is a stable slot which programs can cache.
+    std::vector<Uniform> _uniforms;
+    std::unordered_map<size_t, int> _uniformSlots;
     
     State* _nextState;
     State* _currentState;
@@ -0,0 +1,713 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "platform/CCGL.h"
+
+#if CC_USE_GFX_NULL
+
+#include <string.h>
+#include <unordered_set>
+
+using namespace cocos2d::renderer;
+
+namespace
+{
+    GFXNullStats __stats;
+
+    // Names are unique among all kinds of objects, 0 is never used.
+    GLuint __nextName = 1;
+    std::unordered_set<GLuint> __buffers;
+    std::unordered_set<GLuint> __textures;
+    std::unordered_set<GLuint> __programs;
+    std::unordered_set<GLuint> __frameBuffers;
+    std::unordered_set<GLuint> __renderBuffers;
+    std::unordered_set<GLuint> __syncs;
+    bool __fenceSyncSupported = false;
+
+    GLuint __boundFrameBuffer = 0;
+    GLuint __boundRenderBuffer = 0;
+    GLint __viewport[4] = {0};
+
+    void genNames(GLsizei n, GLuint* names, std::unordered_set<GLuint>& live)
+    {
+        for (GLsizei i = 0; i < n; ++i)
+        {
+            names[i] = __nextName++;
+            live.insert(names[i]);
+        }
+    }
+
+    void deleteNames(GLsizei n, const GLuint* names, std::unordered_set<GLuint>& live)
+    {
+        for (GLsizei i = 0; i < n; ++i)
+        {
+            live.erase(names[i]);
+        }
+    }
+
+    void emptyString(GLsizei bufSize, GLsizei* length, GLchar* str)
+    {
+        if (length) *length = 0;
+        if (str && bufSize > 0) str[0] = '\0';
+    }
+
+    uint32_t pixelBytes(GLenum format, GLenum type)
+    {
+        switch (type)
+        {
+            case GL_UNSIGNED_SHORT_5_6_5:
+            case GL_UNSIGNED_SHORT_4_4_4_4:
+            case GL_UNSIGNED_SHORT_5_5_5_1:
+                return 2;
+            default:
+                break;
+        }
+
+        switch (format)
+        {
+            case GL_ALPHA:
+            case GL_LUMINANCE:
+                return 1;
+            case GL_LUMINANCE_ALPHA:
+                return 2;
+            case GL_RGB:
+                return 3;
+            default:
+                return 4;
+        }
+    }
+}
+
+RENDERER_BEGIN
+
+const GFXNullStats& GFXNull::getStats()
+{
+    return __stats;
+}
+
+void GFXNull::resetStats()
+{
+    __stats = GFXNullStats();
+}
+
+uint32_t GFXNull::getLiveObjectCount()
+{
+    return (uint32_t)(__buffers.size() + __textures.size() + __programs.size() + __frameBuffers.size() + __renderBuffers.size() + __syncs.size());
+}
+
+void GFXNull::setFenceSyncSupported(bool supported)
+{
+    __fenceSyncSupported = supported;
+}
+
+bool GFXNull::isFenceSyncSupported()
+{
+    return __fenceSyncSupported;
+}
+
+RENDERER_END
+
+void ccNullGenBuffers(GLsizei n, GLuint* buffers)
+{
+    genNames(n, buffers, __buffers);
+}
+
+void ccNullDeleteBuffers(GLsizei n, const GLuint* buffers)
+{
+    deleteNames(n, buffers, __buffers);
+}
+
+void ccNullBindBuffer(GLenum target, GLuint buffer)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullBufferData(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage)
+{
+    __stats.bufferUploads++;
+    if (data)
+    {
+        __stats.uploadedBytes += size;
+    }
+}
+
+void ccNullBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data)
+{
+    __stats.bufferUploads++;
+    __stats.uploadedBytes += size;
+}
+
+void ccNullGenTextures(GLsizei n, GLuint* textures)
+{
+    genNames(n, textures, __textures);
+}
+
+void ccNullDeleteTextures(GLsizei n, const GLuint* textures)
+{
+    deleteNames(n, textures, __textures);
+}
+
+void ccNullBindTexture(GLenum target, GLuint texture)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullActiveTexture(GLenum texture)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid* pixels)
+{
+    __stats.textureUploads++;
+    if (pixels)
+    {
+        __stats.uploadedBytes += (uint64_t)width * height * pixelBytes(format, type);
+    }
+}
+
+void ccNullTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid* pixels)
+{
+    __stats.textureUploads++;
+    __stats.uploadedBytes += (uint64_t)width * height * pixelBytes(format, type);
+}
+
+void ccNullCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const GLvoid* data)
+{
+    __stats.textureUploads++;
+    if (data)
+    {
+        __stats.uploadedBytes += imageSize;
+    }
+}
+
+void ccNullCompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const GLvoid* data)
+{
+    __stats.textureUploads++;
+    __stats.uploadedBytes += imageSize;
+}
+
+void ccNullCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    // copied on GPU, nothing is uploaded
+    __stats.textureUploads++;
+}
+
+void ccNullTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullGenerateMipmap(GLenum target)
+{
+    __stats.textureUploads++;
+}
+
+void ccNullPixelStorei(GLenum pname, GLint param)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullGenFramebuffers(GLsizei n, GLuint* framebuffers)
+{
+    genNames(n, framebuffers, __frameBuffers);
+}
+
+void ccNullDeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
+{
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        if (framebuffers[i] == __boundFrameBuffer)
+        {
+            __boundFrameBuffer = 0;
+        }
+    }
+    deleteNames(n, framebuffers, __frameBuffers);
+}
+
+void ccNullBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    __stats.stateChanges++;
+    __boundFrameBuffer = framebuffer;
+}
+
+void ccNullFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+    __stats.stateChanges++;
+}
+
+GLenum ccNullCheckFramebufferStatus(GLenum target)
+{
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+void ccNullGenRenderbuffers(GLsizei n, GLuint* renderbuffers)
+{
+    genNames(n, renderbuffers, __renderBuffers);
+}
+
+void ccNullDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
+{
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        if (renderbuffers[i] == __boundRenderBuffer)
+        {
+            __boundRenderBuffer = 0;
+        }
+    }
+    deleteNames(n, renderbuffers, __renderBuffers);
+}
+
+void ccNullBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+    __stats.stateChanges++;
+    __boundRenderBuffer = renderbuffer;
+}
+
+void ccNullRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+}
+
+void ccNullDrawBuffer(GLenum mode)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullReadBuffer(GLenum mode)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullBindVertexArray(GLuint array)
+{
+    __stats.stateChanges++;
+}
+
+GLuint ccNullCreateShader(GLenum type)
+{
+    return __nextName++;
+}
+
+void ccNullShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length)
+{
+}
+
+void ccNullCompileShader(GLuint shader)
+{
+    __stats.shaderCompiles++;
+}
+
+void ccNullGetShaderiv(GLuint shader, GLenum pname, GLint* params)
+{
+    *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+void ccNullGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+    emptyString(bufSize, length, infoLog);
+}
+
+void ccNullGetShaderSource(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* source)
+{
+    emptyString(bufSize, length, source);
+}
+
+void ccNullDeleteShader(GLuint shader)
+{
+}
+
+GLuint ccNullCreateProgram(void)
+{
+    GLuint program = __nextName++;
+    __programs.insert(program);
+    return program;
+}
+
+void ccNullAttachShader(GLuint program, GLuint shader)
+{
+}
+
+void ccNullLinkProgram(GLuint program)
+{
+    __stats.programLinks++;
+}
+
+void ccNullGetProgramiv(GLuint program, GLenum pname, GLint* params)
+{
+    *params = pname == GL_LINK_STATUS ? GL_TRUE : 0;
+}
+
+void ccNullGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+    emptyString(bufSize, length, infoLog);
+}
+
+void ccNullDeleteProgram(GLuint program)
+{
+    __programs.erase(program);
+}
+
+void ccNullUseProgram(GLuint program)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    *size = 0;
+    *type = 0;
+    emptyString(bufSize, length, name);
+}
+
+GLint ccNullGetAttribLocation(GLuint program, const GLchar* name)
+{
+    return -1;
+}
+
+void ccNullGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    *size = 0;
+    *type = 0;
+    emptyString(bufSize, length, name);
+}
+
+GLint ccNullGetUniformLocation(GLuint program, const GLchar* name)
+{
+    return -1;
+}
+
+void ccNullUniform1i(GLint location, GLint x)
+{
+    __stats.uniformCalls++;
+}
+
+void ccNullUniform1f(GLint location, GLfloat x)
+{
+    __stats.uniformCalls++;
+}
+
+void ccNullUniform1iv(GLint location, GLsizei count, const GLint* v)
+{
+    __stats.uniformCalls++;
+}
+
+void ccNullUniform2iv(GLint location, GLsizei count, const GLint* v)
+{
+    __stats.uniformCalls++;
+}
+
+void ccNullUniform3iv(GLint location, GLsizei count, const GLint* v)
+{
+    __stats.uniformCalls++;
+}
+
+void ccNullUniform4iv(GLint location, GLsizei count, const GLint* v)
+{
+    __stats.uniformCalls++;
+}
+
+void ccNullUniform1fv(GLint location, GLsizei count, const GLfloat* v)
+{
+    __stats.uniformCalls++;
+}
+
+void ccNullUniform2fv(GLint location, GLsizei count, const GLfloat* v)
+{
+    __stats.uniformCalls++;
+}
+
+void ccNullUniform3fv(GLint location, GLsizei count, const GLfloat* v)
+{
+    __stats.uniformCalls++;
+}
+
+void ccNullUniform4fv(GLint location, GLsizei count, const GLfloat* v)
+{
+    __stats.uniformCalls++;
+}
+
+void ccNullUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    __stats.uniformCalls++;
+}
+
+void ccNullUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    __stats.uniformCalls++;
+}
+
+void ccNullUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    __stats.uniformCalls++;
+}
+
+void ccNullEnable(GLenum cap)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullDisable(GLenum cap)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullBlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullBlendEquation(GLenum mode)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullBlendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullDepthFunc(GLenum func)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullDepthMask(GLboolean flag)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullDepthRange(GLfloat zNear, GLfloat zFar)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullCullFace(GLenum mode)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullStencilFunc(GLenum func, GLint ref, GLuint mask)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullStencilOp(GLenum fail, GLenum zfail, GLenum zpass)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullStencilOpSeparate(GLenum face, GLenum fail, GLenum zfail, GLenum zpass)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullStencilMask(GLuint mask)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullStencilMaskSeparate(GLenum face, GLuint mask)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    __stats.stateChanges++;
+    __viewport[0] = x;
+    __viewport[1] = y;
+    __viewport[2] = width;
+    __viewport[3] = height;
+}
+
+void ccNullScissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullHint(GLenum target, GLenum mode)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullClearDepth(GLfloat depth)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullClearStencil(GLint s)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullClear(GLbitfield mask)
+{
+    __stats.clears++;
+}
+
+void ccNullVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* ptr)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullEnableVertexAttribArray(GLuint index)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullDisableVertexAttribArray(GLuint index)
+{
+    __stats.stateChanges++;
+}
+
+void ccNullDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices)
+{
+    __stats.drawCalls++;
+    __stats.drawElements += count;
+}
+
+void ccNullDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    __stats.drawCalls++;
+    __stats.drawElements += count;
+}
+
+void ccNullGetIntegerv(GLenum pname, GLint* params)
+{
+    switch (pname)
+    {
+        case GL_FRAMEBUFFER_BINDING:
+            *params = __boundFrameBuffer;
+            break;
+        case GL_RENDERBUFFER_BINDING:
+            *params = __boundRenderBuffer;
+            break;
+        case GL_VIEWPORT:
+            memcpy(params, __viewport, sizeof(__viewport));
+            break;
+        case GL_MAX_VERTEX_ATTRIBS:
+        case GL_MAX_TEXTURE_IMAGE_UNITS:
+        case GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS:
+            *params = 16;
+            break;
+        case GL_MAX_FRAGMENT_UNIFORM_VECTORS:
+            *params = 256;
+            break;
+#ifdef GL_MAX_FRAGMENT_UNIFORM_COMPONENTS
+        case GL_MAX_FRAGMENT_UNIFORM_COMPONENTS:
+            *params = 1024;
+            break;
+#endif
+#ifdef GL_MAX_COLOR_ATTACHMENTS
+        case GL_MAX_COLOR_ATTACHMENTS:
+#endif
+#ifdef GL_MAX_DRAW_BUFFERS
+        case GL_MAX_DRAW_BUFFERS:
+#endif
+            *params = 1;
+            break;
+        case GL_MAX_TEXTURE_SIZE:
+            *params = 4096;
+            break;
+        default:
+            *params = 0;
+            break;
+    }
+}
+
+const GLubyte* ccNullGetString(GLenum name)
+{
+    switch (name)
+    {
+        case GL_VENDOR:
+            return (const GLubyte*)"Cocos";
+        case GL_RENDERER:
+            return (const GLubyte*)"Null";
+        case GL_VERSION:
+            // Reports no GLES3 core functions and no extensions, so every optional path falls back.
+            return (const GLubyte*)"OpenGL ES 2.0 Null";
+        case GL_SHADING_LANGUAGE_VERSION:
+            return (const GLubyte*)"OpenGL ES GLSL ES 1.00";
+        default:
+            return (const GLubyte*)"";
+    }
+}
+
+GLenum ccNullGetError(void)
+{
+    return GL_NO_ERROR;
+}
+
+void* ccNullFenceSync(GLenum condition, GLbitfield flags)
+{
+    __stats.fenceSyncs++;
+    GLuint name = 0;
+    genNames(1, &name, __syncs);
+    return (void*)(uintptr_t)name;
+}
+
+GLenum ccNullClientWaitSync(void* sync, GLbitfield flags, uint64_t timeout)
+{
+    __stats.fenceWaits++;
+    // GL_ALREADY_SIGNALED, nothing is ever in flight.
+    return __syncs.count((GLuint)(uintptr_t)sync) ? 0x911A : GL_INVALID_VALUE;
+}
+
+void ccNullDeleteSync(void* sync)
+{
+    GLuint name = (GLuint)(uintptr_t)sync;
+    deleteNames(1, &name, __syncs);
+}
+
+#endif // CC_USE_GFX_NULL
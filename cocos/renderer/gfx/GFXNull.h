@@ -0,0 +1,396 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+/**
+ * The null GL driver, it is only included by platform/CCGL.h when CC_USE_GFX_NULL is 1.
+ * The GL functions used by the renderer are redirected to the functions below, so VertexBuffer, IndexBuffer,
+ * Texture2D, Program, FrameBuffer and DeviceGraphics run without a GL context.
+ * Every object gets a valid name, shaders always compile, programs always link without active attributes and uniforms,
+ * and the content of every upload is discarded after it is counted.
+ */
+
+#include <stdint.h>
+#include "../Macro.h"
+
+RENDERER_BEGIN
+
+/**
+ * @addtogroup gfx
+ * @{
+ */
+
+/**
+ * @brief Counters of the GL calls received by the null driver.
+ */
+struct GFXNullStats
+{
+    /** draw calls */
+    uint32_t drawCalls = 0;
+    /** vertices or indices consumed by the draw calls */
+    uint64_t drawElements = 0;
+    /** calls which change fixed function states, bindings or the program in use */
+    uint32_t stateChanges = 0;
+    /** uniform uploads */
+    uint32_t uniformCalls = 0;
+    /** buffer data and sub data uploads */
+    uint32_t bufferUploads = 0;
+    /** texture image and sub image uploads */
+    uint32_t textureUploads = 0;
+    /** bytes of all buffer and texture uploads */
+    uint64_t uploadedBytes = 0;
+    /** shader compilations */
+    uint32_t shaderCompiles = 0;
+    /** program links */
+    uint32_t programLinks = 0;
+    /** clears of the bound frame buffer */
+    uint32_t clears = 0;
+    /** fences inserted */
+    uint32_t fenceSyncs = 0;
+    /** waits on fences */
+    uint32_t fenceWaits = 0;
+};
+
+/**
+ * @brief Accesses the null driver, it only exists when CC_USE_GFX_NULL is 1.
+ */
+class GFXNull
+{
+public:
+    /**
+     * Gets the counters since the last resetStats.
+     */
+    static const GFXNullStats& getStats();
+    /**
+     * Resets all counters to 0, live objects are not affected.
+     */
+    static void resetStats();
+    /**
+     * Gets the count of buffers, textures, programs, frame buffers and render buffers which are not deleted yet.
+     */
+    static uint32_t getLiveObjectCount();
+    /**
+     * Enables or disables fence syncs, they are disabled by default like the other GLES3 functions.
+     * It takes effect after ccInvalidateStateCache. Fences of the null driver are signaled as soon as they are inserted.
+     */
+    static void setFenceSyncSupported(bool supported);
+    /**
+     * Whether fence syncs are enabled.
+     */
+    static bool isFenceSyncSupported();
+};
+
+// end of gfx group
+/// @}
+
+RENDERER_END
+
+void ccNullGenBuffers(GLsizei n, GLuint* buffers);
+void ccNullDeleteBuffers(GLsizei n, const GLuint* buffers);
+void ccNullBindBuffer(GLenum target, GLuint buffer);
+void ccNullBufferData(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage);
+void ccNullBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data);
+void ccNullGenTextures(GLsizei n, GLuint* textures);
+void ccNullDeleteTextures(GLsizei n, const GLuint* textures);
+void ccNullBindTexture(GLenum target, GLuint texture);
+void ccNullActiveTexture(GLenum texture);
+void ccNullTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid* pixels);
+void ccNullTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid* pixels);
+void ccNullCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const GLvoid* data);
+void ccNullCompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const GLvoid* data);
+void ccNullCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height);
+void ccNullTexParameteri(GLenum target, GLenum pname, GLint param);
+void ccNullGenerateMipmap(GLenum target);
+void ccNullPixelStorei(GLenum pname, GLint param);
+void ccNullGenFramebuffers(GLsizei n, GLuint* framebuffers);
+void ccNullDeleteFramebuffers(GLsizei n, const GLuint* framebuffers);
+void ccNullBindFramebuffer(GLenum target, GLuint framebuffer);
+void ccNullFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+void ccNullFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
+GLenum ccNullCheckFramebufferStatus(GLenum target);
+void ccNullGenRenderbuffers(GLsizei n, GLuint* renderbuffers);
+void ccNullDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers);
+void ccNullBindRenderbuffer(GLenum target, GLuint renderbuffer);
+void ccNullRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
+void ccNullDrawBuffer(GLenum mode);
+void ccNullReadBuffer(GLenum mode);
+void ccNullBindVertexArray(GLuint array);
+GLuint ccNullCreateShader(GLenum type);
+void ccNullShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length);
+void ccNullCompileShader(GLuint shader);
+void ccNullGetShaderiv(GLuint shader, GLenum pname, GLint* params);
+void ccNullGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+void ccNullGetShaderSource(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* source);
+void ccNullDeleteShader(GLuint shader);
+GLuint ccNullCreateProgram(void);
+void ccNullAttachShader(GLuint program, GLuint shader);
+void ccNullLinkProgram(GLuint program);
+void ccNullGetProgramiv(GLuint program, GLenum pname, GLint* params);
+void ccNullGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+void ccNullDeleteProgram(GLuint program);
+void ccNullUseProgram(GLuint program);
+void ccNullGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+GLint ccNullGetAttribLocation(GLuint program, const GLchar* name);
+void ccNullGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+GLint ccNullGetUniformLocation(GLuint program, const GLchar* name);
+void ccNullUniform1i(GLint location, GLint x);
+void ccNullUniform1f(GLint location, GLfloat x);
+void ccNullUniform1iv(GLint location, GLsizei count, const GLint* v);
+void ccNullUniform2iv(GLint location, GLsizei count, const GLint* v);
+void ccNullUniform3iv(GLint location, GLsizei count, const GLint* v);
+void ccNullUniform4iv(GLint location, GLsizei count, const GLint* v);
+void ccNullUniform1fv(GLint location, GLsizei count, const GLfloat* v);
+void ccNullUniform2fv(GLint location, GLsizei count, const GLfloat* v);
+void ccNullUniform3fv(GLint location, GLsizei count, const GLfloat* v);
+void ccNullUniform4fv(GLint location, GLsizei count, const GLfloat* v);
+void ccNullUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+void ccNullUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+void ccNullUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+void ccNullEnable(GLenum cap);
+void ccNullDisable(GLenum cap);
+void ccNullBlendFunc(GLenum sfactor, GLenum dfactor);
+void ccNullBlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+void ccNullBlendEquation(GLenum mode);
+void ccNullBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha);
+void ccNullBlendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+void ccNullColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
+void ccNullDepthFunc(GLenum func);
+void ccNullDepthMask(GLboolean flag);
+void ccNullDepthRange(GLfloat zNear, GLfloat zFar);
+void ccNullCullFace(GLenum mode);
+void ccNullStencilFunc(GLenum func, GLint ref, GLuint mask);
+void ccNullStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask);
+void ccNullStencilOp(GLenum fail, GLenum zfail, GLenum zpass);
+void ccNullStencilOpSeparate(GLenum face, GLenum fail, GLenum zfail, GLenum zpass);
+void ccNullStencilMask(GLuint mask);
+void ccNullStencilMaskSeparate(GLenum face, GLuint mask);
+void ccNullViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+void ccNullScissor(GLint x, GLint y, GLsizei width, GLsizei height);
+void ccNullHint(GLenum target, GLenum mode);
+void ccNullClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+void ccNullClearDepth(GLfloat depth);
+void ccNullClearStencil(GLint s);
+void ccNullClear(GLbitfield mask);
+void ccNullVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* ptr);
+void ccNullEnableVertexAttribArray(GLuint index);
+void ccNullDisableVertexAttribArray(GLuint index);
+void ccNullDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices);
+void ccNullDrawArrays(GLenum mode, GLint first, GLsizei count);
+void ccNullGetIntegerv(GLenum pname, GLint* params);
+const GLubyte* ccNullGetString(GLenum name);
+GLenum ccNullGetError(void);
+// Fence syncs are called through ccFenceSync, ccClientWaitSync and ccDeleteSync, sync objects are opaque pointers.
+void* ccNullFenceSync(GLenum condition, GLbitfield flags);
+GLenum ccNullClientWaitSync(void* sync, GLbitfield flags, uint64_t timeout);
+void ccNullDeleteSync(void* sync);
+
+#undef glGenBuffers
+#define glGenBuffers ccNullGenBuffers
+#undef glDeleteBuffers
+#define glDeleteBuffers ccNullDeleteBuffers
+#undef glBindBuffer
+#define glBindBuffer ccNullBindBuffer
+#undef glBufferData
+#define glBufferData ccNullBufferData
+#undef glBufferSubData
+#define glBufferSubData ccNullBufferSubData
+#undef glGenTextures
+#define glGenTextures ccNullGenTextures
+#undef glDeleteTextures
+#define glDeleteTextures ccNullDeleteTextures
+#undef glBindTexture
+#define glBindTexture ccNullBindTexture
+#undef glActiveTexture
+#define glActiveTexture ccNullActiveTexture
+#undef glTexImage2D
+#define glTexImage2D ccNullTexImage2D
+#undef glTexSubImage2D
+#define glTexSubImage2D ccNullTexSubImage2D
+#undef glCompressedTexImage2D
+#define glCompressedTexImage2D ccNullCompressedTexImage2D
+#undef glCompressedTexSubImage2D
+#define glCompressedTexSubImage2D ccNullCompressedTexSubImage2D
+#undef glCopyTexSubImage2D
+#define glCopyTexSubImage2D ccNullCopyTexSubImage2D
+#undef glTexParameteri
+#define glTexParameteri ccNullTexParameteri
+#undef glGenerateMipmap
+#define glGenerateMipmap ccNullGenerateMipmap
+#undef glPixelStorei
+#define glPixelStorei ccNullPixelStorei
+#undef glGenFramebuffers
+#define glGenFramebuffers ccNullGenFramebuffers
+#undef glDeleteFramebuffers
+#define glDeleteFramebuffers ccNullDeleteFramebuffers
+#undef glBindFramebuffer
+#define glBindFramebuffer ccNullBindFramebuffer
+#undef glFramebufferTexture2D
+#define glFramebufferTexture2D ccNullFramebufferTexture2D
+#undef glFramebufferRenderbuffer
+#define glFramebufferRenderbuffer ccNullFramebufferRenderbuffer
+#undef glCheckFramebufferStatus
+#define glCheckFramebufferStatus ccNullCheckFramebufferStatus
+#undef glGenRenderbuffers
+#define glGenRenderbuffers ccNullGenRenderbuffers
+#undef glDeleteRenderbuffers
+#define glDeleteRenderbuffers ccNullDeleteRenderbuffers
+#undef glBindRenderbuffer
+#define glBindRenderbuffer ccNullBindRenderbuffer
+#undef glRenderbufferStorage
+#define glRenderbufferStorage ccNullRenderbufferStorage
+#undef glDrawBuffer
+#define glDrawBuffer ccNullDrawBuffer
+#undef glReadBuffer
+#define glReadBuffer ccNullReadBuffer
+#undef glBindVertexArray
+#define glBindVertexArray ccNullBindVertexArray
+#undef glCreateShader
+#define glCreateShader ccNullCreateShader
+#undef glShaderSource
+#define glShaderSource ccNullShaderSource
+#undef glCompileShader
+#define glCompileShader ccNullCompileShader
+#undef glGetShaderiv
+#define glGetShaderiv ccNullGetShaderiv
+#undef glGetShaderInfoLog
+#define glGetShaderInfoLog ccNullGetShaderInfoLog
+#undef glGetShaderSource
+#define glGetShaderSource ccNullGetShaderSource
+#undef glDeleteShader
+#define glDeleteShader ccNullDeleteShader
+#undef glCreateProgram
+#define glCreateProgram ccNullCreateProgram
+#undef glAttachShader
+#define glAttachShader ccNullAttachShader
+#undef glLinkProgram
+#define glLinkProgram ccNullLinkProgram
+#undef glGetProgramiv
+#define glGetProgramiv ccNullGetProgramiv
+#undef glGetProgramInfoLog
+#define glGetProgramInfoLog ccNullGetProgramInfoLog
+#undef glDeleteProgram
+#define glDeleteProgram ccNullDeleteProgram
+#undef glUseProgram
+#define glUseProgram ccNullUseProgram
+#undef glGetActiveAttrib
+#define glGetActiveAttrib ccNullGetActiveAttrib
+#undef glGetAttribLocation
+#define glGetAttribLocation ccNullGetAttribLocation
+#undef glGetActiveUniform
+#define glGetActiveUniform ccNullGetActiveUniform
+#undef glGetUniformLocation
+#define glGetUniformLocation ccNullGetUniformLocation
+#undef glUniform1i
+#define glUniform1i ccNullUniform1i
+#undef glUniform1f
+#define glUniform1f ccNullUniform1f
+#undef glUniform1iv
+#define glUniform1iv ccNullUniform1iv
+#undef glUniform2iv
+#define glUniform2iv ccNullUniform2iv
+#undef glUniform3iv
+#define glUniform3iv ccNullUniform3iv
+#undef glUniform4iv
+#define glUniform4iv ccNullUniform4iv
+#undef glUniform1fv
+#define glUniform1fv ccNullUniform1fv
+#undef glUniform2fv
+#define glUniform2fv ccNullUniform2fv
+#undef glUniform3fv
+#define glUniform3fv ccNullUniform3fv
+#undef glUniform4fv
+#define glUniform4fv ccNullUniform4fv
+#undef glUniformMatrix2fv
+#define glUniformMatrix2fv ccNullUniformMatrix2fv
+#undef glUniformMatrix3fv
+#define glUniformMatrix3fv ccNullUniformMatrix3fv
+#undef glUniformMatrix4fv
+#define glUniformMatrix4fv ccNullUniformMatrix4fv
+#undef glEnable
+#define glEnable ccNullEnable
+#undef glDisable
+#define glDisable ccNullDisable
+#undef glBlendFunc
+#define glBlendFunc ccNullBlendFunc
+#undef glBlendFuncSeparate
+#define glBlendFuncSeparate ccNullBlendFuncSeparate
+#undef glBlendEquation
+#define glBlendEquation ccNullBlendEquation
+#undef glBlendEquationSeparate
+#define glBlendEquationSeparate ccNullBlendEquationSeparate
+#undef glBlendColor
+#define glBlendColor ccNullBlendColor
+#undef glColorMask
+#define glColorMask ccNullColorMask
+#undef glDepthFunc
+#define glDepthFunc ccNullDepthFunc
+#undef glDepthMask
+#define glDepthMask ccNullDepthMask
+#undef glDepthRange
+#define glDepthRange ccNullDepthRange
+#undef glCullFace
+#define glCullFace ccNullCullFace
+#undef glStencilFunc
+#define glStencilFunc ccNullStencilFunc
+#undef glStencilFuncSeparate
+#define glStencilFuncSeparate ccNullStencilFuncSeparate
+#undef glStencilOp
+#define glStencilOp ccNullStencilOp
+#undef glStencilOpSeparate
+#define glStencilOpSeparate ccNullStencilOpSeparate
+#undef glStencilMask
+#define glStencilMask ccNullStencilMask
+#undef glStencilMaskSeparate
+#define glStencilMaskSeparate ccNullStencilMaskSeparate
+#undef glViewport
+#define glViewport ccNullViewport
+#undef glScissor
+#define glScissor ccNullScissor
+#undef glHint
+#define glHint ccNullHint
+#undef glClearColor
+#define glClearColor ccNullClearColor
+#undef glClearDepth
+#define glClearDepth ccNullClearDepth
+#undef glClearStencil
+#define glClearStencil ccNullClearStencil
+#undef glClear
+#define glClear ccNullClear
+#undef glVertexAttribPointer
+#define glVertexAttribPointer ccNullVertexAttribPointer
+#undef glEnableVertexAttribArray
+#define glEnableVertexAttribArray ccNullEnableVertexAttribArray
+#undef glDisableVertexAttribArray
+#define glDisableVertexAttribArray ccNullDisableVertexAttribArray
+#undef glDrawElements
+#define glDrawElements ccNullDrawElements
+#undef glDrawArrays
+#define glDrawArrays ccNullDrawArrays
+#undef glGetIntegerv
+#define glGetIntegerv ccNullGetIntegerv
+#undef glGetString
+#define glGetString ccNullGetString
+#undef glGetError
+#define glGetError ccNullGetError
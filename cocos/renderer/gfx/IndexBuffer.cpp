@@ -117,6 +117,55 @@ void IndexBuffer::update(uint32_t offset, const void* data, size_t dataByteLengt
     _device->restoreIndexBuffer();
 }
 
+void IndexBuffer::updateDiscard(const void* data, size_t dataByteLength, bool unsynchronized)
+{
+    if (_glID == 0)
+    {
+        RENDERER_LOGE("The buffer is destroyed");
+        return;
+    }
+
+    if (data == nullptr || dataByteLength == 0) return;
+
+    if (dataByteLength > _bytes)
+    {
+        _needExpandDataStore = true;
+        _bytes = (uint32_t)dataByteLength;
+        _numIndices = _bytes / _bytesPerIndex;
+    }
+
+    GLenum glUsage = (GLenum)_usage;
+    ccBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _glID);
+    if (_needExpandDataStore)
+    {
+        // A new data store has nothing in flight.
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, _bytes, (const GLvoid*)data, glUsage);
+        _needExpandDataStore = false;
+    }
+    else
+    {
+        bool uploaded = false;
+        if (ccIsMapBufferRangeSupported())
+        {
+            GLbitfield access = GL_MAP_WRITE_BIT | (unsynchronized ? GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT : GL_MAP_INVALIDATE_BUFFER_BIT);
+            GLvoid* mapped = ccMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, (GLsizeiptr)dataByteLength, access);
+            if (mapped)
+            {
+                memcpy(mapped, data, dataByteLength);
+                uploaded = ccUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+            }
+        }
+
+        if (!uploaded)
+        {
+            // Orphans the old data store, the driver keeps it alive until pending draw calls finish.
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, _bytes, nullptr, glUsage);
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, (GLsizeiptr)dataByteLength, (const GLvoid*)data);
+        }
+    }
+    _device->restoreIndexBuffer();
+}
+
 void IndexBuffer::destroy()
 {
     if (_glID == 0)
@@ -24,6 +24,7 @@
 
 #include "Program.h"
 #include "GFXUtils.h"
+#include "base/CCGLUtils.h"
 
 #include <unordered_map>
 #include <stdlib.h>
@@ -281,6 +282,7 @@ void Program::link()
     }
 
     GLuint program = glCreateProgram();
+    ccProgramBinaryRetrievableHint(program);
     GL_CHECK(glAttachShader(program, vertShader));
     GL_CHECK(glAttachShader(program, fragShader));
     GL_CHECK(glLinkProgram(program));
@@ -303,7 +305,57 @@ void Program::link()
     glDeleteShader(fragShader);
 
     _glID = program;
+    parseProgram(program);
+    _linked = true;
+}
+
+bool Program::initWithBinary(DeviceGraphics* device, GLenum format, const void* binary, GLsizei length)
+{
+    assert(device);
+    assert(binary);
+
+    _device = device;
+    _id = _genID++;
+    _linked = false;
+
+    GLuint program = glCreateProgram();
+    GL_CHECK(ccProgramBinary(program, format, binary, length));
+
+    // The driver rejects binaries of another driver version, it is not an error.
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status == GL_FALSE)
+    {
+        glGetError();
+        glDeleteProgram(program);
+        return false;
+    }
+
+    _glID = program;
+    parseProgram(program);
+    _linked = true;
+    return true;
+}
 
+bool Program::getBinary(GLenum& format, std::vector<uint8_t>& binary) const
+{
+    if (!_linked || !ccIsProgramBinarySupported())
+        return false;
+
+    GLint length = 0;
+    GL_CHECK(glGetProgramiv(_glID, GL_PROGRAM_BINARY_LENGTH, &length));
+    if (length <= 0)
+        return false;
+
+    binary.resize(length);
+    GLsizei written = 0;
+    GL_CHECK(ccGetProgramBinary(_glID, length, &written, &format, binary.data()));
+    binary.resize(written);
+    return written > 0;
+}
+
+void Program::parseProgram(GLuint program)
+{
     // parse attribute
     GLint numAttributes;
     glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &numAttributes);
@@ -391,8 +443,16 @@ void Program::link()
             free(uniformName);
         }
     }
+}
 
-    _linked = true;
+bool Program::hasUniform(size_t hashName) const
+{
+    for (const auto& uniform : _uniforms)
+    {
+        if (uniform.hashName == hashName)
+            return true;
+    }
+    return false;
 }
 
 RENDERER_END
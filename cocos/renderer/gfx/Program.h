@@ -138,6 +138,10 @@ public:
      * Gets the uniforms used in the program
      */
     inline const std::vector<Uniform>& getUniforms() const { return _uniforms; }
+    /**
+     * Whether the uniform is used in the program
+     */
+    bool hasUniform(size_t hashName) const;
     /**
      * Indicates whether the program is successfully linked
      */
@@ -146,10 +150,26 @@ public:
      * Link the program with its shader sources
      */
     void link();
+    /**
+     * Initializes and links the program with a binary got from getBinary, returns false if the driver rejects it,
+     * then the program should be initialized and linked with its shader sources.
+     * Only available if ccIsProgramBinarySupported returns true.
+     * @param[in] device DeviceGraphics pointer
+     * @param[in] format Binary format
+     * @param[in] binary Binary data
+     * @param[in] length Binary length in bytes
+     */
+    bool initWithBinary(DeviceGraphics* device, GLenum format, const void* binary, GLsizei length);
+    /**
+     * Gets the binary of the linked program, returns false if the driver can not provide it
+     */
+    bool getBinary(GLenum& format, std::vector<uint8_t>& binary) const;
     
     inline size_t getHash() const { return _hash; }
     inline void setHash(size_t hash) { _hash = hash; }
 private:
+    void parseProgram(GLuint program);
+    
     DeviceGraphics* _device;
     std::vector<Attribute> _attributes;
     std::vector<Uniform> _uniforms;
@@ -158,6 +178,13 @@ private:
     uint32_t _id;
     bool _linked;
     size_t _hash = 0;
+    
+    // Index of each uniform in the uniform storage of DeviceGraphics, -1 if the device has no value for it.
+    std::vector<int> _uniformSlots;
+    // Uniform count of the device when the slots were resolved, the slots are resolved again when it changes.
+    size_t _uniformSlotsCount = (size_t)-1;
+    
+    friend class DeviceGraphics;
 };
 
 // end of gfx group
@@ -28,6 +28,7 @@
 #include "IndexBuffer.h"
 #include "Texture2D.h"
 #include "Program.h"
+#include <algorithm>
 
 RENDERER_BEGIN
 
@@ -36,6 +37,7 @@ State::State()
     _textureUnits.resize(10);
     _vertexBuffers.resize(10);
     _vertexBufferOffsets.resize(10);
+    _vertexBufferDivisors.resize(10);
     
     reset();
 }
@@ -91,6 +93,7 @@ void State::reset()
     stencilWriteMaskBack = 0xFF;
     // cull-mode
     cullMode = CullMode::BACK;
+    pipelineID = 0;
     
     // primitive-type
     primitiveType = PrimitiveType::TRIANGLES;
@@ -112,6 +115,7 @@ void State::reset()
         }
         _vertexBuffers[i] = nullptr;
     }
+    std::fill(_vertexBufferDivisors.begin(), _vertexBufferDivisors.end(), 0);
     
     if (_indexBuffer)
     {
@@ -126,6 +130,45 @@ void State::reset()
     _program = nullptr;
 }
 
+void State::copyPipelineStates(const State& o)
+{
+    // blend
+    blend = o.blend;
+    blendSeparation = o.blendSeparation;
+    blendColor = o.blendColor;
+    blendEq = o.blendEq;
+    blendAlphaEq = o.blendAlphaEq;
+    blendSrc = o.blendSrc;
+    blendDst = o.blendDst;
+    blendSrcAlpha = o.blendSrcAlpha;
+    blendDstAlpha = o.blendDstAlpha;
+    // depth
+    depthTest = o.depthTest;
+    depthWrite = o.depthWrite;
+    depthFunc = o.depthFunc;
+    // stencil
+    stencilTest = o.stencilTest;
+    stencilSeparation = o.stencilSeparation;
+    stencilFuncFront = o.stencilFuncFront;
+    stencilRefFront = o.stencilRefFront;
+    stencilMaskFront = o.stencilMaskFront;
+    stencilFailOpFront = o.stencilFailOpFront;
+    stencilZFailOpFront = o.stencilZFailOpFront;
+    stencilZPassOpFront = o.stencilZPassOpFront;
+    stencilWriteMaskFront = o.stencilWriteMaskFront;
+    stencilFuncBack = o.stencilFuncBack;
+    stencilRefBack = o.stencilRefBack;
+    stencilMaskBack = o.stencilMaskBack;
+    stencilFailOpBack = o.stencilFailOpBack;
+    stencilZFailOpBack = o.stencilZFailOpBack;
+    stencilZPassOpBack = o.stencilZPassOpBack;
+    stencilWriteMaskBack = o.stencilWriteMaskBack;
+    // cull-mode
+    cullMode = o.cullMode;
+    
+    pipelineID = o.pipelineID;
+}
+
 void State::setVertexBuffer(size_t index, VertexBuffer* vertBuf)
 {
     if (index >= _vertexBuffers.size())
@@ -166,6 +209,21 @@ int32_t State::getVertexBufferOffset(size_t index) const
     return _vertexBufferOffsets[index];
 }
 
+void State::setVertexBufferDivisor(size_t index, uint32_t divisor)
+{
+    if (index >= _vertexBufferDivisors.size())
+    {
+        _vertexBufferDivisors.resize(index + 1);
+    }
+
+    _vertexBufferDivisors[index] = divisor;
+}
+
+uint32_t State::getVertexBufferDivisor(size_t index) const
+{
+    return index < _vertexBufferDivisors.size() ? _vertexBufferDivisors[index] : 0;
+}
+
 void State::setIndexBuffer(IndexBuffer* indexBuf)
 {
     if (_indexBuffer != indexBuf)
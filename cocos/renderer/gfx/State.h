@@ -59,6 +59,10 @@ struct State final
      * Reset all states to default values
      */
     void reset();
+    /**
+     * Copies blend, depth, stencil and cull states and their hash
+     */
+    void copyPipelineStates(const State& o);
 
     /**
      @name Blend
@@ -206,6 +210,9 @@ struct State final
      */
     CullMode cullMode;
     
+    // Id of the blend, depth, stencil and cull states above, 0 means unknown.
+    uint32_t pipelineID;
+    
     /**
      * Specifies the primitive type for rendering
      */
@@ -231,6 +238,15 @@ struct State final
      */
     int32_t getVertexBufferOffset(size_t index) const;
 
+    /**
+     * Specifies the vertex buffer divisor, 0 means per vertex data, 1 means per instance data
+     */
+    void setVertexBufferDivisor(size_t index, uint32_t divisor);
+    /**
+     * Gets the vertex buffer divisor
+     */
+    uint32_t getVertexBufferDivisor(size_t index) const;
+
     /**
      * Specifies the index buffer
      */
@@ -266,6 +282,7 @@ struct State final
 private:
     std::vector<VertexBuffer*> _vertexBuffers;
     std::vector<int32_t> _vertexBufferOffsets;
+    std::vector<uint32_t> _vertexBufferDivisors;
     IndexBuffer *_indexBuffer = nullptr;
     std::vector<Texture*> _textureUnits;
     Program *_program = nullptr;
@@ -253,6 +253,14 @@ public:
      * Gets the height of texture
      */
     inline uint16_t getHeight() const { return _height; }
+    /**
+     * Gets the pixel format of the texel data
+     */
+    inline GLenum getGLFormat() const { return _glFormat; }
+    /**
+     * Whether the texture is compressed
+     */
+    inline bool isCompressed() const { return _compressed; }
 
 protected:
     
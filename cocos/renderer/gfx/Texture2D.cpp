@@ -122,6 +122,36 @@ void Texture2D::updateImage(const ImageOption& option)
     _device->restoreTexture(0);
 }
 
+bool Texture2D::copySubImage(const Texture2D* source, uint16_t srcX, uint16_t srcY, uint16_t dstX, uint16_t dstY, uint16_t width, uint16_t height)
+{
+    // Components of the destination must be available in the source frame buffer.
+    if (source == nullptr || source->_compressed || _compressed || source->_glFormat != _glFormat)
+        return false;
+    
+    GLuint fbo = 0;
+    GL_CHECK(glGenFramebuffers(1, &fbo));
+    GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, fbo));
+    GL_CHECK(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, source->_glID, 0));
+    
+    bool ok = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (ok)
+    {
+        GL_CHECK(glActiveTexture(GL_TEXTURE0));
+        GL_CHECK(glBindTexture(GL_TEXTURE_2D, _glID));
+        GL_CHECK(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, dstX, dstY, srcX, srcY, width, height));
+        _device->restoreTexture(0);
+    }
+    else
+    {
+        RENDERER_LOGW("texture-2d copy source can not be attached to a frame buffer.");
+    }
+    
+    GL_CHECK(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0));
+    _device->restoreFrameBuffer();
+    GL_CHECK(glDeleteFramebuffers(1, &fbo));
+    return ok;
+}
+
 // Private methods:
 
 void Texture2D::setSubImage(const SubImageOption& option)
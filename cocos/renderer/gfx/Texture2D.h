@@ -77,6 +77,11 @@ public:
      * @see Texture::ImageOption
      */
     void updateImage(const ImageOption& option);
+    /**
+     * Copies a sub area of the source texture into this texture on GPU, the source is read through a temporary frame buffer
+     * @return false if the source can not be attached to a frame buffer or has another format, such as a compressed texture
+     */
+    bool copySubImage(const Texture2D* source, uint16_t srcX, uint16_t srcY, uint16_t dstX, uint16_t dstY, uint16_t width, uint16_t height);
 
 private:
     void setSubImage(const SubImageOption& options);
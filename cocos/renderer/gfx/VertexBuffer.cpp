@@ -109,6 +109,55 @@ void VertexBuffer::update(uint32_t offset, const void* data, size_t dataByteLeng
     ccBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+void VertexBuffer::updateDiscard(const void* data, size_t dataByteLength, bool unsynchronized)
+{
+    if (_glID == 0)
+    {
+        RENDERER_LOGE("The buffer is destroyed");
+        return;
+    }
+
+    if (data == nullptr || dataByteLength == 0) return;
+
+    if (dataByteLength > _bytes)
+    {
+        _needExpandDataStore = true;
+        _bytes = (uint32_t)dataByteLength;
+        _numVertices = _bytes / _format->_bytes;
+    }
+
+    GLenum glUsage = (GLenum)_usage;
+    ccBindBuffer(GL_ARRAY_BUFFER, _glID);
+    if (_needExpandDataStore)
+    {
+        // A new data store has nothing in flight.
+        glBufferData(GL_ARRAY_BUFFER, _bytes, (const GLvoid*)data, glUsage);
+        _needExpandDataStore = false;
+    }
+    else
+    {
+        bool uploaded = false;
+        if (ccIsMapBufferRangeSupported())
+        {
+            GLbitfield access = GL_MAP_WRITE_BIT | (unsynchronized ? GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT : GL_MAP_INVALIDATE_BUFFER_BIT);
+            GLvoid* mapped = ccMapBufferRange(GL_ARRAY_BUFFER, 0, (GLsizeiptr)dataByteLength, access);
+            if (mapped)
+            {
+                memcpy(mapped, data, dataByteLength);
+                uploaded = ccUnmapBuffer(GL_ARRAY_BUFFER);
+            }
+        }
+
+        if (!uploaded)
+        {
+            // Orphans the old data store, the driver keeps it alive until pending draw calls finish.
+            glBufferData(GL_ARRAY_BUFFER, _bytes, nullptr, glUsage);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)dataByteLength, (const GLvoid*)data);
+        }
+    }
+    ccBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
 void VertexBuffer::destroy()
 {
     if (_glID == 0)
@@ -77,6 +77,14 @@ public:
      * @param[in] dataByteLength Data byte length to be updated.
      */
     void update(uint32_t offset, const void* data, size_t dataByteLength);
+    /**
+     * Replaces the whole content of the GL vertex buffer, the old content is discarded, so the upload never waits for draw calls still reading it.
+     * The data store is mapped and invalidated if the driver supports it, otherwise it is orphaned.
+     * @param[in] data Data to be updated.
+     * @param[in] dataByteLength Data byte length to be updated.
+     * @param[in] unsynchronized Skips the implicit synchronization of mapping, only pass true if the caller guarantees the GPU has finished with the buffer, by a fence like BufferRing.
+     */
+    void updateDiscard(const void* data, size_t dataByteLength, bool unsynchronized);
 
     /**
      * Gets the count of vertices
@@ -23,6 +23,8 @@
  ****************************************************************************/
 
 #include "VertexFormat.h"
+#include <algorithm>
+#include <string.h>
 
 RENDERER_BEGIN
 
@@ -80,15 +82,42 @@ VertexFormat::VertexFormat(const std::vector<Info>& infos)
     std::vector<Element*> elements;
 #endif
 
-    uint32_t offset = 0;
+    // Streams should be numbered from 0 without gap, or all attributes are kept in one stream.
+    uint32_t streamCount = 1;
+    std::vector<bool> usedStreams(MAX_STREAM_COUNT, false);
+    bool splitStreams = true;
+    for (const auto& info : infos)
+    {
+        if (info._stream >= MAX_STREAM_COUNT)
+        {
+            splitStreams = false;
+            break;
+        }
+        usedStreams[info._stream] = true;
+        streamCount = std::max(streamCount, info._stream + 1);
+    }
+    for (uint32_t i = 0; i < streamCount && splitStreams; ++i)
+    {
+        splitStreams = usedStreams[i];
+    }
+    if (!splitStreams)
+    {
+        RENDERER_LOGE("VertexFormat streams should be numbered from 0 to %u without gap, attributes are kept in one stream.", MAX_STREAM_COUNT - 1);
+        streamCount = 1;
+    }
+    _streamBytes.resize(streamCount, 0);
+
+    uint32_t packedOffset = 0;
     for (size_t i = 0, len = infos.size(); i < len; ++i)
     {
         const auto& info = infos[i];
+        uint32_t stream = splitStreams ? info._stream : 0;
         Element el;
         el.name = info._name;
-        el.offset = offset;
+        el.offset = _streamBytes[stream];
+        el.packedOffset = packedOffset;
         el.stride = 0;
-        el.stream = -1;
+        el.stream = stream;
         el.type = info._type;
         el.num = info._num;
         el.normalize = info._normalize;
@@ -98,14 +127,43 @@ VertexFormat::VertexFormat(const std::vector<Info>& infos)
         _attr2el[std::hash<std::string>{}(el.name)] = el;
         elements.push_back(&_attr2el[std::hash<std::string>{}(el.name)]);
 
+        if (!_copyRanges.empty() &&
+            _copyRanges.back().stream == stream &&
+            _copyRanges.back().srcOffset + _copyRanges.back().bytes == packedOffset &&
+            _copyRanges.back().dstOffset + _copyRanges.back().bytes == el.offset)
+        {
+            _copyRanges.back().bytes += el.bytes;
+        }
+        else
+        {
+            _copyRanges.push_back({ stream, packedOffset, (uint32_t)el.offset, el.bytes });
+        }
+
+        _streamBytes[stream] += el.bytes;
         _bytes += el.bytes;
-        offset += el.bytes;
+        packedOffset += el.bytes;
     }
 
     for (size_t i = 0, len = elements.size(); i < len; ++i)
     {
         auto& el = elements[i];
-        el->stride = _bytes;
+        el->stride = _streamBytes[el->stream];
+    }
+
+    if (streamCount > 1)
+    {
+        for (uint32_t stream = 0; stream < streamCount; ++stream)
+        {
+            std::vector<Info> streamInfos;
+            for (const auto& info : infos)
+            {
+                if (info._stream == stream)
+                {
+                    streamInfos.push_back(Info(info._name, info._type, info._num, info._normalize));
+                }
+            }
+            _streamFormats.push_back(new VertexFormat(streamInfos));
+        }
     }
 }
 
@@ -121,6 +179,15 @@ VertexFormat::VertexFormat(VertexFormat&& o)
         *this = std::move(o);
 }
 
+VertexFormat::~VertexFormat()
+{
+    for (auto fmt : _streamFormats)
+    {
+        fmt->release();
+    }
+    _streamFormats.clear();
+}
+
 VertexFormat& VertexFormat::operator=(const VertexFormat& o)
 {
     if (this != &o)
@@ -129,8 +196,19 @@ VertexFormat& VertexFormat::operator=(const VertexFormat& o)
         _attr2el = o._attr2el;
 #if GFX_DEBUG > 0
         _elements = o._elements;
-        _bytes = o._bytes;
 #endif
+        _bytes = o._bytes;
+        _streamBytes = o._streamBytes;
+        _copyRanges = o._copyRanges;
+        for (auto fmt : o._streamFormats)
+        {
+            fmt->retain();
+        }
+        for (auto fmt : _streamFormats)
+        {
+            fmt->release();
+        }
+        _streamFormats = o._streamFormats;
     }
     return *this;
 }
@@ -143,13 +221,46 @@ VertexFormat& VertexFormat::operator=(VertexFormat&& o)
         _attr2el = std::move(o._attr2el);
 #if GFX_DEBUG > 0
         _elements = std::move(o._elements);
+#endif
         _bytes = o._bytes;
         o._bytes = 0;
-#endif
+        _streamBytes = std::move(o._streamBytes);
+        _copyRanges = std::move(o._copyRanges);
+        _streamFormats.swap(o._streamFormats);
     }
     return *this;
 }
 
+VertexFormat* VertexFormat::getStreamFormat(uint32_t stream) const
+{
+    if (_streamFormats.empty())
+    {
+        return stream == 0 ? const_cast<VertexFormat*>(this) : nullptr;
+    }
+    return stream < _streamFormats.size() ? _streamFormats[stream] : nullptr;
+}
+
+void VertexFormat::copyStream(uint32_t stream, const uint8_t* src, uint8_t* dst, uint32_t vertexCount) const
+{
+    uint32_t dstStride = getStreamBytes(stream);
+    for (const auto& range : _copyRanges)
+    {
+        if (range.stream != stream)
+        {
+            continue;
+        }
+        
+        const uint8_t* from = src + range.srcOffset;
+        uint8_t* to = dst + range.dstOffset;
+        for (uint32_t i = 0; i < vertexCount; ++i)
+        {
+            memcpy(to, from, range.bytes);
+            from += _bytes;
+            to += dstStride;
+        }
+    }
+}
+
 const VertexFormat::Element* VertexFormat::getElement(size_t hashName) const
 {
     static const Element* INVALID_ELEMENT_VALUE = nullptr;
@@ -40,6 +40,8 @@ RENDERER_BEGIN
 
 /**
  * The vertex format defines the attributes and their data layout in the VertexBuffer\n
+ * Attributes can be split into several streams, every stream is stored in its own VertexBuffer,
+ * so the attributes which rarely change don't need to be uploaded with the others.\n
  * JS API: gfx.VertexFormat
  @code
  let vertexFmt = new gfx.VertexFormat([
@@ -47,6 +49,11 @@ RENDERER_BEGIN
      { name: gfx.ATTR_UV0, type: gfx.ATTR_TYPE_FLOAT32, num: 2 },
      { name: gfx.ATTR_COLOR, type: gfx.ATTR_TYPE_FLOAT32, num: 4, normalize: true },
  ]);
+ let splitFmt = new gfx.VertexFormat([
+     { name: gfx.ATTR_POSITION, type: gfx.ATTR_TYPE_FLOAT32, num: 2 },
+     { name: gfx.ATTR_UV0, type: gfx.ATTR_TYPE_FLOAT32, num: 2, stream: 1 },
+     { name: gfx.ATTR_COLOR, type: gfx.ATTR_TYPE_UINT8, num: 4, normalize: true, stream: 2 },
+ ]);
  @endcode
  */
 class VertexFormat : public Ref
@@ -64,18 +71,21 @@ public:
          * @param[in] type Data type of each component
          * @param[in] num Number of components per attribute
          * @param[in] normalized Whether integer data values should be normalized into a certain range when being casted to a float
+         * @param[in] stream Index of the stream which stores the attribute
          */
-        Info(const std::string& name, AttribType type, uint32_t num, bool normalize = false)
+        Info(const std::string& name, AttribType type, uint32_t num, bool normalize = false, uint32_t stream = 0)
         : _name(name)
         , _num(num)
         , _type(type)
         , _normalize(normalize)
+        , _stream(stream)
         {
         }
         std::string _name;
         uint32_t _num;
         AttribType _type;
         bool _normalize;
+        uint32_t _stream;
     };
 
     static Info INFO_END;
@@ -88,8 +98,9 @@ public:
     {
         Element()
         : offset(0)
+        , packedOffset(0)
         , stride(0)
-        , stream(-1)
+        , stream(0)
         , num(0)
         , bytes(0)
         , type(AttribType::INVALID)
@@ -106,13 +117,20 @@ public:
          */
         std::string name;
         /*
-         * Byte offset in each vertex data
+         * Byte offset in each vertex data of its stream
          */
         size_t offset;
+        /*
+         * Byte offset in the vertex which packs all streams in declaration order, it's the layout of the render datas
+         */
+        size_t packedOffset;
         /*
          * Specifies the offset in bytes between the beginning of consecutive vertex attributes
          */
         uint32_t stride;
+        /*
+         * Index of the stream which stores the attribute
+         */
         int32_t stream;
         /*
          * Number of components per attribute unit
@@ -149,6 +167,10 @@ public:
      * Move constructor
      */
     VertexFormat(VertexFormat&& o);
+    /*
+     * Destructor
+     */
+    ~VertexFormat();
 
     VertexFormat& operator=(const VertexFormat& o);
     VertexFormat& operator=(VertexFormat&& o);
@@ -163,9 +185,35 @@ public:
     const Element* getElement(size_t hashName) const;
     
     /**
-     * Gets total byte size of a vertex
+     * Gets total byte size of a vertex, including all streams
      */
     uint32_t getBytes() const { return _bytes; };
+    /**
+     * Gets the count of streams
+     */
+    uint32_t getStreamCount() const { return (uint32_t)_streamBytes.size(); };
+    /**
+     * Gets byte size of a vertex in the given stream
+     */
+    uint32_t getStreamBytes(uint32_t stream) const { return stream < _streamBytes.size() ? _streamBytes[stream] : 0; };
+    /**
+     * Gets the format of the attributes in the given stream, which is used by the VertexBuffer of the stream.
+     * It's the format itself if there is only one stream.
+     */
+    VertexFormat* getStreamFormat(uint32_t stream) const;
+    /**
+     * Copies the attributes of the given stream out of packed vertices.
+     * @param[in] stream Stream index
+     * @param[in] src Vertices which pack all streams in declaration order
+     * @param[in] dst Vertices of the stream
+     * @param[in] vertexCount Count of vertices to copy
+     */
+    void copyStream(uint32_t stream, const uint8_t* src, uint8_t* dst, uint32_t vertexCount) const;
+    
+    /*
+     * Max count of streams of a vertex format
+     */
+    static const uint32_t MAX_STREAM_COUNT = 4;
     
     /*
      * Builtin VertexFormat with 2d position, uv, color, color0 attributes
@@ -186,7 +234,19 @@ private:
 #if GFX_DEBUG > 0
     std::vector<Element> _elements;
 #endif
-    uint32_t _bytes;
+    uint32_t _bytes = 0;
+
+    // Attributes of a stream which are contiguous in both layouts are copied together.
+    struct CopyRange
+    {
+        uint32_t stream;
+        uint32_t srcOffset;
+        uint32_t dstOffset;
+        uint32_t bytes;
+    };
+    std::vector<uint32_t> _streamBytes;
+    std::vector<CopyRange> _copyRanges;
+    std::vector<VertexFormat*> _streamFormats;
 
     friend class VertexBuffer;
 };
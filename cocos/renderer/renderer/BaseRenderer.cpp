@@ -24,8 +24,14 @@
 
 #include "BaseRenderer.h"
 #include <new>
+#include <algorithm>
+#include <string.h>
+#include <cmath>
+#include <cfloat>
 #include "gfx/DeviceGraphics.h"
 #include "gfx/Texture2D.h"
+#include "gfx/VertexBuffer.h"
+#include "gfx/VertexFormat.h"
 #include "ProgramLib.h"
 #include "View.h"
 #include "Scene.h"
@@ -37,6 +43,10 @@
 #include "Model.h"
 #include "math/MathUtil.h"
 #include "Program.h"
+#include "../Profiler.h"
+
+// Initial capacity of the per instance vertex buffer, in instances.
+#define BASE_RENDERER_INSTANCE_CAPACITY 128
 
 RENDERER_BEGIN
 
@@ -59,6 +69,8 @@ const size_t BaseRenderer::cc_matWorldIT = std::hash<std::string>{}("cc_matWorld
 const size_t BaseRenderer::cc_matpProj = std::hash<std::string>{}("cc_matpProj");
 const size_t BaseRenderer::cc_matViewProj = std::hash<std::string>{}("cc_matViewProj");
 const size_t BaseRenderer::cc_cameraPos = std::hash<std::string>{}("cc_cameraPos");
+const std::string BaseRenderer::CC_USE_INSTANCING = "CC_USE_INSTANCING";
+const size_t BaseRenderer::CC_USE_INSTANCING_HASH = std::hash<std::string>{}(CC_USE_INSTANCING);
 
 const size_t BaseRenderer::cc_shadow_map[4] = {
     std::hash<std::string>{}("cc_shadow_map_0"),
@@ -73,7 +85,7 @@ BaseRenderer::BaseRenderer()
     _stageInfos = new RecyclePool<StageInfo>([]()mutable->StageInfo*{return new StageInfo();}, 10);
     _views = new RecyclePool<View>([]()mutable->View*{return new View();}, 8);
     
-    _tmpMat4 = new cocos2d::Mat4();
+    _instancingDefines[CC_USE_INSTANCING] = true;
 }
 
 BaseRenderer::~BaseRenderer()
@@ -96,8 +108,8 @@ BaseRenderer::~BaseRenderer()
     delete _views;
     _views = nullptr;
     
-    delete _tmpMat4;
-    _tmpMat4 = nullptr;
+    RENDERER_SAFE_RELEASE(_instanceBuffer);
+    _instanceBuffer = nullptr;
 }
 
 bool BaseRenderer::init(DeviceGraphics* device, std::vector<ProgramLib::Template>& programTemplates)
@@ -127,6 +139,8 @@ void BaseRenderer::registerStage(const std::string& name, const StageCallback& c
 
 void BaseRenderer::render(const View& view, const Scene* scene)
 {
+    _currentView = &view;
+    
     // setup framebuffer
     _device->setFrameBuffer(view.frameBuffer);
     
@@ -136,6 +150,9 @@ void BaseRenderer::render(const View& view, const Scene* scene)
                          view.rect.w,
                          view.rect.h);
     
+    // clear is clipped by scissor too
+    _device->disableScissorTest();
+    
     // setup clear
     Color4F clearColor;
     if (ClearFlag::COLOR & view.clearFlags)
@@ -182,7 +199,7 @@ void BaseRenderer::render(const View& view, const Scene* scene)
             stageItem.model = item->model;
             stageItem.ia = item->ia;
             stageItem.effect = item->effect;
-            stageItem.sortKey = -1;
+            stageItem.sortKey = 0;
             
             stageInfo->items.push_back(stageItem);
         }
@@ -200,6 +217,9 @@ void BaseRenderer::render(const View& view, const Scene* scene)
             fn(view, stageInfo->items);
         }
     }
+    
+    _device->disableScissorTest();
+    _currentView = nullptr;
 }
 
 void BaseRenderer::setProperty (const Effect::Property* prop)
@@ -272,20 +292,19 @@ void BaseRenderer::setProperty (const Effect::Property* prop)
 std::vector<const ValueMap*> BaseRenderer::__tmp_defines__;
 void BaseRenderer::draw(const StageItem& item)
 {
-    const Mat4& worldMatrix = item.model->getWorldMatrix();
-    _device->setUniformMat4(cc_matWorld, worldMatrix);
-    
-    _tmpMat4->set(worldMatrix);
-    _tmpMat4->inverse();
-    _tmpMat4->transpose();
-    _device->setUniformMat4(cc_matWorldIT, *_tmpMat4);
+    RENDERER_PROFILE_SCOPE(DRAW);
+    _device->setUniformMat4(cc_matWorld, item.model->getWorldMatrix());
+    commitScissor(item.model);
     
     auto ia = item.ia;
     // for each pass
     for (const auto& pass : item.passes)
     {
-        // set vertex buffer
-        _device->setVertexBuffer(0, ia->getVertexBuffer());
+        // set vertex buffers of all streams
+        for (uint32_t stream = 0, streamCount = ia->getStreamCount(); stream < streamCount; ++stream)
+        {
+            _device->setVertexBuffer(stream, ia->getStreamBuffer(stream));
+        }
         
         // set index buffer
         if (ia->_indexBuffer)
@@ -295,75 +314,306 @@ void BaseRenderer::draw(const StageItem& item)
         _device->setPrimitiveType(ia->_primitiveType);
         
         // get program
-        __tmp_defines__.clear();
-        __tmp_defines__.push_back(&_defines);
-        size_t definesHash = _definesHash;
-        pass->extractDefines(definesHash, __tmp_defines__);
-        
-        _program = _programLib->switchProgram(pass->getHashName(), definesHash, __tmp_defines__);
+        _program = switchProgram(pass, false);
         _device->setProgram(_program);
         
-        for (auto& uniform : _program->getUniforms())
+        // only programs which transform normals need it
+        if (_program->hasUniform(cc_matWorldIT))
         {
-            auto prop = pass->getProperty(uniform.hashName);
-            if (prop) {
-                setProperty(prop);
-            }
+            _device->setUniformMat4(cc_matWorldIT, item.model->getWorldMatrixIT());
         }
         
-        // cull mode
-        _device->setCullMode(pass->getCullMode());
+        commitPass(pass);
+        
+        // draw pass
+        _device->draw(ia->_start, ia->getPrimitiveCount());
         
-        // blend
-        if (pass->isBlend())
+        resetTextureUint();
+    }
+}
+
+std::size_t BaseRenderer::getInstancingCount(const std::vector<const StageItem*>& items, std::size_t start) const
+{
+    const StageItem& first = *items[start];
+    if (!_instancingEnabled || !_device->supportsInstancing() || !first.ia || !first.effect)
+        return 1;
+    
+    // Only programs which declare CC_USE_INSTANCING read the per instance attributes.
+    for (const auto& pass : first.passes)
+    {
+        if (!_programLib->hasDefine(pass->getHashName(), CC_USE_INSTANCING))
+            return 1;
+    }
+    
+    std::size_t end = start + 1;
+    for (std::size_t n = items.size(); end < n; ++end)
+    {
+        const StageItem& item = *items[end];
+        if (!item.effect || !item.ia)
+            break;
+        if (item.effect != first.effect && item.effect->getHash() != first.effect->getHash())
+            break;
+        if (item.passes.size() != first.passes.size() || !item.ia->isSameGeometry(*first.ia))
+            break;
+        if (!item.model->isSameScissor(*first.model))
+            break;
+    }
+    return end - start;
+}
+
+void BaseRenderer::drawInstanced(const std::vector<const StageItem*>& items, std::size_t start, std::size_t count)
+{
+    RENDERER_PROFILE_SCOPE(DRAW);
+    const StageItem& first = *items[start];
+    
+    // The shader may skip the instanced code path, then draw the items one by one.
+    for (const auto& pass : first.passes)
+    {
+        Program* program = switchProgram(pass, true);
+        bool hasMatWorld = false;
+        for (const auto& attr : program->getAttributes())
         {
-            _device->enableBlend();
-            _device->setBlendFuncSeparate(pass->getBlendSrc(),
-                                          pass->getBlendDst(),
-                                          pass->getBlendSrcAlpha(),
-                                          pass->getBlendDstAlpha());
-            _device->setBlendEquationSeparate(pass->getBlendEq(), pass->getBlendAlphaEq());
-            _device->setBlendColor(pass->getBlendColor());
+            if (attr.hashName == ATTRIB_NAME_MAT_WORLD0_HASH)
+            {
+                hasMatWorld = true;
+                break;
+            }
         }
-        
-        // depth test & write
-        if (pass->isDepthTest())
+        if (!hasMatWorld)
         {
-            _device->enableDepthTest();
-            _device->setDepthFunc(pass->getDepthFunc());
+            for (std::size_t i = start, end = start + count; i < end; ++i)
+            {
+                draw(*items[i]);
+            }
+            return;
         }
-        if (pass->isDepthWrite())
-            _device->enableDepthWrite();
+    }
+    
+    // fill per instance data
+    if (_instanceData.size() < count)
+        _instanceData.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Model* model = items[start + i]->model;
+        InstanceData& data = _instanceData[i];
+        memcpy(data.matWorld, model->getWorldMatrix().m, sizeof(data.matWorld));
         
-        // setencil
-        if (pass->isStencilTest())
+        // Node color is kept by js, only opacity is available in native.
+        const NodeProxy* node = model->getNode();
+        data.color[0] = data.color[1] = data.color[2] = 255;
+        data.color[3] = node ? node->getRealOpacity() : 255;
+    }
+    std::size_t instanceStart = uploadInstances(count);
+    commitScissor(first.model);
+    
+    auto ia = first.ia;
+    for (const auto& pass : first.passes)
+    {
+        // instance data follows the vertex streams
+        uint32_t streamCount = ia->getStreamCount();
+        for (uint32_t stream = 0; stream < streamCount; ++stream)
         {
-            _device->enableStencilTest();
-            
-            // front
-            _device->setStencilFuncFront(pass->getStencilFuncFront(),
-                                         pass->getStencilRefFront(),
-                                         pass->getStencilMaskFront());
-            _device->setStencilOpFront(pass->getStencilFailOpFront(),
-                                       pass->getStencilZFailOpFront(),
-                                       pass->getStencilZPassOpFront(),
-                                       pass->getStencilWriteMaskFront());
-            
-            // back
-            _device->setStencilFuncBack(pass->getStencilFuncBack(),
-                                        pass->getStencilRefBack(),
-                                        pass->getStencilMaskBack());
-            _device->setStencilOpBack(pass->getStencilFailOpBack(),
-                                      pass->getStencilZFailOpBack(),
-                                      pass->getStencilZPassOpBack(),
-                                      pass->getStencilWriteMaskBack());
+            _device->setVertexBuffer(stream, ia->getStreamBuffer(stream));
         }
+        _device->setInstanceBuffer(streamCount, _instanceBuffer, (int)instanceStart);
         
-        // draw pass
-        _device->draw(ia->_start, ia->getPrimitiveCount());
+        if (ia->_indexBuffer)
+            _device->setIndexBuffer(ia->_indexBuffer);
+        
+        _device->setPrimitiveType(ia->_primitiveType);
+        
+        _program = switchProgram(pass, true);
+        _device->setProgram(_program);
+        
+        commitPass(pass);
+        
+        _device->drawInstanced(ia->_start, ia->getPrimitiveCount(), (GLsizei)count);
         
         resetTextureUint();
     }
+    
+    _instancedDrawCount++;
+    _instanceCount += (uint32_t)count;
+}
+
+std::size_t BaseRenderer::uploadInstances(std::size_t count)
+{
+    const std::size_t stride = sizeof(InstanceData);
+    if (_instanceBuffer == nullptr)
+    {
+        std::vector<VertexFormat::Info> vfmt;
+        vfmt.push_back({ ATTRIB_NAME_MAT_WORLD0, AttribType::FLOAT32, 4 });
+        vfmt.push_back({ ATTRIB_NAME_MAT_WORLD1, AttribType::FLOAT32, 4 });
+        vfmt.push_back({ ATTRIB_NAME_MAT_WORLD2, AttribType::FLOAT32, 4 });
+        vfmt.push_back({ ATTRIB_NAME_MAT_WORLD3, AttribType::FLOAT32, 4 });
+        vfmt.push_back({ ATTRIB_NAME_INSTANCE_COLOR, AttribType::UINT8, 4, true });
+        
+        VertexFormat* fmt = new VertexFormat(vfmt);
+        _instanceBuffer = new VertexBuffer();
+        _instanceBuffer->init(_device, fmt, Usage::DYNAMIC, nullptr, 0, BASE_RENDERER_INSTANCE_CAPACITY);
+        fmt->release();
+    }
+    
+    if ((_instanceOffset + count) * stride > _instanceBuffer->getBytes())
+    {
+        // Reallocate a larger data store, draws issued before still read the old one.
+        std::size_t capacity = std::max(count, (std::size_t)_instanceBuffer->getCount()) * 2;
+        _instanceData.resize(capacity);
+        _instanceBuffer->update(0, _instanceData.data(), capacity * stride);
+        _instanceOffset = 0;
+    }
+    else
+    {
+        _instanceBuffer->update((uint32_t)(_instanceOffset * stride), _instanceData.data(), count * stride);
+    }
+    
+    std::size_t instanceStart = _instanceOffset;
+    _instanceOffset += count;
+    return instanceStart;
+}
+
+size_t BaseRenderer::extractDefines(const Pass* pass, bool instancing, std::vector<const ValueMap*>& defines) const
+{
+    defines.clear();
+    defines.push_back(&_defines);
+    size_t definesHash = _definesHash;
+    pass->extractDefines(definesHash, defines);
+    
+    if (instancing)
+    {
+        defines.push_back(&_instancingDefines);
+        MathUtil::combineHash(definesHash, CC_USE_INSTANCING_HASH);
+    }
+    return definesHash;
+}
+
+Program* BaseRenderer::switchProgram(const Pass* pass, bool instancing)
+{
+    size_t definesHash = extractDefines(pass, instancing, __tmp_defines__);
+    return _programLib->switchProgram(pass->getHashName(), definesHash, __tmp_defines__);
+}
+
+void BaseRenderer::precompile(EffectBase* effect)
+{
+    if (!effect)
+        return;
+    
+    bool instancing = _instancingEnabled && _device->supportsInstancing();
+    std::vector<ProgramLib::Variant> variants;
+    for (const auto& pass : effect->getPasses())
+    {
+        variants.emplace_back();
+        auto& variant = variants.back();
+        variant.programNameHash = pass->getHashName();
+        variant.definesKeyHash = extractDefines(pass, false, variant.definesList);
+        
+        if (instancing && _programLib->hasDefine(pass->getHashName(), CC_USE_INSTANCING))
+        {
+            variants.emplace_back();
+            auto& instancedVariant = variants.back();
+            instancedVariant.programNameHash = pass->getHashName();
+            instancedVariant.definesKeyHash = extractDefines(pass, true, instancedVariant.definesList);
+        }
+    }
+    _programLib->precompile(variants);
+}
+
+void BaseRenderer::commitScissor(const Model* model)
+{
+    if (!model->isScissorEnabled() || !_currentView)
+    {
+        _device->disableScissorTest();
+        return;
+    }
+    
+    // Masks only use scissor while the rectangle stays axis aligned in all views, so two corners give the screen rectangle.
+    const Rect& rect = model->getScissorRect();
+    const float* m = _currentView->matViewProj.m;
+    const Rect& viewport = _currentView->rect;
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (int i = 0; i < 2; ++i)
+    {
+        float x = rect.x + rect.w * i;
+        float y = rect.y + rect.h * i;
+        float z = model->getScissorZ();
+        float w = m[3] * x + m[7] * y + m[11] * z + m[15];
+        if (w == 0) w = 1;
+        float sx = viewport.x + ((m[0] * x + m[4] * y + m[8] * z + m[12]) / w * 0.5f + 0.5f) * viewport.w;
+        float sy = viewport.y + ((m[1] * x + m[5] * y + m[9] * z + m[13]) / w * 0.5f + 0.5f) * viewport.h;
+        minX = std::min(minX, sx);
+        minY = std::min(minY, sy);
+        maxX = std::max(maxX, sx);
+        maxY = std::max(maxY, sy);
+    }
+    
+    int x = (int)std::floor(minX + 0.5f);
+    int y = (int)std::floor(minY + 0.5f);
+    int w = std::max((int)std::floor(maxX + 0.5f) - x, 0);
+    int h = std::max((int)std::floor(maxY + 0.5f) - y, 0);
+    _device->setScissor(x, y, w, h);
+    _device->enableScissorTest();
+}
+
+void BaseRenderer::commitPass(const Pass* pass)
+{
+    for (auto prop : pass->getUniformBindings(_program))
+    {
+        if (prop) {
+            setProperty(prop);
+        }
+    }
+    
+    // The device keeps the states of the last draw if they are the same.
+    if (_device->setPipelineState(pass->getStateID()))
+        return;
+    
+    // cull mode
+    _device->setCullMode(pass->getCullMode());
+    
+    // blend
+    if (pass->isBlend())
+    {
+        _device->enableBlend();
+        _device->setBlendFuncSeparate(pass->getBlendSrc(),
+                                      pass->getBlendDst(),
+                                      pass->getBlendSrcAlpha(),
+                                      pass->getBlendDstAlpha());
+        _device->setBlendEquationSeparate(pass->getBlendEq(), pass->getBlendAlphaEq());
+        _device->setBlendColor(pass->getBlendColor());
+    }
+    
+    // depth test & write
+    if (pass->isDepthTest())
+    {
+        _device->enableDepthTest();
+        _device->setDepthFunc(pass->getDepthFunc());
+    }
+    if (pass->isDepthWrite())
+        _device->enableDepthWrite();
+    
+    // setencil
+    if (pass->isStencilTest())
+    {
+        _device->enableStencilTest();
+        
+        // front
+        _device->setStencilFuncFront(pass->getStencilFuncFront(),
+                                     pass->getStencilRefFront(),
+                                     pass->getStencilMaskFront());
+        _device->setStencilOpFront(pass->getStencilFailOpFront(),
+                                   pass->getStencilZFailOpFront(),
+                                   pass->getStencilZPassOpFront(),
+                                   pass->getStencilWriteMaskFront());
+        
+        // back
+        _device->setStencilFuncBack(pass->getStencilFuncBack(),
+                                    pass->getStencilRefBack(),
+                                    pass->getStencilMaskBack());
+        _device->setStencilOpBack(pass->getStencilFailOpBack(),
+                                  pass->getStencilZFailOpBack(),
+                                  pass->getStencilZPassOpBack(),
+                                  pass->getStencilWriteMaskBack());
+    }
 }
 
 // private functions
@@ -386,6 +636,11 @@ void BaseRenderer::reset()
 {
     _views->reset();
     _stageInfos->reset();
+    
+    _instanceOffset = 0;
+    _instancedDrawCount = 0;
+    _instanceCount = 0;
+    Model::resetInversionCount();
 }
 
 View* BaseRenderer::requestView()
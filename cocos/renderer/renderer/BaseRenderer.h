@@ -45,6 +45,8 @@ class InputAssembler;
 class Effect;
 class Technique;
 class Texture2D;
+class VertexBuffer;
+class Program;
 
 /**
  * @addtogroup renderer
@@ -63,7 +65,8 @@ public:
         InputAssembler *ia = nullptr;
         EffectVariant* effect = nullptr;
         std::vector<const Pass*> passes;
-        int sortKey = -1;
+        // Packed sort criteria, see ForwardRenderer for the key layouts.
+        uint64_t sortKey = 0;
     };
     typedef std::function<void(const View&, std::vector<StageItem>&)> StageCallback;
     /**
@@ -99,10 +102,52 @@ public:
      *  @return Program library pointer.
      */
     ProgramLib* getProgramLib() const { return _programLib; };
+    /**
+     *  @brief Enables or disables instanced drawing, consecutive stage items sharing the effect and the geometry are drawn in one draw call.
+     *  It falls back to one draw call per item if the device or the program doesn't support instancing.
+     */
+    void setInstancingEnabled(bool enabled) { _instancingEnabled = enabled; }
+    /**
+     *  @brief Whether instanced drawing is enabled.
+     */
+    bool isInstancingEnabled() const { return _instancingEnabled; }
+    /**
+     *  @brief Gets the count of instanced draw calls since last reset.
+     */
+    uint32_t getInstancedDrawCount() const { return _instancedDrawCount; }
+    /**
+     *  @brief Gets the count of models drawn by instanced draw calls since last reset.
+     */
+    uint32_t getInstanceCount() const { return _instanceCount; }
+    /**
+     *  @brief Gets the count of world matrix inversions for cc_matWorldIT since last reset.
+     */
+    uint32_t getWorldMatrixInversionCount() const { return Model::getInversionCount(); }
+    /**
+     *  @brief Compiles the programs used by all passes of the effect ahead, including the instanced variants, call it during loading.
+     *  Linked program binaries are cached on disk if the device supports it, so later runs link them without compiling.
+     */
+    void precompile(EffectBase* effect);
     
 protected:
     void render(const View&, const Scene* scene);
     void draw(const StageItem& item);
+    /**
+     *  @brief Gets how many items from start could be drawn in one instanced draw call, 1 means no instancing.
+     */
+    std::size_t getInstancingCount(const std::vector<const StageItem*>& items, std::size_t start) const;
+    /**
+     *  @brief Draws items in [start, start + count) in one instanced draw call per pass.
+     */
+    void drawInstanced(const std::vector<const StageItem*>& items, std::size_t start, std::size_t count);
+    Program* switchProgram(const Pass* pass, bool instancing);
+    size_t extractDefines(const Pass* pass, bool instancing, std::vector<const ValueMap*>& defines) const;
+    void commitPass(const Pass* pass);
+    /**
+     *  @brief Projects the scissor rectangle of the model by the current view, or disables scissor test if the model has none.
+     */
+    void commitScissor(const Model* model);
+    std::size_t uploadInstances(std::size_t count);
     void setProperty (const Effect::Property* prop);
     
     struct StageInfo
@@ -126,8 +171,23 @@ protected:
     RecyclePool<DrawItem>* _drawItems = nullptr;
     RecyclePool<StageInfo>* _stageInfos = nullptr;
     RecyclePool<View>* _views = nullptr;
-    
-    cocos2d::Mat4* _tmpMat4 = nullptr;
+    // The view being rendered, scissor rectangles of models are projected by it.
+    const View* _currentView = nullptr;
+
+    // Per instance attributes, matches the layout of the instance vertex format.
+    struct InstanceData
+    {
+        float matWorld[16];
+        uint8_t color[4];
+    };
+    bool _instancingEnabled = true;
+    VertexBuffer* _instanceBuffer = nullptr;
+    std::vector<InstanceData> _instanceData;
+    // Instances written to the instance buffer in this frame.
+    std::size_t _instanceOffset = 0;
+    uint32_t _instancedDrawCount = 0;
+    uint32_t _instanceCount = 0;
+    ValueMap _instancingDefines;
 
     CC_DISALLOW_COPY_ASSIGN_AND_MOVE(BaseRenderer);
     
@@ -155,6 +215,8 @@ protected:
     static const size_t cc_matpProj;
     static const size_t cc_matViewProj;
     static const size_t cc_cameraPos;
+    static const std::string CC_USE_INSTANCING;
+    static const size_t CC_USE_INSTANCING_HASH;
     
     static std::vector<const ValueMap*> __tmp_defines__;
 };
@@ -178,6 +178,10 @@ public:
      *  @brief Extracts the camera info to view.
      */
     void extractView(View& view, int width, int height);
+    /**
+     *  @brief Calculates the view projection matrix, the frame buffer size is used instead if the camera has one.
+     */
+    void calculateViewProjMatrix(Mat4& out, int width, int height);
     /**
      *  @brief Transform a screen position to world in the current camera projection.
      */
@@ -37,7 +37,9 @@
 #include "Pass.h"
 #include "Camera.h"
 #include "Light.h"
+#include "../Profiler.h"
 #include <algorithm>
+#include <string.h>
 
 #include "CCApplication.h"
 
@@ -47,6 +49,48 @@ RENDERER_BEGIN
 
 #define CC_MAX_LIGHTS 4
 #define CC_MAX_SHADOW_LIGHTS 2
+// Opaque items are sorted inside segments, and every segment gets one key prefix.
+#define CC_OPAQUE_SEGMENT_BITS 24
+
+namespace {
+    // Maps a float to an unsigned int which keeps the order of floats.
+    inline uint32_t floatToOrderedBits(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+    }
+    
+    // Folds a hash value into the given count of low bits.
+    inline uint64_t foldHash(uint64_t hash, uint32_t bits)
+    {
+        hash ^= hash >> 32;
+        hash ^= hash >> 16;
+        hash ^= hash >> 8;
+        return hash & ((1ull << bits) - 1);
+    }
+    
+    inline uint64_t getProgramHash(const cocos2d::renderer::Pass* pass)
+    {
+        size_t hash = pass->getHashName();
+        cocos2d::MathUtil::combineHash(hash, pass->getDefinesHash());
+        return hash;
+    }
+    
+    inline uint64_t getEffectHash(const cocos2d::renderer::EffectVariant* effect)
+    {
+        double hash = effect->getHash();
+        uint64_t bits;
+        memcpy(&bits, &hash, sizeof(bits));
+        return bits;
+    }
+    
+    // Multi-pass items are drawn before single-pass ones.
+    inline uint64_t getPassRank(size_t passCount)
+    {
+        return 3 - std::min(passCount, (size_t)3);
+    }
+}
 
 ForwardRenderer::ForwardRenderer()
 {
@@ -350,44 +394,100 @@ void ForwardRenderer::submitOtherStagesUniforms()
     _device->setUniformfv(cc_shadow_info, count * 4, shadowLightInfo, count);
 }
 
-bool ForwardRenderer::compareItems(const StageItem &a, const StageItem &b)
+float ForwardRenderer::getViewDepth(const StageItem& item, const Vec3& cameraPos, const Vec3& cameraForward)
 {
-    size_t pa = a.passes.size();
-    size_t pb = b.passes.size();
+    // TODO: we should use mesh center instead!
+    Vec3 position;
+    const NodeProxy* node = item.model->getNode();
+    if (node != nullptr)
+    {
+        node->getWorldPosition(&position);
+    }
     
-    if (pa != pb) {
-        return pa > pb;
+    Vec3::subtract(position, cameraPos, &position);
+    return -Vec3::dot(position, cameraForward);
+}
+
+bool ForwardRenderer::isOrderIndependent(const StageItem& item)
+{
+    // Items without depth write, blended or stencil items, like 2D items and the masks of StencilManager,
+    // depend on the submission order.
+    for (const auto pass : item.passes)
+    {
+        if (!pass->isDepthTest() || !pass->isDepthWrite() || pass->isBlend() || pass->isStencilTest())
+        {
+            return false;
+        }
     }
+    return true;
+}
+
+// Opaque key, from the most significant bit:
+// segment 24 | program 12 | effect 10 | geometry 8 | depth 10, near to far.
+// A segment is a run of order independent items, or a single order dependent item, numbered in submission order.
+// Inside a segment items sharing states are adjacent, and items sharing geometry too, so they can be instanced.
+uint64_t ForwardRenderer::getOpaqueSortKey(const StageItem& item, uint32_t segment, float depth)
+{
+    const Pass* pass = item.passes[0];
+    uint64_t geometry = item.ia ? (uint64_t)(uintptr_t)item.ia->getVertexBuffer() ^ (uint64_t)(uintptr_t)item.ia->getIndexBuffer() ^ (uint64_t)item.ia->getStart() : 0;
+    uint64_t depthBits = floatToOrderedBits(std::max(depth, 0.0f)) >> 22;
     
-    return a.sortKey > b.sortKey;
+    return (uint64_t)segment << 40 |
+           foldHash(getProgramHash(pass), 12) << 28 |
+           foldHash(getEffectHash(item.effect), 10) << 18 |
+           foldHash(geometry, 8) << 10 |
+           depthBits;
 }
 
-void ForwardRenderer::sortItems(std::vector<StageItem>& items)
+// Transparent key, from the most significant bit:
+// pass rank 2 | depth 32, far to near | submission index 30.
+// Depth must win for correct blending, items at the same depth keep the submission order.
+uint64_t ForwardRenderer::getTransparentSortKey(const StageItem& item, float depth, uint32_t index)
 {
-    std::sort(items.begin(), items.end(), compareItems);
+    uint64_t depthBits = ~floatToOrderedBits(depth);
+    
+    return getPassRank(item.passes.size()) << 62 |
+           depthBits << 30 |
+           (index & ((1u << 30) - 1));
 }
 
-void ForwardRenderer::drawItems(const std::vector<StageItem>& items)
+void ForwardRenderer::sortItems(const std::vector<StageItem>& items)
 {
-    size_t count = _shadowLights.size();
-    if (count == 0 && _numLights == 0)
+    RENDERER_PROFILE_SCOPE(SORT);
+    std::size_t count = items.size();
+    _sortEntries.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
     {
-        for (size_t i = 0, l = items.size(); i < l; i++)
-        {
-            draw(items.at(i));
-        }
+        _sortEntries[i].key = items[i].sortKey;
+        _sortEntries[i].index = (uint32_t)i;
     }
-    else
+    
+    radixSort(_sortEntries, _sortBuffer);
+    
+    _sortedItems.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
     {
-        for (const auto& item : items)
+        _sortedItems[i] = &items[_sortEntries[i].index];
+    }
+}
+
+void ForwardRenderer::drawItems(const std::vector<const StageItem*>& items)
+{
+    size_t count = _shadowLights.size();
+    for (size_t i = 0, l = items.size(); i < l;)
+    {
+        for (int j = 0; j < count; j++)
         {
-            for(int i = 0; i < count; i++)
-            {
-                Light* light = _shadowLights.at(i);
-                _device->setTexture(cc_shadow_map[i], light->getShadowMap(), allocTextureUnit());
-            }
-            draw(item);
+            Light* light = _shadowLights.at(j);
+            _device->setTexture(cc_shadow_map[j], light->getShadowMap(), allocTextureUnit());
         }
+        
+        size_t instances = getInstancingCount(items, i);
+        if (instances > 1)
+            drawInstanced(items, i, instances);
+        else
+            draw(*items[i]);
+        i += instances;
     }
 }
 
@@ -404,7 +504,39 @@ void ForwardRenderer::opaqueStage(const View& view, std::vector<StageItem>& item
     _device->setUniformVec4(cc_cameraPos, cameraPos4);
     submitLightsUniforms();
     submitOtherStagesUniforms();
-    drawItems(items);
+    
+    static Vec3 camFwd;
+    view.getForward(camFwd);
+    
+    // Too many segments for the key, keep the submission order.
+    std::size_t count = items.size();
+    if (count >= (1u << CC_OPAQUE_SEGMENT_BITS))
+    {
+        _sortedItems.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            _sortedItems[i] = &items[i];
+        }
+        drawItems(_sortedItems);
+        return;
+    }
+    
+    uint32_t segment = 0;
+    bool lastIndependent = false;
+    for (auto& item : items)
+    {
+        bool independent = isOrderIndependent(item);
+        if (!independent || !lastIndependent)
+        {
+            segment++;
+        }
+        lastIndependent = independent;
+        
+        item.sortKey = independent ? getOpaqueSortKey(item, segment, getViewDepth(item, cameraPos3, camFwd)) : (uint64_t)segment << 40;
+    }
+    
+    sortItems(items);
+    drawItems(_sortedItems);
 }
 
 void ForwardRenderer::shadowStage(const View& view, std::vector<StageItem>& items)
@@ -434,33 +566,21 @@ void ForwardRenderer::transparentStage(const View& view, const std::vector<Stage
     _device->setUniformVec4(cc_cameraPos, cameraPos4);
     
     static Vec3 camFwd;
-    static Vec3 tmpVec3;
     view.getForward(camFwd);
     
     submitLightsUniforms();
     submitOtherStagesUniforms();
     
-    NodeProxy* node;
     // calculate zdist
-    for (auto& item : const_cast<std::vector<StageItem>&>(items))
+    auto& stageItems = const_cast<std::vector<StageItem>&>(items);
+    for (std::size_t i = 0, count = stageItems.size(); i < count; ++i)
     {
-        // TODO: we should use mesh center instead!
-        node = const_cast<NodeProxy*>(item.model->getNode());
-        if (node != nullptr)
-        {
-            node->getWorldPosition(&tmpVec3);
-        }
-        else
-        {
-            tmpVec3.set(0, 0, 0);
-        }
-        
-        Vec3::subtract(tmpVec3, tmpVec3, &cameraPos3);
-        item.sortKey = -Vec3::dot(tmpVec3, camFwd);
+        auto& item = stageItems[i];
+        item.sortKey = getTransparentSortKey(item, getViewDepth(item, cameraPos3, camFwd), (uint32_t)i);
     }
     
-    sortItems(const_cast<std::vector<StageItem>&>(items));
-    drawItems(items);
+    sortItems(items);
+    drawItems(_sortedItems);
 }
 
 RENDERER_END
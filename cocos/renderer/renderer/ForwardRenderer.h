@@ -27,6 +27,7 @@
 #include "BaseRenderer.h"
 #include "Camera.h"
 #include "../memop/RecyclePool.hpp"
+#include "RadixSort.h"
 
 RENDERER_BEGIN
 
@@ -69,13 +70,16 @@ private:
     void submitLightsUniforms();
     void submitShadowStageUniforms(const View& view);
     void submitOtherStagesUniforms();
-    void sortItems(std::vector<StageItem>& items);
-    void drawItems(const std::vector<StageItem>& items);
+    void sortItems(const std::vector<StageItem>& items);
+    void drawItems(const std::vector<const StageItem*>& items);
     void opaqueStage(const View& view, std::vector<StageItem>& items);
     void shadowStage(const View& view, std::vector<StageItem>& items);
     void transparentStage(const View& view, const std::vector<StageItem>& items);
     void resetData();
-    static bool compareItems(const StageItem& a, const StageItem& b);
+    static float getViewDepth(const StageItem& item, const Vec3& cameraPos, const Vec3& cameraForward);
+    static bool isOrderIndependent(const StageItem& item);
+    static uint64_t getOpaqueSortKey(const StageItem& item, uint32_t segment, float depth);
+    static uint64_t getTransparentSortKey(const StageItem& item, float depth, uint32_t index);
     
     Vector<Light*> _directionalLights;
     Vector<Light*> _pointLights;
@@ -85,6 +89,11 @@ private:
     
     RecyclePool<float>* _arrayPool = nullptr;
     std::size_t _numLights = 0;
+    
+    std::vector<SortEntry> _sortEntries;
+    std::vector<SortEntry> _sortBuffer;
+    // Stage items in draw order, filled by sortItems.
+    std::vector<const StageItem*> _sortedItems;
 };
 
 // end of renderer group
@@ -46,6 +46,10 @@ InputAssembler::~InputAssembler()
 {
     RENDERER_SAFE_RELEASE(_vertexBuffer);
     RENDERER_SAFE_RELEASE(_indexBuffer);
+    for (uint32_t i = 1; i < _streamCount; ++i)
+    {
+        RENDERER_SAFE_RELEASE(_streamBuffers[i - 1]);
+    }
 }
 
 void InputAssembler::clear()
@@ -55,6 +59,11 @@ void InputAssembler::clear()
     
     _vertexBuffer = nullptr;
     _indexBuffer = nullptr;
+    for (uint32_t i = 1; i < _streamCount; ++i)
+    {
+        CC_SAFE_RELEASE_NULL(_streamBuffers[i - 1]);
+    }
+    _streamCount = 1;
     _primitiveType = PrimitiveType::TRIANGLES;
     _start = 0;
     _count = -1;
@@ -65,11 +74,25 @@ InputAssembler& InputAssembler::operator=(const InputAssembler& o)
     CC_SAFE_RELEASE(_vertexBuffer);
     CC_SAFE_RELEASE(_indexBuffer);
     
+    for (uint32_t i = 1; i < o._streamCount; ++i)
+    {
+        CC_SAFE_RETAIN(o._streamBuffers[i - 1]);
+    }
+    for (uint32_t i = 1; i < _streamCount; ++i)
+    {
+        CC_SAFE_RELEASE(_streamBuffers[i - 1]);
+    }
+    
     _vertexBuffer = o._vertexBuffer;
     _indexBuffer = o._indexBuffer;
     _start = o._start;
     _count = o._count;
     _primitiveType = o._primitiveType;
+    _streamCount = o._streamCount;
+    for (uint32_t i = 1; i < _streamCount; ++i)
+    {
+        _streamBuffers[i - 1] = o._streamBuffers[i - 1];
+    }
     
     CC_SAFE_RETAIN(_vertexBuffer);
     CC_SAFE_RETAIN(_indexBuffer);
@@ -82,16 +105,28 @@ InputAssembler& InputAssembler::operator=(InputAssembler&& o)
     CC_SAFE_RELEASE(_vertexBuffer);
     CC_SAFE_RELEASE(_indexBuffer);
     
+    for (uint32_t i = 1; i < _streamCount; ++i)
+    {
+        CC_SAFE_RELEASE(_streamBuffers[i - 1]);
+    }
+    
     _vertexBuffer = o._vertexBuffer;
     _indexBuffer = o._indexBuffer;
     _start = o._start;
     _count = o._count;
     _primitiveType = o._primitiveType;
+    _streamCount = o._streamCount;
+    for (uint32_t i = 1; i < _streamCount; ++i)
+    {
+        _streamBuffers[i - 1] = o._streamBuffers[i - 1];
+        o._streamBuffers[i - 1] = nullptr;
+    }
     
     o._indexBuffer = nullptr;
     o._vertexBuffer = nullptr;
     o._start = 0;
     o._count = -1;
+    o._streamCount = 1;
     
     return *this;
 }
@@ -113,6 +148,28 @@ void InputAssembler::setVertexBuffer(VertexBuffer* vb)
     RENDERER_SAFE_RETAIN(_vertexBuffer);
 }
 
+void InputAssembler::setStreamBuffer(uint32_t stream, VertexBuffer* vb)
+{
+    if (stream == 0)
+    {
+        setVertexBuffer(vb);
+        return;
+    }
+    if (stream >= VertexFormat::MAX_STREAM_COUNT)
+    {
+        RENDERER_LOGW("InputAssembler::setStreamBuffer stream %u is out of range.", stream);
+        return;
+    }
+    
+    RENDERER_SAFE_RETAIN(vb);
+    RENDERER_SAFE_RELEASE(_streamBuffers[stream - 1]);
+    _streamBuffers[stream - 1] = vb;
+    if (stream >= _streamCount)
+    {
+        _streamCount = stream + 1;
+    }
+}
+
 void InputAssembler::setIndexBuffer(IndexBuffer* ib)
 {
     RENDERER_SAFE_RELEASE(_indexBuffer);
@@ -134,11 +191,37 @@ uint32_t InputAssembler::getPrimitiveCount() const
 
 bool InputAssembler::isMergeable(const InputAssembler& ia) const
 {
-    if (_indexBuffer != ia._indexBuffer || _vertexBuffer != ia._vertexBuffer)
+    if (_indexBuffer != ia._indexBuffer || _vertexBuffer != ia._vertexBuffer || !isSameStreams(ia))
     {
         return false;
     }
     return (_start + _count) == ia._start;
 }
 
+bool InputAssembler::isSameGeometry(const InputAssembler& ia) const
+{
+    return _vertexBuffer == ia._vertexBuffer &&
+           _indexBuffer == ia._indexBuffer &&
+           _primitiveType == ia._primitiveType &&
+           _start == ia._start &&
+           _count == ia._count &&
+           isSameStreams(ia);
+}
+
+bool InputAssembler::isSameStreams(const InputAssembler& ia) const
+{
+    if (_streamCount != ia._streamCount)
+    {
+        return false;
+    }
+    for (uint32_t i = 1; i < _streamCount; ++i)
+    {
+        if (_streamBuffers[i - 1] != ia._streamBuffers[i - 1])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 RENDERER_END
@@ -26,6 +26,7 @@
 
 #include "../Types.h"
 #include "../Macro.h"
+#include "../gfx/VertexFormat.h"
 
 RENDERER_BEGIN
 
@@ -70,6 +71,18 @@ public:
      *  @brief Gets the vertex buffer.
      */
     inline VertexBuffer* getVertexBuffer() const { return _vertexBuffer; }
+    /**
+     *  @brief Sets the vertex buffer of a stream, the vertex buffer of stream 0 is the one set by setVertexBuffer.
+     */
+    void setStreamBuffer(uint32_t stream, VertexBuffer* vb);
+    /**
+     *  @brief Gets the vertex buffer of a stream.
+     */
+    inline VertexBuffer* getStreamBuffer(uint32_t stream) const { return stream == 0 ? _vertexBuffer : (stream < _streamCount ? _streamBuffers[stream - 1] : nullptr); }
+    /**
+     *  @brief Gets the count of vertex streams, it's 1 unless vertex buffers of other streams are set.
+     */
+    inline uint32_t getStreamCount() const { return _streamCount; }
     /**
      *  @brief Sets the index buffer.
      */
@@ -111,10 +124,19 @@ public:
      *  @brief Can be merge.
      */
     bool isMergeable(const InputAssembler& ia) const;
+    /**
+     *  @brief Whether draws the same primitives of the same buffers, then it can be instanced.
+     */
+    bool isSameGeometry(const InputAssembler& ia) const;
 private:
+    bool isSameStreams(const InputAssembler& ia) const;
+    
     friend class BaseRenderer;
     
     VertexBuffer* _vertexBuffer = nullptr;
+    // Vertex buffers of the streams after stream 0.
+    VertexBuffer* _streamBuffers[VertexFormat::MAX_STREAM_COUNT - 1] = {};
+    uint32_t _streamCount = 1;
     IndexBuffer* _indexBuffer = nullptr;
     PrimitiveType _primitiveType = PrimitiveType::TRIANGLES;
     int _start = 0;
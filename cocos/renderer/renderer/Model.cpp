@@ -28,6 +28,7 @@
 #include "../scene/NodeProxy.hpp"
 #include "../gfx/VertexBuffer.h"
 #include "math/MathUtil.h"
+#include <string.h>
 
 RENDERER_BEGIN
 
@@ -62,6 +63,8 @@ void ModelPool::returnModel(Model *model)
 
 // Implementation of Model
 
+uint32_t Model::_inversionCount = 0;
+
 Model::Model()
 {
 }
@@ -93,7 +96,43 @@ void Model::setNode(NodeProxy* node)
         CC_SAFE_RELEASE(_node);
         _node = node;
         CC_SAFE_RETAIN(_node);
+        _worldMatrixITDirty = true;
+    }
+}
+
+const Mat4& Model::getWorldMatrixIT()
+{
+    if (!_worldMatrixITDirty) return _worldMatrixIT;
+    _worldMatrixITDirty = false;
+    
+    if (_worldMatrix.isIdentity())
+    {
+        _worldMatrixIT.setIdentity();
+        return _worldMatrixIT;
+    }
+    
+    // The node caches the result only if the model uses its world matrix.
+    bool nodeMatrix = _node && memcmp(_node->getWorldMatrix().m, _worldMatrix.m, sizeof(_worldMatrix.m)) == 0;
+    if (nodeMatrix)
+    {
+        const Mat4* cached = _node->getCachedWorldMatrixIT();
+        if (cached)
+        {
+            _worldMatrixIT = *cached;
+            return _worldMatrixIT;
+        }
     }
+    
+    _worldMatrixIT = _worldMatrix;
+    _worldMatrixIT.inverse();
+    _worldMatrixIT.transpose();
+    _inversionCount++;
+    
+    if (nodeMatrix)
+    {
+        _node->setCachedWorldMatrixIT(_worldMatrixIT);
+    }
+    return _worldMatrixIT;
 }
 
 void Model::extractDrawItem(DrawItem& out) const
@@ -112,11 +151,29 @@ void Model::extractDrawItem(DrawItem& out) const
     out.effect = _effect;
 }
 
+void Model::setScissor(const Rect& rect, float z)
+{
+    _scissorEnabled = true;
+    _scissorRect = rect;
+    _scissorZ = z;
+}
+
+bool Model::isSameScissor(const Model& other) const
+{
+    if (_scissorEnabled != other._scissorEnabled) return false;
+    if (!_scissorEnabled) return true;
+    return _scissorZ == other._scissorZ &&
+        _scissorRect.x == other._scissorRect.x && _scissorRect.y == other._scissorRect.y &&
+        _scissorRect.w == other._scissorRect.w && _scissorRect.h == other._scissorRect.h;
+}
+
 void Model::reset()
 {
     CC_SAFE_RELEASE_NULL(_effect);
     CC_SAFE_RELEASE_NULL(_node);
     _inputAssembler.clear();
+    _worldMatrixITDirty = true;
+    _scissorEnabled = false;
 }
 
 RENDERER_END
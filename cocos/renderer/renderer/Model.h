@@ -31,6 +31,7 @@
 #include "base/ccCArray.h"
 #include "math/Mat4.h"
 #include "../Macro.h"
+#include "../Types.h"
 #include "InputAssembler.h"
 #include "../gfx/DeviceGraphics.h"
 #include "EffectVariant.hpp"
@@ -83,11 +84,24 @@ public:
     /**
      *  @brief Sets model matrix.
      */
-    inline void setWorldMatix(const Mat4& matrix) { _worldMatrix = matrix; }
+    inline void setWorldMatix(const Mat4& matrix) { _worldMatrix = matrix; _worldMatrixITDirty = true; }
     /**
      *  @brief Gets mode matrix.
      */
     inline const Mat4& getWorldMatrix() const { return _worldMatrix; }
+    /**
+     *  @brief Gets the inverse transpose of model matrix, it's used to transform normals.
+     *  It's calculated at most once per model, and reused from the node until the node moves.
+     */
+    const Mat4& getWorldMatrixIT();
+    /**
+     *  @brief Gets the count of model matrix inversions since last reset.
+     */
+    static uint32_t getInversionCount() { return _inversionCount; }
+    /**
+     *  @brief Resets the count of model matrix inversions.
+     */
+    static void resetInversionCount() { _inversionCount = 0; }
     /**
      *  @brief Sets culling mask.
      */
@@ -104,6 +118,10 @@ public:
      *  @brief Adds an effect.
      */
     void setEffect(EffectVariant* effect);
+    /**
+     *  @brief Gets the effect.
+     */
+    inline EffectVariant* getEffect() const { return _effect; }
     /**
      *  @brief Set user key.
      */
@@ -116,6 +134,30 @@ public:
      *  @brief Get node.
      */
     inline const NodeProxy* getNode() const { return _node; };
+    /**
+     *  @brief Clips the model to a world space rectangle on the plane z, it is projected to a scissor box by every view.
+     */
+    void setScissor(const Rect& rect, float z);
+    /**
+     *  @brief Removes the scissor rectangle.
+     */
+    inline void disableScissor() { _scissorEnabled = false; }
+    /**
+     *  @brief Is the model clipped by a scissor rectangle.
+     */
+    inline bool isScissorEnabled() const { return _scissorEnabled; }
+    /**
+     *  @brief Gets the world space scissor rectangle.
+     */
+    inline const Rect& getScissorRect() const { return _scissorRect; }
+    /**
+     *  @brief Gets the world z of the scissor rectangle.
+     */
+    inline float getScissorZ() const { return _scissorZ; }
+    /**
+     *  @brief Whether the two models are clipped by the same scissor rectangle or both not clipped.
+     */
+    bool isSameScissor(const Model& other) const;
     /**
      *  @brief Extract draw item for the given index during rendering process.
      */
@@ -127,14 +169,22 @@ public:
 private:
     friend class ModelPool;
     
+    static uint32_t _inversionCount;
+    
     NodeProxy* _node = nullptr;
     Mat4 _worldMatrix;
+    Mat4 _worldMatrixIT;
+    bool _worldMatrixITDirty = true;
     EffectVariant* _effect = nullptr;
     
     InputAssembler _inputAssembler;
     bool _dynamicIA = false;
     int _cullingMask = -1;
     int _userKey = -1;
+    
+    bool _scissorEnabled = false;
+    Rect _scissorRect;
+    float _scissorZ = 0;
 };
 
 // end of renderer group
@@ -24,6 +24,9 @@
 
 #include "Pass.h"
 #include "math/MathUtil.h"
+#include "../gfx/Program.h"
+#include <algorithm>
+#include <unordered_map>
 
 RENDERER_BEGIN
 
@@ -68,6 +71,7 @@ uint32_t* Pass::DEFAULT_STATES = new uint32_t[PASS_VALUE_LENGTH] {
     
 };
 
+uint32_t Pass::_versionCounter = 0;
 
 Pass::Pass(const std::string& programName, Pass* parent)
 : _programName(programName),
@@ -75,6 +79,7 @@ Pass::Pass(const std::string& programName, Pass* parent)
 {
     _hashName = std::hash<std::string>{}(programName);
     reset();
+    markBindingsDirty();
 }
 
 Pass::Pass(
@@ -103,6 +108,8 @@ void Pass::generateDefinesKey()
     
     _definesHash = 0;
     MathUtil::combineHash(_definesHash, std::hash<std::string>{}(key));
+    
+    markBindingsDirty();
 }
 
 void Pass::extractDefines(size_t& hash, std::vector<const ValueMap*>& defines) const
@@ -118,6 +125,7 @@ void Pass::extractDefines(size_t& hash, std::vector<const ValueMap*>& defines) c
 void Pass::setCullMode(CullMode cullMode)
 {
     _states[0] = (uint32_t)cullMode;
+    markStatesDirty();
 }
 
 void Pass::setBlend(bool blendTest,
@@ -137,6 +145,7 @@ void Pass::setBlend(bool blendTest,
     _states[6] = (uint32_t)blendSrcAlpha;
     _states[7] = (uint32_t)blendDstAlpha;
     _states[8] = (uint32_t)blendColor;
+    markStatesDirty();
 }
 
 void Pass::setDepth(bool depthTest, bool depthWrite, DepthFunc depthFunc)
@@ -144,6 +153,7 @@ void Pass::setDepth(bool depthTest, bool depthWrite, DepthFunc depthFunc)
     _states[9] = (uint32_t)depthTest;
     _states[10] = (uint32_t)depthWrite;
     _states[11] = (uint32_t)depthFunc;
+    markStatesDirty();
 }
 
 void Pass::setStencilFront(StencilFunc stencilFunc,
@@ -162,6 +172,7 @@ void Pass::setStencilFront(StencilFunc stencilFunc,
     _states[17] = (uint32_t)stencilZFailOp;
     _states[18] = (uint32_t)stencilZPassOp;
     _states[19] = (uint32_t)stencilWriteMask;
+    markStatesDirty();
 }
 
 void Pass::setStencilBack(StencilFunc stencilFunc,
@@ -180,6 +191,7 @@ void Pass::setStencilBack(StencilFunc stencilFunc,
     _states[24] = (uint32_t)stencilZFailOp;
     _states[25] = (uint32_t)stencilZPassOp;
     _states[26] = (uint32_t)stencilWriteMask;
+    markStatesDirty();
 }
 
 uint32_t Pass::getState(uint32_t index) const {
@@ -219,6 +231,9 @@ void Pass::copy(const Pass& pass)
     _definesHash = pass._definesHash;
     
     memcpy(_states, pass._states, PASS_VALUE_LENGTH * sizeof(uint32_t));
+    
+    markBindingsDirty();
+    markStatesDirty();
 }
 
 const Technique::Parameter* Pass::getProperty(const std::string& name) const
@@ -254,7 +269,17 @@ const Value* Pass::getDefine(const std::string& name) const
 
 void Pass::setProperty(size_t hashName, const Technique::Parameter& property)
 {
-    _properties[hashName] = property;
+    // Assigning to an existing property keeps its address, only a new key changes the bindings.
+    auto iter = _properties.find(hashName);
+    if (_properties.end() == iter)
+    {
+        _properties[hashName] = property;
+        markBindingsDirty();
+    }
+    else
+    {
+        iter->second = property;
+    }
 }
 
 void Pass::setProperty(size_t hashName, void* value)
@@ -268,6 +293,7 @@ void Pass::setProperty(size_t hashName, void* value)
         if (!parentProp) return;
         prop = &_properties[hashName];
         *prop = *parentProp;
+        markBindingsDirty();
     }
     else
     {
@@ -299,4 +325,82 @@ void Pass::define(const std::string& name, const Value& value)
     generateDefinesKey();
 }
 
+void Pass::markBindingsDirty()
+{
+    _bindingVersion = ++_versionCounter;
+}
+
+void Pass::markStatesDirty()
+{
+    _stateVersion = ++_versionCounter;
+}
+
+uint32_t Pass::getChainVersion(uint32_t Pass::*version) const
+{
+    // Every change takes a newer stamp, so the newest stamp in the chain changes whenever any pass in it changes.
+    uint32_t result = 0;
+    const Pass* pass = this;
+    while (pass) {
+        result = std::max(result, pass->*version);
+        pass = pass->_parent;
+    }
+    return result;
+}
+
+uint32_t Pass::getStateID() const
+{
+    uint32_t version = getChainVersion(&Pass::_stateVersion);
+    if (_stateID != 0 && _stateIDVersion == version)
+        return _stateID;
+    
+    // Ids are interned by the exact state values, so equal ids always mean equal states, unlike a hash.
+    // The number of distinct state combinations of a game is small, the table is never shrunk.
+    static std::unordered_map<std::string, uint32_t> ids;
+    uint32_t states[PASS_VALUE_LENGTH];
+    for (uint32_t i = 0; i < PASS_VALUE_LENGTH; ++i)
+    {
+        states[i] = getState(i);
+    }
+    // 0 means unknown states in DeviceGraphics, so ids start from 1.
+    auto result = ids.emplace(std::string((const char*)states, sizeof(states)), (uint32_t)ids.size() + 1);
+    _stateID = result.first->second;
+    _stateIDVersion = version;
+    return _stateID;
+}
+
+const std::vector<const Technique::Parameter*>& Pass::getUniformBindings(const Program* program) const
+{
+    uint32_t version = getChainVersion(&Pass::_bindingVersion);
+    UniformBinding* binding = nullptr;
+    for (auto& item : _uniformBindings)
+    {
+        // Compares the hash too, another program may be created at the address of a released one.
+        if (item.program == program && item.programHash == program->getHash())
+        {
+            binding = &item;
+            break;
+        }
+    }
+    
+    if (binding && binding->version == version)
+        return binding->properties;
+    
+    if (!binding)
+    {
+        _uniformBindings.emplace_back();
+        binding = &_uniformBindings.back();
+        binding->program = program;
+        binding->programHash = program->getHash();
+    }
+    
+    const auto& uniforms = program->getUniforms();
+    binding->version = version;
+    binding->properties.resize(uniforms.size());
+    for (std::size_t i = 0, n = uniforms.size(); i < n; ++i)
+    {
+        binding->properties[i] = getProperty(uniforms[i].hashName);
+    }
+    return binding->properties;
+}
+
 RENDERER_END
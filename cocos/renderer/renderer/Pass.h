@@ -32,6 +32,7 @@
 
 RENDERER_BEGIN
 
+class Program;
 /**
  * @addtogroup renderer
  * @{
@@ -68,6 +69,7 @@ public:
     inline const std::string& getProgramName() const { return _programName; }
     
     inline size_t getHashName() const { return _hashName; }
+    inline size_t getDefinesHash() const { return _definesHash; }
     
     void copy(const Pass& pass);
     
@@ -105,8 +107,8 @@ public:
                   DepthFunc depthFunc = DepthFunc::LESS);
     
     // stencil
-    inline void setStencilTest(bool value)     { _states[12] = value; }
-    inline void disableStencilTest()           { _states[12] = false; }
+    inline void setStencilTest(bool value)     { _states[12] = value; markStatesDirty(); }
+    inline void disableStencilTest()           { _states[12] = false; markStatesDirty(); }
     inline bool isStencilTest()                const { return getState(12); }
     
     // stencil front
@@ -144,14 +146,20 @@ public:
                         uint8_t stencilWriteMask = 0xff);
     
     uint32_t getState(uint32_t index) const;
+    /**
+     *  @brief Gets the id of cull, blend, depth and stencil states of the pass chain, never 0.
+     *  Passes share an id only if all these states are equal. It is looked up again only after a state of the pass or its parents is changed,
+     *  it should be called on the render thread.
+     */
+    uint32_t getStateID() const;
     
     // stage
     void setStage (const std::string& stage) { _stage = stage; }
     const std::string& getStage() const;
     
-    inline void reset () { memset(_states, -1, PASS_VALUE_LENGTH * sizeof(uint32_t)); }
+    inline void reset () { memset(_states, -1, PASS_VALUE_LENGTH * sizeof(uint32_t)); markStatesDirty(); }
     
-    inline void setParent(Pass* parent) { _parent = parent; }
+    inline void setParent(Pass* parent) { _parent = parent; markBindingsDirty(); markStatesDirty(); }
     inline const Pass* getParent() { return _parent; }
     
     void extractDefines (size_t& hash, std::vector<const ValueMap*>& defines) const;
@@ -168,7 +176,25 @@ public:
     
     const Value* getDefine(const std::string& name) const;
     void define(const std::string& name, const Value& value);
+    
+    /**
+     *  @brief Gets the properties of the program uniforms, in the same order as Program::getUniforms, nullptr if the pass has no such property.
+     *  The table is resolved once per program and resolved again after properties are added or defines are changed in the pass or its parents.
+     */
+    const std::vector<const Technique::Parameter*>& getUniformBindings(const Program* program) const;
 private:
+    struct UniformBinding
+    {
+        const Program* program = nullptr;
+        size_t programHash = 0;
+        uint32_t version = 0;
+        std::vector<const Technique::Parameter*> properties;
+    };
+    
+    void markBindingsDirty();
+    void markStatesDirty();
+    uint32_t getChainVersion(uint32_t Pass::*version) const;
+    
     std::string _programName = "";
     size_t _hashName = 0;
     
@@ -184,6 +210,14 @@ private:
     static uint32_t* DEFAULT_STATES;
     
     std::string _stage = "";
+    
+    // Stamps of the last change of the property set or defines, and of the states, taken from a global counter.
+    uint32_t _bindingVersion = 0;
+    uint32_t _stateVersion = 0;
+    mutable std::vector<UniformBinding> _uniformBindings;
+    mutable uint32_t _stateID = 0;
+    mutable uint32_t _stateIDVersion = 0;
+    static uint32_t _versionCounter;
 };
 
 // end of renderer group
@@ -0,0 +1,183 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ProgramCache.h"
+#include "platform/CCFileUtils.h"
+#include "base/CCThreadPool.h"
+
+#include <stdio.h>
+#include <memory>
+
+namespace {
+    const uint32_t PROGRAM_CACHE_MAGIC = 0x42504343; // "CCPB"
+    const uint32_t PROGRAM_CACHE_VERSION = 2;
+    
+    // Followed by the driver string, the key string and the binary.
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t driverLength;
+        uint32_t keyLength;
+        uint32_t format;
+        uint32_t length;
+    };
+    
+    std::string getGLString(GLenum name)
+    {
+        const char* str = (const char*)glGetString(name);
+        return str ? str : "";
+    }
+    
+    bool readString(FILE* fp, uint32_t length, const std::string& expected)
+    {
+        if (length != expected.size())
+            return false;
+        std::string str(length, '\0');
+        return fread(&str[0], 1, length, fp) == length && str == expected;
+    }
+}
+
+RENDERER_BEGIN
+
+ProgramCache::ProgramCache(const std::string& path)
+: _path(path)
+{
+    if (!_path.empty() && _path.back() != '/')
+        _path += '/';
+    
+    FileUtils::getInstance()->createDirectory(_path);
+    
+    _driver = getGLString(GL_VENDOR) + "\n" + getGLString(GL_RENDERER) + "\n" + getGLString(GL_VERSION);
+    
+    _threadPool = ThreadPool::newSingleThreadPool();
+}
+
+ProgramCache::~ProgramCache()
+{
+    // ThreadPool finishes the queued tasks before it returns.
+    delete _threadPool;
+    _threadPool = nullptr;
+}
+
+uint64_t ProgramCache::hash(const std::string& str, uint64_t seed)
+{
+    uint64_t hash = seed;
+    for (unsigned char c : str)
+    {
+        hash ^= c;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+std::string ProgramCache::getFilePath(const std::string& key) const
+{
+    char name[32] = {0};
+    snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)hash(key));
+    return _path + name;
+}
+
+bool ProgramCache::load(const std::string& key, GLenum& format, std::vector<uint8_t>& binary) const
+{
+    FILE* fp = fopen(getFilePath(key).c_str(), "rb");
+    if (!fp)
+        return false;
+    
+    FileHeader header;
+    bool ok = fread(&header, sizeof(header), 1, fp) == 1 &&
+              header.magic == PROGRAM_CACHE_MAGIC &&
+              header.version == PROGRAM_CACHE_VERSION &&
+              header.length > 0 &&
+              readString(fp, header.driverLength, _driver) &&
+              readString(fp, header.keyLength, key);
+    if (ok)
+    {
+        binary.resize(header.length);
+        ok = fread(binary.data(), 1, header.length, fp) == header.length;
+        format = (GLenum)header.format;
+    }
+    fclose(fp);
+    
+    if (!ok)
+        binary.clear();
+    return ok;
+}
+
+void ProgramCache::save(const std::string& key, GLenum format, std::vector<uint8_t>&& binary)
+{
+    if (binary.empty())
+        return;
+    
+    FileHeader header;
+    header.magic = PROGRAM_CACHE_MAGIC;
+    header.version = PROGRAM_CACHE_VERSION;
+    header.driverLength = (uint32_t)_driver.size();
+    header.keyLength = (uint32_t)key.size();
+    header.format = (uint32_t)format;
+    header.length = (uint32_t)binary.size();
+    
+    std::string filePath = getFilePath(key);
+    auto data = std::make_shared<std::vector<uint8_t>>(std::move(binary));
+    std::string driver = _driver;
+    _threadPool->pushTask([filePath, header, driver, key, data](int /*threadId*/) {
+        // Write to a temporary file and rename it, so readers never see a partial file.
+        std::string tmpPath = filePath + ".tmp";
+        FILE* fp = fopen(tmpPath.c_str(), "wb");
+        if (!fp)
+        {
+            RENDERER_LOGW("Failed to write program cache %s", filePath.c_str());
+            return;
+        }
+        
+        bool ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+                  fwrite(driver.data(), 1, driver.size(), fp) == driver.size() &&
+                  fwrite(key.data(), 1, key.size(), fp) == key.size() &&
+                  fwrite(data->data(), 1, data->size(), fp) == data->size();
+        ok = fclose(fp) == 0 && ok;
+        if (ok)
+        {
+#ifdef _WIN32
+            // rename fails on Windows if the file exists, a file rejected by load is replaced here.
+            ::remove(filePath.c_str());
+#endif
+            ok = rename(tmpPath.c_str(), filePath.c_str()) == 0;
+        }
+        if (!ok)
+        {
+            ::remove(tmpPath.c_str());
+            RENDERER_LOGW("Failed to write program cache %s", filePath.c_str());
+        }
+    });
+}
+
+void ProgramCache::remove(const std::string& key)
+{
+    std::string filePath = getFilePath(key);
+    _threadPool->pushTask([filePath](int /*threadId*/) {
+        ::remove(filePath.c_str());
+    });
+}
+
+RENDERER_END
@@ -0,0 +1,95 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "../Macro.h"
+#include "platform/CCGL.h"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace cocos2d {
+class ThreadPool;
+}
+
+RENDERER_BEGIN
+
+/**
+ * @addtogroup renderer
+ * @{
+ */
+
+/**
+ *  @brief Persistent cache of linked program binaries, stored as one file per program under the writable path.\n
+ *  Every file records the driver which produced it and the full key of the program, the file name is only a hash of the key,
+ *  so binaries of another driver or of a colliding key are treated as missing.
+ *  Reading is thread safe, writing and removing are done in order on a background thread.
+ */
+class ProgramCache final
+{
+public:
+    /**
+     *  @brief 64 bits FNV-1a hash, stable between runs and platforms unlike std::hash.
+     */
+    static uint64_t hash(const std::string& str, uint64_t seed = 0xcbf29ce484222325ull);
+    
+    /**
+     *  @brief Constructor, it should be called on the GL thread to identify the driver.
+     *  @param[in] path The directory to store binaries in, it is created if missing.
+     */
+    ProgramCache(const std::string& path);
+    /**
+     *  @brief The destructor, it waits for pending writes.
+     */
+    ~ProgramCache();
+    
+    /**
+     *  @brief Reads the binary of the key, it can be called from any thread.
+     *  @param[in] key The full key of the program, the template, its source digest and the defines.
+     *  @return false if no usable binary is cached.
+     */
+    bool load(const std::string& key, GLenum& format, std::vector<uint8_t>& binary) const;
+    /**
+     *  @brief Writes the binary of the key in background.
+     */
+    void save(const std::string& key, GLenum format, std::vector<uint8_t>&& binary);
+    /**
+     *  @brief Removes the binary of the key in background, used when the driver rejects it.
+     */
+    void remove(const std::string& key);
+private:
+    std::string getFilePath(const std::string& key) const;
+    
+    std::string _path;
+    // Vendor, renderer and version of the GL driver.
+    std::string _driver;
+    ThreadPool* _threadPool = nullptr;
+};
+
+// end of renderer group
+/// @}
+
+RENDERER_END
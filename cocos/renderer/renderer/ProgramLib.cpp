@@ -24,8 +24,12 @@
 #include "ProgramLib.h"
 #include "../gfx/Program.h"
 #include "gfx/DeviceGraphics.h"
+#include "ProgramCache.h"
+#include "../scene/JobSystem.hpp"
 
 #include "math/MathUtil.h"
+#include "base/CCGLUtils.h"
+#include "platform/CCFileUtils.h"
 
 #include <regex>
 #include <string>
@@ -168,10 +172,17 @@ ProgramLib::ProgramLib(DeviceGraphics* device, std::vector<Template>& templates)
     
     for (auto& templ : templates)
         define(templ.name, templ.vert, templ.frag, templ.defines);
+    
+    if (ccIsProgramBinarySupported())
+    {
+        _programCache = new ProgramCache(FileUtils::getInstance()->getWritablePath() + "program_cache/");
+    }
 }
 
 ProgramLib::~ProgramLib()
 {
+    delete _programCache;
+    _programCache = nullptr;
     RENDERER_SAFE_RELEASE(_device);
     _device = nullptr;
 }
@@ -230,13 +241,24 @@ void ProgramLib::define(const std::string& name, const std::string& vert, const
     templ.vert = newVert;
     templ.frag = newFrag;
     templ.defines = defines;
+    char digest[64] = {0};
+    snprintf(digest, sizeof(digest), "%016llx:%zu:%016llx:%zu",
+             (unsigned long long)ProgramCache::hash(newVert), newVert.size(),
+             (unsigned long long)ProgramCache::hash(newFrag), newFrag.size());
+    templ.sourceDigest = digest;
 }
 
-Program* ProgramLib::switchProgram(const size_t programNameHash, const size_t definesKeyHash, const std::vector<const ValueMap*>& definesList)
+size_t ProgramLib::getProgramHash(const size_t programNameHash, const size_t definesKeyHash) const
 {
     size_t programHash = 0;
     MathUtil::combineHash(programHash, programNameHash);
     MathUtil::combineHash(programHash, definesKeyHash);
+    return programHash;
+}
+
+Program* ProgramLib::switchProgram(const size_t programNameHash, const size_t definesKeyHash, const std::vector<const ValueMap*>& definesList)
+{
+    size_t programHash = getProgramHash(programNameHash, definesKeyHash);
     
     if (_current && _current->getHash() == programHash) {
         return _current;
@@ -252,23 +274,122 @@ Program* ProgramLib::switchProgram(const size_t programNameHash, const size_t de
     auto templIter = _templates.find(programNameHash);
     if (templIter != _templates.end())
     {
-        const auto& tmpl = templIter->second;
-        std::string customDef = generateDefines(definesList) + "\n";
-        std::string vert = replaceMacroNums(tmpl.vert, definesList);
-        vert = customDef + unrollLoops(vert);
-        std::string frag = replaceMacroNums(tmpl.frag, definesList);
-        frag = customDef + unrollLoops(frag);
+        ProgramSource source;
+        source.programHash = programHash;
+        source.tmpl = &templIter->second;
+        source.definesList = &definesList;
+        prepareSource(source);
+        program = createProgram(source);
+    }
+    
+    _current = program;
+
+    return program;
+}
+
+void ProgramLib::precompile(const std::vector<Variant>& variants)
+{
+    std::vector<ProgramSource> sources;
+    sources.reserve(variants.size());
+    for (const auto& variant : variants)
+    {
+        size_t programHash = getProgramHash(variant.programNameHash, variant.definesKeyHash);
+        if (_cache.find(programHash) != _cache.end())
+            continue;
         
-        program = new Program();
-        program->init(_device, vert.c_str(), frag.c_str());
-        program->link();
-        _cache.emplace(programHash, program);
+        auto templIter = _templates.find(variant.programNameHash);
+        if (templIter == _templates.end())
+            continue;
+        
+        bool duplicated = false;
+        for (const auto& source : sources)
+        {
+            if (source.programHash == programHash)
+            {
+                duplicated = true;
+                break;
+            }
+        }
+        if (duplicated)
+            continue;
         
-        program->setHash(programHash);
+        sources.emplace_back();
+        auto& source = sources.back();
+        source.programHash = programHash;
+        source.tmpl = &templIter->second;
+        source.definesList = &variant.definesList;
     }
     
-    _current = program;
+    if (sources.empty())
+        return;
+    
+    JobSystem::getInstance()->parallelFor(0, sources.size(), 1, [this, &sources](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            prepareSource(sources[i]);
+        }
+    });
+    
+    for (auto& source : sources)
+    {
+        createProgram(source);
+    }
+}
+
+void ProgramLib::prepareSource(ProgramSource& source) const
+{
+    if (_programCache)
+    {
+        source.cacheKey = source.tmpl->name + "\n" + source.tmpl->sourceDigest + "\n" + generateDefines(*source.definesList);
+        if (_programCache->load(source.cacheKey, source.binaryFormat, source.binary))
+            return;
+    }
+    
+    generateSource(source);
+}
 
+void ProgramLib::generateSource(ProgramSource& source) const
+{
+    const auto& tmpl = *source.tmpl;
+    const auto& definesList = *source.definesList;
+    std::string customDef = generateDefines(definesList) + "\n";
+    std::string vert = replaceMacroNums(tmpl.vert, definesList);
+    source.vert = customDef + unrollLoops(vert);
+    std::string frag = replaceMacroNums(tmpl.frag, definesList);
+    source.frag = customDef + unrollLoops(frag);
+}
+
+Program* ProgramLib::createProgram(ProgramSource& source)
+{
+    Program* program = new Program();
+    
+    bool linked = false;
+    if (!source.binary.empty())
+    {
+        linked = program->initWithBinary(_device, source.binaryFormat, source.binary.data(), (GLsizei)source.binary.size());
+        if (!linked)
+        {
+            // Made by an older driver, compile the sources and replace it.
+            _programCache->remove(source.cacheKey);
+            generateSource(source);
+        }
+    }
+    
+    if (!linked)
+    {
+        program->init(_device, source.vert.c_str(), source.frag.c_str());
+        program->link();
+        
+        GLenum format = 0;
+        std::vector<uint8_t> binary;
+        if (_programCache && program->isLinked() && program->getBinary(format, binary))
+        {
+            _programCache->save(source.cacheKey, format, std::move(binary));
+        }
+    }
+    
+    _cache.emplace(source.programHash, program);
+    program->setHash(source.programHash);
     return program;
 }
 
@@ -287,6 +408,22 @@ const Value* ProgramLib::getValueFromDefineList(const std::string& name, const s
     return nullptr;
 }
 
+bool ProgramLib::hasDefine(const size_t programNameHash, const std::string& name) const
+{
+    auto iter = _templates.find(programNameHash);
+    if (iter == _templates.end())
+        return false;
+
+    for (const auto& def : iter->second.defines)
+    {
+        const ValueMap& defMap = def.asValueMap();
+        auto nameIter = defMap.find("name");
+        if (nameIter != defMap.end() && nameIter->second.asString() == name)
+            return true;
+    }
+    return false;
+}
+
 uint32_t ProgramLib::getValueKey(const Value *v)
 {
     if (v->getType() == Value::Type::BOOLEAN)
@@ -26,6 +26,7 @@
 
 #include "../Macro.h"
 #include "base/CCValue.h"
+#include "platform/CCGL.h"
 
 #include <string>
 #include <vector>
@@ -35,6 +36,7 @@ RENDERER_BEGIN
 
 class DeviceGraphics;
 class Program;
+class ProgramCache;
 
 /**
  * @addtogroup renderer
@@ -57,6 +59,18 @@ public:
         std::string vert;
         std::string frag;
         ValueVector defines;
+        // Digest of the shader sources, part of the program cache key.
+        std::string sourceDigest;
+    };
+    
+    /**
+     *  @brief A program variant to precompile, the arguments of switchProgram.
+     */
+    struct Variant
+    {
+        size_t programNameHash = 0;
+        size_t definesKeyHash = 0;
+        std::vector<const ValueMap*> definesList;
     };
 
     /**
@@ -79,15 +93,45 @@ public:
      */
     Program* switchProgram(const size_t programNameHash, const size_t definesKeyHash, const std::vector<const ValueMap*>& definesList);
     
+    /**
+     *  @brief Compiles programs of the variants ahead, so that switchProgram does not stall on them later, call it during loading.
+     *  The shader sources are generated and the cached binaries are read in parallel, then the programs are linked on the calling GL thread.
+     */
+    void precompile(const std::vector<Variant>& variants);
+    
     const Value* getValueFromDefineList(const std::string& name, const std::vector<const ValueMap*>& definesList);
 
+    /**
+     *  @brief Whether the program template declares the define, for example CC_USE_INSTANCING.
+     */
+    bool hasDefine(const size_t programNameHash, const std::string& name) const;
+
 private:
+    struct ProgramSource
+    {
+        size_t programHash = 0;
+        // Template name, source digest and defines, stored in full by the program cache.
+        std::string cacheKey;
+        const Template* tmpl = nullptr;
+        const std::vector<const ValueMap*>* definesList = nullptr;
+        std::string vert;
+        std::string frag;
+        GLenum binaryFormat = 0;
+        std::vector<uint8_t> binary;
+    };
+    
     uint32_t getValueKey(const Value* v);
+    size_t getProgramHash(const size_t programNameHash, const size_t definesKeyHash) const;
+    // Thread safe, it reads the cached binary, or generates the sources if there is no binary.
+    void prepareSource(ProgramSource& source) const;
+    void generateSource(ProgramSource& source) const;
+    Program* createProgram(ProgramSource& source);
     
 private:
     DeviceGraphics* _device = nullptr;
     std::unordered_map<size_t, Template> _templates;
     std::unordered_map<uint64_t, Program*> _cache;
+    ProgramCache* _programCache = nullptr;
     
     Program* _current = nullptr;
 };
@@ -0,0 +1,115 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "../Macro.h"
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+
+// Below this count std::stable_sort is cheaper than clearing the radix histograms.
+#define CC_RADIX_SORT_MIN_COUNT 64
+
+RENDERER_BEGIN
+
+/**
+ * @addtogroup renderer
+ * @{
+ */
+
+/**
+ *  @brief A sort key and the index of the sorted element.
+ */
+struct SortEntry
+{
+    uint64_t key;
+    uint32_t index;
+};
+
+/**
+ *  @brief Sorts entries by key with a stable LSD radix sort, one byte per pass.
+ *  @param[in,out] entries The entries to sort.
+ *  @param[in] buffer Scratch buffer, kept by the caller to avoid allocations.
+ */
+inline void radixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& buffer)
+{
+    std::size_t count = entries.size();
+    if (count < CC_RADIX_SORT_MIN_COUNT)
+    {
+        std::stable_sort(entries.begin(), entries.end(), [](const SortEntry& a, const SortEntry& b) {
+            return a.key < b.key;
+        });
+        return;
+    }
+    
+    uint32_t histograms[8][256];
+    memset(histograms, 0, sizeof(histograms));
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        uint64_t key = entries[i].key;
+        for (int b = 0; b < 8; ++b)
+        {
+            histograms[b][(key >> (b * 8)) & 0xFF]++;
+        }
+    }
+    
+    buffer.resize(count);
+    SortEntry* src = entries.data();
+    SortEntry* dst = buffer.data();
+    for (int b = 0; b < 8; ++b)
+    {
+        uint32_t* histogram = histograms[b];
+        int shift = b * 8;
+        // All keys share this byte, nothing to move.
+        if (histogram[(src[0].key >> shift) & 0xFF] == count)
+            continue;
+        
+        uint32_t offset = 0;
+        for (int i = 0; i < 256; ++i)
+        {
+            uint32_t bucketCount = histogram[i];
+            histogram[i] = offset;
+            offset += bucketCount;
+        }
+        
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+    
+    if (src != entries.data())
+    {
+        memcpy(entries.data(), src, count * sizeof(SortEntry));
+    }
+}
+
+// end of renderer group
+/// @}
+
+RENDERER_END
@@ -0,0 +1,424 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "DynamicAtlasManager.hpp"
+#include "assembler/Assembler.hpp"
+#include "../gfx/Texture2D.h"
+#include "../gfx/DeviceGraphics.h"
+#include <algorithm>
+
+RENDERER_BEGIN
+
+DynamicAtlasManager* DynamicAtlasManager::_instance = nullptr;
+
+DynamicAtlasManager* DynamicAtlasManager::getInstance()
+{
+    if (_instance == nullptr)
+    {
+        _instance = new DynamicAtlasManager();
+    }
+    return _instance;
+}
+
+void DynamicAtlasManager::destroyInstance()
+{
+    if (_instance)
+    {
+        delete _instance;
+        _instance = nullptr;
+    }
+}
+
+DynamicAtlasManager::DynamicAtlasManager()
+{
+}
+
+DynamicAtlasManager::~DynamicAtlasManager()
+{
+    reset();
+}
+
+void DynamicAtlasManager::setMaxPageCount(uint8_t count)
+{
+    if (count < 1) count = 1;
+    _maxPageCount = count;
+    
+    // Frames keep the index of their page, so only the last pages could be removed.
+    while (_pages.size() > _maxPageCount && _pages.back().references == 0)
+    {
+        clearPage(_pages.size() - 1);
+        RENDERER_SAFE_RELEASE(_pages.back().texture);
+        _pages.pop_back();
+    }
+}
+
+void DynamicAtlasManager::reset()
+{
+    for (auto& page : _pages)
+    {
+        RENDERER_SAFE_RELEASE(page.texture);
+    }
+    _pages.clear();
+    _frames.clear();
+    _sourceFrames.clear();
+    _evictionCount = 0;
+}
+
+bool DynamicAtlasManager::createPage()
+{
+    Texture2D* texture = new (std::nothrow) Texture2D();
+    if (!texture)
+    {
+        return false;
+    }
+    
+    // Cleared texels, the padding around frames must be transparent.
+    std::vector<uint8_t> zeros((std::size_t)_pageSize * _pageSize * 4, 0);
+    Texture2D::Options options;
+    options.width = _pageSize;
+    options.height = _pageSize;
+    options.glInternalFormat = GL_RGBA;
+    options.glFormat = GL_RGBA;
+    options.glType = GL_UNSIGNED_BYTE;
+    options.bpp = 32;
+    options.wrapS = Texture2D::WrapMode::CLAMP;
+    options.wrapT = Texture2D::WrapMode::CLAMP;
+    options.images.emplace_back();
+    options.images.back().data = zeros.data();
+    options.images.back().length = zeros.size();
+    if (!texture->init(DeviceGraphics::getInstance(), options))
+    {
+        texture->release();
+        return false;
+    }
+    
+    _pages.emplace_back();
+    Page& page = _pages.back();
+    page.texture = texture;
+    page.skyline.emplace_back();
+    page.skyline.back().width = _pageSize;
+    return true;
+}
+
+void DynamicAtlasManager::clearPage(std::size_t index)
+{
+    Page& page = _pages[index];
+    for (auto frameID : page.frames)
+    {
+        auto found = _frames.find(frameID);
+        if (found == _frames.end()) continue;
+        
+        auto sourceFound = _sourceFrames.find(found->second.source);
+        if (sourceFound != _sourceFrames.end())
+        {
+            sourceFound->second.erase(found->second.sourceKey);
+            if (sourceFound->second.empty())
+            {
+                _sourceFrames.erase(sourceFound);
+            }
+        }
+        _frames.erase(found);
+    }
+    
+    // Texels are left as they are, they are overwritten by the new frames.
+    page.frames.clear();
+    page.skyline.clear();
+    page.skyline.emplace_back();
+    page.skyline.back().width = _pageSize;
+    page.lastUsed = 0;
+}
+
+bool DynamicAtlasManager::findPosition(const Page& page, uint16_t width, uint16_t height, std::size_t& bestNode, uint16_t& bestY) const
+{
+    bool found = false;
+    uint32_t bestTop = UINT32_MAX;
+    uint16_t bestWidth = UINT16_MAX;
+    const auto& skyline = page.skyline;
+    for (std::size_t i = 0, n = skyline.size(); i < n; ++i)
+    {
+        if ((uint32_t)skyline[i].x + width > _pageSize) break;
+        
+        // The frame rests on the highest node under it.
+        uint16_t y = 0;
+        uint32_t remain = width;
+        for (std::size_t j = i; j < n && remain > 0; ++j)
+        {
+            y = std::max(y, skyline[j].y);
+            remain -= std::min<uint32_t>(remain, skyline[j].width);
+        }
+        
+        // Bottom left, the lowest top wins, then the narrowest node wastes less.
+        uint32_t top = (uint32_t)y + height;
+        if (top > _pageSize) continue;
+        if (top < bestTop || (top == bestTop && skyline[i].width < bestWidth))
+        {
+            found = true;
+            bestTop = top;
+            bestWidth = skyline[i].width;
+            bestNode = i;
+            bestY = y;
+        }
+    }
+    return found;
+}
+
+void DynamicAtlasManager::addSkylineLevel(Page& page, std::size_t node, uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+{
+    auto& skyline = page.skyline;
+    SkylineNode level;
+    level.x = x;
+    level.y = y + height;
+    level.width = width;
+    skyline.insert(skyline.begin() + node, level);
+    
+    // Shrink or remove the nodes under the new level.
+    for (std::size_t i = node + 1; i < skyline.size();)
+    {
+        uint32_t levelEnd = (uint32_t)skyline[i - 1].x + skyline[i - 1].width;
+        SkylineNode& current = skyline[i];
+        if (current.x >= levelEnd) break;
+        
+        uint32_t shrink = levelEnd - current.x;
+        if (current.width <= shrink)
+        {
+            skyline.erase(skyline.begin() + i);
+            continue;
+        }
+        current.x += shrink;
+        current.width -= shrink;
+        break;
+    }
+    
+    // Merge neighbours at the same height.
+    for (std::size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+void DynamicAtlasManager::touch(const Frame& frame)
+{
+    _pages[frame.page].lastUsed = ++_useClock;
+}
+
+uint32_t DynamicAtlasManager::insert(Texture2D* texture, uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+{
+    if (!texture || width == 0 || height == 0) return 0;
+    
+    uint64_t key = ((uint64_t)x << 48) | ((uint64_t)y << 32) | ((uint64_t)width << 16) | height;
+    auto sourceFound = _sourceFrames.find(texture);
+    if (sourceFound != _sourceFrames.end())
+    {
+        auto found = sourceFound->second.find(key);
+        if (found != sourceFound->second.end())
+        {
+            touch(_frames[found->second]);
+            return found->second;
+        }
+    }
+    
+    if (!_enabled || width > _maxFrameSize || height > _maxFrameSize) return 0;
+    if ((uint32_t)x + width > texture->getWidth() || (uint32_t)y + height > texture->getHeight()) return 0;
+    // Pages are RGBA8, only a texture of the same format could be copied into them.
+    if (texture->isCompressed() || texture->getGLFormat() != GL_RGBA) return 0;
+    
+    uint16_t paddedWidth = std::min<uint32_t>((uint32_t)width + FRAME_PADDING, _pageSize);
+    uint16_t paddedHeight = std::min<uint32_t>((uint32_t)height + FRAME_PADDING, _pageSize);
+    
+    std::size_t pageIndex = _pages.size();
+    std::size_t node = 0;
+    uint16_t frameY = 0;
+    uint32_t bestTop = UINT32_MAX;
+    for (std::size_t i = 0, n = _pages.size(); i < n; ++i)
+    {
+        std::size_t pageNode = 0;
+        uint16_t pageY = 0;
+        if (findPosition(_pages[i], paddedWidth, paddedHeight, pageNode, pageY) && (uint32_t)pageY + paddedHeight < bestTop)
+        {
+            pageIndex = i;
+            node = pageNode;
+            frameY = pageY;
+            bestTop = (uint32_t)pageY + paddedHeight;
+        }
+    }
+    
+    if (pageIndex == _pages.size())
+    {
+        if (_pages.size() < _maxPageCount && createPage())
+        {
+            pageIndex = _pages.size() - 1;
+        }
+        else if (!_pages.empty())
+        {
+            // All pages are full, reuse the least recently used one which is not drawn.
+            for (std::size_t i = 0, n = _pages.size(); i < n; ++i)
+            {
+                if (_pages[i].references > 0) continue;
+                if (pageIndex == n || _pages[i].lastUsed < _pages[pageIndex].lastUsed) pageIndex = i;
+            }
+            if (pageIndex == _pages.size()) return 0;
+            clearPage(pageIndex);
+            _evictionCount++;
+        }
+        else
+        {
+            return 0;
+        }
+        
+        if (!findPosition(_pages[pageIndex], paddedWidth, paddedHeight, node, frameY)) return 0;
+    }
+    
+    Page& page = _pages[pageIndex];
+    uint16_t frameX = page.skyline[node].x;
+    if (!page.texture->copySubImage(texture, x, y, frameX, frameY, width, height)) return 0;
+    addSkylineLevel(page, node, frameX, frameY, paddedWidth, paddedHeight);
+    
+    uint32_t frameID = _nextFrameID++;
+    if (_nextFrameID == 0) _nextFrameID = 1;
+    
+    Frame& frame = _frames[frameID];
+    frame.source = texture;
+    frame.sourceKey = key;
+    frame.page = pageIndex;
+    frame.x = frameX;
+    frame.y = frameY;
+    frame.width = width;
+    frame.height = height;
+    frame.sourceX = x;
+    frame.sourceY = y;
+    frame.sourceWidth = texture->getWidth();
+    frame.sourceHeight = texture->getHeight();
+    
+    page.frames.push_back(frameID);
+    _sourceFrames[texture][key] = frameID;
+    touch(frame);
+    return frameID;
+}
+
+Texture2D* DynamicAtlasManager::getTexture(uint32_t frameID)
+{
+    auto found = _frames.find(frameID);
+    if (found == _frames.end()) return nullptr;
+    
+    touch(found->second);
+    return _pages[found->second.page].texture;
+}
+
+uint16_t DynamicAtlasManager::getFrameX(uint32_t frameID) const
+{
+    auto found = _frames.find(frameID);
+    return found != _frames.end() ? found->second.x : 0;
+}
+
+uint16_t DynamicAtlasManager::getFrameY(uint32_t frameID) const
+{
+    auto found = _frames.find(frameID);
+    return found != _frames.end() ? found->second.y : 0;
+}
+
+bool DynamicAtlasManager::remapUVs(uint32_t frameID, Assembler* assembler, std::size_t iaIndex)
+{
+    auto found = _frames.find(frameID);
+    if (found == _frames.end() || !assembler) return false;
+    
+    // texel = uv * source size, it moves by the offset between the frame and the source rectangle.
+    const Frame& frame = found->second;
+    float pageSize = (float)_pageSize;
+    float scaleU = frame.sourceWidth / pageSize;
+    float scaleV = frame.sourceHeight / pageSize;
+    float offsetU = ((float)frame.x - frame.sourceX) / pageSize;
+    float offsetV = ((float)frame.y - frame.sourceY) / pageSize;
+    assembler->remapUVs(iaIndex, scaleU, offsetU, scaleV, offsetV, frameID);
+    
+    touch(frame);
+    return true;
+}
+
+void DynamicAtlasManager::removeTexture(Texture2D* texture)
+{
+    auto sourceFound = _sourceFrames.find(texture);
+    if (sourceFound == _sourceFrames.end()) return;
+    
+    // The texels stay in the page until it is cleared, only the lookup is dropped.
+    // Referenced frames are still drawn, they are removed when the last reference is released.
+    for (const auto& iter : sourceFound->second)
+    {
+        auto found = _frames.find(iter.second);
+        if (found == _frames.end()) continue;
+        
+        found->second.source = nullptr;
+        if (found->second.references == 0)
+        {
+            removeFrame(iter.second);
+        }
+    }
+    _sourceFrames.erase(sourceFound);
+}
+
+void DynamicAtlasManager::removeFrame(uint32_t frameID)
+{
+    auto found = _frames.find(frameID);
+    if (found == _frames.end()) return;
+    
+    auto& frames = _pages[found->second.page].frames;
+    frames.erase(std::remove(frames.begin(), frames.end(), frameID), frames.end());
+    _frames.erase(found);
+}
+
+void DynamicAtlasManager::retainFrame(uint32_t frameID)
+{
+    if (!_instance || frameID == 0) return;
+    
+    auto found = _instance->_frames.find(frameID);
+    if (found == _instance->_frames.end()) return;
+    
+    found->second.references++;
+    _instance->_pages[found->second.page].references++;
+}
+
+void DynamicAtlasManager::releaseFrame(uint32_t frameID)
+{
+    if (!_instance || frameID == 0) return;
+    
+    auto found = _instance->_frames.find(frameID);
+    if (found == _instance->_frames.end() || found->second.references == 0) return;
+    
+    Frame& frame = found->second;
+    frame.references--;
+    _instance->_pages[frame.page].references--;
+    if (frame.references == 0 && !frame.source)
+    {
+        _instance->removeFrame(frameID);
+    }
+}
+
+RENDERER_END
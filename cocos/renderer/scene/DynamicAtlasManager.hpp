@@ -0,0 +1,222 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "../Macro.h"
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+
+RENDERER_BEGIN
+
+class Texture2D;
+class Assembler;
+
+/**
+ * @addtogroup scene
+ * @{
+ */
+
+/**
+ *  @brief Packs small textures into shared atlas pages at runtime, so that sprites from different textures use the same texture and could be batched.\n
+ *  Frames are packed with the skyline bottom left algorithm and copied on GPU, the source textures are not read back.
+ *  When all pages are full, the least recently used page without referenced frames is cleared, frames in it become invalid and should be inserted again.
+ *  A frame is referenced by every render data remapped into it, so a page drawn by live sprites is never cleared.\n
+ *  A frame is identified by the id returned by insert, the JS layer sets the page texture to the material and calls remapUVs after assembling vertices.
+ *  Only textures with the same format as the pages (RGBA) are packed, and sprites sharing a page should agree on premultiplied alpha.
+ */
+class DynamicAtlasManager
+{
+public:
+    static const uint16_t DEFAULT_PAGE_SIZE = 2048;
+    static const uint16_t DEFAULT_MAX_FRAME_SIZE = 512;
+    static const uint8_t DEFAULT_MAX_PAGE_COUNT = 4;
+    // Empty texels kept on the right and top of every frame, so linear filtering does not sample the neighbours.
+    static const uint16_t FRAME_PADDING = 2;
+    
+    static DynamicAtlasManager* getInstance();
+    static void destroyInstance();
+    
+    /**
+     *  @brief Enables or disables packing, inserted frames are kept if disabled.
+     */
+    void setEnabled(bool enabled) { _enabled = enabled; }
+    /**
+     *  @brief Is packing enabled.
+     */
+    bool isEnabled() const { return _enabled; }
+    /**
+     *  @brief Sets the maximum page count, pages over the count are cleared once their frames are not referenced.
+     */
+    void setMaxPageCount(uint8_t count);
+    /**
+     *  @brief Gets the maximum page count.
+     */
+    uint8_t getMaxPageCount() const { return _maxPageCount; }
+    /**
+     *  @brief Sets the maximum width and height of a frame to pack, larger frames batch well enough by themselves.
+     */
+    void setMaxFrameSize(uint16_t size) { _maxFrameSize = size; }
+    /**
+     *  @brief Gets the maximum width and height of a frame to pack.
+     */
+    uint16_t getMaxFrameSize() const { return _maxFrameSize; }
+    /**
+     *  @brief Gets the width and height of pages.
+     */
+    uint16_t getPageSize() const { return _pageSize; }
+    
+    /**
+     *  @brief Packs a rectangle of the texture, the same rectangle of the same texture is only packed once.
+     *  @param[in] texture Source texture.
+     *  @param[in] x Left of the rectangle in texels.
+     *  @param[in] y Bottom of the rectangle in texels, the same row order as the texture data.
+     *  @param[in] width Width of the rectangle in texels.
+     *  @param[in] height Height of the rectangle in texels.
+     *  @return Id of the frame, 0 if it is not packed.
+     */
+    uint32_t insert(Texture2D* texture, uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+    /**
+     *  @brief Whether the frame is still in a page.
+     */
+    bool isValid(uint32_t frameID) const { return _frames.find(frameID) != _frames.end(); }
+    /**
+     *  @brief Gets the page texture of the frame and marks the frame used, nullptr if the frame is invalid.
+     */
+    Texture2D* getTexture(uint32_t frameID);
+    /**
+     *  @brief Gets left of the frame in the page in texels.
+     */
+    uint16_t getFrameX(uint32_t frameID) const;
+    /**
+     *  @brief Gets bottom of the frame in the page in texels.
+     */
+    uint16_t getFrameY(uint32_t frameID) const;
+    /**
+     *  @brief Moves the uv of a render data from the source texture into the page, and marks the frame used.
+     *  The render data references the frame until it is remapped to another frame or the assembler is reset.
+     *  Call it every time the assembler writes vertices again, remapping the same vertices twice is harmless.
+     *  @param[in] frameID Id returned by insert.
+     *  @param[in] assembler The assembler whose render data is drawn with the source texture.
+     *  @param[in] iaIndex Render data index.
+     *  @return false if the frame is invalid.
+     */
+    bool remapUVs(uint32_t frameID, Assembler* assembler, std::size_t iaIndex);
+    /**
+     *  @brief Forgets all frames of the texture, call it before the texture is destroyed, so a new texture at the same address is not mistaken for it.
+     *  Referenced frames stay valid until they are released, their texels are in the page.
+     */
+    void removeTexture(Texture2D* texture);
+    /**
+     *  @brief Clears all pages and frames.
+     */
+    void reset();
+    /**
+     *  @brief Adds a reference to the frame, it is done by Assembler::remapUVs.
+     */
+    static void retainFrame(uint32_t frameID);
+    /**
+     *  @brief Drops a reference to the frame, it does nothing if the manager is destroyed.
+     */
+    static void releaseFrame(uint32_t frameID);
+    
+    /**
+     *  @brief Gets count of pages in use.
+     */
+    uint32_t getPageCount() const { return (uint32_t)_pages.size(); }
+    /**
+     *  @brief Gets count of valid frames.
+     */
+    uint32_t getFrameCount() const { return (uint32_t)_frames.size(); }
+    /**
+     *  @brief Gets count of pages cleared to make room since last reset.
+     */
+    uint32_t getEvictionCount() const { return _evictionCount; }
+private:
+    DynamicAtlasManager();
+    ~DynamicAtlasManager();
+    
+    struct Frame
+    {
+        Texture2D* source = nullptr;
+        uint64_t sourceKey = 0;
+        std::size_t page = 0;
+        uint16_t x = 0;
+        uint16_t y = 0;
+        uint16_t width = 0;
+        uint16_t height = 0;
+        uint16_t sourceX = 0;
+        uint16_t sourceY = 0;
+        uint16_t sourceWidth = 0;
+        uint16_t sourceHeight = 0;
+        uint32_t references = 0;
+    };
+    
+    // The top edge of packed frames over [x, x + width).
+    struct SkylineNode
+    {
+        uint16_t x = 0;
+        uint16_t y = 0;
+        uint16_t width = 0;
+    };
+    
+    struct Page
+    {
+        Texture2D* texture = nullptr;
+        std::vector<SkylineNode> skyline;
+        std::vector<uint32_t> frames;
+        uint64_t lastUsed = 0;
+        // Sum of the references to its frames, a referenced page is not cleared.
+        uint32_t references = 0;
+    };
+    
+    bool createPage();
+    void clearPage(std::size_t index);
+    bool findPosition(const Page& page, uint16_t width, uint16_t height, std::size_t& node, uint16_t& y) const;
+    void addSkylineLevel(Page& page, std::size_t node, uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+    void touch(const Frame& frame);
+    void removeFrame(uint32_t frameID);
+    
+    static DynamicAtlasManager* _instance;
+    
+    bool _enabled = true;
+    uint16_t _pageSize = DEFAULT_PAGE_SIZE;
+    uint16_t _maxFrameSize = DEFAULT_MAX_FRAME_SIZE;
+    uint8_t _maxPageCount = DEFAULT_MAX_PAGE_COUNT;
+    
+    std::vector<Page> _pages;
+    std::unordered_map<uint32_t, Frame> _frames;
+    // Frame ids of every source texture, keyed by the packed source rectangle.
+    std::unordered_map<const Texture2D*, std::unordered_map<uint64_t, uint32_t>> _sourceFrames;
+    uint32_t _nextFrameID = 1;
+    // Increases every time a frame is used, pages keep the value of their last use.
+    uint64_t _useClock = 0;
+    uint32_t _evictionCount = 0;
+};
+
+// end of scene group
+/// @}
+
+RENDERER_END
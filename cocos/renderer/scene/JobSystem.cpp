@@ -0,0 +1,219 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "JobSystem.hpp"
+#include <algorithm>
+
+// How many times an idle worker retries stealing before going to sleep.
+#define JOB_SYSTEM_SPIN_COUNT 64
+// Split a range into about this many jobs per thread, so that stealing can balance uneven jobs.
+#define JOB_SYSTEM_JOBS_PER_THREAD 4
+
+RENDERER_BEGIN
+
+JobSystem* JobSystem::_instance = nullptr;
+
+JobSystem::JobSystem(int workerCount)
+: _pendingJobs(0)
+, _finished(false)
+{
+    if (workerCount < 0)
+    {
+        workerCount = (int)std::thread::hardware_concurrency() - 1;
+    }
+    if (workerCount < 0) workerCount = 0;
+    if (workerCount > JOB_SYSTEM_MAX_WORKER_COUNT) workerCount = JOB_SYSTEM_MAX_WORKER_COUNT;
+
+    // One queue per worker, plus one shared by the threads out of the pool.
+    for (int i = 0; i <= workerCount; i++)
+    {
+        _queues.emplace_back(new WorkQueue());
+    }
+
+    // Workers wait for the sleep mutex before their first job, so _workerIDs is filled before any of them reads it.
+    std::lock_guard<std::mutex> lock(_sleepMutex);
+    _workers.resize(workerCount);
+    _workerIDs.resize(workerCount);
+    for (int i = 0; i < workerCount; i++)
+    {
+        _workers[i].reset(new std::thread(&JobSystem::workerLoop, this, i));
+        _workerIDs[i] = _workers[i]->get_id();
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _finished = true;
+        _sleepCV.notify_all();
+    }
+
+    for (auto& worker : _workers)
+    {
+        if (worker && worker->joinable())
+        {
+            worker->join();
+        }
+    }
+    _workers.clear();
+    _workerIDs.clear();
+    _queues.clear();
+}
+
+int JobSystem::getQueueIndex() const
+{
+    auto tid = std::this_thread::get_id();
+    for (std::size_t i = 0, n = _workerIDs.size(); i < n; i++)
+    {
+        if (_workerIDs[i] == tid) return (int)i;
+    }
+    return (int)_workerIDs.size();
+}
+
+void JobSystem::push(int queueIndex, const Job& job)
+{
+    auto& queue = *_queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.push_back(job);
+    _pendingJobs++;
+}
+
+bool JobSystem::pop(int queueIndex, Job& job)
+{
+    auto& queue = *_queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) return false;
+    job = queue.jobs.back();
+    queue.jobs.pop_back();
+    _pendingJobs--;
+    return true;
+}
+
+bool JobSystem::steal(int queueIndex, Job& job)
+{
+    for (std::size_t i = 1, n = _queues.size(); i < n; i++)
+    {
+        auto& queue = *_queues[(queueIndex + i) % n];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) continue;
+        job = queue.jobs.front();
+        queue.jobs.pop_front();
+        _pendingJobs--;
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::execute(const Job& job)
+{
+    (*job.func)(job.begin, job.end);
+    job.remain->fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::workerLoop(int queueIndex)
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+    }
+
+    Job job;
+    int spin = 0;
+    while (!_finished)
+    {
+        if (pop(queueIndex, job) || steal(queueIndex, job))
+        {
+            execute(job);
+            spin = 0;
+            continue;
+        }
+
+        if (++spin < JOB_SYSTEM_SPIN_COUNT)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        spin = 0;
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepCV.wait(lock, [this]() {
+            return _pendingJobs > 0 || _finished;
+        });
+    }
+}
+
+void JobSystem::parallelFor(std::size_t begin, std::size_t end, std::size_t grain, const RangeJob& job)
+{
+    if (end <= begin) return;
+
+    std::size_t count = end - begin;
+    if (grain == 0) grain = 1;
+    if (_workers.empty() || count <= grain)
+    {
+        job(begin, end);
+        return;
+    }
+
+    std::size_t jobSize = count / (getConcurrency() * JOB_SYSTEM_JOBS_PER_THREAD);
+    if (jobSize < grain) jobSize = grain;
+    std::size_t jobCount = (count + jobSize - 1) / jobSize;
+
+    std::atomic<std::size_t> remain(jobCount);
+    int queueIndex = getQueueIndex();
+
+    // Fork, the first job is kept for the calling thread.
+    Job item;
+    item.func = &job;
+    item.remain = &remain;
+    for (std::size_t i = jobCount - 1; i > 0; i--)
+    {
+        item.begin = begin + i * jobSize;
+        item.end = std::min(item.begin + jobSize, end);
+        push(queueIndex, item);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepCV.notify_all();
+    }
+
+    item.begin = begin;
+    item.end = std::min(begin + jobSize, end);
+    execute(item);
+
+    // Join, help the others until all forked jobs are finished.
+    while (remain.load(std::memory_order_acquire) > 0)
+    {
+        if (pop(queueIndex, item) || steal(queueIndex, item))
+        {
+            execute(item);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+RENDERER_END
@@ -0,0 +1,146 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "../Macro.h"
+#include <vector>
+#include <deque>
+#include <stdint.h>
+#include <functional>
+#include <thread>
+#include <memory>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+// Upper bound of worker threads, the calling thread always takes part in the work too.
+#define JOB_SYSTEM_MAX_WORKER_COUNT 15
+
+RENDERER_BEGIN
+
+/**
+ * @addtogroup scene
+ * @{
+ */
+
+/**
+ *  @brief A work-stealing job scheduler used by the native render flow.\n
+ *  Every worker owns a deque of jobs, it pops jobs from the back of its own deque and steals from the front of the others when idle.
+ *  The thread which calls parallelFor pushes the split range into its own deque and helps to execute jobs until the whole range is finished,
+ *  so parallelFor can be nested inside a running job without dead lock.
+ */
+class JobSystem
+{
+public:
+    /**
+     *  @brief Range job, it processes elements in [begin, end).
+     */
+    typedef std::function<void(std::size_t begin, std::size_t end)> RangeJob;
+
+    static JobSystem* getInstance()
+    {
+        if (_instance == nullptr)
+        {
+            _instance = new JobSystem();
+        }
+        return _instance;
+    }
+
+    static void destroyInstance()
+    {
+        if (_instance)
+        {
+            delete _instance;
+            _instance = nullptr;
+        }
+    }
+
+    /**
+     *  @brief The constructor.
+     *  @param[in] workerCount Worker thread count, -1 means hardware concurrency minus the calling thread.
+     */
+    JobSystem(int workerCount = -1);
+    /**
+     *  @brief The destructor, it joins all worker threads.
+     */
+    ~JobSystem();
+
+    /**
+     *  @brief Gets worker thread count, not including the calling thread.
+     */
+    int getWorkerCount() const { return (int)_workers.size(); }
+    /**
+     *  @brief Gets the count of threads which may run a job at the same time.
+     */
+    int getConcurrency() const { return (int)_workers.size() + 1; }
+
+    /**
+     *  @brief Fork jobs over [begin, end) and join them before return.
+     *  @param[in] begin Range begin.
+     *  @param[in] end Range end.
+     *  @param[in] grain The minimum element count of one job.
+     *  @param[in] job The job to run, it may be invoked by any thread.
+     */
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, const RangeJob& job);
+private:
+    struct Job
+    {
+        const RangeJob* func = nullptr;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        std::atomic<std::size_t>* remain = nullptr;
+    };
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    int getQueueIndex() const;
+    void push(int queueIndex, const Job& job);
+    bool pop(int queueIndex, Job& job);
+    bool steal(int queueIndex, Job& job);
+    void execute(const Job& job);
+    void workerLoop(int queueIndex);
+private:
+    static JobSystem* _instance;
+
+    std::vector<std::unique_ptr<std::thread>> _workers;
+    std::vector<std::thread::id> _workerIDs;
+    // The last queue is shared by threads out of the pool.
+    std::vector<std::unique_ptr<WorkQueue>> _queues;
+
+    std::atomic<int> _pendingJobs;
+    std::atomic<bool> _finished;
+
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCV;
+};
+
+// end of scene group
+/// @}
+
+RENDERER_END
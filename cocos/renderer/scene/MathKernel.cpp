@@ -0,0 +1,332 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "MathKernel.hpp"
+#include "NodeMemPool.hpp"
+
+#if MATH_KERNEL_SSE
+#include <xmmintrin.h>
+#if MATH_KERNEL_SSE2
+#include <emmintrin.h>
+#endif
+#elif MATH_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+RENDERER_BEGIN
+
+namespace {
+    inline bool isAffine(const cocos2d::Mat4& mat)
+    {
+        const float* m = mat.m;
+        return m[3] == 0.0f && m[7] == 0.0f && m[11] == 0.0f && m[15] == 1.0f;
+    }
+    
+    inline void transformPosition(float* p, uint32_t num, const cocos2d::Mat4& mat)
+    {
+        if (num == 3)
+        {
+            ((cocos2d::Vec3*)p)->transformMat4(*((cocos2d::Vec3*)p), mat);
+        }
+        else
+        {
+            const float* m = mat.m;
+            float x = p[0], y = p[1];
+            p[0] = m[0] * x + m[4] * y + m[12];
+            p[1] = m[1] * x + m[5] * y + m[13];
+        }
+    }
+    
+    inline void rebaseIndicesScalar(const uint16_t* src, uint16_t* dst, std::size_t count, uint16_t offset)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            dst[i] = (uint16_t)(src[i] + offset);
+        }
+    }
+}
+
+void MathKernel::composeLocalMatrix(const TRS* trs, bool is3D, cocos2d::Mat4* out)
+{
+    float sz = is3D ? trs->sz : 1.0f;
+    
+    float x2 = trs->qx + trs->qx;
+    float y2 = trs->qy + trs->qy;
+    float z2 = trs->qz + trs->qz;
+    
+    float xx2 = trs->qx * x2;
+    float yy2 = trs->qy * y2;
+    float zz2 = trs->qz * z2;
+    float xy2 = trs->qx * y2;
+    float xz2 = trs->qx * z2;
+    float yz2 = trs->qy * z2;
+    float wx2 = trs->qw * x2;
+    float wy2 = trs->qw * y2;
+    float wz2 = trs->qw * z2;
+    
+    float* m = out->m;
+    m[0] = (1.0f - yy2 - zz2) * trs->sx;
+    m[1] = (xy2 + wz2) * trs->sx;
+    m[2] = (xz2 - wy2) * trs->sx;
+    m[3] = 0.0f;
+    
+    m[4] = (xy2 - wz2) * trs->sy;
+    m[5] = (1.0f - xx2 - zz2) * trs->sy;
+    m[6] = (yz2 + wx2) * trs->sy;
+    m[7] = 0.0f;
+    
+    m[8] = (xz2 + wy2) * sz;
+    m[9] = (yz2 - wx2) * sz;
+    m[10] = (1.0f - xx2 - yy2) * sz;
+    m[11] = 0.0f;
+    
+    m[12] = trs->x;
+    m[13] = trs->y;
+    m[14] = is3D ? trs->z : 0.0f;
+    m[15] = 1.0f;
+}
+
+#if MATH_KERNEL_SSE || MATH_KERNEL_NEON
+
+#if MATH_KERNEL_SSE
+typedef __m128 vfloat;
+#define VLOAD(p) _mm_loadu_ps(p)
+#define VSET1(v) _mm_set1_ps(v)
+#define VADD(a, b) _mm_add_ps(a, b)
+#define VSUB(a, b) _mm_sub_ps(a, b)
+#define VMUL(a, b) _mm_mul_ps(a, b)
+#define VSTORE(p, v) _mm_storeu_ps(p, v)
+#else
+typedef float32x4_t vfloat;
+#define VLOAD(p) vld1q_f32(p)
+#define VSET1(v) vdupq_n_f32(v)
+#define VADD(a, b) vaddq_f32(a, b)
+#define VSUB(a, b) vsubq_f32(a, b)
+#define VMUL(a, b) vmulq_f32(a, b)
+#define VSTORE(p, v) vst1q_f32(p, v)
+#endif
+
+namespace {
+    inline void transpose4(vfloat& c0, vfloat& c1, vfloat& c2, vfloat& c3)
+    {
+#if MATH_KERNEL_SSE
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+#else
+        float32x4x2_t t01 = vtrnq_f32(c0, c1);
+        float32x4x2_t t23 = vtrnq_f32(c2, c3);
+        c0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+        c1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+        c2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+        c3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+#endif
+    }
+
+    // Lane i is a if is3D[i] is not 0, otherwise b.
+    inline vfloat select3D(const uint8_t is3D[MathKernel::BATCH_SIZE], vfloat a, vfloat b)
+    {
+#if MATH_KERNEL_SSE
+        __m128 mask = _mm_cmpneq_ps(_mm_set_ps(is3D[3], is3D[2], is3D[1], is3D[0]), _mm_setzero_ps());
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+#else
+        const uint32_t lanes[MathKernel::BATCH_SIZE] = { is3D[0], is3D[1], is3D[2], is3D[3] };
+        return vbslq_f32(vcgtq_u32(vld1q_u32(lanes), vdupq_n_u32(0)), a, b);
+#endif
+    }
+
+    // Writes four column vectors of BATCH_SIZE nodes, lane i of every vector belongs to node i.
+    inline void storeColumn(vfloat c0, vfloat c1, vfloat c2, vfloat c3, cocos2d::Mat4* const out[MathKernel::BATCH_SIZE], int column)
+    {
+        transpose4(c0, c1, c2, c3);
+        VSTORE(out[0]->m + column * 4, c0);
+        VSTORE(out[1]->m + column * 4, c1);
+        VSTORE(out[2]->m + column * 4, c2);
+        VSTORE(out[3]->m + column * 4, c3);
+    }
+}
+
+void MathKernel::composeLocalMatrix4(const TRS* const trs[BATCH_SIZE], const uint8_t is3D[BATCH_SIZE], cocos2d::Mat4* const out[BATCH_SIZE])
+{
+    // Transpose TRS of nodes into structure of arrays, TRS is 10 floats,
+    // so it is read as (x, y, z, qx), (qy, qz, qw, sx) and (qw, sx, sy, sz).
+    vfloat tx = VLOAD(&trs[0]->x), ty = VLOAD(&trs[1]->x), tz = VLOAD(&trs[2]->x), qx = VLOAD(&trs[3]->x);
+    transpose4(tx, ty, tz, qx);
+    vfloat qy = VLOAD(&trs[0]->qy), qz = VLOAD(&trs[1]->qy), qw = VLOAD(&trs[2]->qy), sx = VLOAD(&trs[3]->qy);
+    transpose4(qy, qz, qw, sx);
+    vfloat unused0 = VLOAD(&trs[0]->qw), unused1 = VLOAD(&trs[1]->qw), sy = VLOAD(&trs[2]->qw), sz = VLOAD(&trs[3]->qw);
+    transpose4(unused0, unused1, sy, sz);
+    
+    vfloat one = VSET1(1.0f), zero = VSET1(0.0f);
+    tz = select3D(is3D, tz, zero);
+    sz = select3D(is3D, sz, one);
+    
+    vfloat x2 = VADD(qx, qx);
+    vfloat y2 = VADD(qy, qy);
+    vfloat z2 = VADD(qz, qz);
+    
+    vfloat xx2 = VMUL(qx, x2);
+    vfloat yy2 = VMUL(qy, y2);
+    vfloat zz2 = VMUL(qz, z2);
+    vfloat xy2 = VMUL(qx, y2);
+    vfloat xz2 = VMUL(qx, z2);
+    vfloat yz2 = VMUL(qy, z2);
+    vfloat wx2 = VMUL(qw, x2);
+    vfloat wy2 = VMUL(qw, y2);
+    vfloat wz2 = VMUL(qw, z2);
+    
+    storeColumn(VMUL(VSUB(VSUB(one, yy2), zz2), sx), VMUL(VADD(xy2, wz2), sx), VMUL(VSUB(xz2, wy2), sx), zero, out, 0);
+    storeColumn(VMUL(VSUB(xy2, wz2), sy), VMUL(VSUB(VSUB(one, xx2), zz2), sy), VMUL(VADD(yz2, wx2), sy), zero, out, 1);
+    storeColumn(VMUL(VADD(xz2, wy2), sz), VMUL(VSUB(yz2, wx2), sz), VMUL(VSUB(VSUB(one, xx2), yy2), sz), zero, out, 2);
+    storeColumn(tx, ty, tz, one, out, 3);
+}
+
+void MathKernel::transformPositions(float* positions, std::size_t stride, std::size_t count, uint32_t num, const cocos2d::Mat4& mat)
+{
+    if (num != 2 && num != 3)
+        return;
+    
+    // Projective matrices need the division by w, which is rare for nodes.
+    if (num == 3 && !isAffine(mat))
+    {
+        for (std::size_t i = 0; i < count; ++i, positions += stride)
+        {
+            transformPosition(positions, num, mat);
+        }
+        return;
+    }
+    
+    const float* m = mat.m;
+    vfloat m0 = VSET1(m[0]), m1 = VSET1(m[1]), m2 = VSET1(m[2]);
+    vfloat m4 = VSET1(m[4]), m5 = VSET1(m[5]), m6 = VSET1(m[6]);
+    vfloat m8 = VSET1(m[8]), m9 = VSET1(m[9]), m10 = VSET1(m[10]);
+    vfloat m12 = VSET1(m[12]), m13 = VSET1(m[13]), m14 = VSET1(m[14]);
+    
+    // Gather BATCH_SIZE strided positions into structure of arrays, transform, then scatter them back.
+    float xs[BATCH_SIZE], ys[BATCH_SIZE], zs[BATCH_SIZE];
+    std::size_t i = 0;
+    for (; i + BATCH_SIZE <= count; i += BATCH_SIZE)
+    {
+        float* p[BATCH_SIZE] = { positions, positions + stride, positions + stride * 2, positions + stride * 3 };
+        for (int k = 0; k < BATCH_SIZE; ++k)
+        {
+            xs[k] = p[k][0];
+            ys[k] = p[k][1];
+        }
+        vfloat x = VLOAD(xs), y = VLOAD(ys);
+        
+        if (num == 3)
+        {
+            for (int k = 0; k < BATCH_SIZE; ++k)
+            {
+                zs[k] = p[k][2];
+            }
+            vfloat z = VLOAD(zs);
+            VSTORE(xs, VADD(VADD(VMUL(m0, x), VMUL(m4, y)), VADD(VMUL(m8, z), m12)));
+            VSTORE(ys, VADD(VADD(VMUL(m1, x), VMUL(m5, y)), VADD(VMUL(m9, z), m13)));
+            VSTORE(zs, VADD(VADD(VMUL(m2, x), VMUL(m6, y)), VADD(VMUL(m10, z), m14)));
+            for (int k = 0; k < BATCH_SIZE; ++k)
+            {
+                p[k][0] = xs[k];
+                p[k][1] = ys[k];
+                p[k][2] = zs[k];
+            }
+        }
+        else
+        {
+            VSTORE(xs, VADD(VADD(VMUL(m0, x), VMUL(m4, y)), m12));
+            VSTORE(ys, VADD(VADD(VMUL(m1, x), VMUL(m5, y)), m13));
+            for (int k = 0; k < BATCH_SIZE; ++k)
+            {
+                p[k][0] = xs[k];
+                p[k][1] = ys[k];
+            }
+        }
+        positions += stride * BATCH_SIZE;
+    }
+    
+    for (; i < count; ++i, positions += stride)
+    {
+        transformPosition(positions, num, mat);
+    }
+}
+
+#else
+
+void MathKernel::composeLocalMatrix4(const TRS* const trs[BATCH_SIZE], const uint8_t is3D[BATCH_SIZE], cocos2d::Mat4* const out[BATCH_SIZE])
+{
+    for (int i = 0; i < BATCH_SIZE; i++)
+    {
+        composeLocalMatrix(trs[i], is3D[i], out[i]);
+    }
+}
+
+void MathKernel::transformPositions(float* positions, std::size_t stride, std::size_t count, uint32_t num, const cocos2d::Mat4& mat)
+{
+    if (num != 2 && num != 3)
+        return;
+    
+    for (std::size_t i = 0; i < count; ++i, positions += stride)
+    {
+        transformPosition(positions, num, mat);
+    }
+}
+
+#endif
+
+#if MATH_KERNEL_SSE2 || MATH_KERNEL_NEON
+
+void MathKernel::rebaseIndices(const uint16_t* src, uint16_t* dst, std::size_t count, uint16_t offset)
+{
+    std::size_t i = 0;
+#if MATH_KERNEL_SSE
+    __m128i vOffset = _mm_set1_epi16((short)offset);
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(src + i + 8));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_add_epi16(a, vOffset));
+        _mm_storeu_si128((__m128i*)(dst + i + 8), _mm_add_epi16(b, vOffset));
+    }
+#else
+    uint16x8_t vOffset = vdupq_n_u16(offset);
+    for (; i + 16 <= count; i += 16)
+    {
+        uint16x8_t a = vld1q_u16(src + i);
+        uint16x8_t b = vld1q_u16(src + i + 8);
+        vst1q_u16(dst + i, vaddq_u16(a, vOffset));
+        vst1q_u16(dst + i + 8, vaddq_u16(b, vOffset));
+    }
+#endif
+    rebaseIndicesScalar(src + i, dst + i, count - i, offset);
+}
+
+#else
+
+void MathKernel::rebaseIndices(const uint16_t* src, uint16_t* dst, std::size_t count, uint16_t offset)
+{
+    rebaseIndicesScalar(src, dst, count, offset);
+}
+
+#endif
+
+RENDERER_END
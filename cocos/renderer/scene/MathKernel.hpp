@@ -0,0 +1,101 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "../Macro.h"
+#include <stdint.h>
+#include <stddef.h>
+#include "math/Mat4.h"
+
+// MSVC never defines __SSE__, SSE is always there on x64 and /arch:SSE or above on x86.
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MATH_KERNEL_SSE 1
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_KERNEL_SSE2 1
+#endif
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON) || defined(__aarch64__)
+#define MATH_KERNEL_NEON 1
+#endif
+
+RENDERER_BEGIN
+
+struct TRS;
+
+/**
+ * @addtogroup scene
+ * @{
+ */
+
+/**
+ *  @brief Batch math kernels used by the native render flow.\n
+ *  Every kernel has a SSE and a NEON implementation which process several elements at once, and a scalar fallback.
+ */
+class MathKernel
+{
+public:
+    /**
+     *  @brief Count of nodes composeLocalMatrix4 processes at once.
+     */
+    static const int BATCH_SIZE = 4;
+
+    /**
+     *  @brief Builds a local matrix from translation, rotation and scale in closed form.
+     *  The result equals to translate(x, y, z) * rotate(q) * scale(sx, sy, sz).
+     *  @param[in] trs Node transform, z and sz are ignored if not 3D.
+     *  @param[in] is3D Whether the node is a 3D node.
+     *  @param[out] out The local matrix.
+     */
+    static void composeLocalMatrix(const TRS* trs, bool is3D, cocos2d::Mat4* out);
+    /**
+     *  @brief Same as composeLocalMatrix but builds BATCH_SIZE matrices at once.
+     *  @param[in] trs Node transforms.
+     *  @param[in] is3D 3D flags of nodes.
+     *  @param[out] out The local matrices.
+     */
+    static void composeLocalMatrix4(const TRS* const trs[BATCH_SIZE], const uint8_t is3D[BATCH_SIZE], cocos2d::Mat4* const out[BATCH_SIZE]);
+    /**
+     *  @brief Transforms positions of interleaved vertices in place, BATCH_SIZE vertices at once.
+     *  Same results as Vec3::transformMat4 for 3 components and Mat4::transformPoint with z = 0 for 2 components.
+     *  @param[in,out] positions Position of the first vertex.
+     *  @param[in] stride Float count of one vertex.
+     *  @param[in] count Vertex count.
+     *  @param[in] num Position component count, 2 or 3, the float after a 2 components position is kept.
+     *  @param[in] mat The transform matrix.
+     */
+    static void transformPositions(float* positions, std::size_t stride, std::size_t count, uint32_t num, const cocos2d::Mat4& mat);
+    /**
+     *  @brief Copies indices and adds offset to every index, 16 indices at once.
+     *  @param[in] src Source indices.
+     *  @param[out] dst Destination indices, it should not overlap src.
+     *  @param[in] count Index count.
+     *  @param[in] offset The offset, the result wraps around as uint16_t.
+     */
+    static void rebaseIndices(const uint16_t* src, uint16_t* dst, std::size_t count, uint16_t offset);
+};
+
+// end of scene group
+/// @}
+
+RENDERER_END
@@ -27,6 +27,7 @@
 #include "ModelBatcher.hpp"
 #include "RenderFlow.hpp"
 #include "../gfx/DeviceGraphics.h"
+#include "../Profiler.h"
 
 #define MAX_VB_SIZE 1310700
 
@@ -36,14 +37,14 @@ MeshBuffer::MeshBuffer(ModelBatcher* batcher, VertexFormat* fmt)
 : _vertexFmt(fmt)
 , _batcher(batcher)
 {
-    _bytesPerVertex = _vertexFmt->getBytes();
+    _streamCount = _vertexFmt->getStreamCount();
+    _bytesPerVertex = _vertexFmt->getStreamBytes(0);
+    _streamPages.resize(_streamCount - 1);
     
-    DeviceGraphics* device = _batcher->getFlow()->getDevice();
-    _vb = VertexBuffer::create(device, _vertexFmt, Usage::DYNAMIC, nullptr, 0, 0);
-    _vbArr.pushBack(_vb);
-    
-    _ib = IndexBuffer::create(device, IndexFormat::UINT16, Usage::STATIC, nullptr, 0, 0);
-    _ib->retain();
+    // The other slots are created when the ring advances.
+    _ring = new BufferRing(_batcher->getFlow()->getDevice(), _vertexFmt->getStreamFormat(0));
+    _vb = _ring->getVertexBuffer();
+    _ib = _ring->getIndexBuffer();
     
     _vDataCount = MeshBuffer::INIT_VERTEX_COUNT * 4 * _bytesPerVertex / sizeof(float);
     _iDataCount = MeshBuffer::INIT_VERTEX_COUNT * 6;
@@ -54,14 +55,19 @@ MeshBuffer::MeshBuffer(ModelBatcher* batcher, VertexFormat* fmt)
 
 MeshBuffer::~MeshBuffer()
 {
-    for (std::size_t i = 0, n = _vbArr.size(); i < n; i++)
+    delete _ring;
+    _ring = nullptr;
+    
+    for (auto& pages : _streamPages)
     {
-         _vbArr.at(i)->destroy();
+        for (auto& page : pages)
+        {
+            delete[] page.data;
+            page.vb->destroy();
+            page.vb->release();
+        }
     }
-    _vbArr.clear();
-    
-    _ib->destroy();
-    _ib->release();
+    _streamPages.clear();
     
     if (iData)
     {
@@ -118,22 +124,17 @@ const MeshBuffer::OffsetInfo& MeshBuffer::requestStatic(uint32_t vertexCount, ui
     uint32_t byteOffset = _byteOffset + vertexCount * _bytesPerVertex;
     if (MAX_VB_SIZE < byteOffset)
     {
-        // Finish pre data.
+        // Finish pre data, deferred fills must be done before vData is reused.
         _batcher->flush();
-        _vb->update(0, vData, _byteOffset);
+        _batcher->flushFills();
+        RENDERER_PROFILE_SCOPE(BUFFER_UPLOAD);
+        _vb->updateDiscard(vData, _byteOffset, _ring->isUnsynchronized());
+        _batcher->addUploadedBytes(0, _byteOffset);
+        uploadStreams();
         
         // Prepare next data.
-        _vbPos++;
-        if (_vbPos >= _vbArr.size())
-        {
-            DeviceGraphics* device = _batcher->getFlow()->getDevice();
-            _vb = VertexBuffer::create(device, _vertexFmt, Usage::DYNAMIC, nullptr, 0, 0);
-            _vbArr.pushBack(_vb);
-        }
-        else
-        {
-            _vb = _vbArr.at(_vbPos);
-        }
+        _vb = _ring->nextVertexBuffer();
+        _vbPos = _ring->getVertexBufferPos();
         
         _byteStart = 0;
         _byteOffset = 0;
@@ -178,20 +179,160 @@ const MeshBuffer::OffsetInfo& MeshBuffer::requestStatic(uint32_t vertexCount, ui
     _indexOffset += indexCount;
     _byteOffset = byteOffset;
     _dirty = true;
+    _requestVertexCount = vertexCount;
+    _offsetInfo.streams = (1u << _streamCount) - 1;
+    reserveStreams();
+    return _offsetInfo;
+}
+
+const MeshBuffer::OffsetInfo& MeshBuffer::commitStreams(const void* owner, std::size_t index, uint32_t dirtyStreams)
+{
+    if (_streamCount == 1)
+    {
+        return _offsetInfo;
+    }
+    
+    if (_pageRecords.size() <= _vbPos)
+    {
+        _pageRecords.resize(_vbPos + 1);
+    }
+    auto& records = _pageRecords[_vbPos];
+    
+    FillRecord record = { owner, index, _offsetInfo.vertex, _requestVertexCount };
+    std::size_t pos = records.current.size();
+    records.current.push_back(record);
+    
+    // The data of the range is left by the same owner in the last frame, only dirty streams need to be written.
+    if (pos < records.last.size())
+    {
+        const FillRecord& last = records.last[pos];
+        if (last.owner == owner && last.index == index && last.vertex == record.vertex && last.count == record.count)
+        {
+            _offsetInfo.streams &= dirtyStreams | 1u;
+        }
+    }
+    
+    for (uint32_t stream = 1; stream < _streamCount; ++stream)
+    {
+        if (_offsetInfo.streams & (1u << stream))
+        {
+            _streamPages[stream - 1][_vbPos].dirty = true;
+        }
+    }
     return _offsetInfo;
 }
 
+void MeshBuffer::reserveStreams()
+{
+    if (_streamCount == 1)
+    {
+        return;
+    }
+    
+    DeviceGraphics* device = _batcher->getFlow()->getDevice();
+    for (uint32_t stream = 1; stream < _streamCount; ++stream)
+    {
+        auto& pages = _streamPages[stream - 1];
+        while (pages.size() <= _vbPos)
+        {
+            StreamPage page;
+            page.vb = VertexBuffer::create(device, _vertexFmt->getStreamFormat(stream), Usage::DYNAMIC, nullptr, 0, 0);
+            page.vb->retain();
+            pages.push_back(page);
+        }
+        
+        auto& page = pages[_vbPos];
+        if (page.capacity >= _vertexOffset)
+        {
+            continue;
+        }
+        
+        // Data of the last frame is kept, the ranges which are not written again still use it.
+        uint32_t capacity = page.capacity > 0 ? page.capacity : MeshBuffer::INIT_VERTEX_COUNT;
+        while (capacity < _vertexOffset)
+        {
+            capacity *= 2;
+        }
+        uint32_t streamBytes = _vertexFmt->getStreamBytes(stream);
+        uint8_t* data = new uint8_t[capacity * streamBytes];
+        if (page.data)
+        {
+            memcpy(data, page.data, page.capacity * streamBytes);
+            delete[] page.data;
+        }
+        page.data = data;
+        page.capacity = capacity;
+    }
+}
+
+void MeshBuffer::uploadStreams()
+{
+    for (uint32_t stream = 1; stream < _streamCount; ++stream)
+    {
+        auto& pages = _streamPages[stream - 1];
+        if (_vbPos >= pages.size() || !pages[_vbPos].dirty)
+        {
+            continue;
+        }
+        
+        // The buffer is synchronized, it is only uploaded when its data is changed.
+        auto& page = pages[_vbPos];
+        uint32_t bytes = _vertexOffset * _vertexFmt->getStreamBytes(stream);
+        page.vb->updateDiscard(page.data, bytes, false);
+        page.dirty = false;
+        _batcher->addUploadedBytes(stream, bytes);
+    }
+}
+
+VertexBuffer* MeshBuffer::getStreamBuffer(uint32_t stream) const
+{
+    if (stream == 0)
+    {
+        return _vb;
+    }
+    if (stream >= _streamCount)
+    {
+        return nullptr;
+    }
+    
+    const auto& pages = _streamPages[stream - 1];
+    return _vbPos < pages.size() ? pages[_vbPos].vb : nullptr;
+}
+
+uint8_t* MeshBuffer::getStreamData(uint32_t stream) const
+{
+    if (stream == 0)
+    {
+        return (uint8_t*)vData;
+    }
+    if (stream >= _streamCount)
+    {
+        return nullptr;
+    }
+    
+    const auto& pages = _streamPages[stream - 1];
+    return _vbPos < pages.size() ? pages[_vbPos].data : nullptr;
+}
+
 void MeshBuffer::uploadData()
 {
-    _vb->update(0, vData, _byteOffset);
-    _ib->update(0, iData, _indexOffset * IDATA_BYTE);
+    RENDERER_PROFILE_SCOPE(BUFFER_UPLOAD);
+    // The ring has waited for the GPU to finish reading the slot if it is unsynchronized.
+    bool unsynchronized = _ring->isUnsynchronized();
+    _vb->updateDiscard(vData, _byteOffset, unsynchronized);
+    _ib->updateDiscard(iData, _indexOffset * IDATA_BYTE, unsynchronized);
+    _batcher->addUploadedBytes(0, _byteOffset);
+    uploadStreams();
     _dirty = false;
 }
 
 void MeshBuffer::reset()
 {
-    _vbPos = 0;
-    _vb = _vbArr.at(0);
+    // The draw calls of the last frame are issued, the ring fences their slot.
+    _ring->advance(_batcher->getBufferRingSize());
+    _vbPos = _ring->getVertexBufferPos();
+    _vb = _ring->getVertexBuffer();
+    _ib = _ring->getIndexBuffer();
     _byteStart = 0;
     _byteOffset = 0;
     _vertexStart = 0;
@@ -199,6 +340,12 @@ void MeshBuffer::reset()
     _indexStart = 0;
     _indexOffset = 0;
     _dirty = false;
+    
+    for (auto& records : _pageRecords)
+    {
+        records.last.swap(records.current);
+        records.current.clear();
+    }
 }
 
 RENDERER_END
@@ -25,11 +25,13 @@
 #pragma once
 
 #include <stdint.h>
+#include <vector>
 
 #include "../Macro.h"
 #include "../gfx/VertexFormat.h"
 #include "../gfx/VertexBuffer.h"
 #include "../gfx/IndexBuffer.h"
+#include "../gfx/BufferRing.h"
 #include "base/CCVector.h"
 
 RENDERER_BEGIN
@@ -59,6 +61,8 @@ public:
         uint32_t index = 0;
         /** offset in vertex buffer */
         uint32_t vertex = 0;
+        /** bit mask of the vertex streams to be written, see commitStreams */
+        uint32_t streams = 1;
     };
     
     /**
@@ -80,6 +84,16 @@ public:
      */
     const OffsetInfo& request(uint32_t vertexCount, uint32_t indexCount);
     const OffsetInfo& requestStatic(uint32_t vertexCount, uint32_t indexCount);
+    /**
+     *  @brief Records the owner of the range returned by the last request, and works out which vertex streams of the range should be written.
+     *  Stream 0 is always written, the other streams are skipped if the owner filled the same range in the last frame and their data isn't dirty,
+     *  then they are not uploaded again unless another range of the same vertex buffer is written.
+     *  @param[in] owner The owner of the range, usually an Assembler
+     *  @param[in] index Render data index of the owner
+     *  @param[in] dirtyStreams Bit mask of the streams whose data is changed since the last fill
+     *  @return The range returned by the last request, OffsetInfo::streams tells which streams should be written.
+     */
+    const OffsetInfo& commitStreams(const void* owner, std::size_t index, uint32_t dirtyStreams);
     
     /**
      *  @brief Upload data to GPU memory
@@ -134,9 +148,21 @@ public:
      *  @brief Gets the index buffer.
      */
     IndexBuffer* getIndexBuffer() const { return _ib; };
+    /**
+     *  @brief Gets the count of vertex streams, it's the stream count of the vertex format.
+     */
+    uint32_t getStreamCount() const { return _streamCount; };
+    /**
+     *  @brief Gets the vertex buffer of a stream, the vertex buffer of stream 0 is getVertexBuffer.
+     */
+    VertexBuffer* getStreamBuffer(uint32_t stream) const;
+    /**
+     *  @brief Gets the vertex data storage of a stream in memory, the storage of stream 0 is vData.
+     */
+    uint8_t* getStreamData(uint32_t stream) const;
     
     /**
-     *  @brief The vertex data storage in memory
+     *  @brief The vertex data storage of stream 0 in memory
      */
     float* vData = nullptr;
     /**
@@ -151,10 +177,41 @@ public:
     static const int INIT_VERTEX_COUNT = 4096;
     static const uint8_t VDATA_BYTE = sizeof(float);
     static const uint8_t IDATA_BYTE = sizeof(uint16_t);
+    
+    static const uint8_t DEFAULT_RING_SIZE = 3;
+    static const uint8_t MAX_RING_SIZE = 4;
 protected:
     void reallocVBuffer();
     void reallocIBuffer();
+    void reserveStreams();
+    void uploadStreams();
 private:
+    // Vertices of a stream after stream 0, one page for every vertex buffer of stream 0 in a frame.
+    // Pages keep their data between frames, a page is uploaded only when a range of it is written.
+    struct StreamPage
+    {
+        uint8_t* data = nullptr;
+        uint32_t capacity = 0;
+        VertexBuffer* vb = nullptr;
+        bool dirty = false;
+    };
+    
+    struct FillRecord
+    {
+        const void* owner;
+        std::size_t index;
+        uint32_t vertex;
+        uint32_t count;
+    };
+    
+    // Ranges filled in a page in order, the ranges of the last frame tell whether the data of a range is still there.
+    struct PageRecords
+    {
+        std::vector<FillRecord> last;
+        std::vector<FillRecord> current;
+    };
+    
+
     uint32_t _byteStart = 0;
     uint32_t _byteOffset = 0;
     uint32_t _indexStart = 0;
@@ -162,6 +219,7 @@ private:
     uint32_t _vertexStart = 0;
     uint32_t _vertexOffset = 0;
     uint32_t _bytesPerVertex = 0;
+    uint32_t _requestVertexCount = 0;
     
     uint32_t _vDataCount = 0;
     uint32_t _iDataCount = 0;
@@ -172,11 +230,18 @@ private:
     bool _dirty = false;
     
     ModelBatcher* _batcher = nullptr;
+    // One slot of buffers per frame in flight, the vertex buffers of a slot are used in turn when MAX_VB_SIZE is exceeded.
+    BufferRing* _ring = nullptr;
+    // The buffers in use and the position of the vertex buffer in its slot, taken from the ring.
     std::size_t _vbPos = 0;
-    cocos2d::Vector<VertexBuffer*> _vbArr;
     VertexBuffer* _vb = nullptr;
     IndexBuffer* _ib = nullptr;
     OffsetInfo _offsetInfo;
+    
+    uint32_t _streamCount = 1;
+    // Pages of the streams after stream 0, indexed by stream - 1 and then the vertex buffer position.
+    std::vector<std::vector<StreamPage>> _streamPages;
+    std::vector<PageRecords> _pageRecords;
 };
 
 // end of scene group
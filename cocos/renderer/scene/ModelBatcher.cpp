@@ -27,11 +27,19 @@
 #include "StencilManager.hpp"
 #include "assembler/RenderDataList.hpp"
 #include "NodeProxy.hpp"
+#include "JobSystem.hpp"
+#include "StaticBatch.hpp"
+#include "../Profiler.h"
 
 RENDERER_BEGIN
 
 #define INIT_MODEL_LENGTH 16
 
+// Below this count deferred fills are executed by the calling thread.
+const std::size_t Fill_Use_Thread_Command_Count = 64;
+// Minimum assembler count of one fill job.
+const std::size_t Fill_Job_Group_Count = 16;
+
 ModelBatcher::ModelBatcher(RenderFlow* flow)
 : _flow(flow)
 , _modelOffset(0)
@@ -96,6 +104,21 @@ void ModelBatcher::reset()
     
     _modelMat.set(Mat4::IDENTITY);
     _stencilMgr->reset();
+    
+    _fillCommands.clear();
+    _fillGroups.clear();
+    
+    for (uint32_t i = 0; i < VertexFormat::MAX_STREAM_COUNT; ++i)
+    {
+        _uploadedBytes[i] = 0;
+    }
+}
+
+void ModelBatcher::setBufferRingSize(uint8_t size)
+{
+    if (size < 1) size = 1;
+    if (size > MeshBuffer::MAX_RING_SIZE) size = MeshBuffer::MAX_RING_SIZE;
+    _bufferRingSize = size;
 }
 
 void ModelBatcher::changeCommitState(CommitState state)
@@ -143,7 +166,7 @@ void ModelBatcher::commit(NodeProxy* node, Assembler* assembler, int cullingMask
             // Break auto batch
             flush();
             
-            setNode(_useModel ? node : nullptr);
+            setNode(useModel ? node : nullptr);
             setCurrentEffect(effect);
             _modelMat.set(worldMat);
             _useModel = useModel;
@@ -180,7 +203,7 @@ void ModelBatcher::commitIA(NodeProxy* node, CustomAssembler* assembler, int cul
     {
         flushIA();
         
-        setNode(_useModel ? node : nullptr);
+        setNode(useModel ? node : nullptr);
         setCurrentEffect(effect);
         _modelMat.set(worldMat);
         _useModel = useModel;
@@ -202,7 +225,7 @@ void ModelBatcher::commitIA(NodeProxy* node, CustomAssembler* assembler, int cul
         {
             flushIA();
             
-            setNode(_useModel ? node : nullptr);
+            setNode(useModel ? node : nullptr);
             setCurrentEffect(effect);
             _modelMat.set(worldMat);
             _useModel = useModel;
@@ -231,26 +254,19 @@ void ModelBatcher::flushIA()
         return;
     }
     
+    RENDERER_PROFILE_SCOPE(BATCH_FLUSH);
+    
     // Stencil manager process
     _stencilMgr->handleEffect(_currEffect);
     
     // Generate model
-    Model* model = nullptr;
-    if (_modelOffset >= _modelPool.size())
-    {
-        model = new Model();
-        _modelPool.push_back(model);
-    }
-    else
-    {
-        model = _modelPool[_modelOffset];
-    }
-    _modelOffset++;
+    Model* model = requestModel();
     model->setWorldMatix(_modelMat);
     model->setCullingMask(_cullingMask);
     model->setEffect(_currEffect);
     model->setNode(_node);
     model->setInputAssembler(_ia);
+    _stencilMgr->handleModel(model);
     
     _ia.clear();
     
@@ -277,7 +293,12 @@ void ModelBatcher::flush()
         return;
     }
     
+    RENDERER_PROFILE_SCOPE(BATCH_FLUSH);
     _ia.setVertexBuffer(_buffer->getVertexBuffer());
+    for (uint32_t stream = 1, streamCount = _buffer->getStreamCount(); stream < streamCount; ++stream)
+    {
+        _ia.setStreamBuffer(stream, _buffer->getStreamBuffer(stream));
+    }
     _ia.setIndexBuffer(_buffer->getIndexBuffer());
     _ia.setStart(indexStart);
     _ia.setCount(indexCount);
@@ -286,22 +307,13 @@ void ModelBatcher::flush()
     _stencilMgr->handleEffect(_currEffect);
     
     // Generate model
-    Model* model = nullptr;
-    if (_modelOffset >= _modelPool.size())
-    {
-        model = new Model();
-        _modelPool.push_back(model);
-    }
-    else
-    {
-        model = _modelPool[_modelOffset];
-    }
-    _modelOffset++;
+    Model* model = requestModel();
     model->setWorldMatix(_modelMat);
     model->setCullingMask(_cullingMask);
     model->setEffect(_currEffect);
     model->setNode(_node);
     model->setInputAssembler(_ia);
+    _stencilMgr->handleModel(model);
     
     _ia.clear();
 
@@ -310,6 +322,77 @@ void ModelBatcher::flush()
     _buffer->updateOffset();
 }
 
+Model* ModelBatcher::requestModel()
+{
+    // Models of a static batch are kept by itself to be submitted again
+    std::vector<Model*>& pool = _staticBatch ? _staticBatch->_models : _modelPool;
+    std::size_t offset = _staticBatch ? _staticBatch->_modelCount++ : _modelOffset++;
+    
+    Model* model = nullptr;
+    if (offset >= pool.size())
+    {
+        model = new Model();
+        pool.push_back(model);
+    }
+    else
+    {
+        model = pool[offset];
+    }
+    return model;
+}
+
+void ModelBatcher::beginStaticBatch(StaticBatch* staticBatch)
+{
+    // Break auto batch, nothing outside is merged into the static batch
+    changeCommitState(CommitState::None);
+    
+    _staticBatch = staticBatch;
+    _staticBatch->_modelCount = 0;
+    _buffers.swap(_staticBatch->_buffers);
+    for (auto iter : _buffers)
+    {
+        iter.second->reset();
+    }
+    _buffer = nullptr;
+}
+
+void ModelBatcher::endStaticBatch()
+{
+    changeCommitState(CommitState::None);
+    flushFills();
+    
+    for (auto iter : _buffers)
+    {
+        iter.second->uploadData();
+    }
+    
+    // Models left from the last build should not retain anything
+    auto& models = _staticBatch->_models;
+    for (std::size_t i = _staticBatch->_modelCount, n = models.size(); i < n; ++i)
+    {
+        models[i]->reset();
+    }
+    
+    _buffers.swap(_staticBatch->_buffers);
+    _buffer = nullptr;
+    _staticBatch = nullptr;
+}
+
+void ModelBatcher::commitStaticBatch(StaticBatch* staticBatch)
+{
+    changeCommitState(CommitState::None);
+    
+    Scene* scene = _flow->getRenderScene();
+    auto& models = staticBatch->_models;
+    for (std::size_t i = 0, n = staticBatch->_modelCount; i < n; ++i)
+    {
+        Model* model = models[i];
+        _stencilMgr->handleEffect(model->getEffect());
+        _stencilMgr->handleModel(model);
+        scene->addModel(model);
+    }
+}
+
 void ModelBatcher::startBatch()
 {
     reset();
@@ -320,6 +403,7 @@ void ModelBatcher::terminateBatch()
 {
     flush();
     flushIA();
+    flushFills();
     
     for (auto iter : _buffers)
     {
@@ -329,6 +413,68 @@ void ModelBatcher::terminateBatch()
     _walking = false;
 }
 
+void ModelBatcher::commitFill(NodeProxy* node, Assembler* assembler, MeshBuffer* buffer, std::size_t index, const MeshBuffer::OffsetInfo& offset, bool updateWorld)
+{
+    if (!_parallelFill)
+    {
+        assembler->fillRange(node, buffer, index, offset, updateWorld);
+        return;
+    }
+    
+    // Render datas of one assembler may share world vertices, keep them in the same group.
+    if (_fillCommands.empty() || _fillCommands.back().assembler != assembler)
+    {
+        _fillGroups.push_back(_fillCommands.size());
+    }
+    
+    _fillCommands.emplace_back();
+    FillCommand& command = _fillCommands.back();
+    command.node = node;
+    command.assembler = assembler;
+    command.buffer = buffer;
+    command.index = index;
+    command.offset = offset;
+    command.updateWorld = updateWorld;
+}
+
+void ModelBatcher::executeFills(std::size_t begin, std::size_t end)
+{
+    RENDERER_PROFILE_SCOPE(BATCH_FLUSH);
+    std::size_t groupCount = _fillGroups.size();
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        std::size_t last = i + 1 < groupCount ? _fillGroups[i + 1] : _fillCommands.size();
+        for (std::size_t j = _fillGroups[i]; j < last; ++j)
+        {
+            const FillCommand& command = _fillCommands[j];
+            command.assembler->fillRange(command.node, command.buffer, command.index, command.offset, command.updateWorld);
+        }
+    }
+}
+
+void ModelBatcher::flushFills()
+{
+    if (_fillCommands.empty())
+    {
+        return;
+    }
+    
+    std::size_t groupCount = _fillGroups.size();
+    if (_fillCommands.size() < Fill_Use_Thread_Command_Count)
+    {
+        executeFills(0, groupCount);
+    }
+    else
+    {
+        JobSystem::getInstance()->parallelFor(0, groupCount, Fill_Job_Group_Count, [this](std::size_t begin, std::size_t end) {
+            executeFills(begin, end);
+        });
+    }
+    
+    _fillCommands.clear();
+    _fillGroups.clear();
+}
+
 void ModelBatcher::setNode(NodeProxy* node)
 {
     if (_node == node)
@@ -37,6 +37,7 @@ RENDERER_BEGIN
 
 class RenderFlow;
 class StencilManager;
+class StaticBatch;
 
 /**
  * @addtogroup scene
@@ -129,13 +130,98 @@ public:
     void setCullingMask(int cullingMask) { _cullingMask = cullingMask; }
     void setCurrentEffect(EffectVariant* effect);
     void setUseModel(bool useModel) { _useModel = useModel; }
+    
+    /**
+     *  @brief Enables or disables two-phase batching.
+     *  If enabled, the traversal only reserves buffer ranges and records them in draw order,
+     *  the ranges are filled on the job system before the vertex data is uploaded.
+     */
+    void setParallelFill(bool enabled) { _parallelFill = enabled; }
+    /**
+     *  @brief Is two-phase batching enabled.
+     */
+    bool isParallelFill() const { return _parallelFill; }
+    /**
+     *  @brief Fills a reserved buffer range by Assembler::fillRange, the fill is deferred if two-phase batching is enabled.
+     *  @param[in] node The node which owns the assembler
+     *  @param[in] assembler The assembler which reserved the range
+     *  @param[in] buffer The buffer which the range belongs to
+     *  @param[in] index The render data index of the assembler
+     *  @param[in] offset The reserved range returned by MeshBuffer::request
+     *  @param[in] updateWorld Whether the assembler should recalculate its world vertices before copying
+     */
+    void commitFill(NodeProxy* node, Assembler* assembler, MeshBuffer* buffer, std::size_t index, const MeshBuffer::OffsetInfo& offset, bool updateWorld);
+    /**
+     *  @brief Fills all deferred ranges, it must be invoked before the vertex data of any buffer is uploaded or reused.
+     */
+    void flushFills();
+    
+    /**
+     *  @brief Sets how many frames of vertex and index buffers every MeshBuffer rotates through, it takes effect when the buffers are reset.
+     *  A buffer written in this frame is not written again until the ring wraps, so the upload never waits for the GPU reading the previous frames.
+     *  From BufferRing::UNSYNCHRONIZED_SIZE the slots are fenced, and mapped without synchronization once their fences are signaled.
+     *  @param[in] size The ring size, it is clamped to [1, MeshBuffer::MAX_RING_SIZE], 1 disables the ring.
+     */
+    void setBufferRingSize(uint8_t size);
+    /**
+     *  @brief Gets the ring size of the vertex and index buffers.
+     */
+    uint8_t getBufferRingSize() const { return _bufferRingSize; }
+    
+    /**
+     *  @brief Adds the bytes uploaded to a vertex stream, it's invoked by MeshBuffer.
+     */
+    void addUploadedBytes(uint32_t stream, uint32_t bytes)
+    {
+        if (stream < VertexFormat::MAX_STREAM_COUNT) _uploadedBytes[stream] += bytes;
+    }
+    /**
+     *  @brief Gets the bytes uploaded to a vertex stream in the current frame.
+     *  Stream 0 of every buffer is uploaded every frame, the other streams are uploaded only when their data is changed.
+     */
+    uint32_t getUploadedBytes(uint32_t stream) const
+    {
+        return stream < VertexFormat::MAX_STREAM_COUNT ? _uploadedBytes[stream] : 0;
+    }
+    
+    /**
+     *  @brief Is building a static batch.
+     */
+    bool isStaticBatching() const { return _staticBatch != nullptr; }
+    /**
+     *  @brief Starts building a static batch, render datas committed before endStaticBatch go to the buffers and Models of the static batch.
+     */
+    void beginStaticBatch(StaticBatch* staticBatch);
+    /**
+     *  @brief Finishes building the current static batch and uploads its buffers.
+     */
+    void endStaticBatch();
+    /**
+     *  @brief Submits the Models of a static batch built in a previous frame.
+     */
+    void commitStaticBatch(StaticBatch* staticBatch);
 private:
+    struct FillCommand
+    {
+        NodeProxy* node = nullptr;
+        Assembler* assembler = nullptr;
+        MeshBuffer* buffer = nullptr;
+        std::size_t index = 0;
+        MeshBuffer::OffsetInfo offset;
+        bool updateWorld = false;
+    };
+    
     void changeCommitState(CommitState state);
+    void executeFills(std::size_t begin, std::size_t end);
+    Model* requestModel();
 private:
     int _modelOffset = 0;
     int _cullingMask = 0;
     bool _useModel = false;
     bool _walking = false;
+    bool _parallelFill = false;
+    uint8_t _bufferRingSize = MeshBuffer::DEFAULT_RING_SIZE;
+    uint32_t _uploadedBytes[VertexFormat::MAX_STREAM_COUNT] = {};
     cocos2d::Mat4 _modelMat;
     CommitState _commitState = CommitState::None;
 
@@ -146,10 +232,15 @@ private:
     RenderFlow* _flow = nullptr;
 
     StencilManager* _stencilMgr = nullptr;
+    StaticBatch* _staticBatch = nullptr;
     
     InputAssembler _ia;
     std::vector<Model*> _modelPool;
     std::unordered_map<VertexFormat*, MeshBuffer*> _buffers;
+    
+    std::vector<FillCommand> _fillCommands;
+    // Start of every run of commands from the same assembler, a run is filled by one thread.
+    std::vector<std::size_t> _fillGroups;
 };
 
 // end of scene group
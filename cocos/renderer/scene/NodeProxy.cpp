@@ -35,6 +35,7 @@
 #include "NodeMemPool.hpp"
 #include <math.h>
 #include "RenderFlow.hpp"
+#include "StaticBatch.hpp"
 #include "assembler/AssemblerSprite.hpp"
 
 RENDERER_BEGIN
@@ -83,6 +84,7 @@ NodeProxy::~NodeProxy()
     {
         child->_parent = nullptr;
     }
+    CC_SAFE_DELETE(_staticBatch);
 }
 
 void NodeProxy::destroyImmediately()
@@ -91,8 +93,10 @@ void NodeProxy::destroyImmediately()
     {
         _parent->removeChild(this);
     }
-    RenderFlow::getInstance()->removeNodeLevel(_level, _worldMat);
+    RenderFlow::getInstance()->removeNodeLevel(_level, this);
     CC_SAFE_RELEASE_NULL(_assembler);
+    // cached Models retain nodes of the subtree
+    CC_SAFE_DELETE(_staticBatch);
     _level = NODE_LEVEL_INVALID;
     _dirty = nullptr;
     _trs = nullptr;
@@ -240,30 +244,39 @@ void NodeProxy::updateLevel()
 {
     static RenderFlow::LevelInfo levelInfo;
     auto renderFlow = RenderFlow::getInstance();
-
-    renderFlow->removeNodeLevel(_level, _worldMat);
     
+    levelInfo.node = this;
     levelInfo.dirty = _dirty;
     levelInfo.localMat = _localMat;
     levelInfo.worldMat = _worldMat;
     levelInfo.opacity = _opacity;
     levelInfo.realOpacity = &_realOpacity;
     
+    std::size_t level = 0;
     if (_parent)
     {
-        _level = _parent->_level + 1;
+        level = _parent->_level + 1;
         levelInfo.parentWorldMat = _parent->_worldMat;
         levelInfo.parentDirty = _parent->_dirty;
         levelInfo.parentRealOpacity = &_parent->_realOpacity;
     }
     else
     {
-        _level = 0;
         levelInfo.parentWorldMat = nullptr;
         levelInfo.parentDirty = nullptr;
         levelInfo.parentRealOpacity = nullptr;
     }
-    renderFlow->insertNodeLevel(_level, levelInfo);
+    
+    if (level == _level && _levelIndex != NODE_LEVEL_INVALID)
+    {
+        renderFlow->updateNodeLevel(_level, levelInfo);
+    }
+    else
+    {
+        renderFlow->removeNodeLevel(_level, this);
+        _level = level;
+        renderFlow->insertNodeLevel(_level, levelInfo);
+    }
     
     for (auto it = _children.begin(); it != _children.end(); it++)
     {
@@ -307,6 +320,9 @@ void NodeProxy::setAssembler(AssemblerBase* assembler)
     _assembler = assembler;
     CC_SAFE_RETAIN(_assembler);
     
+    _culled = false;
+    _cullingDirty = true;
+    
     auto assemblerSprite = dynamic_cast<AssemblerSprite*>(_assembler);
     if (assemblerSprite)
     {
@@ -322,6 +338,9 @@ void NodeProxy::clearAssembler()
 {
     CC_SAFE_RELEASE_NULL(_assembler);
     *_dirty &= ~RenderFlow::PRE_CALCULATE_VERTICES;
+    
+    _culled = false;
+    _cullingDirty = true;
 }
 
 AssemblerBase* NodeProxy::getAssembler() const
@@ -329,6 +348,27 @@ AssemblerBase* NodeProxy::getAssembler() const
     return _assembler;
 }
 
+void NodeProxy::setStaticBatch(bool enabled)
+{
+    if (enabled == (_staticBatch != nullptr)) return;
+    if (enabled)
+    {
+        _staticBatch = new StaticBatch();
+    }
+    else
+    {
+        CC_SAFE_DELETE(_staticBatch);
+    }
+}
+
+void NodeProxy::markStaticBatchDirty()
+{
+    for (NodeProxy* node = this; node; node = node->_parent)
+    {
+        if (node->_staticBatch) node->_staticBatch->invalidate();
+    }
+}
+
 void NodeProxy::getPosition(cocos2d::Vec3* out) const
 {
     out->x = _trs->x;
@@ -461,6 +501,27 @@ void NodeProxy::updateWorldMatrix(const cocos2d::Mat4& worldMatrix)
     *_dirty |= RenderFlow::WORLD_TRANSFORM_CHANGED;
 }
 
+const cocos2d::Mat4* NodeProxy::getCachedWorldMatrixIT()
+{
+    if (_worldMatITFrame == 0) return nullptr;
+    
+    // WORLD_TRANSFORM_CHANGED is reset every frame, so it only tells the change since the last frame.
+    uint32_t frame = RenderFlow::getInstance()->getFrameIndex();
+    if (_worldMatITFrame == frame) return &_worldMatIT;
+    if (_worldMatITFrame + 1 == frame && !(*_dirty & RenderFlow::WORLD_TRANSFORM_CHANGED))
+    {
+        _worldMatITFrame = frame;
+        return &_worldMatIT;
+    }
+    return nullptr;
+}
+
+void NodeProxy::setCachedWorldMatrixIT(const cocos2d::Mat4& matrix)
+{
+    _worldMatIT = matrix;
+    _worldMatITFrame = RenderFlow::getInstance()->getFrameIndex();
+}
+
 void NodeProxy::updateLocalMatrix()
 {
     bool skew = std::abs(_skew->x - 0.0f) > MATH_EPSILON || std::abs(_skew->y - 0.0f) > MATH_EPSILON;
@@ -508,6 +569,30 @@ void NodeProxy::render(NodeProxy* node, ModelBatcher* batcher, Scene* scene)
     node->_renderOrder = _globalRenderOrder++;
     
     if (!node->_needVisit || node->_realOpacity == 0) return;
+    
+    // static batches are not nested, the inner ones are part of the outer one
+    StaticBatch* staticBatch = batcher->isStaticBatching() ? nullptr : node->_staticBatch;
+    if (staticBatch)
+    {
+        switch (staticBatch->prepare(node))
+        {
+            case StaticBatch::Action::REUSE:
+            {
+                auto renderFlow = RenderFlow::getInstance();
+                renderFlow->_culledNodeCount += staticBatch->getCulledNodeCount();
+                renderFlow->_submittedNodeCount += staticBatch->getSubmittedNodeCount();
+                renderFlow->_staticNodeCount += staticBatch->getNodeCount();
+                batcher->commitStaticBatch(staticBatch);
+                return;
+            }
+            case StaticBatch::Action::REBUILD:
+                batcher->beginStaticBatch(staticBatch);
+                break;
+            default:
+                staticBatch = nullptr;
+                break;
+        }
+    }
 
     bool needRender = *node->_dirty & RenderFlow::RENDER;
     if (node->_needRender != needRender)
@@ -516,8 +601,18 @@ void NodeProxy::render(NodeProxy* node, ModelBatcher* batcher, Scene* scene)
         node->_needRender = needRender;
     }
     
+    // out of all cameras, skip the assembler but still traverse children
+    bool culled = false;
+    if (node->_assembler && needRender)
+    {
+        auto renderFlow = RenderFlow::getInstance();
+        culled = node->_culled;
+        if (culled) renderFlow->_culledNodeCount++;
+        else renderFlow->_submittedNodeCount++;
+    }
+    
     // pre render
-    if (node->_assembler && needRender) node->_assembler->handle(node, batcher, scene);
+    if (node->_assembler && needRender && !culled) node->_assembler->handle(node, batcher, scene);
 
     node->reorderChildren();
     for (const auto& child : node->_children)
@@ -528,7 +623,9 @@ void NodeProxy::render(NodeProxy* node, ModelBatcher* batcher, Scene* scene)
 
     // post render
     bool needPostRender = *(node->_dirty) & RenderFlow::POST_RENDER;
-    if (node->_assembler && needPostRender) node->_assembler->postHandle(node, batcher, scene);
+    if (node->_assembler && needPostRender && !culled) node->_assembler->postHandle(node, batcher, scene);
+    
+    if (staticBatch) batcher->endStaticBatch();
 }
 
 void NodeProxy::visit(NodeProxy* node, ModelBatcher* batcher, Scene* scene)
@@ -41,10 +41,14 @@ namespace se {
     class Object;
 }
 
+#define NODE_LEVEL_INVALID 0xffffffff
+
 RENDERER_BEGIN
 
 class ModelBatcher;
 class Scene;
+class RenderFlow;
+class StaticBatch;
 struct TRS;
 struct ParentInfo;
 struct Skew;
@@ -165,6 +169,17 @@ public:
      *  @return World matrix.
      */
     inline const cocos2d::Mat4& getWorldMatrix() const { return *_worldMat; };
+    
+    /*
+     *  @brief Gets the cached inverse transpose of the world matrix.
+     *  @return Nullptr if nothing is cached or the world matrix may have changed since it was cached.
+     */
+    const cocos2d::Mat4* getCachedWorldMatrixIT();
+    
+    /*
+     *  @brief Caches the inverse transpose of the current world matrix.
+     */
+    void setCachedWorldMatrixIT(const cocos2d::Mat4& matrix);
 
     /*
      *  @brief Gets the local matrix.
@@ -301,6 +316,38 @@ public:
      */
     bool isDirty(uint32_t flag) const { return *_dirty & flag; }
     
+    /*
+     *  @brief Is node out of all cameras, it's updated by the culling pass of RenderFlow.
+     */
+    bool isCulled() const { return _culled; }
+    /*
+     *  @brief Sets the culling result and caches it until node or assembler changes.
+     */
+    void setCulled(bool culled)
+    {
+        _culled = culled;
+        _cullingDirty = false;
+        _culledMask = *_cullingMask;
+    }
+    /*
+     *  @brief Is the cached culling result invalid.
+     */
+    bool isCullingDirty() const { return _cullingDirty || _culledMask != *_cullingMask; }
+    
+    /*
+     *  @brief Enables or disables static batching of the subtree.
+     *  A static subtree keeps its batched buffers and Models, and reuses them in frames that nothing in the subtree changed.
+     */
+    void setStaticBatch(bool enabled);
+    /*
+     *  @brief Is static batching of the subtree enabled.
+     */
+    bool isStaticBatch() const { return _staticBatch != nullptr; }
+    /*
+     *  @brief Rebuilds static batches containing the node in the next frame, it's needed if render datas changed without dirty flags.
+     */
+    void markStaticBatchDirty();
+    
     /*
      *  @brief Gets render order
      */
@@ -325,14 +372,25 @@ protected:
     void detachChild(NodeProxy* child, ssize_t childIndex);
     void reorderChildren();
 private:
+    friend class RenderFlow;
+    friend class StaticBatch;
+    
     bool _needVisit = true;
     bool _updateWorldMatrix = true;
     bool _needRender = false;
+    bool _culled = false;
+    bool _cullingDirty = true;
+    int32_t _culledMask = 0;
+    // Render flow frame index when the inverse transpose world matrix is cached, 0 means not cached.
+    uint32_t _worldMatITFrame = 0;
+    cocos2d::Mat4 _worldMatIT;
     
     uint8_t _realOpacity = 255;
     std::string _id = "";
     std::string _name = "";
     std::size_t _level = 0;
+    // Index in the level array of RenderFlow, NODE_LEVEL_INVALID if not in any level.
+    std::size_t _levelIndex = NODE_LEVEL_INVALID;
     
     uint32_t* _dirty = nullptr;
     TRS* _trs = nullptr;
@@ -353,6 +411,7 @@ private:
     cocos2d::Vector<NodeProxy*> _children;        ///< array of children nodes
 
     AssemblerBase* _assembler = nullptr;
+    StaticBatch* _staticBatch = nullptr;
     
     uint32_t _renderOrder = 0;
     static uint32_t _globalRenderOrder;
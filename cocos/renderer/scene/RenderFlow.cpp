@@ -24,15 +24,18 @@
 
 #include "RenderFlow.hpp"
 #include "NodeMemPool.hpp"
+#include "MathKernel.hpp"
+#include "DynamicAtlasManager.hpp"
 #include "assembler/AssemblerSprite.hpp"
+#include "../renderer/Camera.h"
+#include "platform/CCApplication.h"
+#include <string.h>
+#include <cmath>
 
 #if USE_MIDDLEWARE
 #include "MiddlewareManager.h"
 #endif
 
-#define SUB_RENDER_THREAD_COUNT 1
-#define RENDER_THREAD_COUNT (SUB_RENDER_THREAD_COUNT + 1)
-
 RENDERER_BEGIN
 
 const uint32_t InitLevelCount = 3;
@@ -40,9 +43,34 @@ const uint32_t InitLevelNodeCount = 100;
 
 const uint32_t LocalMat_Use_Thread_Unit_Count = 5;
 const uint32_t WorldMat_Use_Thread_Node_count = 500;
+// Minimum work of one job, common units for local matrix, nodes for world matrix.
+const std::size_t LocalMat_Job_Unit_Count = 1;
+const std::size_t WorldMat_Job_Node_Count = 128;
+const uint32_t Culling_Use_Thread_Node_Count = 500;
+const std::size_t Culling_Job_Node_Count = 128;
 
 RenderFlow* RenderFlow::_instance = nullptr;
 
+namespace {
+    const float Aligned_Epsilon = 1e-4f;
+    
+    // x and y axes are only scaled, translated or swapped, in proportion to the scale of the matrix.
+    bool isAxisAligned(const float* m)
+    {
+        float scale = std::abs(m[0]) + std::abs(m[1]) + std::abs(m[4]) + std::abs(m[5]);
+        return std::abs(m[1]) + std::abs(m[4]) <= Aligned_Epsilon * scale ||
+            std::abs(m[0]) + std::abs(m[5]) <= Aligned_Epsilon * scale;
+    }
+    
+    // Besides, a plane z = c is projected with the same w, which is not true for tilted perspective views.
+    bool isViewAligned(const cocos2d::Mat4& viewProj)
+    {
+        const float* m = viewProj.m;
+        float wScale = std::abs(m[11]) + std::abs(m[15]);
+        return isAxisAligned(m) && std::abs(m[3]) + std::abs(m[7]) <= Aligned_Epsilon * wScale;
+    }
+}
+
 RenderFlow::RenderFlow(DeviceGraphics* device, Scene* scene, ForwardRenderer* forward)
 : _device(device)
 , _scene(scene)
@@ -52,27 +80,7 @@ RenderFlow::RenderFlow(DeviceGraphics* device, Scene* scene, ForwardRenderer* fo
     
     _batcher = new ModelBatcher(this);
 
-#if SUB_RENDER_THREAD_COUNT > 0
-    _paralleTask = new ParallelTask();
-    _paralleTask->init(SUB_RENDER_THREAD_COUNT);
-    
-    for (uint32_t i = 0; i < SUB_RENDER_THREAD_COUNT; i++)
-    {
-        _paralleTask->pushTask(i, [this](int tid){
-            switch(_parallelStage)
-            {
-                case ParallelStage::LOCAL_MAT:
-                    calculateLocalMatrix(tid);
-                break;
-                case ParallelStage::WORLD_MAT:
-                    calculateLevelWorldMatrix(tid, _parallelStage);
-                break;
-                default:
-                break;
-            }
-        });
-    }
-#endif
+    _jobSystem = JobSystem::getInstance();
     
     _levelInfoArr.resize(InitLevelCount);
     for (auto i = 0; i < InitLevelCount; i++)
@@ -83,22 +91,28 @@ RenderFlow::RenderFlow(DeviceGraphics* device, Scene* scene, ForwardRenderer* fo
 
 RenderFlow::~RenderFlow()
 {
-    CC_SAFE_DELETE(_paralleTask);
     CC_SAFE_DELETE(_batcher);
+    JobSystem::destroyInstance();
+    DynamicAtlasManager::destroyInstance();
+    _jobSystem = nullptr;
 }
 
-void RenderFlow::removeNodeLevel(std::size_t level, cocos2d::Mat4* worldMat)
+void RenderFlow::removeNodeLevel(std::size_t level, NodeProxy* node)
 {
     if (level >= _levelInfoArr.size()) return;
     auto& levelInfos = _levelInfoArr[level];
-    for(auto it = levelInfos.begin(); it != levelInfos.end(); it++)
+    std::size_t index = node->_levelIndex;
+    if (index >= levelInfos.size() || levelInfos[index].node != node) return;
+    
+    // Order in a level does not matter, so move the last one into the hole to keep the level dense.
+    std::size_t last = levelInfos.size() - 1;
+    if (index != last)
     {
-        if (it->worldMat == worldMat)
-        {
-            levelInfos.erase(it);
-            return;
-        }
+        levelInfos[index] = levelInfos[last];
+        levelInfos[index].node->_levelIndex = index;
     }
+    levelInfos.pop_back();
+    node->_levelIndex = NODE_LEVEL_INVALID;
 }
 
 void RenderFlow::insertNodeLevel(std::size_t level, const LevelInfo& levelInfo)
@@ -108,13 +122,45 @@ void RenderFlow::insertNodeLevel(std::size_t level, const LevelInfo& levelInfo)
         _levelInfoArr.resize(level + 1);
     }
     auto& levelInfos = _levelInfoArr[level];
+    levelInfo.node->_levelIndex = levelInfos.size();
     levelInfos.push_back(levelInfo);
 }
 
-void RenderFlow::calculateLocalMatrix(int tid)
+void RenderFlow::updateNodeLevel(std::size_t level, const LevelInfo& levelInfo)
+{
+    NodeProxy* node = levelInfo.node;
+    if (level < _levelInfoArr.size() && node->_levelIndex < _levelInfoArr[level].size() &&
+        _levelInfoArr[level][node->_levelIndex].node == node)
+    {
+        _levelInfoArr[level][node->_levelIndex] = levelInfo;
+        return;
+    }
+    
+    insertNodeLevel(level, levelInfo);
+}
+
+void RenderFlow::calculateLocalMatrix()
+{
+    RENDERER_PROFILE_SCOPE(LOCAL_MATRIX);
+    NodeMemPool* instance = NodeMemPool::getInstance();
+    CCASSERT(instance, "RenderFlow calculateLocalMatrix NodeMemPool is null");
+    std::size_t unitCount = instance->getCommonList().size();
+    
+    if (unitCount < LocalMat_Use_Thread_Unit_Count)
+    {
+        calculateLocalMatrix(0, unitCount);
+        return;
+    }
+    
+    _jobSystem->parallelFor(0, unitCount, LocalMat_Job_Unit_Count, [this](std::size_t begin, std::size_t end) {
+        calculateLocalMatrix(begin, end);
+    });
+}
+
+void RenderFlow::calculateLocalMatrix(std::size_t begin, std::size_t end)
 {
     const uint16_t SPACE_FREE_FLAG = 0x0;
-    cocos2d::Mat4 matTemp;
+    const int BATCH_SIZE = MathKernel::BATCH_SIZE;
     
     NodeMemPool* instance = NodeMemPool::getInstance();
     CCASSERT(instance, "RenderFlow calculateLocalMatrix NodeMemPool is null");
@@ -130,19 +176,14 @@ void RenderFlow::calculateLocalMatrix(int tid)
     cocos2d::Mat4* localMat = nullptr;
     TRS* trs = nullptr;
     uint8_t* is3D = nullptr;
-    cocos2d::Quaternion* quat = nullptr;
-    float trsZ = 0.0f, trsSZ = 0.0f;
     
-    std::size_t begin = 0, end = commonList.size();
-    std::size_t fieldSize = end / RENDER_THREAD_COUNT;
-    if (tid >= 0)
-    {
-        begin = tid * fieldSize;
-        if (tid < RENDER_THREAD_COUNT - 1)
-        {
-            end = (tid + 1) * fieldSize;
-        }
-    }
+    // Dirty nodes are collected and composed BATCH_SIZE at a time.
+    const TRS* batchTRS[BATCH_SIZE];
+    uint8_t batchIs3D[BATCH_SIZE];
+    cocos2d::Mat4* batchMat[BATCH_SIZE];
+    int batchCount = 0;
+    
+    if (end > commonList.size()) end = commonList.size();
 
     for(auto i = begin; i < end; i++)
     {
@@ -171,43 +212,38 @@ void RenderFlow::calculateLocalMatrix(int tid)
             *dirty &= ~(WORLD_TRANSFORM_CHANGED | NODE_OPACITY_CHANGED);
             if (!(*dirty & LOCAL_TRANSFORM)) continue;
             
-            localMat->setIdentity();
-            trsZ = *is3D ? trs->z : 0;
-            localMat->translate(trs->x, trs->y, trsZ);
-            
-            quat = (cocos2d::Quaternion*)&(trs->qx);
-            cocos2d::Mat4::createRotation(*quat, &matTemp);
-            cocos2d::Mat4::multiply(*localMat, matTemp, localMat);
-            
-            trsSZ = *is3D ? trs->sz : 1;
-            cocos2d::Mat4::createScale(trs->sx, trs->sy, trsSZ, &matTemp);
-            cocos2d::Mat4::multiply(*localMat, matTemp, localMat);
+            batchTRS[batchCount] = trs;
+            batchIs3D[batchCount] = *is3D;
+            batchMat[batchCount] = localMat;
+            batchCount++;
+            if (batchCount == BATCH_SIZE)
+            {
+                MathKernel::composeLocalMatrix4(batchTRS, batchIs3D, batchMat);
+                batchCount = 0;
+            }
             
             *dirty &= ~LOCAL_TRANSFORM;
             *dirty |= WORLD_TRANSFORM;
         }
     }
+    
+    for (int k = 0; k < batchCount; k++)
+    {
+        MathKernel::composeLocalMatrix(batchTRS[k], batchIs3D[k], batchMat[k]);
+    }
 }
 
-void RenderFlow::calculateLevelWorldMatrix(int tid, int stage)
+void RenderFlow::calculateLevelWorldMatrix(std::size_t begin, std::size_t end)
 {
+    // Recorded per job, so the time is summed over the threads.
+    RENDERER_PROFILE_SCOPE(WORLD_MATRIX);
     if (_curLevel >= _levelInfoArr.size())
     {
         return;
     }
     
     auto& levelInfos = _levelInfoArr[_curLevel];
-
-    std::size_t begin = 0, end = levelInfos.size();
-    std::size_t fieldSize = end / RENDER_THREAD_COUNT;
-    if (tid >= 0)
-    {
-        begin = tid * fieldSize;
-        if (tid < RENDER_THREAD_COUNT - 1)
-        {
-            end = (tid + 1) * fieldSize;
-        }
-    }
+    if (end > levelInfos.size()) end = levelInfos.size();
 
     for(std::size_t index = begin; index < end; index++)
     {
@@ -299,68 +335,218 @@ void RenderFlow::calculateWorldMatrix()
     }
 }
 
-void RenderFlow::render(NodeProxy* scene, float deltaTime)
+void RenderFlow::updateCullingViews()
 {
-    if (scene != nullptr)
+    auto& cameras = _scene->getCameras();
+    bool cullable = _cullingEnabled;
+    for (auto camera : cameras)
+    {
+        // view matrix comes from the camera node
+        if (camera->getNode() == nullptr) cullable = false;
+    }
+    
+    std::size_t count = cullable ? cameras.size() : 0;
+    _cullingViewsChanged = count != _cullingViews.size();
+    _cullingViews.resize(count);
+    _unalignedViewMask = 0;
+    
+    auto& viewSize = Application::getInstance()->getViewSize();
+    cocos2d::Mat4 viewProj;
+    for (std::size_t i = 0, n = cameras.size(); i < n; i++)
     {
+        auto camera = cameras.at(i);
+        if (camera->getNode() == nullptr)
+        {
+            _unalignedViewMask |= camera->getCullingMask();
+            continue;
+        }
         
-#if USE_MIDDLEWARE
-        // udpate middleware before render
-        middleware::MiddlewareManager::getInstance()->update(deltaTime);
-#endif
+        camera->calculateViewProjMatrix(viewProj, viewSize.x, viewSize.y);
+        if (!isViewAligned(viewProj))
+        {
+            _unalignedViewMask |= camera->getCullingMask();
+        }
+        if (i >= count) continue;
+        
+        auto& view = _cullingViews[i];
+        if (view.cullingMask != camera->getCullingMask() || memcmp(view.viewProj.m, viewProj.m, sizeof(viewProj.m)) != 0)
+        {
+            view.viewProj = viewProj;
+            view.cullingMask = camera->getCullingMask();
+            _cullingViewsChanged = true;
+        }
+    }
+}
+
+bool RenderFlow::isScreenAligned(const cocos2d::Mat4& worldMat, int cullingMask) const
+{
+    if (cullingMask & _unalignedViewMask) return false;
+    
+    // The rectangle must stay on a plane z = c in world space.
+    const float* m = worldMat.m;
+    float scale = std::abs(m[0]) + std::abs(m[1]) + std::abs(m[4]) + std::abs(m[5]);
+    return isAxisAligned(m) && std::abs(m[2]) + std::abs(m[6]) <= Aligned_Epsilon * scale;
+}
+
+bool RenderFlow::isOutOfViews(const cocos2d::Mat4& worldMat, int cullingMask, const cocos2d::Vec3& min, const cocos2d::Vec3& max) const
+{
+    // 2d bounds only have 4 corners
+    const int cornerCount = min.z == max.z ? 4 : 8;
+    cocos2d::Mat4 mvp;
+    
+    for (const auto& view : _cullingViews)
+    {
+        if (!(view.cullingMask & cullingMask)) continue;
+        
+        cocos2d::Mat4::multiply(view.viewProj, worldMat, &mvp);
+        const float* m = mvp.m;
         
-#if SUB_RENDER_THREAD_COUNT > 0
+        // Every corner marks the clip planes it is out of,
+        // the box is invisible only if all corners are out of the same plane.
+        uint32_t outside = 0x3f;
+        for (int i = 0; i < cornerCount && outside; i++)
+        {
+            float x = (i & 1) ? max.x : min.x;
+            float y = (i & 2) ? max.y : min.y;
+            float z = (i & 4) ? max.z : min.z;
+            
+            float cx = m[0] * x + m[4] * y + m[8] * z + m[12];
+            float cy = m[1] * x + m[5] * y + m[9] * z + m[13];
+            float cz = m[2] * x + m[6] * y + m[10] * z + m[14];
+            float cw = m[3] * x + m[7] * y + m[11] * z + m[15];
+            
+            uint32_t bits = 0;
+            if (cx < -cw) bits |= 1 << 0;
+            if (cx > cw) bits |= 1 << 1;
+            if (cy < -cw) bits |= 1 << 2;
+            if (cy > cw) bits |= 1 << 3;
+            if (cz < -cw) bits |= 1 << 4;
+            if (cz > cw) bits |= 1 << 5;
+            outside &= bits;
+        }
+        
+        if (!outside) return false;
+    }
+    return true;
+}
 
-        int mainThreadTid = RENDER_THREAD_COUNT - 1;
+void RenderFlow::calculateLevelCulling(std::size_t begin, std::size_t end)
+{
+    if (_curLevel >= _levelInfoArr.size())
+    {
+        return;
+    }
+    
+    auto& levelInfos = _levelInfoArr[_curLevel];
+    if (end > levelInfos.size()) end = levelInfos.size();
+    
+    cocos2d::Vec3 min, max;
+    for(std::size_t index = begin; index < end; index++)
+    {
+        auto& info = levelInfos[index];
+        NodeProxy* node = info.node;
+        AssemblerBase* assembler = node->getAssembler();
+        if (!assembler) continue;
+        
+        // keep the last result if neither the node nor the cameras changed
+        if (!_cullingViewsChanged && !node->isCullingDirty() &&
+            !(*info.dirty & WORLD_TRANSFORM_CHANGED) && !assembler->isDirty(AssemblerBase::VERTICES_DIRTY))
+        {
+            continue;
+        }
+        
+        bool culled = !_cullingViews.empty() && assembler->getLocalAABB(min, max) &&
+            isOutOfViews(*info.worldMat, node->getCullingMask(), min, max);
+        
+        // vertices are not updated while culled, refresh them once visible again
+        if (node->isCulled() && !culled)
+        {
+            assembler->enableDirty(AssemblerBase::VERTICES_DIRTY | AssemblerBase::VERTICES_OPACITY_CHANGED);
+        }
+        node->setCulled(culled);
+    }
+}
 
-        NodeMemPool* instance = NodeMemPool::getInstance();
-        auto& commonList = instance->getCommonList();
-        if (commonList.size() < LocalMat_Use_Thread_Unit_Count)
+void RenderFlow::calculateCulling()
+{
+    updateCullingViews();
+    
+    _curLevel = 0;
+    for(auto count = _levelInfoArr.size(); _curLevel < count; _curLevel++)
+    {
+        std::size_t nodeCount = _levelInfoArr[_curLevel].size();
+        if (nodeCount < Culling_Use_Thread_Node_Count)
         {
-            _parallelStage = ParallelStage::NONE;
-            calculateLocalMatrix();
+            calculateLevelCulling(0, nodeCount);
         }
         else
         {
-            _parallelStage = ParallelStage::LOCAL_MAT;
-            _paralleTask->beginAllThreads();
-            calculateLocalMatrix(mainThreadTid);
-            _paralleTask->waitAllThreads();
+            _jobSystem->parallelFor(0, nodeCount, Culling_Job_Node_Count, [this](std::size_t begin, std::size_t end) {
+                calculateLevelCulling(begin, end);
+            });
+        }
+    }
+}
+
+void RenderFlow::render(NodeProxy* scene, float deltaTime)
+{
+    if (scene != nullptr)
+    {
+#if CC_ENABLE_PROFILERS
+        // Stage times of the last frame are available from now on.
+        Profiler::getInstance()->endFrame();
+#endif
+        RENDERER_PROFILE_SCOPE(FRAME);
+        _frameIndex++;
+        
+#if USE_MIDDLEWARE
+        {
+            // udpate middleware before render
+            RENDERER_PROFILE_SCOPE(MIDDLEWARE_UPDATE);
+            middleware::MiddlewareManager::getInstance()->update(deltaTime);
         }
+#endif
+        
+        calculateLocalMatrix();
 
         _curLevel = 0;
         for(auto count = _levelInfoArr.size(); _curLevel < count; _curLevel++)
         {
-            auto& levelInfos = _levelInfoArr[_curLevel];
-            if (levelInfos.size() < WorldMat_Use_Thread_Node_count)
+            std::size_t nodeCount = _levelInfoArr[_curLevel].size();
+            if (nodeCount < WorldMat_Use_Thread_Node_count)
             {
-                _parallelStage = ParallelStage::NONE;
-                calculateLevelWorldMatrix();
+                calculateLevelWorldMatrix(0, nodeCount);
             }
             else
             {
-                _parallelStage = ParallelStage::WORLD_MAT;
-                _paralleTask->beginAllThreads();
-                calculateLevelWorldMatrix(mainThreadTid);
-                _paralleTask->waitAllThreads();
+                _jobSystem->parallelFor(0, nodeCount, WorldMat_Job_Node_Count, [this](std::size_t begin, std::size_t end) {
+                    calculateLevelWorldMatrix(begin, end);
+                });
             }
         }
-#else
-        calculateLocalMatrix();
-        calculateWorldMatrix();
-#endif
+        
+        calculateCulling();
+        _culledNodeCount = 0;
+        _submittedNodeCount = 0;
+        _staticNodeCount = 0;
         
         _batcher->startBatch();
 
 #if USE_MIDDLEWARE
-        // render middleware
-        middleware::MiddlewareManager::getInstance()->render(deltaTime);
+        {
+            // render middleware
+            RENDERER_PROFILE_SCOPE(MIDDLEWARE_RENDER);
+            middleware::MiddlewareManager::getInstance()->render(deltaTime);
+        }
 #endif
         scene->resetGlobalRenderOrder();
         
-        auto traverseHandle = scene->traverseHandle;
-        traverseHandle(scene, _batcher, _scene);
-        _batcher->terminateBatch();
+        {
+            RENDERER_PROFILE_SCOPE(TRAVERSAL);
+            auto traverseHandle = scene->traverseHandle;
+            traverseHandle(scene, _batcher, _scene);
+            _batcher->terminateBatch();
+        }
 
         _forward->render(_scene);
     }
@@ -368,6 +554,9 @@ void RenderFlow::render(NodeProxy* scene, float deltaTime)
 
 void RenderFlow::visit(NodeProxy* rootNode)
 {
+    _frameIndex++;
+    // Views of a visit are unknown, masks use stencil.
+    _unalignedViewMask = -1;
     NodeProxy::visit(rootNode, _batcher, _scene);
 }
 
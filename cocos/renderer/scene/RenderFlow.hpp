@@ -27,10 +27,12 @@
 #include "../Macro.h"
 #include "NodeProxy.hpp"
 #include "ModelBatcher.hpp"
+#include "StencilManager.hpp"
 #include "../renderer/Scene.h"
 #include "../renderer/ForwardRenderer.h"
 #include "../gfx/DeviceGraphics.h"
-#include "ParallelTask.hpp"
+#include "JobSystem.hpp"
+#include "../Profiler.h"
 
 RENDERER_BEGIN
 
@@ -49,8 +51,6 @@ RENDERER_BEGIN
  @endcode
  */
 
-#define NODE_LEVEL_INVALID 0xffffffff
-
 class RenderFlow
 {
 public:
@@ -80,14 +80,8 @@ public:
         NODE_OPACITY_CHANGED = 1 << 31,
     };
 
-    enum ParallelStage {
-        NONE = 1 << 0,
-        LOCAL_MAT = 1 << 1,
-        WORLD_MAT = 1 << 2,
-        CALC_VERTICES = 1 << 3,
-    };
-    
     struct LevelInfo{
+        NodeProxy* node = nullptr;
         uint32_t* dirty = nullptr;
         uint32_t* parentDirty = nullptr;
         cocos2d::Mat4* parentWorldMat = nullptr;
@@ -137,29 +131,168 @@ public:
      */
     void visit(NodeProxy* rootNode);
     /**
-     *  @brief Calculate local matrix.
-     *  @param[in] tid It must rather than -1 if enable multiple thread.
+     *  @brief Calculate local matrix of all nodes, runs on the job system if there are enough nodes.
+     */
+    void calculateLocalMatrix();
+    /**
+     *  @brief Calculate local matrix of nodes in the given common units.
+     *  @param[in] begin First common unit index.
+     *  @param[in] end Last common unit index, exclusive.
      */
-    void calculateLocalMatrix(int tid = -1);
+    void calculateLocalMatrix(std::size_t begin, std::size_t end);
     /**
      *  @brief Calculate world matrix.
      */
     void calculateWorldMatrix();
     /**
-     *  @brief Calculate world matrix by level.
-     *  @param[in] tid Thread id.
-     *  @param[level] level Node level.
+     *  @brief Calculate world matrix of nodes in the current level.
+     *  @param[in] begin First node index in level.
+     *  @param[in] end Last node index in level, exclusive.
+     */
+    void calculateLevelWorldMatrix(std::size_t begin, std::size_t end);
+    /**
+     *  @brief Culls all nodes with bounds against cameras of the render scene, runs on the job system if there are enough nodes.
+     */
+    void calculateCulling();
+    /**
+     *  @brief Culls nodes in the current level, the cached result is kept if neither the node nor the cameras changed.
+     *  @param[in] begin First node index in level.
+     *  @param[in] end Last node index in level, exclusive.
+     */
+    void calculateLevelCulling(std::size_t begin, std::size_t end);
+    /**
+     *  @brief Enables or disables culling, all nodes are submitted if disabled.
+     */
+    void setCullingEnabled(bool enabled) { _cullingEnabled = enabled; }
+    /**
+     *  @brief Is culling enabled.
+     */
+    bool isCullingEnabled() const { return _cullingEnabled; }
+    /**
+     *  @brief Tests local bounds against the culling views of the current frame, the bounds are always visible if culling is disabled.
+     */
+    bool isAABBVisible(const cocos2d::Mat4& worldMat, int cullingMask, const cocos2d::Vec3& min, const cocos2d::Vec3& max) const
+    {
+        return _cullingViews.empty() || !isOutOfViews(worldMat, cullingMask, min, max);
+    }
+    /**
+     *  @brief Whether a local rectangle on the plane z = 0 stays an axis aligned rectangle on the screen of every view which renders the culling mask,
+     *  so that it could be clipped by scissor.
+     */
+    bool isScreenAligned(const cocos2d::Mat4& worldMat, int cullingMask) const;
+    /**
+     *  @brief Enables or disables filling batch buffers in parallel.
+     *  The traversal only reserves vertex and index ranges in draw order, and the ranges are filled on the job system afterwards.
+     */
+    void setParallelFillEnabled(bool enabled) { _batcher->setParallelFill(enabled); }
+    /**
+     *  @brief Is filling batch buffers in parallel enabled.
+     */
+    bool isParallelFillEnabled() const { return _batcher->isParallelFill(); }
+    /**
+     *  @brief Sets how many frames of batch buffers are kept in flight, 3 or more also skips the synchronization when the buffers are mapped.
+     */
+    void setBufferRingSize(uint8_t size) { _batcher->setBufferRingSize(size); }
+    /**
+     *  @brief Gets how many frames of batch buffers are kept in flight.
+     */
+    uint8_t getBufferRingSize() const { return _batcher->getBufferRingSize(); }
+    /**
+     *  @brief Enables or disables recording stage times.\n
+     *  The profiler methods only work if CC_ENABLE_PROFILERS is 1, otherwise they do nothing and return 0 or false.
+     */
+    void setProfilerEnabled(bool enabled)
+    {
+#if CC_ENABLE_PROFILERS
+        Profiler::getInstance()->setEnabled(enabled);
+#endif
+    }
+    /**
+     *  @brief Is recording stage times enabled.
+     */
+    bool isProfilerEnabled() const
+    {
+#if CC_ENABLE_PROFILERS
+        return Profiler::isEnabled();
+#else
+        return false;
+#endif
+    }
+    /**
+     *  @brief Gets the time in milliseconds spent in a stage in the last frame.
+     *  @param[in] stage The value of ProfileStage.
+     */
+    float getStageTime(int stage) const
+    {
+#if CC_ENABLE_PROFILERS
+        return Profiler::getInstance()->getStageTime((ProfileStage)stage);
+#else
+        return 0;
+#endif
+    }
+    /**
+     *  @brief Writes the recorded samples to a file in the Chrome trace event format.
+     *  @param[in] path Full path of the file.
+     */
+    bool dumpProfile(const std::string& path) const
+    {
+#if CC_ENABLE_PROFILERS
+        return Profiler::getInstance()->dumpChromeTrace(path);
+#else
+        return false;
+#endif
+    }
+    /**
+     *  @brief Gets count of nodes skipped by culling in the last frame.
+     */
+    uint32_t getCulledNodeCount() const { return _culledNodeCount; }
+    /**
+     *  @brief Gets count of nodes submitted to the batcher in the last frame.
+     */
+    uint32_t getSubmittedNodeCount() const { return _submittedNodeCount; }
+    /**
+     *  @brief Gets count of nodes in static batches which reused the last built buffers in the last frame.
+     */
+    uint32_t getStaticNodeCount() const { return _staticNodeCount; }
+    /**
+     *  @brief Gets count of masks clipped by scissor in the last frame.
+     */
+    uint32_t getScissorMaskCount() const { return StencilManager::getInstance()->getScissorMaskCount(); }
+    /**
+     *  @brief Gets count of masks clipped by stencil in the last frame.
+     */
+    uint32_t getStencilMaskCount() const { return StencilManager::getInstance()->getStencilMaskCount(); }
+    /**
+     *  @brief Gets bytes of vertices uploaded to a stream in the last frame, the streams are defined by the vertex formats.
+     */
+    uint32_t getUploadedVertexBytes(uint32_t stream) const { return _batcher->getUploadedBytes(stream); }
+    /**
+     *  @brief Gets the index of the current render or visit pass, it starts from 1.
      */
-    void calculateLevelWorldMatrix(int tid = -1, int stage = -1);
+    uint32_t getFrameIndex() const { return _frameIndex; }
     /**
-     *  @brief remove node level
+     *  @brief Removes the node from its level in O(1), the last node of the level takes its index.
      */
-    void removeNodeLevel(std::size_t level, cocos2d::Mat4* worldMat);
+    void removeNodeLevel(std::size_t level, NodeProxy* node);
     /**
-     *  @brief insert node level
+     *  @brief Appends the node of levelInfo to the level and records its index in the level.
      */
     void insertNodeLevel(std::size_t level, const LevelInfo& levelInfo);
+    /**
+     *  @brief Replaces the level info of a node which stays in the same level, such as when reparented at the same depth.
+     */
+    void updateNodeLevel(std::size_t level, const LevelInfo& levelInfo);
 private:
+    friend class NodeProxy;
+    
+    struct CullingView
+    {
+        cocos2d::Mat4 viewProj;
+        int cullingMask = 0;
+    };
+    
+    void updateCullingViews();
+    bool isOutOfViews(const cocos2d::Mat4& worldMat, int cullingMask, const cocos2d::Vec3& min, const cocos2d::Vec3& max) const;
     
     static RenderFlow *_instance;
     
@@ -170,8 +303,17 @@ private:
     std::size_t _curLevel = 0;
     std::vector<std::vector<LevelInfo>> _levelInfoArr;
 
-    ParallelStage _parallelStage = ParallelStage::NONE;
-    ParallelTask* _paralleTask = nullptr;
+    JobSystem* _jobSystem = nullptr;
+    
+    bool _cullingEnabled = true;
+    bool _cullingViewsChanged = true;
+    std::vector<CullingView> _cullingViews;
+    // Culling masks of the cameras which do not keep screen rectangles axis aligned.
+    int _unalignedViewMask = -1;
+    uint32_t _culledNodeCount = 0;
+    uint32_t _submittedNodeCount = 0;
+    uint32_t _staticNodeCount = 0;
+    uint32_t _frameIndex = 0;
 };
 
 // end of scene group
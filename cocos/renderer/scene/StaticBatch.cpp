@@ -0,0 +1,156 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "StaticBatch.hpp"
+#include "NodeProxy.hpp"
+#include "MeshBuffer.hpp"
+#include "RenderFlow.hpp"
+#include "../renderer/Model.h"
+
+RENDERER_BEGIN
+
+namespace {
+    enum StateFlag {
+        STATE_VISIBLE = 1 << 0,
+        STATE_RENDER = 1 << 1,
+        STATE_POST_RENDER = 1 << 2,
+        STATE_CULLED = 1 << 3,
+    };
+    
+    typedef void (*TraverseFuncPtr)(NodeProxy*, ModelBatcher*, Scene*);
+}
+
+StaticBatch::StaticBatch()
+{
+}
+
+StaticBatch::~StaticBatch()
+{
+    for (auto model : _models)
+    {
+        delete model;
+    }
+    _models.clear();
+    
+    for (auto iter = _buffers.begin(); iter != _buffers.end(); ++iter)
+    {
+        delete iter->second;
+    }
+    _buffers.clear();
+}
+
+StaticBatch::Action StaticBatch::prepare(NodeProxy* root)
+{
+    uint32_t renderOrder = NodeProxy::_globalRenderOrder;
+    
+    _pendingStates.clear();
+    _clean = true;
+    _nodeCount = 0;
+    _culledNodeCount = 0;
+    _submittedNodeCount = 0;
+    
+    if (!collect(root, true))
+    {
+        NodeProxy::_globalRenderOrder = renderOrder;
+        _states.clear();
+        _valid = false;
+        return Action::DISABLED;
+    }
+    
+    if (_valid && _clean && _pendingStates == _states)
+    {
+        return Action::REUSE;
+    }
+    
+    // the traversal assigns render orders again while building
+    NodeProxy::_globalRenderOrder = renderOrder;
+    _states.swap(_pendingStates);
+    _valid = true;
+    return Action::REBUILD;
+}
+
+// Follows NodeProxy::render, returns false if the subtree can't be cached.
+bool StaticBatch::collect(NodeProxy* node, bool root)
+{
+    if (!root)
+    {
+        // children switched to visit update their own transforms
+        auto traverse = node->traverseHandle.target<TraverseFuncPtr>();
+        if (!traverse || *traverse != NodeProxy::render)
+        {
+            return false;
+        }
+        node->_renderOrder = NodeProxy::_globalRenderOrder++;
+    }
+    
+    _pendingStates.emplace_back();
+    NodeState& state = _pendingStates.back();
+    state.node = node;
+    state.assembler = node->_assembler;
+    
+    if (!node->_needVisit || node->_realOpacity == 0)
+    {
+        return true;
+    }
+    
+    _nodeCount++;
+    uint32_t dirty = *node->_dirty;
+    bool needRender = dirty & RenderFlow::RENDER;
+    bool needPostRender = dirty & RenderFlow::POST_RENDER;
+    state.flags = STATE_VISIBLE | (needRender ? STATE_RENDER : 0) | (needPostRender ? STATE_POST_RENDER : 0);
+    
+    // Color and render data changes come from JS, they may rewrite vertices without marking the assembler dirty.
+    if (dirty & (RenderFlow::WORLD_TRANSFORM_CHANGED | RenderFlow::NODE_OPACITY_CHANGED | RenderFlow::REORDER_CHILDREN |
+                 RenderFlow::COLOR | RenderFlow::UPDATE_RENDER_DATA))
+    {
+        _clean = false;
+    }
+    
+    AssemblerBase* assembler = node->_assembler;
+    if (assembler && (needRender || needPostRender))
+    {
+        if (!assembler->isStaticBatchable())
+        {
+            return false;
+        }
+        if (assembler->isDirty(AssemblerBase::VERTICES_DIRTY | AssemblerBase::VERTICES_OPACITY_CHANGED))
+        {
+            _clean = false;
+        }
+        if (node->_culled) state.flags |= STATE_CULLED;
+        if (needRender)
+        {
+            if (node->_culled) _culledNodeCount++;
+            else _submittedNodeCount++;
+        }
+    }
+    
+    for (const auto& child : node->_children)
+    {
+        if (!collect(child, false)) return false;
+    }
+    return true;
+}
+
+RENDERER_END
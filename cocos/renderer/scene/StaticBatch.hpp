@@ -0,0 +1,127 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+#include "../Macro.h"
+
+RENDERER_BEGIN
+
+class NodeProxy;
+class AssemblerBase;
+class ModelBatcher;
+class MeshBuffer;
+class VertexFormat;
+class Model;
+
+/**
+ * @addtogroup scene
+ * @{
+ */
+
+/**
+ *  @brief The cache of a static batch subtree, it's owned by the root NodeProxy of the subtree.\n
+ *  It keeps the merged vertex and index data in its own MeshBuffers and the Models built from them,
+ *  if nothing in the subtree changed since they were built, the Models are submitted again without filling or uploading buffers.
+ *  Render datas should be changed with the assembler dirty flags or the COLOR and UPDATE_RENDER_DATA render flags,
+ *  or NodeProxy::markStaticBatchDirty should be called.
+ */
+class StaticBatch
+{
+public:
+    /**
+     *  @brief Result of prepare.
+     */
+    enum class Action {
+        // Nothing changed, the cached Models can be submitted
+        REUSE,
+        // The subtree changed, the cache should be built again
+        REBUILD,
+        // The subtree contains assemblers can't be cached, render it as ordinary nodes
+        DISABLED,
+    };
+    
+    StaticBatch();
+    ~StaticBatch();
+    
+    /**
+     *  @brief Compares the subtree with the cached state, render orders of the subtree are assigned if the cache is reused.
+     *  @param[in] root The root node of the subtree, its render order should be assigned already.
+     */
+    Action prepare(NodeProxy* root);
+    /**
+     *  @brief Invalidates the cache, it will be rebuilt the next time the subtree is rendered.
+     */
+    void invalidate() { _valid = false; }
+    
+    /**
+     *  @brief Gets the count of visible nodes in the subtree, recorded by the last prepare.
+     */
+    uint32_t getNodeCount() const { return _nodeCount; }
+    /**
+     *  @brief Gets the count of culled render nodes in the subtree, recorded by the last prepare.
+     */
+    uint32_t getCulledNodeCount() const { return _culledNodeCount; }
+    /**
+     *  @brief Gets the count of submitted render nodes in the subtree, recorded by the last prepare.
+     */
+    uint32_t getSubmittedNodeCount() const { return _submittedNodeCount; }
+private:
+    friend class ModelBatcher;
+    
+    struct NodeState
+    {
+        NodeProxy* node = nullptr;
+        AssemblerBase* assembler = nullptr;
+        uint32_t flags = 0;
+        
+        bool operator==(const NodeState& o) const
+        {
+            return node == o.node && assembler == o.assembler && flags == o.flags;
+        }
+    };
+    
+    bool collect(NodeProxy* node, bool root);
+private:
+    bool _valid = false;
+    bool _clean = true;
+    uint32_t _nodeCount = 0;
+    uint32_t _culledNodeCount = 0;
+    uint32_t _submittedNodeCount = 0;
+    
+    std::vector<NodeState> _states;
+    std::vector<NodeState> _pendingStates;
+    
+    std::unordered_map<VertexFormat*, MeshBuffer*> _buffers;
+    std::vector<Model*> _models;
+    std::size_t _modelCount = 0;
+};
+
+// end of scene group
+/// @}
+
+RENDERER_END
@@ -26,6 +26,8 @@
 #include "../Types.h"
 #include "../renderer/Technique.h"
 #include "../renderer/Pass.h"
+#include "../renderer/Model.h"
+#include <algorithm>
 
 RENDERER_BEGIN
 
@@ -46,6 +48,9 @@ void StencilManager::reset ()
     // reset stack and stage
     _maskStack.clear();
     _stage = Stage::DISABLED;
+    _scissorStack.clear();
+    _scissorMaskCount = 0;
+    _stencilMaskCount = 0;
 }
 
 EffectVariant* StencilManager::handleEffect (EffectVariant* effect)
@@ -119,6 +124,52 @@ void StencilManager::pushMask (bool mask)
         cocos2d::log("StencilManager:pushMask _maxLevel:%d is out of range", _maxLevel);
     }
     _maskStack.push_back(mask);
+    _stencilMaskCount++;
+}
+
+bool StencilManager::pushScissor (const Rect& rect, float z)
+{
+    Scissor scissor;
+    scissor.rect = rect;
+    scissor.z = z;
+    
+    if (!_scissorStack.empty())
+    {
+        // Rectangles on different planes do not project to the same screen rectangles in perspective views.
+        const Scissor& parent = _scissorStack.back();
+        if (parent.z != z) return false;
+        
+        float minX = std::max(rect.x, parent.rect.x);
+        float minY = std::max(rect.y, parent.rect.y);
+        float maxX = std::min(rect.x + rect.w, parent.rect.x + parent.rect.w);
+        float maxY = std::min(rect.y + rect.h, parent.rect.y + parent.rect.h);
+        scissor.rect.set(minX, minY, std::max(maxX - minX, 0.0f), std::max(maxY - minY, 0.0f));
+    }
+    
+    _scissorStack.push_back(scissor);
+    _scissorMaskCount++;
+    return true;
+}
+
+void StencilManager::exitScissor ()
+{
+    if (_scissorStack.size() == 0) {
+        cocos2d::log("StencilManager:exitScissor _scissorStack size is 0");
+        return;
+    }
+    _scissorStack.pop_back();
+}
+
+void StencilManager::handleModel (Model* model)
+{
+    if (_scissorStack.empty())
+    {
+        model->disableScissor();
+        return;
+    }
+    
+    const Scissor& scissor = _scissorStack.back();
+    model->setScissor(scissor.rect, scissor.z);
 }
     
 void StencilManager::clear ()
@@ -26,9 +26,12 @@
 #include <vector>
 #include "../../base/CCVector.h"
 #include "renderer/EffectVariant.hpp"
+#include "../Types.h"
 
 RENDERER_BEGIN
 
+class Model;
+
 /**
  * @addtogroup scene
  * @{
@@ -86,6 +89,27 @@ public:
      * Exits a mask level
      */
     void exitMask();
+    /**
+     * Pushes an axis aligned mask as a world space scissor rectangle, it is intersected with the current scissor rectangle.
+     * Returns false if it can not be intersected, such as on another plane, the mask should use stencil then.
+     */
+    bool pushScissor(const Rect& rect, float z);
+    /**
+     * Exits a scissor level
+     */
+    void exitScissor();
+    /**
+     * Applies the current scissor rectangle to the Model
+     */
+    void handleModel(Model* model);
+    /**
+     * Gets count of masks which used scissor since last reset
+     */
+    uint32_t getScissorMaskCount() const { return _scissorMaskCount; }
+    /**
+     * Gets count of masks which used stencil since last reset
+     */
+    uint32_t getStencilMaskCount() const { return _stencilMaskCount; }
     uint8_t getWriteMask();
     uint8_t getExitWriteMask();
     uint32_t getStencilRef();
@@ -104,6 +128,15 @@ private:
     const int _maxLevel = 8;
     std::vector<bool> _maskStack;
     Stage _stage;
+    
+    struct Scissor
+    {
+        Rect rect;
+        float z = 0;
+    };
+    std::vector<Scissor> _scissorStack;
+    uint32_t _scissorMaskCount = 0;
+    uint32_t _stencilMaskCount = 0;
     static StencilManager* _instance;
 };
 
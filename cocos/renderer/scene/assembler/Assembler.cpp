@@ -33,6 +33,10 @@
 #include "cocos/scripting/js-bindings/manual/jsb_conversions.hpp"
 #include "cocos/scripting/js-bindings/auto/jsb_renderer_auto.hpp"
 #include "../RenderFlow.hpp"
+#include "../MathKernel.hpp"
+#include "../DynamicAtlasManager.hpp"
+
+#include <algorithm>
 
 RENDERER_BEGIN
 
@@ -76,6 +80,7 @@ Assembler::Assembler()
 
 Assembler::~Assembler()
 {
+    releaseAtlasFrames();
     CC_SAFE_RELEASE_NULL(_datas);
     CC_SAFE_RELEASE(_vfmt);
 }
@@ -88,6 +93,9 @@ void Assembler::updateMeshIndex(std::size_t iaIndex, int meshIndex)
     }
     IARenderData& ia = _iaDatas[iaIndex];
     ia.meshIndex = meshIndex;
+    
+    // cached static batches should be rebuilt
+    enableDirty(AssemblerBase::VERTICES_DIRTY);
 }
 
 void Assembler::updateIndicesRange(std::size_t iaIndex, int start, int count)
@@ -99,6 +107,7 @@ void Assembler::updateIndicesRange(std::size_t iaIndex, int start, int count)
     IARenderData& ia = _iaDatas[iaIndex];
     ia.indicesStart = start;
     ia.indicesCount = count;
+    enableDirty(AssemblerBase::VERTICES_DIRTY);
 }
 
 void Assembler::updateVerticesRange(std::size_t iaIndex, int start, int count)
@@ -114,6 +123,33 @@ void Assembler::updateVerticesRange(std::size_t iaIndex, int start, int count)
     enableDirty(AssemblerBase::VERTICES_OPACITY_CHANGED);
 }
 
+void Assembler::setLocalAABB(float minX, float minY, float minZ, float maxX, float maxY, float maxZ)
+{
+    _localAABBMin.set(minX, minY, minZ);
+    _localAABBMax.set(maxX, maxY, maxZ);
+    _hasLocalAABB = true;
+    
+    // bounds changed, node must be culled again
+    enableDirty(AssemblerBase::VERTICES_DIRTY);
+}
+
+void Assembler::clearLocalAABB()
+{
+    _hasLocalAABB = false;
+    enableDirty(AssemblerBase::VERTICES_DIRTY);
+}
+
+bool Assembler::getLocalAABB(cocos2d::Vec3& min, cocos2d::Vec3& max) const
+{
+    if (!_hasLocalAABB || _ignoreWorldMatrix)
+    {
+        return false;
+    }
+    min = _localAABBMin;
+    max = _localAABBMax;
+    return true;
+}
+
 void Assembler::updateEffect(std::size_t iaIndex, EffectVariant* effect)
 {
     if (iaIndex >= _iaDatas.size())
@@ -122,11 +158,22 @@ void Assembler::updateEffect(std::size_t iaIndex, EffectVariant* effect)
     }
     IARenderData& ia = _iaDatas[iaIndex];
     ia.setEffect(effect);
+    enableDirty(AssemblerBase::VERTICES_DIRTY);
 }
 
 void Assembler::reset()
 {
     _iaDatas.clear();
+    releaseAtlasFrames();
+}
+
+void Assembler::releaseAtlasFrames()
+{
+    for (const auto& iter : _remappedUVs)
+    {
+        DynamicAtlasManager::releaseFrame(iter.second.frameID);
+    }
+    _remappedUVs.clear();
 }
 
 void Assembler::handle(NodeProxy *node, ModelBatcher* batcher, Scene* scene)
@@ -155,55 +202,108 @@ void Assembler::fillBuffers(NodeProxy* node, ModelBatcher* batcher, std::size_t
     CCASSERT(data->getVBytes() % _bytesPerVertex == 0, "Assembler::fillBuffers vertices data doesn't follow vertex format");
     uint32_t vertexCount = ia.verticesCount >= 0 ? (uint32_t)ia.verticesCount : (uint32_t)data->getVBytes() / _bytesPerVertex;
     uint32_t indexCount = ia.indicesCount >= 0 ? (uint32_t)ia.indicesCount : (uint32_t)data->getIBytes() / sizeof(unsigned short);
-    uint32_t vertexStart = (uint32_t)ia.verticesStart;
     
     // must retrieve offset before request
-    auto& bufferOffset = buffer->request(vertexCount, indexCount);
-    uint32_t vBufferOffset = bufferOffset.vByte / sizeof(float);
-    uint32_t indexId = bufferOffset.index;
-    uint32_t vertexId = bufferOffset.vertex;
-    uint32_t vertexOffset = vertexId - vertexStart;
-    uint32_t num = _vfPos->num;
+    buffer->request(vertexCount, indexCount);
+    auto& bufferOffset = buffer->commitStreams(this, index, getDirtyStreams(node, index));
+    batcher->commitFill(node, this, buffer, index, bufferOffset, false);
+    
+    // world vertices are always recalculated, only culling cares about the flag
+    disableDirty(AssemblerBase::VERTICES_DIRTY);
+}
+
+uint32_t Assembler::getDirtyStreams(NodeProxy* node, std::size_t index)
+{
+    if (_vfmt->getStreamCount() == 1)
+    {
+        return ~0u;
+    }
+    
+    // Render datas which were never filled are dirty.
+    if (_dirtyStreams.size() < _iaDatas.size())
+    {
+        _dirtyStreams.resize(_iaDatas.size(), ~0u);
+    }
+    // The flag is cleared by the first fill, but it applies to all render datas.
+    if (isDirty(AssemblerBase::VERTICES_DIRTY))
+    {
+        std::fill(_dirtyStreams.begin(), _dirtyStreams.end(), ~0u);
+    }
+    
+    uint32_t streams = _dirtyStreams[index];
+    _dirtyStreams[index] = 0;
+    // The JS side writes the vertices of the node again for these flags.
+    if (node->isDirty(RenderFlow::UPDATE_RENDER_DATA))
+    {
+        return ~0u;
+    }
+    if (_vfColor && node->isDirty(RenderFlow::COLOR))
+    {
+        streams |= 1u << _vfColor->stream;
+    }
+    if (!_useModel && !_ignoreWorldMatrix && node->isDirty(RenderFlow::WORLD_TRANSFORM_CHANGED))
+    {
+        streams |= 1u << _vfPos->stream;
+    }
+    return streams;
+}
 
-    float* worldVerts = buffer->vData + vBufferOffset;
-    memcpy(worldVerts, data->getVertices() + vertexStart * _bytesPerVertex, vertexCount * _bytesPerVertex);
+void Assembler::fillRange(NodeProxy* node, MeshBuffer* buffer, std::size_t index, const MeshBuffer::OffsetInfo& offset, bool updateWorld)
+{
+    const IARenderData& ia = _iaDatas[index];
+    std::size_t meshIndex = ia.meshIndex >= 0 ? ia.meshIndex : index;
+    RenderData* data = _datas->getRenderData(meshIndex);
+    
+    uint32_t vertexCount = ia.verticesCount >= 0 ? (uint32_t)ia.verticesCount : (uint32_t)data->getVBytes() / _bytesPerVertex;
+    uint32_t indexCount = ia.indicesCount >= 0 ? (uint32_t)ia.indicesCount : (uint32_t)data->getIBytes() / sizeof(unsigned short);
+    uint32_t vertexStart = (uint32_t)ia.verticesStart;
+    
+    uint32_t vertexOffset = offset.vertex - vertexStart;
     
-    // Calculate vertices world positions
-    if (!_useModel && !_ignoreWorldMatrix)
+    if (_vfmt->getStreamCount() > 1)
     {
-        size_t dataPerVertex = _bytesPerVertex / sizeof(float);
-        float* ptrPos = worldVerts + _posOffset;
-        auto& worldMat = node->getWorldMatrix();
+        fillStreams(node, buffer, data->getVertices() + vertexStart * _bytesPerVertex, vertexCount, offset, !_useModel && !_ignoreWorldMatrix);
+    }
+    else
+    {
+        uint32_t vBufferOffset = offset.vByte / sizeof(float);
+        uint32_t num = _vfPos->num;
+        float* worldVerts = buffer->vData + vBufferOffset;
+        memcpy(worldVerts, data->getVertices() + vertexStart * _bytesPerVertex, vertexCount * _bytesPerVertex);
         
-        switch (num) {
-           // Vertex is X Y Z Format
-            case 3:
-                for (uint32_t i = 0; i < vertexCount; ++i)
-                {
-                    ((cocos2d::Vec3*)ptrPos)->transformMat4(*((cocos2d::Vec3*)ptrPos), worldMat);
-                    ptrPos += dataPerVertex;
-                }
-                break;
-            // Vertex is X Y Format
-            case 2:
-                for (uint32_t i = 0; i < vertexCount; ++i)
-                {
-                    float z = ptrPos[2];
-                    ptrPos[2] = 0;
-                    worldMat.transformPoint((cocos2d::Vec3*)ptrPos);
-                    ptrPos[2] = z;
-                    ptrPos += dataPerVertex;
-                }
-                break;
+        // Calculate vertices world positions
+        if (!_useModel && !_ignoreWorldMatrix)
+        {
+            size_t dataPerVertex = _bytesPerVertex / sizeof(float);
+            MathKernel::transformPositions(worldVerts + _posOffset, dataPerVertex, vertexCount, num, node->getWorldMatrix());
         }
     }
     
     // Copy index buffer with vertex offset
     uint16_t* indices = (uint16_t*)data->getIndices();
-    uint16_t* dst = buffer->iData;
-    for (auto i = 0, j = ia.indicesStart; i < indexCount; ++i, ++j)
+    MathKernel::rebaseIndices(indices + ia.indicesStart, buffer->iData + offset.index, indexCount, (uint16_t)vertexOffset);
+}
+
+void Assembler::fillStreams(NodeProxy* node, MeshBuffer* buffer, const uint8_t* vertices, uint32_t vertexCount, const MeshBuffer::OffsetInfo& offset, bool transform)
+{
+    uint32_t posStream = (uint32_t)_vfPos->stream;
+    for (uint32_t stream = 0, streamCount = _vfmt->getStreamCount(); stream < streamCount; ++stream)
     {
-        dst[indexId++] = vertexOffset + indices[j];
+        if (!(offset.streams & (1u << stream)))
+        {
+            continue;
+        }
+        
+        uint32_t streamBytes = _vfmt->getStreamBytes(stream);
+        uint8_t* streamVerts = buffer->getStreamData(stream) + offset.vertex * streamBytes;
+        _vfmt->copyStream(stream, vertices, streamVerts, vertexCount);
+        
+        // Calculate vertices world positions in the stream of position
+        if (stream == posStream && transform)
+        {
+            float* worldVerts = (float*)streamVerts + _vfPos->offset / sizeof(float);
+            MathKernel::transformPositions(worldVerts, streamBytes / sizeof(float), vertexCount, _vfPos->num, node->getWorldMatrix());
+        }
     }
 }
 
@@ -217,12 +317,13 @@ void Assembler::setVertexFormat(VertexFormat* vfmt)
     {
         _bytesPerVertex = _vfmt->getBytes();
         _vfPos = _vfmt->getElement(ATTRIB_NAME_POSITION_HASH);
-        _posOffset = _vfPos->offset / 4;
+        _posOffset = _vfPos->packedOffset / 4;
         _vfColor = _vfmt->getElement(ATTRIB_NAME_COLOR_HASH);
         if (_vfColor != nullptr)
         {
-            _alphaOffset = _vfColor->offset + 3;
+            _alphaOffset = _vfColor->packedOffset + 3;
         }
+        _dirtyStreams.clear();
     }
 }
 
@@ -262,7 +363,73 @@ void Assembler::updateOpacity(std::size_t index, uint8_t opacity)
         ptrAlpha += dataPerVertex;
     }
     
+    if (index < _dirtyStreams.size())
+    {
+        _dirtyStreams[index] |= 1u << _vfColor->stream;
+    }
+    
     *_dirty &= ~VERTICES_OPACITY_CHANGED;
 }
 
+void Assembler::remapUVs(std::size_t iaIndex, float scaleU, float offsetU, float scaleV, float offsetV, uint32_t frameID)
+{
+    if (!_datas || !_vfmt || iaIndex >= _iaDatas.size())
+    {
+        return;
+    }
+    
+    const VertexFormat::Element* vfUV = _vfmt->getElement(ATTRIB_NAME_UV0_HASH);
+    if (!vfUV || vfUV->type != AttribType::FLOAT32 || vfUV->num < 2)
+    {
+        return;
+    }
+    
+    const IARenderData& ia = _iaDatas[iaIndex];
+    std::size_t meshIndex = ia.meshIndex >= 0 ? ia.meshIndex : iaIndex;
+    RenderData* data = _datas->getRenderData(meshIndex);
+    if (!data)
+    {
+        return;
+    }
+    
+    uint32_t vertexCount = ia.verticesCount >= 0 ? (uint32_t)ia.verticesCount : (uint32_t)data->getVBytes() / _bytesPerVertex;
+    size_t dataPerVertex = _bytesPerVertex / sizeof(float);
+    float* ptrUV = (float*)(data->getVertices() + ia.verticesStart * _bytesPerVertex + vfUV->offset);
+    
+    // The uv are the ones written by the last remap unless the vertices are written again, then they are the new source uv.
+    RemappedUVs& remapped = _remappedUVs[iaIndex];
+    bool rewritten = remapped.remapped.size() != vertexCount * 2;
+    for (uint32_t i = 0; i < vertexCount && !rewritten; ++i)
+    {
+        const float* uv = ptrUV + i * dataPerVertex;
+        rewritten = uv[0] != remapped.remapped[i * 2] || uv[1] != remapped.remapped[i * 2 + 1];
+    }
+    if (rewritten)
+    {
+        remapped.source.resize(vertexCount * 2);
+        for (uint32_t i = 0; i < vertexCount; ++i)
+        {
+            const float* uv = ptrUV + i * dataPerVertex;
+            remapped.source[i * 2] = uv[0];
+            remapped.source[i * 2 + 1] = uv[1];
+        }
+        remapped.remapped.resize(vertexCount * 2);
+    }
+    
+    for (uint32_t i = 0; i < vertexCount; ++i)
+    {
+        ptrUV[0] = remapped.remapped[i * 2] = remapped.source[i * 2] * scaleU + offsetU;
+        ptrUV[1] = remapped.remapped[i * 2 + 1] = remapped.source[i * 2 + 1] * scaleV + offsetV;
+        ptrUV += dataPerVertex;
+    }
+    
+    if (remapped.frameID != frameID)
+    {
+        DynamicAtlasManager::retainFrame(frameID);
+        DynamicAtlasManager::releaseFrame(remapped.frameID);
+        remapped.frameID = frameID;
+    }
+    enableDirty(VERTICES_DIRTY);
+}
+
 RENDERER_END
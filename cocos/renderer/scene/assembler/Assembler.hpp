@@ -31,6 +31,7 @@
 #include "../../renderer/Effect.h"
 #include "RenderDataList.hpp"
 #include "../../renderer/EffectVariant.hpp"
+#include <unordered_map>
 
 namespace se {
     class Object;
@@ -89,6 +90,27 @@ public:
      *  @param[in] node
      */
     virtual void fillBuffers(NodeProxy* node, ModelBatcher* batcher, std::size_t index);
+    /*
+     *  @brief Copies render data in given index to the range reserved by fillBuffers.
+     *  It may run on a worker thread if the ModelBatcher fills in parallel, so it should only touch render data of its own.
+     *  @param[in] node
+     *  @param[in] buffer The shared mesh buffer
+     *  @param[in] index The index of render data to be updated
+     *  @param[in] offset The reserved range
+     *  @param[in] updateWorld Whether world vertices should be recalculated
+     */
+    virtual void fillRange(NodeProxy* node, MeshBuffer* buffer, std::size_t index, const MeshBuffer::OffsetInfo& offset, bool updateWorld);
+    /*
+     *  @brief Copies vertices to the streams of the range which should be written, it's used by fillRange if the vertex format has several streams.
+     *  Render datas keep all streams packed in declaration order, only positions are transformed.
+     *  @param[in] node
+     *  @param[in] buffer The shared mesh buffer
+     *  @param[in] vertices Packed vertices to copy
+     *  @param[in] vertexCount Count of vertices
+     *  @param[in] offset The reserved range, OffsetInfo::streams tells which streams should be written
+     *  @param[in] transform Whether positions are transformed by the world matrix of the node, false if the vertices are in world space already
+     */
+    void fillStreams(NodeProxy* node, MeshBuffer* buffer, const uint8_t* vertices, uint32_t vertexCount, const MeshBuffer::OffsetInfo& offset, bool transform);
     
     /**
      *  @brief Sets IArenderDataList
@@ -133,6 +155,22 @@ public:
      */
     bool isIgnoreWorldMatrix() { return _ignoreWorldMatrix; }
     
+    /**
+     *  @brief Sets the local bounding box, the node will be culled if the box is out of all cameras.
+     */
+    void setLocalAABB(float minX, float minY, float minZ, float maxX, float maxY, float maxZ);
+    /**
+     *  @brief Clears the local bounding box set by setLocalAABB.
+     */
+    void clearLocalAABB();
+    /**
+     *  @brief Gets the local bounding box set by setLocalAABB, vertices in world space are never culled.
+     */
+    virtual bool getLocalAABB(cocos2d::Vec3& min, cocos2d::Vec3& max) const override;
+    /**
+     *  @brief Render datas of assembler are only copied to the batch buffers, they can be cached.
+     */
+    virtual bool isStaticBatchable() const override { return true; }
     /**
      *  @brief Updates mesh index
      */
@@ -147,6 +185,15 @@ public:
      */
     void updateVerticesRange(std::size_t iaIndex, int start, int count);
     
+    /**
+     *  @brief Maps the first uv of the vertices drawn by the render data to u * scaleU + offsetU and v * scaleV + offsetV,
+     *  it is used to move the uv into a texture atlas. The source uv are kept, so remapping vertices which are not
+     *  written again since the last remap starts from the source uv instead of remapping twice.
+     *  @param[in] iaIndex Render data index.
+     *  @param[in] frameID Atlas frame the uv are moved into, the render data keeps its page from being cleared until another frame is set or the assembler is reset.
+     */
+    void remapUVs(std::size_t iaIndex, float scaleU, float offsetU, float scaleV, float offsetV, uint32_t frameID = 0);
+    
     /**
      *  @brief Update the material for the given index.
      *  @param[in] iaIndex Render data index.
@@ -182,6 +229,25 @@ public:
         return _iaDatas.size();
     }
 protected:
+    /*
+     *  @brief Gets the streams of a render data changed since its last fill, it's passed to MeshBuffer::commitStreams.
+     *  All streams are dirty if the vertices are dirty or the JS side updated the render data of the node, the color stream is
+     *  dirty if the opacity or the color is updated, and the position stream if the positions are transformed by a new world matrix.
+     */
+    uint32_t getDirtyStreams(NodeProxy* node, std::size_t index);
+    /*
+     *  @brief Drops the references of all render datas to atlas frames.
+     */
+    void releaseAtlasFrames();
+    
+    // Uv of a render data before and after the last remapUVs, and the atlas frame they are moved into.
+    struct RemappedUVs
+    {
+        uint32_t frameID = 0;
+        std::vector<float> source;
+        std::vector<float> remapped;
+    };
+    
     RenderDataList* _datas = nullptr;
     std::vector<IARenderData> _iaDatas;
     
@@ -191,9 +257,16 @@ protected:
     VertexFormat* _vfmt = nullptr;
     const VertexFormat::Element* _vfPos = nullptr;
     const VertexFormat::Element* _vfColor = nullptr;
+    // Streams changed since the last fill of every render data, only used if the vertex format has several streams.
+    std::vector<uint32_t> _dirtyStreams;
+    std::unordered_map<std::size_t, RemappedUVs> _remappedUVs;
     
     bool _ignoreWorldMatrix = false;
     bool _ignoreOpacityFlag = false;
+    
+    bool _hasLocalAABB = false;
+    cocos2d::Vec3 _localAABBMin;
+    cocos2d::Vec3 _localAABBMax;
 };
 
 // end of scene group
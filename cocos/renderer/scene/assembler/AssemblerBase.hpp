@@ -27,6 +27,7 @@
 #include "../../Macro.h"
 #include <stdint.h>
 #include "base/CCVector.h"
+#include "math/Vec3.h"
 #include "../../renderer/Effect.h"
 #include "scripting/js-bindings/jswrapper/Object.hpp"
 
@@ -128,6 +129,18 @@ public:
         return false;
     }
     
+    /**
+     *  @brief Gets the local bounding box used by culling.
+     *  @param[out] min Minimum corner in node space.
+     *  @param[out] max Maximum corner in node space.
+     *  @return False if the assembler has no bounds, it will never be culled.
+     */
+    virtual bool getLocalAABB(cocos2d::Vec3& min, cocos2d::Vec3& max) const { return false; }
+    /**
+     *  @brief Whether the batched result can be cached by a static batch.
+     *  It should be false if the assembler changes render states or buffers without dirty flags.
+     */
+    virtual bool isStaticBatchable() const { return false; }
     /**
      *  @brief Resets data.
      */
@@ -24,6 +24,7 @@
 
 #include "AssemblerSprite.hpp"
 #include "../RenderFlow.hpp"
+#include "../MathKernel.hpp"
 
 RENDERER_BEGIN
 
@@ -60,6 +61,34 @@ void AssemblerSprite::setLocalData(se_object_ptr localData)
     _localObj->getTypedArrayData((uint8_t**)&_localData, (std::size_t*)&_localLen);
 }
 
+bool AssemblerSprite::getLocalAABB(cocos2d::Vec3& min, cocos2d::Vec3& max) const
+{
+    if (_hasLocalAABB || _ignoreWorldMatrix)
+    {
+        return Assembler::getLocalAABB(min, max);
+    }
+    
+    // local data is a list of x, y pairs, such as [l, b, r, t] of simple sprite
+    // or the 4 x 4 grid lines of sliced sprite
+    std::size_t count = _localLen / sizeof(float);
+    if (!_localData || count < 4)
+    {
+        return false;
+    }
+    
+    min.set(_localData[0], _localData[1], 0.0f);
+    max.set(_localData[0], _localData[1], 0.0f);
+    for (std::size_t i = 2; i + 1 < count; i += 2)
+    {
+        float x = _localData[i], y = _localData[i + 1];
+        if (x < min.x) min.x = x;
+        if (x > max.x) max.x = x;
+        if (y < min.y) min.y = y;
+        if (y > max.y) max.y = y;
+    }
+    return true;
+}
+
 void AssemblerSprite::fillBuffers(NodeProxy* node, ModelBatcher* batcher, std::size_t index)
 {
     if(!_datas || !_vfmt)
@@ -86,31 +115,52 @@ void AssemblerSprite::fillBuffers(NodeProxy* node, ModelBatcher* batcher, std::s
     CCASSERT(data->getVBytes() % _bytesPerVertex == 0, "AssemblerSprite::fillBuffers vertices data doesn't follow vertex format");
     uint32_t vertexCount = ia.verticesCount >= 0 ? (uint32_t)ia.verticesCount : (uint32_t)data->getVBytes() / _bytesPerVertex;
     uint32_t indexCount = ia.indicesCount >= 0 ? (uint32_t)ia.indicesCount : (uint32_t)data->getIBytes() / sizeof(unsigned short);
-    uint32_t vertexStart = (uint32_t)ia.verticesStart;
     
     // must retrieve offset before request
-    auto& bufferOffset = buffer->request(vertexCount, indexCount);
-    uint32_t vBufferOffset = bufferOffset.vByte / sizeof(float);
-    uint32_t indexId = bufferOffset.index;
-    uint32_t vertexId = bufferOffset.vertex;
-    uint32_t vertexOffset = vertexId - vertexStart;
+    buffer->request(vertexCount, indexCount);
+    auto& bufferOffset = buffer->commitStreams(this, index, getDirtyStreams(node, index));
+    
+    bool updateWorld = *_dirty & VERTICES_DIRTY || node->isDirty(RenderFlow::WORLD_TRANSFORM_CHANGED | RenderFlow::NODE_OPACITY_CHANGED);
+    if (updateWorld)
+    {
+        // clear it now, the world vertices may be calculated later by the batcher
+        *_dirty &= ~VERTICES_DIRTY;
+    }
+    batcher->commitFill(node, this, buffer, index, bufferOffset, updateWorld);
+}
+
+void AssemblerSprite::fillRange(NodeProxy* node, MeshBuffer* buffer, std::size_t index, const MeshBuffer::OffsetInfo& offset, bool updateWorld)
+{
+    const IARenderData& ia = _iaDatas[index];
+    std::size_t meshIndex = ia.meshIndex >= 0 ? ia.meshIndex : index;
+    RenderData* data = _datas->getRenderData(meshIndex);
+    
+    uint32_t vertexCount = ia.verticesCount >= 0 ? (uint32_t)ia.verticesCount : (uint32_t)data->getVBytes() / _bytesPerVertex;
+    uint32_t indexCount = ia.indicesCount >= 0 ? (uint32_t)ia.indicesCount : (uint32_t)data->getIBytes() / sizeof(unsigned short);
+    uint32_t vertexStart = (uint32_t)ia.verticesStart;
+    uint32_t vBufferOffset = offset.vByte / sizeof(float);
+    uint32_t vertexOffset = offset.vertex - vertexStart;
     
-    if (*_dirty & VERTICES_DIRTY || node->isDirty(RenderFlow::WORLD_TRANSFORM_CHANGED | RenderFlow::NODE_OPACITY_CHANGED))
+    if (updateWorld)
     {
         generateWorldVertices();
         calculateWorldVertices(node->getWorldMatrix());
     }
     
-    float* dstWorldVerts = buffer->vData + vBufferOffset;
-    memcpy(dstWorldVerts, data->getVertices() + vertexStart * _bytesPerVertex, vertexCount * _bytesPerVertex);
+    // The render data holds world vertices already.
+    if (_vfmt->getStreamCount() > 1)
+    {
+        fillStreams(node, buffer, data->getVertices() + vertexStart * _bytesPerVertex, vertexCount, offset, false);
+    }
+    else
+    {
+        float* dstWorldVerts = buffer->vData + vBufferOffset;
+        memcpy(dstWorldVerts, data->getVertices() + vertexStart * _bytesPerVertex, vertexCount * _bytesPerVertex);
+    }
     
     // Copy index buffer with vertex offset
     uint16_t* srcIndices = (uint16_t*)data->getIndices();
-    uint16_t* dstIndices = buffer->iData;
-    for (auto i = 0, j = ia.indicesStart; i < indexCount; ++i, ++j)
-    {
-        dstIndices[indexId++] = vertexOffset + srcIndices[j];
-    }
+    MathKernel::rebaseIndices(srcIndices + ia.indicesStart, buffer->iData + offset.index, indexCount, (uint16_t)vertexOffset);
 }
 
 void AssemblerSprite::calculateWorldVertices(const Mat4& worldMat)
@@ -133,26 +183,7 @@ void AssemblerSprite::calculateWorldVertices(const Mat4& worldMat)
         uint32_t vertexCount = ia.verticesCount >= 0 ? (uint32_t)ia.verticesCount : (uint32_t)data->getVBytes() / _bytesPerVertex;
         uint32_t vertexStart = (uint32_t)ia.verticesStart;
         float* srcWorldVerts = (float*)(data->getVertices() + vertexStart * _bytesPerVertex) + _posOffset;
-        
-        switch (num) {
-            case 3:
-                for (uint32_t i = 0; i < vertexCount; ++i)
-                {
-                    ((cocos2d::Vec3*)srcWorldVerts)->transformMat4(*((cocos2d::Vec3*)srcWorldVerts), worldMat);
-                    srcWorldVerts += dataPerVertex;
-                }
-                break;
-            case 2:
-                for (uint32_t i = 0; i < vertexCount; ++i)
-                {
-                    float z = srcWorldVerts[2];
-                    srcWorldVerts[2] = 0;
-                    worldMat.transformPoint((cocos2d::Vec3*)srcWorldVerts);
-                    srcWorldVerts[2] = z;
-                    srcWorldVerts += dataPerVertex;
-                }
-                break;
-        }
+        MathKernel::transformPositions(srcWorldVerts, dataPerVertex, vertexCount, num, worldMat);
     }
     
     *_dirty &= ~VERTICES_DIRTY;
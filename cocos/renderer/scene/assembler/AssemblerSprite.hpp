@@ -37,8 +37,13 @@ public:
     virtual ~AssemblerSprite();
     virtual void setLocalData(se_object_ptr localData);
     virtual void fillBuffers(NodeProxy* node, ModelBatcher* batcher, std::size_t index) override;
+    virtual void fillRange(NodeProxy* node, MeshBuffer* buffer, std::size_t index, const MeshBuffer::OffsetInfo& offset, bool updateWorld) override;
     virtual void calculateWorldVertices(const Mat4& worldMat);
     virtual void generateWorldVertices() {};
+    /**
+     *  @brief Gets the local bounding box, it is computed from local data if not set explicitly.
+     */
+    virtual bool getLocalAABB(cocos2d::Vec3& min, cocos2d::Vec3& max) const override;
 protected:
     se::Object* _localObj = nullptr;
     float* _localData = nullptr;
@@ -25,6 +25,8 @@
 #include "MaskAssembler.hpp"
 #include "../ModelBatcher.hpp"
 #include "../StencilManager.hpp"
+#include "../RenderFlow.hpp"
+#include <algorithm>
 #include "../../Macro.h"
 
 RENDERER_BEGIN
@@ -55,12 +57,43 @@ void MaskAssembler::setClearSubHandle(Assembler* clearSubHandle)
     CC_SAFE_RETAIN(_clearSubHandle);
 }
 
+void MaskAssembler::setScissorRect(float x, float y, float w, float h)
+{
+    _scissorRect.set(x, y, w, h);
+    _scissorRectEnabled = true;
+}
+
+bool MaskAssembler::pushScissor(NodeProxy *node, ModelBatcher* batcher)
+{
+    if (!_scissorRectEnabled || _inverted || _imageStencil) return false;
+    
+    const cocos2d::Mat4& worldMat = node->getWorldMatrix();
+    if (!batcher->getFlow()->isScreenAligned(worldMat, node->getCullingMask())) return false;
+    
+    // The world matrix only scales, translates or swaps axes, so two corners give the world rectangle.
+    cocos2d::Vec3 min(_scissorRect.x, _scissorRect.y, 0);
+    cocos2d::Vec3 max(_scissorRect.x + _scissorRect.w, _scissorRect.y + _scissorRect.h, 0);
+    worldMat.transformPoint(&min);
+    worldMat.transformPoint(&max);
+    
+    float x = std::min(min.x, max.x);
+    float y = std::min(min.y, max.y);
+    Rect rect(x, y, std::max(min.x, max.x) - x, std::max(min.y, max.y) - y);
+    return StencilManager::getInstance()->pushScissor(rect, min.z);
+}
+
 void MaskAssembler::handle(NodeProxy *node, ModelBatcher* batcher, Scene* scene)
 {
     batcher->flush();
     batcher->flushIA();
 
     StencilManager* instance = StencilManager::getInstance();
+    _useScissor = pushScissor(node, batcher);
+    if (_useScissor)
+    {
+        return;
+    }
+    
     instance->pushMask(_inverted);
     instance->clear();
     batcher->commit(node, _clearSubHandle, node->getCullingMask());
@@ -85,7 +118,15 @@ void MaskAssembler::postHandle(NodeProxy *node, ModelBatcher *batcher, Scene *sc
     batcher->flush();
     batcher->flushIA();
     batcher->setCurrentEffect(getEffect(0));
-    StencilManager::getInstance()->exitMask();
+    if (_useScissor)
+    {
+        StencilManager::getInstance()->exitScissor();
+    }
+    else
+    {
+        StencilManager::getInstance()->exitMask();
+    }
+    _useScissor = false;
 }
 
 RENDERER_END
@@ -41,6 +41,10 @@ public:
     virtual ~MaskAssembler();
     virtual void handle(NodeProxy *node, ModelBatcher* batcher, Scene* scene) override;
     virtual void postHandle(NodeProxy *node, ModelBatcher* batcher, Scene* scene) override;
+    // Stencil state is pushed and popped around children, so mask is never culled.
+    virtual bool getLocalAABB(cocos2d::Vec3& min, cocos2d::Vec3& max) const override { return false; }
+    // Stencil states are changed by the handles, they must run every frame.
+    virtual bool isStaticBatchable() const override { return false; }
 
     void setMaskInverted(bool inverted) { _inverted = inverted; };
     bool getMaskInverted() { return _inverted; };
@@ -49,12 +53,27 @@ public:
     void setClearSubHandle(Assembler* clearSubHandle);
 
     void setImageStencil(bool isImageStencil) { _imageStencil = isImageStencil; };
+    /**
+     *  @brief Sets the local rectangle of a rectangle mask, it is clipped by scissor instead of stencil while it is axis aligned on screen.
+     */
+    void setScissorRect(float x, float y, float w, float h);
+    /**
+     *  @brief Clears the rectangle, the mask always uses stencil.
+     */
+    void clearScissorRect() { _scissorRectEnabled = false; };
     
 protected:
     bool _inverted = false;
     bool _imageStencil = false;
+    
+    bool _scissorRectEnabled = false;
+    Rect _scissorRect;
+    // Whether the current handle pushed a scissor rectangle instead of a stencil level.
+    bool _useScissor = false;
 
 private:
+    bool pushScissor(NodeProxy *node, ModelBatcher* batcher);
+    
     Assembler* _renderSubHandle = nullptr;
     Assembler* _clearSubHandle = nullptr;
 };
@@ -24,6 +24,7 @@ THE SOFTWARE.
 
 #include "Particle3DAssembler.hpp"
 #include "../NodeProxy.hpp"
+#include "../MathKernel.hpp"
 
 RENDERER_BEGIN
 
@@ -70,11 +71,7 @@ void Particle3DAssembler::fillBuffer(NodeProxy *node, MeshBuffer *buffer, const
     
     // Copy index buffer with vertex offset
     uint16_t* indices = (uint16_t*)data->getIndices();
-    uint16_t* dst = buffer->iData;
-    for (auto i = 0, j = ia.indicesStart; i < indexCount; ++i, ++j)
-    {
-        dst[indexId++] = vertexOffset + indices[j];
-    }
+    MathKernel::rebaseIndices(indices + ia.indicesStart, buffer->iData + indexId, indexCount, (uint16_t)vertexOffset);
 }
 
 void Particle3DAssembler::fillTrailBuffer(NodeProxy *node, MeshBuffer *buffer, const IARenderData& ia, RenderData* data)
@@ -96,11 +93,7 @@ void Particle3DAssembler::fillTrailBuffer(NodeProxy *node, MeshBuffer *buffer, c
     
     // Copy index buffer with vertex offset
     uint16_t* indices = (uint16_t*)data->getIndices();
-    uint16_t* dst = buffer->iData;
-    for (auto i = 0, j = ia.indicesStart; i < indexCount; ++i, ++j)
-    {
-        dst[indexId++] = vertexOffset + indices[j];
-    }
+    MathKernel::rebaseIndices(indices + ia.indicesStart, buffer->iData + indexId, indexCount, (uint16_t)vertexOffset);
 }
 
 void Particle3DAssembler::fillBuffers(NodeProxy *node, ModelBatcher *batcher, std::size_t index)
@@ -46,6 +46,8 @@ public:
     ~Particle3DAssembler();
     
     virtual void fillBuffers(NodeProxy *node, ModelBatcher *batcher, std::size_t index) override;
+    // Particles are simulated every frame.
+    virtual bool isStaticBatchable() const override { return false; }
     void setTrailVertexFormat(VertexFormat* vfmt);
     void setTrailModuleEnable(bool enable) {_trailModuleEnable = enable;};
     
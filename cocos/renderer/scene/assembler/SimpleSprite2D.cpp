@@ -24,6 +24,7 @@
 
 #include "SimpleSprite2D.hpp"
 #include "../RenderFlow.hpp"
+#include "../MathKernel.hpp"
 
 RENDERER_BEGIN
 
@@ -48,12 +49,23 @@ void SimpleSprite2D::fillBuffers(NodeProxy* node, ModelBatcher* batcher, std::si
     MeshBuffer* buffer = batcher->getBuffer(_vfmt);
     
     // must retrieve offset before request
-    auto& bufferOffset = buffer->request(4, 6);
-    uint32_t vBufferOffset = bufferOffset.vByte / sizeof(float);
-    uint32_t indexId = bufferOffset.index;
-    uint32_t vertexId = bufferOffset.vertex;
+    buffer->request(4, 6);
+    auto& bufferOffset = buffer->commitStreams(this, index, getDirtyStreams(node, index));
     
-    if (*_dirty & VERTICES_DIRTY || node->isDirty(RenderFlow::WORLD_TRANSFORM_CHANGED | RenderFlow::NODE_OPACITY_CHANGED))
+    bool updateWorld = *_dirty & VERTICES_DIRTY || node->isDirty(RenderFlow::WORLD_TRANSFORM_CHANGED | RenderFlow::NODE_OPACITY_CHANGED);
+    if (updateWorld)
+    {
+        *_dirty &= ~VERTICES_DIRTY;
+    }
+    batcher->commitFill(node, this, buffer, index, bufferOffset, updateWorld);
+}
+
+void SimpleSprite2D::fillRange(NodeProxy* node, MeshBuffer* buffer, std::size_t index, const MeshBuffer::OffsetInfo& offset, bool updateWorld)
+{
+    RenderData* data = _datas->getRenderData(0);
+    uint32_t vBufferOffset = offset.vByte / sizeof(float);
+    
+    if (updateWorld)
     {
         float vl = _localData[0],
         vr = _localData[2],
@@ -64,42 +76,28 @@ void SimpleSprite2D::fillBuffers(NodeProxy* node, ModelBatcher* batcher, std::si
         size_t dataPerVertex = _bytesPerVertex / sizeof(float);
         float* srcWorldVerts = (float*)data->getVertices();
         
-        // left bottom
-        float u = srcWorldVerts[2];
-        worldMat.transformVector(vl, vb, 0.0f, 1.0f, (cocos2d::Vec3*)srcWorldVerts);
-        srcWorldVerts[2] = u;
-
-        // right bottom
-        srcWorldVerts += dataPerVertex;
-        u = srcWorldVerts[2];
-        worldMat.transformVector(vr, vb, 0.0f, 1.0f, (cocos2d::Vec3*)srcWorldVerts);
-        srcWorldVerts[2] = u;
-
-        // left top
-        srcWorldVerts += dataPerVertex;
-        u = srcWorldVerts[2];
-        worldMat.transformVector(vl, vt, 0.0f, 1.0f, (cocos2d::Vec3*)srcWorldVerts);
-        srcWorldVerts[2] = u;
-
-        // right top
-        srcWorldVerts += dataPerVertex;
-        u = srcWorldVerts[2];
-        worldMat.transformVector(vr, vt, 0.0f, 1.0f, (cocos2d::Vec3*)srcWorldVerts);
-        srcWorldVerts[2] = u;
-        
-        *_dirty &= ~VERTICES_DIRTY;
+        // left bottom, right bottom, left top, right top
+        float* ptrPos = srcWorldVerts;
+        ptrPos[0] = vl; ptrPos[1] = vb; ptrPos += dataPerVertex;
+        ptrPos[0] = vr; ptrPos[1] = vb; ptrPos += dataPerVertex;
+        ptrPos[0] = vl; ptrPos[1] = vt; ptrPos += dataPerVertex;
+        ptrPos[0] = vr; ptrPos[1] = vt;
+        MathKernel::transformPositions(srcWorldVerts, dataPerVertex, 4, 2, worldMat);
     }
     
-    float* dstWorldVerts = buffer->vData + vBufferOffset;
-    memcpy(dstWorldVerts, data->getVertices(), 4 * _bytesPerVertex);
+    if (_vfmt->getStreamCount() > 1)
+    {
+        fillStreams(node, buffer, data->getVertices(), 4, offset, false);
+    }
+    else
+    {
+        float* dstWorldVerts = buffer->vData + vBufferOffset;
+        memcpy(dstWorldVerts, data->getVertices(), 4 * _bytesPerVertex);
+    }
 
     // Copy index buffer with vertex offset
     uint16_t* srcIndices = (uint16_t*)data->getIndices();
-    uint16_t* dstIndices = buffer->iData;
-    for (auto i = 0, j = 0; i < 6; ++i, ++j)
-    {
-        dstIndices[indexId++] = vertexId + srcIndices[j];
-    }
+    MathKernel::rebaseIndices(srcIndices, buffer->iData + offset.index, 6, (uint16_t)offset.vertex);
 }
 
 RENDERER_END
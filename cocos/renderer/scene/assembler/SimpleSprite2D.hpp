@@ -34,6 +34,7 @@ public:
     SimpleSprite2D();
     virtual ~SimpleSprite2D();
     virtual void fillBuffers(NodeProxy* node, ModelBatcher* batcher, std::size_t index) override;
+    virtual void fillRange(NodeProxy* node, MeshBuffer* buffer, std::size_t index, const MeshBuffer::OffsetInfo& offset, bool updateWorld) override;
 };
 
 RENDERER_END
@@ -26,9 +26,19 @@
 #include "../NodeProxy.hpp"
 #include "../ModelBatcher.hpp"
 #include "../RenderFlow.hpp"
+#include "../MathKernel.hpp"
+#include <unordered_map>
+#include <unordered_set>
+#include <cmath>
+#include <cfloat>
 
 RENDERER_BEGIN
 
+// Tiles are on the grid if their size and position are within this part of a cell.
+static const float GRID_TOLERANCE = 0.001f;
+
+static_assert(TiledMapAssembler::MAX_CHUNK_SIZE * TiledMapAssembler::MAX_CHUNK_SIZE * 4 <= TiledMapAssembler::MAX_FILL_VERTICES, "vertices of a chunk must fit in one fill");
+
 TiledMapAssembler::TiledMapAssembler()
 {
     
@@ -49,14 +59,178 @@ void TiledMapAssembler::clearNodes(std::size_t iaIndex)
     _nodesMap.erase(iaIndex);
 }
 
+void TiledMapAssembler::setChunkSize(uint32_t chunkSize)
+{
+    if (chunkSize > MAX_CHUNK_SIZE) chunkSize = MAX_CHUNK_SIZE;
+    if (_chunkSize == chunkSize) return;
+    _chunkSize = chunkSize;
+    _chunkedMeshes.clear();
+}
+
+void TiledMapAssembler::invalidateChunks()
+{
+    for (auto& mesh : _chunkedMeshes)
+    {
+        mesh.valid = false;
+    }
+}
+
+void TiledMapAssembler::reset()
+{
+    Assembler::reset();
+    _chunkedMeshes.clear();
+}
+
 void TiledMapAssembler::handle(NodeProxy *node, ModelBatcher* batcher, Scene* scene)
 {
     _node = node;
     _batcher = batcher;
     
+    // The flag is shared by all meshes, it is cleared by the first fillBuffers.
+    if (_chunkSize > 0 && isDirty(AssemblerBase::VERTICES_DIRTY))
+    {
+        invalidateChunks();
+    }
+    
     Assembler::handle(node, batcher, scene);
 }
 
+void TiledMapAssembler::updateOpacity(std::size_t index, uint8_t opacity)
+{
+    Assembler::updateOpacity(index, opacity);
+    
+    // the chunks hold copies of the vertex colors
+    if (index < _chunkedMeshes.size())
+    {
+        _chunkedMeshes[index].valid = false;
+    }
+}
+
+void TiledMapAssembler::buildChunks(ChunkedMesh& mesh, RenderData* data, const IARenderData& ia)
+{
+    mesh.source = data->getVertices();
+    mesh.vBytes = data->getVBytes();
+    mesh.iBytes = data->getIBytes();
+    mesh.valid = true;
+    mesh.chunked = false;
+    mesh.worldValid = false;
+    mesh.chunks.clear();
+    
+    uint32_t vertexStart = (uint32_t)ia.verticesStart;
+    uint32_t vertexCount = ia.verticesCount >= 0 ? (uint32_t)ia.verticesCount : (uint32_t)mesh.vBytes / _bytesPerVertex;
+    uint32_t indexCount = ia.indicesCount >= 0 ? (uint32_t)ia.indicesCount : (uint32_t)mesh.iBytes / sizeof(unsigned short);
+    if (indexCount == 0 || indexCount % 6 != 0) return;
+    
+    const uint16_t* indices = (const uint16_t*)data->getIndices() + ia.indicesStart;
+    const float* vertices = (const float*)mesh.source;
+    std::size_t dataPerVertex = _bytesPerVertex / sizeof(float);
+    bool hasZ = _vfPos->num > 2;
+    
+    // Every 6 indices must draw one quad, then the quad is the first vertex of it.
+    uint32_t tileCount = indexCount / 6;
+    std::vector<uint32_t> quads(tileCount);
+    for (uint32_t i = 0; i < tileCount; ++i)
+    {
+        const uint16_t* tile = indices + i * 6;
+        uint32_t quad = tile[0] & ~3u;
+        for (int j = 0; j < 6; ++j)
+        {
+            if ((tile[j] & ~3u) != quad) return;
+        }
+        if (quad < vertexStart || quad + 4 > vertexStart + vertexCount) return;
+        quads[i] = quad;
+    }
+    
+    // Bounds of every tile, the first tile gives the tile size and the grid starts from the bounds of all tiles.
+    std::vector<cocos2d::Vec2> tileMins(tileCount);
+    cocos2d::Vec2 meshMin(FLT_MAX, FLT_MAX), tileSize;
+    for (uint32_t i = 0; i < tileCount; ++i)
+    {
+        cocos2d::Vec2 tileMin(FLT_MAX, FLT_MAX), tileMax(-FLT_MAX, -FLT_MAX);
+        for (uint32_t v = quads[i]; v < quads[i] + 4; ++v)
+        {
+            const float* pos = vertices + v * dataPerVertex + _posOffset;
+            tileMin.x = std::min(tileMin.x, pos[0]);
+            tileMin.y = std::min(tileMin.y, pos[1]);
+            tileMax.x = std::max(tileMax.x, pos[0]);
+            tileMax.y = std::max(tileMax.y, pos[1]);
+        }
+        cocos2d::Vec2 size = tileMax - tileMin;
+        if (i == 0)
+        {
+            tileSize = size;
+            if (tileSize.x <= 0 || tileSize.y <= 0) return;
+        }
+        // Tiles of another size may overlap their neighbours, then the draw order matters.
+        else if (std::abs(size.x - tileSize.x) > tileSize.x * GRID_TOLERANCE || std::abs(size.y - tileSize.y) > tileSize.y * GRID_TOLERANCE) return;
+        tileMins[i] = tileMin;
+        meshMin.x = std::min(meshMin.x, tileMin.x);
+        meshMin.y = std::min(meshMin.y, tileMin.y);
+    }
+    
+    // Every tile must fill one cell of the grid alone, isometric and staggered tiles are half a cell apart.
+    std::vector<uint64_t> cells(tileCount);
+    std::unordered_set<uint64_t> usedCells;
+    usedCells.reserve(tileCount);
+    for (uint32_t i = 0; i < tileCount; ++i)
+    {
+        float column = (tileMins[i].x - meshMin.x) / tileSize.x;
+        float row = (tileMins[i].y - meshMin.y) / tileSize.y;
+        float roundColumn = std::round(column);
+        float roundRow = std::round(row);
+        if (std::abs(column - roundColumn) > GRID_TOLERANCE || std::abs(row - roundRow) > GRID_TOLERANCE) return;
+        if (roundColumn > UINT32_MAX || roundRow > UINT32_MAX) return;
+        cells[i] = ((uint64_t)roundRow << 32) | (uint64_t)roundColumn;
+        if (!usedCells.insert(cells[i]).second) return;
+    }
+    
+    // Tiles do not overlap, so filling them chunk by chunk draws the same picture.
+    std::unordered_map<uint64_t, std::size_t> chunkMap;
+    for (uint32_t i = 0; i < tileCount; ++i)
+    {
+        uint32_t quad = quads[i];
+        const float* quadVerts = vertices + quad * dataPerVertex;
+        
+        uint64_t column = (cells[i] & 0xffffffff) / _chunkSize;
+        uint64_t row = (cells[i] >> 32) / _chunkSize;
+        uint64_t key = (row << 32) | column;
+        
+        auto it = chunkMap.find(key);
+        if (it == chunkMap.end())
+        {
+            it = chunkMap.emplace(key, mesh.chunks.size()).first;
+            mesh.chunks.emplace_back();
+            Chunk& chunk = mesh.chunks.back();
+            chunk.min.set(FLT_MAX, FLT_MAX, hasZ ? FLT_MAX : 0);
+            chunk.max.set(-FLT_MAX, -FLT_MAX, hasZ ? -FLT_MAX : 0);
+        }
+        
+        Chunk& chunk = mesh.chunks[it->second];
+        const uint16_t* tile = indices + i * 6;
+        for (int j = 0; j < 6; ++j)
+        {
+            chunk.indices.push_back((uint16_t)(chunk.vertexCount + tile[j] - quad));
+        }
+        chunk.vertices.insert(chunk.vertices.end(), quadVerts, quadVerts + 4 * dataPerVertex);
+        for (int v = 0; v < 4; ++v)
+        {
+            const float* vpos = quadVerts + v * dataPerVertex + _posOffset;
+            chunk.min.x = std::min(chunk.min.x, vpos[0]);
+            chunk.min.y = std::min(chunk.min.y, vpos[1]);
+            chunk.max.x = std::max(chunk.max.x, vpos[0]);
+            chunk.max.y = std::max(chunk.max.y, vpos[1]);
+            if (hasZ)
+            {
+                chunk.min.z = std::min(chunk.min.z, vpos[2]);
+                chunk.max.z = std::max(chunk.max.z, vpos[2]);
+            }
+        }
+        chunk.vertexCount += 4;
+    }
+    
+    mesh.chunked = true;
+}
+
 void TiledMapAssembler::beforeFillBuffers(std::size_t index)
 {
     static cocos2d::Mat4 tempWorldMat;
@@ -85,7 +259,137 @@ void TiledMapAssembler::beforeFillBuffers(std::size_t index)
 
 void TiledMapAssembler::fillBuffers(NodeProxy* node, ModelBatcher* batcher, std::size_t index)
 {
-    Assembler::fillBuffers(node, batcher, index);
+    // Chunks keep interleaved vertices, vertex formats of several streams are filled by Assembler.
+    if (_chunkSize == 0 || !_datas || !_vfmt || _vfmt->getStreamCount() > 1)
+    {
+        Assembler::fillBuffers(node, batcher, index);
+        return;
+    }
+    
+    const IARenderData& ia = _iaDatas[index];
+    std::size_t meshIndex = ia.meshIndex >= 0 ? ia.meshIndex : index;
+    RenderData* data = _datas->getRenderData(meshIndex);
+    if (!data)
+    {
+        return;
+    }
+    
+    if (index >= _chunkedMeshes.size())
+    {
+        _chunkedMeshes.resize(index + 1);
+    }
+    ChunkedMesh& mesh = _chunkedMeshes[index];
+    if (!mesh.valid || mesh.source != data->getVertices() || mesh.vBytes != data->getVBytes() || mesh.iBytes != data->getIBytes())
+    {
+        buildChunks(mesh, data, ia);
+    }
+    
+    if (!mesh.chunked)
+    {
+        Assembler::fillBuffers(node, batcher, index);
+        return;
+    }
+    
+    // World vertices of every chunk are transformed again once visible.
+    const cocos2d::Mat4& worldMat = node->getWorldMatrix();
+    if (!mesh.worldValid || memcmp(mesh.worldMat.m, worldMat.m, sizeof(worldMat.m)) != 0)
+    {
+        mesh.worldMat = worldMat;
+        mesh.worldValid = true;
+        for (auto& chunk : mesh.chunks)
+        {
+            chunk.worldDirty = true;
+        }
+    }
+    
+    RenderFlow* flow = batcher->getFlow();
+    const cocos2d::Mat4& cullingMat = _ignoreWorldMatrix ? cocos2d::Mat4::IDENTITY : worldMat;
+    mesh.visibleChunks.clear();
+    mesh.fillEnds.clear();
+    mesh.nextFill = 0;
+    uint32_t vertexCount = 0;
+    for (std::size_t i = 0, n = mesh.chunks.size(); i < n; ++i)
+    {
+        const Chunk& chunk = mesh.chunks[i];
+        if (!flow->isAABBVisible(cullingMat, node->getCullingMask(), chunk.min, chunk.max)) continue;
+        // Indices are rebased to 16 bits, one request must not go beyond MAX_FILL_VERTICES.
+        if (vertexCount + chunk.vertexCount > MAX_FILL_VERTICES)
+        {
+            mesh.fillEnds.push_back(mesh.visibleChunks.size());
+            vertexCount = 0;
+        }
+        mesh.visibleChunks.push_back(i);
+        vertexCount += chunk.vertexCount;
+    }
+    if (vertexCount > 0)
+    {
+        mesh.fillEnds.push_back(mesh.visibleChunks.size());
+    }
+    
+    MeshBuffer* buffer = mesh.fillEnds.empty() ? nullptr : batcher->getBuffer(_vfmt);
+    std::size_t begin = 0;
+    for (auto end : mesh.fillEnds)
+    {
+        uint32_t fillVertexCount = 0;
+        uint32_t fillIndexCount = 0;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const Chunk& chunk = mesh.chunks[mesh.visibleChunks[i]];
+            fillVertexCount += chunk.vertexCount;
+            fillIndexCount += (uint32_t)chunk.indices.size();
+        }
+        auto& bufferOffset = buffer->request(fillVertexCount, fillIndexCount);
+        batcher->commitFill(node, this, buffer, index, bufferOffset, false);
+        begin = end;
+    }
+    
+    disableDirty(AssemblerBase::VERTICES_DIRTY);
+}
+
+void TiledMapAssembler::fillRange(NodeProxy* node, MeshBuffer* buffer, std::size_t index, const MeshBuffer::OffsetInfo& offset, bool updateWorld)
+{
+    if (_chunkSize == 0 || _vfmt->getStreamCount() > 1 || index >= _chunkedMeshes.size() || !_chunkedMeshes[index].chunked)
+    {
+        Assembler::fillRange(node, buffer, index, offset, updateWorld);
+        return;
+    }
+    
+    // Commands of one assembler run in commit order, so the fills of a mesh are taken in turn.
+    ChunkedMesh& mesh = _chunkedMeshes[index];
+    if (mesh.nextFill >= mesh.fillEnds.size())
+    {
+        return;
+    }
+    std::size_t begin = mesh.nextFill > 0 ? mesh.fillEnds[mesh.nextFill - 1] : 0;
+    std::size_t end = mesh.fillEnds[mesh.nextFill++];
+    bool transform = !_useModel && !_ignoreWorldMatrix;
+    std::size_t dataPerVertex = _bytesPerVertex / sizeof(float);
+    
+    float* worldVerts = buffer->vData + offset.vByte / sizeof(float);
+    uint16_t* indices = buffer->iData + offset.index;
+    uint32_t vertexOffset = offset.vertex;
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        Chunk& chunk = mesh.chunks[mesh.visibleChunks[i]];
+        const float* vertices = chunk.vertices.data();
+        if (transform)
+        {
+            if (chunk.worldDirty)
+            {
+                chunk.worldVertices = chunk.vertices;
+                MathKernel::transformPositions(chunk.worldVertices.data() + _posOffset, dataPerVertex, chunk.vertexCount, _vfPos->num, mesh.worldMat);
+                chunk.worldDirty = false;
+            }
+            vertices = chunk.worldVertices.data();
+        }
+        
+        memcpy(worldVerts, vertices, chunk.vertexCount * _bytesPerVertex);
+        MathKernel::rebaseIndices(chunk.indices.data(), indices, chunk.indices.size(), (uint16_t)vertexOffset);
+        
+        worldVerts += chunk.vertexCount * dataPerVertex;
+        indices += chunk.indices.size();
+        vertexOffset += chunk.vertexCount;
+    }
 }
 
 RENDERER_END
@@ -33,17 +33,77 @@ RENDERER_BEGIN
 
 class TiledMapAssembler : public Assembler  {
 public:
+    // Upper bound of tiles per chunk side, so that chunk indices fit in 16 bits.
+    static const uint32_t MAX_CHUNK_SIZE = 64;
+    // Upper bound of vertices per buffer request, visible chunks are filled in several requests above it.
+    static const uint32_t MAX_FILL_VERTICES = 65535;
+    
     TiledMapAssembler();
     virtual ~TiledMapAssembler();
     virtual void handle(NodeProxy *node, ModelBatcher* batcher, Scene* scene) override;
     virtual void beforeFillBuffers(std::size_t index) override;
     virtual void fillBuffers(NodeProxy *node, ModelBatcher* batcher, std::size_t index) override;
+    virtual void fillRange(NodeProxy* node, MeshBuffer* buffer, std::size_t index, const MeshBuffer::OffsetInfo& offset, bool updateWorld) override;
+    virtual void updateOpacity(std::size_t index, uint8_t opacity) override;
+    virtual void reset() override;
+    // Object nodes are visited while filling buffers.
+    virtual bool isStaticBatchable() const override { return false; }
     void updateNodes(std::size_t iaIndex, const std::vector<std::string>& nodes);
     void clearNodes(std::size_t iaIndex);
+    /**
+     *  @brief Splits the tiles into square chunks of chunkSize * chunkSize tiles, only chunks in the culling views are filled.
+     *  The chunks keep a copy of the vertices, they are rebuilt when VERTICES_DIRTY is set or the mesh is replaced,
+     *  and the world vertices of a chunk are reused until the world matrix changes.
+     *  Chunks change the draw order of the tiles, so only meshes of equal sized quads on one grid without two tiles
+     *  in a cell are chunked, e.g. orthogonal layers. Isometric, staggered and hexagonal layers, tiles larger than
+     *  the grid or meshes which are not 4 vertices and 6 indices per tile are filled as a whole in their own order.
+     *  @param[in] chunkSize Tiles per chunk side, 0 disables chunking.
+     */
+    void setChunkSize(uint32_t chunkSize);
+    /**
+     *  @brief Gets tiles per chunk side, 0 means chunking is disabled.
+     */
+    uint32_t getChunkSize() const { return _chunkSize; }
+private:
+    struct Chunk
+    {
+        cocos2d::Vec3 min;
+        cocos2d::Vec3 max;
+        uint32_t vertexCount = 0;
+        std::vector<float> vertices;
+        std::vector<uint16_t> indices;
+        std::vector<float> worldVertices;
+        bool worldDirty = true;
+    };
+    
+    struct ChunkedMesh
+    {
+        // Source the chunks were built from, a new typed array means new geometry.
+        const uint8_t* source = nullptr;
+        unsigned long vBytes = 0;
+        unsigned long iBytes = 0;
+        bool valid = false;
+        // False if the mesh is not made of quads on one grid, see setChunkSize.
+        bool chunked = false;
+        cocos2d::Mat4 worldMat;
+        bool worldValid = false;
+        std::vector<Chunk> chunks;
+        std::vector<std::size_t> visibleChunks;
+        // Ends of the fills in visibleChunks, each fill requests at most MAX_FILL_VERTICES.
+        std::vector<std::size_t> fillEnds;
+        // Fills of one mesh are done in the order of their requests, this is the next one.
+        std::size_t nextFill = 0;
+    };
+    
+    void buildChunks(ChunkedMesh& mesh, RenderData* data, const IARenderData& ia);
+    void invalidateChunks();
 private:
     std::map<std::size_t, std::vector<std::string>> _nodesMap;
     NodeProxy* _node = nullptr;
     ModelBatcher* _batcher = nullptr;
+    
+    uint32_t _chunkSize = 0;
+    std::vector<ChunkedMesh> _chunkedMeshes;
 };
 
 RENDERER_END
@@ -30,6 +30,7 @@
 #include "ModelBatcher.hpp"
 #include "RenderFlow.hpp"
 #include "MeshBuffer.hpp"
+#include "DynamicAtlasManager.hpp"
 
 #include "assembler/Assembler.hpp"
 #include "assembler/MaskAssembler.hpp"
@@ -361,6 +361,43 @@ static bool js_cocos2dx_editor_support_MiddlewareManager_getInstance(se::State&
 }
 SE_BIND_FUNC(js_cocos2dx_editor_support_MiddlewareManager_getInstance)
 
+static bool js_cocos2dx_editor_support_MiddlewareManager_setParallelEnabled(se::State& s)
+{
+    cocos2d::middleware::MiddlewareManager* cobj = (cocos2d::middleware::MiddlewareManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_editor_support_MiddlewareManager_setParallelEnabled : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        bool arg0;
+        ok &= seval_to_boolean(args[0], &arg0);
+        SE_PRECONDITION2(ok, false, "js_cocos2dx_editor_support_MiddlewareManager_setParallelEnabled : Error processing arguments");
+        cobj->setParallelEnabled(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_editor_support_MiddlewareManager_setParallelEnabled)
+
+static bool js_cocos2dx_editor_support_MiddlewareManager_isParallelEnabled(se::State& s)
+{
+    cocos2d::middleware::MiddlewareManager* cobj = (cocos2d::middleware::MiddlewareManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_editor_support_MiddlewareManager_isParallelEnabled : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        bool result = cobj->isParallelEnabled();
+        ok &= boolean_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_cocos2dx_editor_support_MiddlewareManager_isParallelEnabled : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_editor_support_MiddlewareManager_isParallelEnabled)
+
 SE_DECLARE_FINALIZE_FUNC(js_cocos2d_middleware_MiddlewareManager_finalize)
 
 static bool js_cocos2dx_editor_support_MiddlewareManager_constructor(se::State& s)
@@ -395,6 +432,8 @@ bool js_register_cocos2dx_editor_support_MiddlewareManager(se::Object* obj)
 
     cls->defineFunction("render", _SE(js_cocos2dx_editor_support_MiddlewareManager_render));
     cls->defineFunction("update", _SE(js_cocos2dx_editor_support_MiddlewareManager_update));
+    cls->defineFunction("setParallelEnabled", _SE(js_cocos2dx_editor_support_MiddlewareManager_setParallelEnabled));
+    cls->defineFunction("isParallelEnabled", _SE(js_cocos2dx_editor_support_MiddlewareManager_isParallelEnabled));
     cls->defineStaticFunction("destroyInstance", _SE(js_cocos2dx_editor_support_MiddlewareManager_destroyInstance));
     cls->defineStaticFunction("generateModuleID", _SE(js_cocos2dx_editor_support_MiddlewareManager_generateModuleID));
     cls->defineStaticFunction("getInstance", _SE(js_cocos2dx_editor_support_MiddlewareManager_getInstance));
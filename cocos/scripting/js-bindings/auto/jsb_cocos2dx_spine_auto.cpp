@@ -1264,6 +1264,22 @@ SE_BIND_FUNC(js_cocos2dx_spine_AnimationState_getTimeScale)
 
 
 
+static bool js_cocos2dx_spine_AnimationState_drainQueue(se::State& s)
+{
+    spine::AnimationState* cobj = (spine::AnimationState*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_spine_AnimationState_drainQueue : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        cobj->drainQueue();
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_spine_AnimationState_drainQueue)
+
 bool js_register_cocos2dx_spine_AnimationState(se::Object* obj)
 {
     auto cls = se::Class::create("AnimationState", obj, nullptr, nullptr);
@@ -1283,6 +1299,7 @@ bool js_register_cocos2dx_spine_AnimationState(se::Object* obj)
     cls->defineFunction("setAnimation", _SE(js_cocos2dx_spine_AnimationState_setAnimation));
     cls->defineFunction("addEmptyAnimation", _SE(js_cocos2dx_spine_AnimationState_addEmptyAnimation));
     cls->defineFunction("getTimeScale", _SE(js_cocos2dx_spine_AnimationState_getTimeScale));
+    cls->defineFunction("drainQueue", _SE(js_cocos2dx_spine_AnimationState_drainQueue));
     cls->install();
     JSBClassType::registerClass<spine::AnimationState>(cls);
 
@@ -15167,6 +15184,94 @@ static bool js_cocos2dx_spine_SkeletonDataMgr_getInstance(se::State& s)
 }
 SE_BIND_FUNC(js_cocos2dx_spine_SkeletonDataMgr_getInstance)
 
+static bool js_cocos2dx_spine_SkeletonDataMgr_getAllocCount(se::State& s)
+{
+    spine::SkeletonDataMgr* cobj = (spine::SkeletonDataMgr*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_spine_SkeletonDataMgr_getAllocCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getAllocCount();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_cocos2dx_spine_SkeletonDataMgr_getAllocCount : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_spine_SkeletonDataMgr_getAllocCount)
+
+static bool js_cocos2dx_spine_SkeletonDataMgr_getFreeCount(se::State& s)
+{
+    spine::SkeletonDataMgr* cobj = (spine::SkeletonDataMgr*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_spine_SkeletonDataMgr_getFreeCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getFreeCount();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_cocos2dx_spine_SkeletonDataMgr_getFreeCount : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_spine_SkeletonDataMgr_getFreeCount)
+
+static bool js_cocos2dx_spine_SkeletonDataMgr_getAllocBytes(se::State& s)
+{
+    spine::SkeletonDataMgr* cobj = (spine::SkeletonDataMgr*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_spine_SkeletonDataMgr_getAllocBytes : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        size_t result = cobj->getAllocBytes();
+        ok &= size_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_cocos2dx_spine_SkeletonDataMgr_getAllocBytes : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_spine_SkeletonDataMgr_getAllocBytes)
+
+static bool js_cocos2dx_spine_SkeletonDataMgr_getPeakAllocBytes(se::State& s)
+{
+    spine::SkeletonDataMgr* cobj = (spine::SkeletonDataMgr*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_spine_SkeletonDataMgr_getPeakAllocBytes : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        size_t result = cobj->getPeakAllocBytes();
+        ok &= size_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_cocos2dx_spine_SkeletonDataMgr_getPeakAllocBytes : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_spine_SkeletonDataMgr_getPeakAllocBytes)
+
+static bool js_cocos2dx_spine_SkeletonDataMgr_resetPeakAllocBytes(se::State& s)
+{
+    spine::SkeletonDataMgr* cobj = (spine::SkeletonDataMgr*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_spine_SkeletonDataMgr_resetPeakAllocBytes : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        cobj->resetPeakAllocBytes();
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_spine_SkeletonDataMgr_resetPeakAllocBytes)
+
 SE_DECLARE_FINALIZE_FUNC(js_spine_SkeletonDataMgr_finalize)
 
 static bool js_cocos2dx_spine_SkeletonDataMgr_constructor(se::State& s)
@@ -15201,6 +15306,11 @@ bool js_register_cocos2dx_spine_SkeletonDataMgr(se::Object* obj)
 
     cls->defineFunction("setDestroyCallback", _SE(js_cocos2dx_spine_SkeletonDataMgr_setDestroyCallback));
     cls->defineStaticFunction("getInstance", _SE(js_cocos2dx_spine_SkeletonDataMgr_getInstance));
+    cls->defineFunction("getAllocCount", _SE(js_cocos2dx_spine_SkeletonDataMgr_getAllocCount));
+    cls->defineFunction("getFreeCount", _SE(js_cocos2dx_spine_SkeletonDataMgr_getFreeCount));
+    cls->defineFunction("getAllocBytes", _SE(js_cocos2dx_spine_SkeletonDataMgr_getAllocBytes));
+    cls->defineFunction("getPeakAllocBytes", _SE(js_cocos2dx_spine_SkeletonDataMgr_getPeakAllocBytes));
+    cls->defineFunction("resetPeakAllocBytes", _SE(js_cocos2dx_spine_SkeletonDataMgr_resetPeakAllocBytes));
     cls->defineFinalizeFunction(_SE(js_spine_SkeletonDataMgr_finalize));
     cls->install();
     JSBClassType::registerClass<spine::SkeletonDataMgr>(cls);
@@ -15250,7 +15360,18 @@ static bool js_cocos2dx_spine_SkeletonCacheMgr_buildSkeletonCache(se::State& s)
         SE_PRECONDITION2(ok, false, "js_cocos2dx_spine_SkeletonCacheMgr_buildSkeletonCache : Error processing arguments");
         return true;
     }
-    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    if (argc == 2) {
+        std::string arg0;
+        std::string arg1;
+        ok &= seval_to_std_string(args[0], &arg0);
+        ok &= seval_to_std_string(args[1], &arg1);
+        SE_PRECONDITION2(ok, false, "js_cocos2dx_spine_SkeletonCacheMgr_buildSkeletonCache : Error processing arguments");
+        spine::SkeletonCache* result = cobj->buildSkeletonCache(arg0, arg1);
+        ok &= native_ptr_to_seval<spine::SkeletonCache>((spine::SkeletonCache*)result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_cocos2dx_spine_SkeletonCacheMgr_buildSkeletonCache : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
     return false;
 }
 SE_BIND_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_buildSkeletonCache)
@@ -15300,6 +15421,150 @@ static bool js_spine_SkeletonCacheMgr_finalize(se::State& s)
 }
 SE_BIND_FINALIZE_FUNC(js_spine_SkeletonCacheMgr_finalize)
 
+static bool js_cocos2dx_spine_SkeletonCacheMgr_setMaxCacheBytes(se::State& s)
+{
+    spine::SkeletonCacheMgr* cobj = (spine::SkeletonCacheMgr*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_spine_SkeletonCacheMgr_setMaxCacheBytes : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        size_t arg0 = 0;
+        ok &= seval_to_size(args[0], &arg0);
+        SE_PRECONDITION2(ok, false, "js_cocos2dx_spine_SkeletonCacheMgr_setMaxCacheBytes : Error processing arguments");
+        cobj->setMaxCacheBytes(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_setMaxCacheBytes)
+
+static bool js_cocos2dx_spine_SkeletonCacheMgr_getMaxCacheBytes(se::State& s)
+{
+    spine::SkeletonCacheMgr* cobj = (spine::SkeletonCacheMgr*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_spine_SkeletonCacheMgr_getMaxCacheBytes : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        size_t result = cobj->getMaxCacheBytes();
+        ok &= size_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_cocos2dx_spine_SkeletonCacheMgr_getMaxCacheBytes : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_getMaxCacheBytes)
+
+static bool js_cocos2dx_spine_SkeletonCacheMgr_getCacheBytes(se::State& s)
+{
+    spine::SkeletonCacheMgr* cobj = (spine::SkeletonCacheMgr*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_spine_SkeletonCacheMgr_getCacheBytes : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        size_t result = cobj->getCacheBytes();
+        ok &= size_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_cocos2dx_spine_SkeletonCacheMgr_getCacheBytes : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_getCacheBytes)
+
+static bool js_cocos2dx_spine_SkeletonCacheMgr_getHitCount(se::State& s)
+{
+    spine::SkeletonCacheMgr* cobj = (spine::SkeletonCacheMgr*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_spine_SkeletonCacheMgr_getHitCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getHitCount();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_cocos2dx_spine_SkeletonCacheMgr_getHitCount : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_getHitCount)
+
+static bool js_cocos2dx_spine_SkeletonCacheMgr_getMissCount(se::State& s)
+{
+    spine::SkeletonCacheMgr* cobj = (spine::SkeletonCacheMgr*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_spine_SkeletonCacheMgr_getMissCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getMissCount();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_cocos2dx_spine_SkeletonCacheMgr_getMissCount : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_getMissCount)
+
+static bool js_cocos2dx_spine_SkeletonCacheMgr_resetStats(se::State& s)
+{
+    spine::SkeletonCacheMgr* cobj = (spine::SkeletonCacheMgr*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_spine_SkeletonCacheMgr_resetStats : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        cobj->resetStats();
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_resetStats)
+
+static bool js_cocos2dx_spine_SkeletonCacheMgr_setAsyncBakeEnabled(se::State& s)
+{
+    spine::SkeletonCacheMgr* cobj = (spine::SkeletonCacheMgr*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_spine_SkeletonCacheMgr_setAsyncBakeEnabled : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        bool arg0;
+        ok &= seval_to_boolean(args[0], &arg0);
+        SE_PRECONDITION2(ok, false, "js_cocos2dx_spine_SkeletonCacheMgr_setAsyncBakeEnabled : Error processing arguments");
+        cobj->setAsyncBakeEnabled(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_setAsyncBakeEnabled)
+
+static bool js_cocos2dx_spine_SkeletonCacheMgr_isAsyncBakeEnabled(se::State& s)
+{
+    spine::SkeletonCacheMgr* cobj = (spine::SkeletonCacheMgr*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_cocos2dx_spine_SkeletonCacheMgr_isAsyncBakeEnabled : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        bool result = cobj->isAsyncBakeEnabled();
+        ok &= boolean_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_cocos2dx_spine_SkeletonCacheMgr_isAsyncBakeEnabled : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_isAsyncBakeEnabled)
+
 bool js_register_cocos2dx_spine_SkeletonCacheMgr(se::Object* obj)
 {
     auto cls = se::Class::create("SkeletonCacheMgr", obj, nullptr, nullptr);
@@ -15308,6 +15573,14 @@ bool js_register_cocos2dx_spine_SkeletonCacheMgr(se::Object* obj)
     cls->defineFunction("buildSkeletonCache", _SE(js_cocos2dx_spine_SkeletonCacheMgr_buildSkeletonCache));
     cls->defineStaticFunction("destroyInstance", _SE(js_cocos2dx_spine_SkeletonCacheMgr_destroyInstance));
     cls->defineStaticFunction("getInstance", _SE(js_cocos2dx_spine_SkeletonCacheMgr_getInstance));
+    cls->defineFunction("setMaxCacheBytes", _SE(js_cocos2dx_spine_SkeletonCacheMgr_setMaxCacheBytes));
+    cls->defineFunction("getMaxCacheBytes", _SE(js_cocos2dx_spine_SkeletonCacheMgr_getMaxCacheBytes));
+    cls->defineFunction("getCacheBytes", _SE(js_cocos2dx_spine_SkeletonCacheMgr_getCacheBytes));
+    cls->defineFunction("getHitCount", _SE(js_cocos2dx_spine_SkeletonCacheMgr_getHitCount));
+    cls->defineFunction("getMissCount", _SE(js_cocos2dx_spine_SkeletonCacheMgr_getMissCount));
+    cls->defineFunction("resetStats", _SE(js_cocos2dx_spine_SkeletonCacheMgr_resetStats));
+    cls->defineFunction("setAsyncBakeEnabled", _SE(js_cocos2dx_spine_SkeletonCacheMgr_setAsyncBakeEnabled));
+    cls->defineFunction("isAsyncBakeEnabled", _SE(js_cocos2dx_spine_SkeletonCacheMgr_isAsyncBakeEnabled));
     cls->defineFinalizeFunction(_SE(js_spine_SkeletonCacheMgr_finalize));
     cls->install();
     JSBClassType::registerClass<spine::SkeletonCacheMgr>(cls);
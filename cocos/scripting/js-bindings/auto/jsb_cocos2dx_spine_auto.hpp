@@ -81,6 +81,7 @@ SE_DECLARE_FUNC(js_cocos2dx_spine_AnimationState_clearTrack);
 SE_DECLARE_FUNC(js_cocos2dx_spine_AnimationState_setAnimation);
 SE_DECLARE_FUNC(js_cocos2dx_spine_AnimationState_addEmptyAnimation);
 SE_DECLARE_FUNC(js_cocos2dx_spine_AnimationState_getTimeScale);
+SE_DECLARE_FUNC(js_cocos2dx_spine_AnimationState_drainQueue);
 
 extern se::Object* __jsb_spine_AnimationStateData_proto;
 extern se::Class* __jsb_spine_AnimationStateData_class;
@@ -989,6 +990,11 @@ bool register_all_cocos2dx_spine(se::Object* obj);
 SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonDataMgr_setDestroyCallback);
 SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonDataMgr_getInstance);
 SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonDataMgr_SkeletonDataMgr);
+SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonDataMgr_getAllocCount);
+SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonDataMgr_getFreeCount);
+SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonDataMgr_getAllocBytes);
+SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonDataMgr_getPeakAllocBytes);
+SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonDataMgr_resetPeakAllocBytes);
 
 extern se::Object* __jsb_spine_SkeletonCacheMgr_proto;
 extern se::Class* __jsb_spine_SkeletonCacheMgr_class;
@@ -999,6 +1005,14 @@ SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_removeSkeletonCache);
 SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_buildSkeletonCache);
 SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_destroyInstance);
 SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_getInstance);
+SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_setMaxCacheBytes);
+SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_getMaxCacheBytes);
+SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_getCacheBytes);
+SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_getHitCount);
+SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_getMissCount);
+SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_resetStats);
+SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_setAsyncBakeEnabled);
+SE_DECLARE_FUNC(js_cocos2dx_spine_SkeletonCacheMgr_isAsyncBakeEnabled);
 
 extern se::Object* __jsb_spine_SkeletonCacheAnimation_proto;
 extern se::Class* __jsb_spine_SkeletonCacheAnimation_class;
@@ -1074,6 +1074,92 @@ SE_BIND_FUNC(js_gfx_DeviceGraphics_getInstance)
 
 
 
+static bool js_gfx_DeviceGraphics_supportsInstancing(se::State& s)
+{
+    cocos2d::renderer::DeviceGraphics* cobj = (cocos2d::renderer::DeviceGraphics*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_gfx_DeviceGraphics_supportsInstancing : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        bool result = cobj->supportsInstancing();
+        ok &= boolean_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_gfx_DeviceGraphics_supportsInstancing : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_gfx_DeviceGraphics_supportsInstancing)
+
+static bool js_gfx_DeviceGraphics_getStateCalls(se::State& s)
+{
+    cocos2d::renderer::DeviceGraphics* cobj = (cocos2d::renderer::DeviceGraphics*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_gfx_DeviceGraphics_getStateCalls : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getStateCalls();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_gfx_DeviceGraphics_getStateCalls : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_gfx_DeviceGraphics_getStateCalls)
+
+static bool js_gfx_DeviceGraphics_getSkippedStateCommits(se::State& s)
+{
+    cocos2d::renderer::DeviceGraphics* cobj = (cocos2d::renderer::DeviceGraphics*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_gfx_DeviceGraphics_getSkippedStateCommits : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getSkippedStateCommits();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_gfx_DeviceGraphics_getSkippedStateCommits : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_gfx_DeviceGraphics_getSkippedStateCommits)
+
+static bool js_gfx_DeviceGraphics_enableScissorTest(se::State& s)
+{
+    cocos2d::renderer::DeviceGraphics* cobj = (cocos2d::renderer::DeviceGraphics*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_gfx_DeviceGraphics_enableScissorTest : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        cobj->enableScissorTest();
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_gfx_DeviceGraphics_enableScissorTest)
+
+static bool js_gfx_DeviceGraphics_disableScissorTest(se::State& s)
+{
+    cocos2d::renderer::DeviceGraphics* cobj = (cocos2d::renderer::DeviceGraphics*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_gfx_DeviceGraphics_disableScissorTest : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        cobj->disableScissorTest();
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_gfx_DeviceGraphics_disableScissorTest)
+
 bool js_register_gfx_DeviceGraphics(se::Object* obj)
 {
     auto cls = se::Class::create("Device", obj, nullptr, nullptr);
@@ -1107,6 +1193,11 @@ bool js_register_gfx_DeviceGraphics(se::Object* obj)
     cls->defineFunction("setStencilOp", _SE(js_gfx_DeviceGraphics_setStencilOp));
     cls->defineFunction("enableStencilTest", _SE(js_gfx_DeviceGraphics_enableStencilTest));
     cls->defineStaticFunction("getInstance", _SE(js_gfx_DeviceGraphics_getInstance));
+    cls->defineFunction("supportsInstancing", _SE(js_gfx_DeviceGraphics_supportsInstancing));
+    cls->defineFunction("getStateCalls", _SE(js_gfx_DeviceGraphics_getStateCalls));
+    cls->defineFunction("getSkippedStateCommits", _SE(js_gfx_DeviceGraphics_getSkippedStateCommits));
+    cls->defineFunction("enableScissorTest", _SE(js_gfx_DeviceGraphics_enableScissorTest));
+    cls->defineFunction("disableScissorTest", _SE(js_gfx_DeviceGraphics_disableScissorTest));
     cls->install();
     JSBClassType::registerClass<cocos2d::renderer::DeviceGraphics>(cls);
 
@@ -1408,6 +1499,42 @@ static bool js_cocos2d_renderer_Texture_finalize(se::State& s)
 }
 SE_BIND_FINALIZE_FUNC(js_cocos2d_renderer_Texture_finalize)
 
+static bool js_gfx_Texture_getGLFormat(se::State& s)
+{
+    cocos2d::renderer::Texture* cobj = (cocos2d::renderer::Texture*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_gfx_Texture_getGLFormat : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getGLFormat();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_gfx_Texture_getGLFormat : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_gfx_Texture_getGLFormat)
+
+static bool js_gfx_Texture_isCompressed(se::State& s)
+{
+    cocos2d::renderer::Texture* cobj = (cocos2d::renderer::Texture*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_gfx_Texture_isCompressed : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        bool result = cobj->isCompressed();
+        ok &= boolean_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_gfx_Texture_isCompressed : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_gfx_Texture_isCompressed)
+
 bool js_register_gfx_Texture(se::Object* obj)
 {
     auto cls = se::Class::create("Texture", obj, __jsb_cocos2d_renderer_RenderTarget_proto, nullptr);
@@ -1415,6 +1542,8 @@ bool js_register_gfx_Texture(se::Object* obj)
     cls->defineFunction("getWidth", _SE(js_gfx_Texture_getWidth));
     cls->defineFunction("getHeight", _SE(js_gfx_Texture_getHeight));
     cls->defineFunction("getTarget", _SE(js_gfx_Texture_getTarget));
+    cls->defineFunction("getGLFormat", _SE(js_gfx_Texture_getGLFormat));
+    cls->defineFunction("isCompressed", _SE(js_gfx_Texture_isCompressed));
     cls->defineFinalizeFunction(_SE(js_cocos2d_renderer_Texture_finalize));
     cls->install();
     JSBClassType::registerClass<cocos2d::renderer::Texture>(cls);
@@ -76,6 +76,11 @@ SE_DECLARE_FUNC(js_gfx_DeviceGraphics_setCullMode);
 SE_DECLARE_FUNC(js_gfx_DeviceGraphics_setStencilOp);
 SE_DECLARE_FUNC(js_gfx_DeviceGraphics_enableStencilTest);
 SE_DECLARE_FUNC(js_gfx_DeviceGraphics_getInstance);
+SE_DECLARE_FUNC(js_gfx_DeviceGraphics_supportsInstancing);
+SE_DECLARE_FUNC(js_gfx_DeviceGraphics_getStateCalls);
+SE_DECLARE_FUNC(js_gfx_DeviceGraphics_getSkippedStateCommits);
+SE_DECLARE_FUNC(js_gfx_DeviceGraphics_enableScissorTest);
+SE_DECLARE_FUNC(js_gfx_DeviceGraphics_disableScissorTest);
 
 extern se::Object* __jsb_cocos2d_renderer_FrameBuffer_proto;
 extern se::Class* __jsb_cocos2d_renderer_FrameBuffer_class;
@@ -110,6 +115,8 @@ bool register_all_gfx(se::Object* obj);
 SE_DECLARE_FUNC(js_gfx_Texture_getWidth);
 SE_DECLARE_FUNC(js_gfx_Texture_getHeight);
 SE_DECLARE_FUNC(js_gfx_Texture_getTarget);
+SE_DECLARE_FUNC(js_gfx_Texture_getGLFormat);
+SE_DECLARE_FUNC(js_gfx_Texture_isCompressed);
 
 extern se::Object* __jsb_cocos2d_renderer_Texture2D_proto;
 extern se::Class* __jsb_cocos2d_renderer_Texture2D_class;
@@ -1291,6 +1291,59 @@ static bool js_renderer_NodeProxy_setAssembler(se::State& s)
 }
 SE_BIND_FUNC(js_renderer_NodeProxy_setAssembler)
 
+static bool js_renderer_NodeProxy_setStaticBatch(se::State& s)
+{
+    cocos2d::renderer::NodeProxy* cobj = (cocos2d::renderer::NodeProxy*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_NodeProxy_setStaticBatch : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        bool arg0;
+        ok &= seval_to_boolean(args[0], &arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_NodeProxy_setStaticBatch : Error processing arguments");
+        cobj->setStaticBatch(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_NodeProxy_setStaticBatch)
+
+static bool js_renderer_NodeProxy_isStaticBatch(se::State& s)
+{
+    cocos2d::renderer::NodeProxy* cobj = (cocos2d::renderer::NodeProxy*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_NodeProxy_isStaticBatch : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        bool result = cobj->isStaticBatch();
+        ok &= boolean_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_NodeProxy_isStaticBatch : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_NodeProxy_isStaticBatch)
+
+static bool js_renderer_NodeProxy_markStaticBatchDirty(se::State& s)
+{
+    cocos2d::renderer::NodeProxy* cobj = (cocos2d::renderer::NodeProxy*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_NodeProxy_markStaticBatchDirty : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        cobj->markStaticBatchDirty();
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_NodeProxy_markStaticBatchDirty)
+
 SE_DECLARE_FINALIZE_FUNC(js_cocos2d_renderer_NodeProxy_finalize)
 
 static bool js_renderer_NodeProxy_constructor(se::State& s)
@@ -1339,6 +1392,9 @@ bool js_register_renderer_NodeProxy(se::Object* obj)
     cls->defineFunction("clearAssembler", _SE(js_renderer_NodeProxy_clearAssembler));
     cls->defineFunction("switchTraverseToVisit", _SE(js_renderer_NodeProxy_switchTraverseToVisit));
     cls->defineFunction("setAssembler", _SE(js_renderer_NodeProxy_setAssembler));
+    cls->defineFunction("setStaticBatch", _SE(js_renderer_NodeProxy_setStaticBatch));
+    cls->defineFunction("isStaticBatch", _SE(js_renderer_NodeProxy_isStaticBatch));
+    cls->defineFunction("markStaticBatchDirty", _SE(js_renderer_NodeProxy_markStaticBatchDirty));
     cls->defineFinalizeFunction(_SE(js_cocos2d_renderer_NodeProxy_finalize));
     cls->install();
     JSBClassType::registerClass<cocos2d::renderer::NodeProxy>(cls);
@@ -1416,6 +1472,116 @@ static bool js_renderer_BaseRenderer_init(se::State& s)
 }
 SE_BIND_FUNC(js_renderer_BaseRenderer_init)
 
+static bool js_renderer_BaseRenderer_setInstancingEnabled(se::State& s)
+{
+    cocos2d::renderer::BaseRenderer* cobj = (cocos2d::renderer::BaseRenderer*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_BaseRenderer_setInstancingEnabled : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        bool arg0;
+        ok &= seval_to_boolean(args[0], &arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_BaseRenderer_setInstancingEnabled : Error processing arguments");
+        cobj->setInstancingEnabled(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_BaseRenderer_setInstancingEnabled)
+
+static bool js_renderer_BaseRenderer_isInstancingEnabled(se::State& s)
+{
+    cocos2d::renderer::BaseRenderer* cobj = (cocos2d::renderer::BaseRenderer*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_BaseRenderer_isInstancingEnabled : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        bool result = cobj->isInstancingEnabled();
+        ok &= boolean_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_BaseRenderer_isInstancingEnabled : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_BaseRenderer_isInstancingEnabled)
+
+static bool js_renderer_BaseRenderer_getInstancedDrawCount(se::State& s)
+{
+    cocos2d::renderer::BaseRenderer* cobj = (cocos2d::renderer::BaseRenderer*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_BaseRenderer_getInstancedDrawCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getInstancedDrawCount();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_BaseRenderer_getInstancedDrawCount : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_BaseRenderer_getInstancedDrawCount)
+
+static bool js_renderer_BaseRenderer_getInstanceCount(se::State& s)
+{
+    cocos2d::renderer::BaseRenderer* cobj = (cocos2d::renderer::BaseRenderer*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_BaseRenderer_getInstanceCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getInstanceCount();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_BaseRenderer_getInstanceCount : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_BaseRenderer_getInstanceCount)
+
+static bool js_renderer_BaseRenderer_getWorldMatrixInversionCount(se::State& s)
+{
+    cocos2d::renderer::BaseRenderer* cobj = (cocos2d::renderer::BaseRenderer*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_BaseRenderer_getWorldMatrixInversionCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getWorldMatrixInversionCount();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_BaseRenderer_getWorldMatrixInversionCount : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_BaseRenderer_getWorldMatrixInversionCount)
+
+static bool js_renderer_BaseRenderer_precompile(se::State& s)
+{
+    cocos2d::renderer::BaseRenderer* cobj = (cocos2d::renderer::BaseRenderer*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_BaseRenderer_precompile : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        cocos2d::renderer::EffectBase* arg0 = nullptr;
+        ok &= seval_to_native_ptr(args[0], &arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_BaseRenderer_precompile : Error processing arguments");
+        cobj->precompile(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_BaseRenderer_precompile)
+
 SE_DECLARE_FINALIZE_FUNC(js_cocos2d_renderer_BaseRenderer_finalize)
 
 static bool js_renderer_BaseRenderer_constructor(se::State& s)
@@ -1444,6 +1610,12 @@ bool js_register_renderer_BaseRenderer(se::Object* obj)
 
     cls->defineFunction("getProgramLib", _SE(js_renderer_BaseRenderer_getProgramLib));
     cls->defineFunction("init", _SE(js_renderer_BaseRenderer_init));
+    cls->defineFunction("setInstancingEnabled", _SE(js_renderer_BaseRenderer_setInstancingEnabled));
+    cls->defineFunction("isInstancingEnabled", _SE(js_renderer_BaseRenderer_isInstancingEnabled));
+    cls->defineFunction("getInstancedDrawCount", _SE(js_renderer_BaseRenderer_getInstancedDrawCount));
+    cls->defineFunction("getInstanceCount", _SE(js_renderer_BaseRenderer_getInstanceCount));
+    cls->defineFunction("getWorldMatrixInversionCount", _SE(js_renderer_BaseRenderer_getWorldMatrixInversionCount));
+    cls->defineFunction("precompile", _SE(js_renderer_BaseRenderer_precompile));
     cls->defineFinalizeFunction(_SE(js_cocos2d_renderer_BaseRenderer_finalize));
     cls->install();
     JSBClassType::registerClass<cocos2d::renderer::BaseRenderer>(cls);
@@ -3675,6 +3847,95 @@ static bool js_renderer_Assembler_ignoreOpacityFlag(se::State& s)
 }
 SE_BIND_FUNC(js_renderer_Assembler_ignoreOpacityFlag)
 
+static bool js_renderer_Assembler_setLocalAABB(se::State& s)
+{
+    cocos2d::renderer::Assembler* cobj = (cocos2d::renderer::Assembler*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_Assembler_setLocalAABB : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 6) {
+        float arg0 = 0;
+        float arg1 = 0;
+        float arg2 = 0;
+        float arg3 = 0;
+        float arg4 = 0;
+        float arg5 = 0;
+        ok &= seval_to_float(args[0], &arg0);
+        ok &= seval_to_float(args[1], &arg1);
+        ok &= seval_to_float(args[2], &arg2);
+        ok &= seval_to_float(args[3], &arg3);
+        ok &= seval_to_float(args[4], &arg4);
+        ok &= seval_to_float(args[5], &arg5);
+        SE_PRECONDITION2(ok, false, "js_renderer_Assembler_setLocalAABB : Error processing arguments");
+        cobj->setLocalAABB(arg0, arg1, arg2, arg3, arg4, arg5);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 6);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_Assembler_setLocalAABB)
+
+static bool js_renderer_Assembler_clearLocalAABB(se::State& s)
+{
+    cocos2d::renderer::Assembler* cobj = (cocos2d::renderer::Assembler*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_Assembler_clearLocalAABB : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        cobj->clearLocalAABB();
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_Assembler_clearLocalAABB)
+
+static bool js_renderer_Assembler_remapUVs(se::State& s)
+{
+    cocos2d::renderer::Assembler* cobj = (cocos2d::renderer::Assembler*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_Assembler_remapUVs : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 5) {
+        size_t arg0 = 0;
+        float arg1 = 0;
+        float arg2 = 0;
+        float arg3 = 0;
+        float arg4 = 0;
+        ok &= seval_to_size(args[0], &arg0);
+        ok &= seval_to_float(args[1], &arg1);
+        ok &= seval_to_float(args[2], &arg2);
+        ok &= seval_to_float(args[3], &arg3);
+        ok &= seval_to_float(args[4], &arg4);
+        SE_PRECONDITION2(ok, false, "js_renderer_Assembler_remapUVs : Error processing arguments");
+        cobj->remapUVs(arg0, arg1, arg2, arg3, arg4);
+        return true;
+    }
+    if (argc == 6) {
+        size_t arg0 = 0;
+        float arg1 = 0;
+        float arg2 = 0;
+        float arg3 = 0;
+        float arg4 = 0;
+        unsigned int arg5 = 0;
+        ok &= seval_to_size(args[0], &arg0);
+        ok &= seval_to_float(args[1], &arg1);
+        ok &= seval_to_float(args[2], &arg2);
+        ok &= seval_to_float(args[3], &arg3);
+        ok &= seval_to_float(args[4], &arg4);
+        ok &= seval_to_uint32(args[5], (uint32_t*)&arg5);
+        SE_PRECONDITION2(ok, false, "js_renderer_Assembler_remapUVs : Error processing arguments");
+        cobj->remapUVs(arg0, arg1, arg2, arg3, arg4, arg5);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 6);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_Assembler_remapUVs)
+
 SE_DECLARE_FINALIZE_FUNC(js_cocos2d_renderer_Assembler_finalize)
 
 static bool js_renderer_Assembler_constructor(se::State& s)
@@ -3721,6 +3982,9 @@ bool js_register_renderer_Assembler(se::Object* obj)
     cls->defineFunction("updateIndicesRange", _SE(js_renderer_Assembler_updateIndicesRange));
     cls->defineFunction("ignoreOpacityFlag", _SE(js_renderer_Assembler_ignoreOpacityFlag));
     cls->defineFunction("ctor", _SE(js_renderer_Assembler_ctor));
+    cls->defineFunction("setLocalAABB", _SE(js_renderer_Assembler_setLocalAABB));
+    cls->defineFunction("clearLocalAABB", _SE(js_renderer_Assembler_clearLocalAABB));
+    cls->defineFunction("remapUVs", _SE(js_renderer_Assembler_remapUVs));
     cls->defineFinalizeFunction(_SE(js_cocos2d_renderer_Assembler_finalize));
     cls->install();
     JSBClassType::registerClass<cocos2d::renderer::Assembler>(cls);
@@ -3871,80 +4135,397 @@ static bool js_renderer_RenderFlow_render(se::State& s)
 }
 SE_BIND_FUNC(js_renderer_RenderFlow_render)
 
-SE_DECLARE_FINALIZE_FUNC(js_cocos2d_renderer_RenderFlow_finalize)
-
-static bool js_renderer_RenderFlow_constructor(se::State& s)
+static bool js_renderer_RenderFlow_getCulledNodeCount(se::State& s)
 {
-    CC_UNUSED bool ok = true;
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_getCulledNodeCount : Invalid Native Object");
     const auto& args = s.args();
-    cocos2d::renderer::DeviceGraphics* arg0 = nullptr;
-    cocos2d::renderer::Scene* arg1 = nullptr;
-    cocos2d::renderer::ForwardRenderer* arg2 = nullptr;
-    ok &= seval_to_native_ptr(args[0], &arg0);
-    ok &= seval_to_native_ptr(args[1], &arg1);
-    ok &= seval_to_native_ptr(args[2], &arg2);
-    SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_constructor : Error processing arguments");
-    cocos2d::renderer::RenderFlow* cobj = new (std::nothrow) cocos2d::renderer::RenderFlow(arg0, arg1, arg2);
-    s.thisObject()->setPrivateData(cobj);
-    se::NonRefNativePtrCreatedByCtorMap::emplace(cobj);
-    return true;
-}
-SE_BIND_CTOR(js_renderer_RenderFlow_constructor, __jsb_cocos2d_renderer_RenderFlow_class, js_cocos2d_renderer_RenderFlow_finalize)
-
-
-
-
-static bool js_cocos2d_renderer_RenderFlow_finalize(se::State& s)
-{
-    CCLOGINFO("jsbindings: finalizing JS object %p (cocos2d::renderer::RenderFlow)", s.nativeThisObject());
-    auto iter = se::NonRefNativePtrCreatedByCtorMap::find(s.nativeThisObject());
-    if (iter != se::NonRefNativePtrCreatedByCtorMap::end())
-    {
-        se::NonRefNativePtrCreatedByCtorMap::erase(iter);
-        cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
-        delete cobj;
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getCulledNodeCount();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_getCulledNodeCount : Error processing arguments");
+        return true;
     }
-    return true;
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
 }
-SE_BIND_FINALIZE_FUNC(js_cocos2d_renderer_RenderFlow_finalize)
+SE_BIND_FUNC(js_renderer_RenderFlow_getCulledNodeCount)
 
-bool js_register_renderer_RenderFlow(se::Object* obj)
+static bool js_renderer_RenderFlow_getSubmittedNodeCount(se::State& s)
 {
-    auto cls = se::Class::create("RenderFlow", obj, nullptr, _SE(js_renderer_RenderFlow_constructor));
-
-    cls->defineFunction("render", _SE(js_renderer_RenderFlow_render));
-    cls->defineFinalizeFunction(_SE(js_cocos2d_renderer_RenderFlow_finalize));
-    cls->install();
-    JSBClassType::registerClass<cocos2d::renderer::RenderFlow>(cls);
-
-    __jsb_cocos2d_renderer_RenderFlow_proto = cls->getProto();
-    __jsb_cocos2d_renderer_RenderFlow_class = cls;
-
-    se::ScriptEngine::getInstance()->clearException();
-    return true;
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_getSubmittedNodeCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getSubmittedNodeCount();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_getSubmittedNodeCount : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
 }
+SE_BIND_FUNC(js_renderer_RenderFlow_getSubmittedNodeCount)
 
-se::Object* __jsb_cocos2d_renderer_AssemblerSprite_proto = nullptr;
-se::Class* __jsb_cocos2d_renderer_AssemblerSprite_class = nullptr;
-
-static bool js_renderer_AssemblerSprite_setLocalData(se::State& s)
+static bool js_renderer_RenderFlow_setCullingEnabled(se::State& s)
 {
-    cocos2d::renderer::AssemblerSprite* cobj = (cocos2d::renderer::AssemblerSprite*)s.nativeThisObject();
-    SE_PRECONDITION2(cobj, false, "js_renderer_AssemblerSprite_setLocalData : Invalid Native Object");
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_setCullingEnabled : Invalid Native Object");
     const auto& args = s.args();
     size_t argc = args.size();
     CC_UNUSED bool ok = true;
     if (argc == 1) {
-        se_object_ptr arg0 = nullptr;
-        arg0 = args[0].toObject();
-        SE_PRECONDITION2(ok, false, "js_renderer_AssemblerSprite_setLocalData : Error processing arguments");
-        cobj->setLocalData(arg0);
+        bool arg0;
+        ok &= seval_to_boolean(args[0], &arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_setCullingEnabled : Error processing arguments");
+        cobj->setCullingEnabled(arg0);
         return true;
     }
     SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
     return false;
 }
-SE_BIND_FUNC(js_renderer_AssemblerSprite_setLocalData)
+SE_BIND_FUNC(js_renderer_RenderFlow_setCullingEnabled)
+
+static bool js_renderer_RenderFlow_isCullingEnabled(se::State& s)
+{
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_isCullingEnabled : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        bool result = cobj->isCullingEnabled();
+        ok &= boolean_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_isCullingEnabled : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_RenderFlow_isCullingEnabled)
+
+static bool js_renderer_RenderFlow_setParallelFillEnabled(se::State& s)
+{
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_setParallelFillEnabled : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        bool arg0;
+        ok &= seval_to_boolean(args[0], &arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_setParallelFillEnabled : Error processing arguments");
+        cobj->setParallelFillEnabled(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_RenderFlow_setParallelFillEnabled)
+
+static bool js_renderer_RenderFlow_isParallelFillEnabled(se::State& s)
+{
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_isParallelFillEnabled : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        bool result = cobj->isParallelFillEnabled();
+        ok &= boolean_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_isParallelFillEnabled : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_RenderFlow_isParallelFillEnabled)
+
+static bool js_renderer_RenderFlow_getStaticNodeCount(se::State& s)
+{
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_getStaticNodeCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getStaticNodeCount();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_getStaticNodeCount : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_RenderFlow_getStaticNodeCount)
+
+static bool js_renderer_RenderFlow_setBufferRingSize(se::State& s)
+{
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_setBufferRingSize : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        uint8_t arg0;
+        ok &= seval_to_uint8(args[0], (uint8_t*)&arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_setBufferRingSize : Error processing arguments");
+        cobj->setBufferRingSize(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_RenderFlow_setBufferRingSize)
+
+static bool js_renderer_RenderFlow_getBufferRingSize(se::State& s)
+{
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_getBufferRingSize : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        uint8_t result = cobj->getBufferRingSize();
+        ok &= uint8_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_getBufferRingSize : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_RenderFlow_getBufferRingSize)
+
+static bool js_renderer_RenderFlow_setProfilerEnabled(se::State& s)
+{
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_setProfilerEnabled : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        bool arg0;
+        ok &= seval_to_boolean(args[0], &arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_setProfilerEnabled : Error processing arguments");
+        cobj->setProfilerEnabled(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_RenderFlow_setProfilerEnabled)
+
+static bool js_renderer_RenderFlow_isProfilerEnabled(se::State& s)
+{
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_isProfilerEnabled : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        bool result = cobj->isProfilerEnabled();
+        ok &= boolean_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_isProfilerEnabled : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_RenderFlow_isProfilerEnabled)
+
+static bool js_renderer_RenderFlow_getStageTime(se::State& s)
+{
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_getStageTime : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        int arg0 = 0;
+        do { int32_t tmp = 0; ok &= seval_to_int32(args[0], &tmp); arg0 = (int)tmp; } while(false);
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_getStageTime : Error processing arguments");
+        float result = cobj->getStageTime(arg0);
+        ok &= float_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_getStageTime : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_RenderFlow_getStageTime)
+
+static bool js_renderer_RenderFlow_dumpProfile(se::State& s)
+{
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_dumpProfile : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        std::string arg0;
+        ok &= seval_to_std_string(args[0], &arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_dumpProfile : Error processing arguments");
+        bool result = cobj->dumpProfile(arg0);
+        ok &= boolean_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_dumpProfile : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_RenderFlow_dumpProfile)
+
+static bool js_renderer_RenderFlow_getScissorMaskCount(se::State& s)
+{
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_getScissorMaskCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getScissorMaskCount();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_getScissorMaskCount : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_RenderFlow_getScissorMaskCount)
+
+static bool js_renderer_RenderFlow_getStencilMaskCount(se::State& s)
+{
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_getStencilMaskCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getStencilMaskCount();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_getStencilMaskCount : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_RenderFlow_getStencilMaskCount)
+
+static bool js_renderer_RenderFlow_getUploadedVertexBytes(se::State& s)
+{
+    cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_RenderFlow_getUploadedVertexBytes : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        unsigned int arg0 = 0;
+        ok &= seval_to_uint32(args[0], (uint32_t*)&arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_getUploadedVertexBytes : Error processing arguments");
+        unsigned int result = cobj->getUploadedVertexBytes(arg0);
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_getUploadedVertexBytes : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_RenderFlow_getUploadedVertexBytes)
+
+SE_DECLARE_FINALIZE_FUNC(js_cocos2d_renderer_RenderFlow_finalize)
+
+static bool js_renderer_RenderFlow_constructor(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    cocos2d::renderer::DeviceGraphics* arg0 = nullptr;
+    cocos2d::renderer::Scene* arg1 = nullptr;
+    cocos2d::renderer::ForwardRenderer* arg2 = nullptr;
+    ok &= seval_to_native_ptr(args[0], &arg0);
+    ok &= seval_to_native_ptr(args[1], &arg1);
+    ok &= seval_to_native_ptr(args[2], &arg2);
+    SE_PRECONDITION2(ok, false, "js_renderer_RenderFlow_constructor : Error processing arguments");
+    cocos2d::renderer::RenderFlow* cobj = new (std::nothrow) cocos2d::renderer::RenderFlow(arg0, arg1, arg2);
+    s.thisObject()->setPrivateData(cobj);
+    se::NonRefNativePtrCreatedByCtorMap::emplace(cobj);
+    return true;
+}
+SE_BIND_CTOR(js_renderer_RenderFlow_constructor, __jsb_cocos2d_renderer_RenderFlow_class, js_cocos2d_renderer_RenderFlow_finalize)
+
+
+
+
+static bool js_cocos2d_renderer_RenderFlow_finalize(se::State& s)
+{
+    CCLOGINFO("jsbindings: finalizing JS object %p (cocos2d::renderer::RenderFlow)", s.nativeThisObject());
+    auto iter = se::NonRefNativePtrCreatedByCtorMap::find(s.nativeThisObject());
+    if (iter != se::NonRefNativePtrCreatedByCtorMap::end())
+    {
+        se::NonRefNativePtrCreatedByCtorMap::erase(iter);
+        cocos2d::renderer::RenderFlow* cobj = (cocos2d::renderer::RenderFlow*)s.nativeThisObject();
+        delete cobj;
+    }
+    return true;
+}
+SE_BIND_FINALIZE_FUNC(js_cocos2d_renderer_RenderFlow_finalize)
+
+bool js_register_renderer_RenderFlow(se::Object* obj)
+{
+    auto cls = se::Class::create("RenderFlow", obj, nullptr, _SE(js_renderer_RenderFlow_constructor));
+
+    cls->defineFunction("render", _SE(js_renderer_RenderFlow_render));
+    cls->defineFunction("getCulledNodeCount", _SE(js_renderer_RenderFlow_getCulledNodeCount));
+    cls->defineFunction("getSubmittedNodeCount", _SE(js_renderer_RenderFlow_getSubmittedNodeCount));
+    cls->defineFunction("setCullingEnabled", _SE(js_renderer_RenderFlow_setCullingEnabled));
+    cls->defineFunction("isCullingEnabled", _SE(js_renderer_RenderFlow_isCullingEnabled));
+    cls->defineFunction("setParallelFillEnabled", _SE(js_renderer_RenderFlow_setParallelFillEnabled));
+    cls->defineFunction("isParallelFillEnabled", _SE(js_renderer_RenderFlow_isParallelFillEnabled));
+    cls->defineFunction("getStaticNodeCount", _SE(js_renderer_RenderFlow_getStaticNodeCount));
+    cls->defineFunction("setBufferRingSize", _SE(js_renderer_RenderFlow_setBufferRingSize));
+    cls->defineFunction("getBufferRingSize", _SE(js_renderer_RenderFlow_getBufferRingSize));
+    cls->defineFunction("setProfilerEnabled", _SE(js_renderer_RenderFlow_setProfilerEnabled));
+    cls->defineFunction("isProfilerEnabled", _SE(js_renderer_RenderFlow_isProfilerEnabled));
+    cls->defineFunction("getStageTime", _SE(js_renderer_RenderFlow_getStageTime));
+    cls->defineFunction("dumpProfile", _SE(js_renderer_RenderFlow_dumpProfile));
+    cls->defineFunction("getScissorMaskCount", _SE(js_renderer_RenderFlow_getScissorMaskCount));
+    cls->defineFunction("getStencilMaskCount", _SE(js_renderer_RenderFlow_getStencilMaskCount));
+    cls->defineFunction("getUploadedVertexBytes", _SE(js_renderer_RenderFlow_getUploadedVertexBytes));
+    cls->defineFinalizeFunction(_SE(js_cocos2d_renderer_RenderFlow_finalize));
+    cls->install();
+    JSBClassType::registerClass<cocos2d::renderer::RenderFlow>(cls);
+
+    __jsb_cocos2d_renderer_RenderFlow_proto = cls->getProto();
+    __jsb_cocos2d_renderer_RenderFlow_class = cls;
+
+    se::ScriptEngine::getInstance()->clearException();
+    return true;
+}
+
+se::Object* __jsb_cocos2d_renderer_AssemblerSprite_proto = nullptr;
+se::Class* __jsb_cocos2d_renderer_AssemblerSprite_class = nullptr;
+
+static bool js_renderer_AssemblerSprite_setLocalData(se::State& s)
+{
+    cocos2d::renderer::AssemblerSprite* cobj = (cocos2d::renderer::AssemblerSprite*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_AssemblerSprite_setLocalData : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        se_object_ptr arg0 = nullptr;
+        arg0 = args[0].toObject();
+        SE_PRECONDITION2(ok, false, "js_renderer_AssemblerSprite_setLocalData : Error processing arguments");
+        cobj->setLocalData(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_AssemblerSprite_setLocalData)
 
 SE_DECLARE_FINALIZE_FUNC(js_cocos2d_renderer_AssemblerSprite_finalize)
 
@@ -4145,6 +4726,47 @@ static bool js_renderer_MaskAssembler_setRenderSubHandle(se::State& s)
 }
 SE_BIND_FUNC(js_renderer_MaskAssembler_setRenderSubHandle)
 
+static bool js_renderer_MaskAssembler_setScissorRect(se::State& s)
+{
+    cocos2d::renderer::MaskAssembler* cobj = (cocos2d::renderer::MaskAssembler*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_MaskAssembler_setScissorRect : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 4) {
+        float arg0 = 0;
+        float arg1 = 0;
+        float arg2 = 0;
+        float arg3 = 0;
+        ok &= seval_to_float(args[0], &arg0);
+        ok &= seval_to_float(args[1], &arg1);
+        ok &= seval_to_float(args[2], &arg2);
+        ok &= seval_to_float(args[3], &arg3);
+        SE_PRECONDITION2(ok, false, "js_renderer_MaskAssembler_setScissorRect : Error processing arguments");
+        cobj->setScissorRect(arg0, arg1, arg2, arg3);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 4);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_MaskAssembler_setScissorRect)
+
+static bool js_renderer_MaskAssembler_clearScissorRect(se::State& s)
+{
+    cocos2d::renderer::MaskAssembler* cobj = (cocos2d::renderer::MaskAssembler*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_MaskAssembler_clearScissorRect : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        cobj->clearScissorRect();
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_MaskAssembler_clearScissorRect)
+
 SE_DECLARE_FINALIZE_FUNC(js_cocos2d_renderer_MaskAssembler_finalize)
 
 static bool js_renderer_MaskAssembler_constructor(se::State& s)
@@ -4187,6 +4809,8 @@ bool js_register_renderer_MaskAssembler(se::Object* obj)
     cls->defineFunction("getMaskInverted", _SE(js_renderer_MaskAssembler_getMaskInverted));
     cls->defineFunction("setRenderSubHandle", _SE(js_renderer_MaskAssembler_setRenderSubHandle));
     cls->defineFunction("ctor", _SE(js_renderer_MaskAssembler_ctor));
+    cls->defineFunction("setScissorRect", _SE(js_renderer_MaskAssembler_setScissorRect));
+    cls->defineFunction("clearScissorRect", _SE(js_renderer_MaskAssembler_clearScissorRect));
     cls->defineFinalizeFunction(_SE(js_cocos2d_renderer_MaskAssembler_finalize));
     cls->install();
     JSBClassType::registerClass<cocos2d::renderer::MaskAssembler>(cls);
@@ -4226,21 +4850,58 @@ SE_BIND_FUNC(js_renderer_TiledMapAssembler_updateNodes)
 static bool js_renderer_TiledMapAssembler_clearNodes(se::State& s)
 {
     cocos2d::renderer::TiledMapAssembler* cobj = (cocos2d::renderer::TiledMapAssembler*)s.nativeThisObject();
-    SE_PRECONDITION2(cobj, false, "js_renderer_TiledMapAssembler_clearNodes : Invalid Native Object");
+    SE_PRECONDITION2(cobj, false, "js_renderer_TiledMapAssembler_clearNodes : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        size_t arg0 = 0;
+        ok &= seval_to_size(args[0], &arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_TiledMapAssembler_clearNodes : Error processing arguments");
+        cobj->clearNodes(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_TiledMapAssembler_clearNodes)
+
+static bool js_renderer_TiledMapAssembler_setChunkSize(se::State& s)
+{
+    cocos2d::renderer::TiledMapAssembler* cobj = (cocos2d::renderer::TiledMapAssembler*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_TiledMapAssembler_setChunkSize : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        unsigned int arg0 = 0;
+        ok &= seval_to_uint32(args[0], (uint32_t*)&arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_TiledMapAssembler_setChunkSize : Error processing arguments");
+        cobj->setChunkSize(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_TiledMapAssembler_setChunkSize)
+
+static bool js_renderer_TiledMapAssembler_getChunkSize(se::State& s)
+{
+    cocos2d::renderer::TiledMapAssembler* cobj = (cocos2d::renderer::TiledMapAssembler*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_TiledMapAssembler_getChunkSize : Invalid Native Object");
     const auto& args = s.args();
     size_t argc = args.size();
     CC_UNUSED bool ok = true;
-    if (argc == 1) {
-        size_t arg0 = 0;
-        ok &= seval_to_size(args[0], &arg0);
-        SE_PRECONDITION2(ok, false, "js_renderer_TiledMapAssembler_clearNodes : Error processing arguments");
-        cobj->clearNodes(arg0);
+    if (argc == 0) {
+        unsigned int result = cobj->getChunkSize();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_TiledMapAssembler_getChunkSize : Error processing arguments");
         return true;
     }
-    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
     return false;
 }
-SE_BIND_FUNC(js_renderer_TiledMapAssembler_clearNodes)
+SE_BIND_FUNC(js_renderer_TiledMapAssembler_getChunkSize)
 
 SE_DECLARE_FINALIZE_FUNC(js_cocos2d_renderer_TiledMapAssembler_finalize)
 
@@ -4281,6 +4942,8 @@ bool js_register_renderer_TiledMapAssembler(se::Object* obj)
     cls->defineFunction("updateNodes", _SE(js_renderer_TiledMapAssembler_updateNodes));
     cls->defineFunction("clearNodes", _SE(js_renderer_TiledMapAssembler_clearNodes));
     cls->defineFunction("ctor", _SE(js_renderer_TiledMapAssembler_ctor));
+    cls->defineFunction("setChunkSize", _SE(js_renderer_TiledMapAssembler_setChunkSize));
+    cls->defineFunction("getChunkSize", _SE(js_renderer_TiledMapAssembler_getChunkSize));
     cls->defineFinalizeFunction(_SE(js_cocos2d_renderer_TiledMapAssembler_finalize));
     cls->install();
     JSBClassType::registerClass<cocos2d::renderer::TiledMapAssembler>(cls);
@@ -4679,6 +5342,417 @@ bool js_register_renderer_Particle3DAssembler(se::Object* obj)
     return true;
 }
 
+se::Object* __jsb_cocos2d_renderer_DynamicAtlasManager_proto = nullptr;
+se::Class* __jsb_cocos2d_renderer_DynamicAtlasManager_class = nullptr;
+
+
+
+
+static bool js_renderer_DynamicAtlasManager_getInstance(se::State& s)
+{
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        cocos2d::renderer::DynamicAtlasManager* result = cocos2d::renderer::DynamicAtlasManager::getInstance();
+        ok &= native_ptr_to_seval<cocos2d::renderer::DynamicAtlasManager>(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_getInstance : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_getInstance)
+
+static bool js_renderer_DynamicAtlasManager_setEnabled(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_setEnabled : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        bool arg0;
+        ok &= seval_to_boolean(args[0], &arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_setEnabled : Error processing arguments");
+        cobj->setEnabled(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_setEnabled)
+
+static bool js_renderer_DynamicAtlasManager_isEnabled(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_isEnabled : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        bool result = cobj->isEnabled();
+        ok &= boolean_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_isEnabled : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_isEnabled)
+
+static bool js_renderer_DynamicAtlasManager_setMaxPageCount(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_setMaxPageCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        uint8_t arg0;
+        ok &= seval_to_uint8(args[0], (uint8_t*)&arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_setMaxPageCount : Error processing arguments");
+        cobj->setMaxPageCount(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_setMaxPageCount)
+
+static bool js_renderer_DynamicAtlasManager_getMaxPageCount(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_getMaxPageCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        uint8_t result = cobj->getMaxPageCount();
+        ok &= uint8_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_getMaxPageCount : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_getMaxPageCount)
+
+static bool js_renderer_DynamicAtlasManager_setMaxFrameSize(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_setMaxFrameSize : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        uint16_t arg0;
+        ok &= seval_to_uint16(args[0], (uint16_t*)&arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_setMaxFrameSize : Error processing arguments");
+        cobj->setMaxFrameSize(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_setMaxFrameSize)
+
+static bool js_renderer_DynamicAtlasManager_getMaxFrameSize(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_getMaxFrameSize : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        uint16_t result = cobj->getMaxFrameSize();
+        ok &= uint16_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_getMaxFrameSize : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_getMaxFrameSize)
+
+static bool js_renderer_DynamicAtlasManager_getPageSize(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_getPageSize : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        uint16_t result = cobj->getPageSize();
+        ok &= uint16_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_getPageSize : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_getPageSize)
+
+static bool js_renderer_DynamicAtlasManager_insert(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_insert : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 5) {
+        cocos2d::renderer::Texture2D* arg0 = nullptr;
+        uint16_t arg1;
+        uint16_t arg2;
+        uint16_t arg3;
+        uint16_t arg4;
+        ok &= seval_to_native_ptr(args[0], &arg0);
+        ok &= seval_to_uint16(args[1], (uint16_t*)&arg1);
+        ok &= seval_to_uint16(args[2], (uint16_t*)&arg2);
+        ok &= seval_to_uint16(args[3], (uint16_t*)&arg3);
+        ok &= seval_to_uint16(args[4], (uint16_t*)&arg4);
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_insert : Error processing arguments");
+        unsigned int result = cobj->insert(arg0, arg1, arg2, arg3, arg4);
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_insert : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 5);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_insert)
+
+static bool js_renderer_DynamicAtlasManager_isValid(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_isValid : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        unsigned int arg0 = 0;
+        ok &= seval_to_uint32(args[0], (uint32_t*)&arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_isValid : Error processing arguments");
+        bool result = cobj->isValid(arg0);
+        ok &= boolean_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_isValid : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_isValid)
+
+static bool js_renderer_DynamicAtlasManager_getTexture(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_getTexture : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        unsigned int arg0 = 0;
+        ok &= seval_to_uint32(args[0], (uint32_t*)&arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_getTexture : Error processing arguments");
+        cocos2d::renderer::Texture2D* result = cobj->getTexture(arg0);
+        ok &= native_ptr_to_seval<cocos2d::renderer::Texture2D>(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_getTexture : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_getTexture)
+
+static bool js_renderer_DynamicAtlasManager_getFrameX(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_getFrameX : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        unsigned int arg0 = 0;
+        ok &= seval_to_uint32(args[0], (uint32_t*)&arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_getFrameX : Error processing arguments");
+        uint16_t result = cobj->getFrameX(arg0);
+        ok &= uint16_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_getFrameX : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_getFrameX)
+
+static bool js_renderer_DynamicAtlasManager_getFrameY(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_getFrameY : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        unsigned int arg0 = 0;
+        ok &= seval_to_uint32(args[0], (uint32_t*)&arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_getFrameY : Error processing arguments");
+        uint16_t result = cobj->getFrameY(arg0);
+        ok &= uint16_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_getFrameY : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_getFrameY)
+
+static bool js_renderer_DynamicAtlasManager_remapUVs(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_remapUVs : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 3) {
+        unsigned int arg0 = 0;
+        cocos2d::renderer::Assembler* arg1 = nullptr;
+        size_t arg2 = 0;
+        ok &= seval_to_uint32(args[0], (uint32_t*)&arg0);
+        ok &= seval_to_native_ptr(args[1], &arg1);
+        ok &= seval_to_size(args[2], &arg2);
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_remapUVs : Error processing arguments");
+        bool result = cobj->remapUVs(arg0, arg1, arg2);
+        ok &= boolean_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_remapUVs : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 3);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_remapUVs)
+
+static bool js_renderer_DynamicAtlasManager_removeTexture(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_removeTexture : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        cocos2d::renderer::Texture2D* arg0 = nullptr;
+        ok &= seval_to_native_ptr(args[0], &arg0);
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_removeTexture : Error processing arguments");
+        cobj->removeTexture(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_removeTexture)
+
+static bool js_renderer_DynamicAtlasManager_reset(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_reset : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        cobj->reset();
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_reset)
+
+static bool js_renderer_DynamicAtlasManager_getPageCount(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_getPageCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getPageCount();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_getPageCount : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_getPageCount)
+
+static bool js_renderer_DynamicAtlasManager_getFrameCount(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_getFrameCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getFrameCount();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_getFrameCount : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_getFrameCount)
+
+static bool js_renderer_DynamicAtlasManager_getEvictionCount(se::State& s)
+{
+    cocos2d::renderer::DynamicAtlasManager* cobj = (cocos2d::renderer::DynamicAtlasManager*)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_renderer_DynamicAtlasManager_getEvictionCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getEvictionCount();
+        ok &= uint32_to_seval(result, &s.rval());
+        SE_PRECONDITION2(ok, false, "js_renderer_DynamicAtlasManager_getEvictionCount : Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_renderer_DynamicAtlasManager_getEvictionCount)
+
+bool js_register_renderer_DynamicAtlasManager(se::Object* obj)
+{
+    auto cls = se::Class::create("DynamicAtlasManager", obj, nullptr, nullptr);
+
+    cls->defineStaticFunction("getInstance", _SE(js_renderer_DynamicAtlasManager_getInstance));
+    cls->defineFunction("setEnabled", _SE(js_renderer_DynamicAtlasManager_setEnabled));
+    cls->defineFunction("isEnabled", _SE(js_renderer_DynamicAtlasManager_isEnabled));
+    cls->defineFunction("setMaxPageCount", _SE(js_renderer_DynamicAtlasManager_setMaxPageCount));
+    cls->defineFunction("getMaxPageCount", _SE(js_renderer_DynamicAtlasManager_getMaxPageCount));
+    cls->defineFunction("setMaxFrameSize", _SE(js_renderer_DynamicAtlasManager_setMaxFrameSize));
+    cls->defineFunction("getMaxFrameSize", _SE(js_renderer_DynamicAtlasManager_getMaxFrameSize));
+    cls->defineFunction("getPageSize", _SE(js_renderer_DynamicAtlasManager_getPageSize));
+    cls->defineFunction("insert", _SE(js_renderer_DynamicAtlasManager_insert));
+    cls->defineFunction("isValid", _SE(js_renderer_DynamicAtlasManager_isValid));
+    cls->defineFunction("getTexture", _SE(js_renderer_DynamicAtlasManager_getTexture));
+    cls->defineFunction("getFrameX", _SE(js_renderer_DynamicAtlasManager_getFrameX));
+    cls->defineFunction("getFrameY", _SE(js_renderer_DynamicAtlasManager_getFrameY));
+    cls->defineFunction("remapUVs", _SE(js_renderer_DynamicAtlasManager_remapUVs));
+    cls->defineFunction("removeTexture", _SE(js_renderer_DynamicAtlasManager_removeTexture));
+    cls->defineFunction("reset", _SE(js_renderer_DynamicAtlasManager_reset));
+    cls->defineFunction("getPageCount", _SE(js_renderer_DynamicAtlasManager_getPageCount));
+    cls->defineFunction("getFrameCount", _SE(js_renderer_DynamicAtlasManager_getFrameCount));
+    cls->defineFunction("getEvictionCount", _SE(js_renderer_DynamicAtlasManager_getEvictionCount));
+    cls->install();
+    JSBClassType::registerClass<cocos2d::renderer::DynamicAtlasManager>(cls);
+
+    __jsb_cocos2d_renderer_DynamicAtlasManager_proto = cls->getProto();
+    __jsb_cocos2d_renderer_DynamicAtlasManager_class = cls;
+
+    se::ScriptEngine::getInstance()->clearException();
+    return true;
+}
+
 bool register_all_renderer(se::Object* obj)
 {
     // Get the ns
@@ -4718,6 +5792,7 @@ bool register_all_renderer(se::Object* obj)
     js_register_renderer_EffectVariant(ns);
     js_register_renderer_Scene(ns);
     js_register_renderer_RenderDataList(ns);
+    js_register_renderer_DynamicAtlasManager(ns);
     return true;
 }
 
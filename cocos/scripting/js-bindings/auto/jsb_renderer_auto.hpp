@@ -86,6 +86,9 @@ SE_DECLARE_FUNC(js_renderer_NodeProxy_clearAssembler);
 SE_DECLARE_FUNC(js_renderer_NodeProxy_switchTraverseToVisit);
 SE_DECLARE_FUNC(js_renderer_NodeProxy_setAssembler);
 SE_DECLARE_FUNC(js_renderer_NodeProxy_NodeProxy);
+SE_DECLARE_FUNC(js_renderer_NodeProxy_setStaticBatch);
+SE_DECLARE_FUNC(js_renderer_NodeProxy_isStaticBatch);
+SE_DECLARE_FUNC(js_renderer_NodeProxy_markStaticBatchDirty);
 
 extern se::Object* __jsb_cocos2d_renderer_BaseRenderer_proto;
 extern se::Class* __jsb_cocos2d_renderer_BaseRenderer_class;
@@ -95,6 +98,12 @@ bool register_all_renderer(se::Object* obj);
 SE_DECLARE_FUNC(js_renderer_BaseRenderer_getProgramLib);
 SE_DECLARE_FUNC(js_renderer_BaseRenderer_init);
 SE_DECLARE_FUNC(js_renderer_BaseRenderer_BaseRenderer);
+SE_DECLARE_FUNC(js_renderer_BaseRenderer_setInstancingEnabled);
+SE_DECLARE_FUNC(js_renderer_BaseRenderer_isInstancingEnabled);
+SE_DECLARE_FUNC(js_renderer_BaseRenderer_getInstancedDrawCount);
+SE_DECLARE_FUNC(js_renderer_BaseRenderer_getInstanceCount);
+SE_DECLARE_FUNC(js_renderer_BaseRenderer_getWorldMatrixInversionCount);
+SE_DECLARE_FUNC(js_renderer_BaseRenderer_precompile);
 
 extern se::Object* __jsb_cocos2d_renderer_View_proto;
 extern se::Class* __jsb_cocos2d_renderer_View_class;
@@ -247,6 +256,9 @@ SE_DECLARE_FUNC(js_renderer_Assembler_updateEffect);
 SE_DECLARE_FUNC(js_renderer_Assembler_updateIndicesRange);
 SE_DECLARE_FUNC(js_renderer_Assembler_ignoreOpacityFlag);
 SE_DECLARE_FUNC(js_renderer_Assembler_Assembler);
+SE_DECLARE_FUNC(js_renderer_Assembler_setLocalAABB);
+SE_DECLARE_FUNC(js_renderer_Assembler_clearLocalAABB);
+SE_DECLARE_FUNC(js_renderer_Assembler_remapUVs);
 
 extern se::Object* __jsb_cocos2d_renderer_CustomAssembler_proto;
 extern se::Class* __jsb_cocos2d_renderer_CustomAssembler_class;
@@ -265,6 +277,22 @@ bool js_register_cocos2d_renderer_RenderFlow(se::Object* obj);
 bool register_all_renderer(se::Object* obj);
 SE_DECLARE_FUNC(js_renderer_RenderFlow_render);
 SE_DECLARE_FUNC(js_renderer_RenderFlow_RenderFlow);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_getCulledNodeCount);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_getSubmittedNodeCount);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_setCullingEnabled);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_isCullingEnabled);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_setParallelFillEnabled);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_isParallelFillEnabled);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_getStaticNodeCount);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_setBufferRingSize);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_getBufferRingSize);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_setProfilerEnabled);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_isProfilerEnabled);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_getStageTime);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_dumpProfile);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_getScissorMaskCount);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_getStencilMaskCount);
+SE_DECLARE_FUNC(js_renderer_RenderFlow_getUploadedVertexBytes);
 
 extern se::Object* __jsb_cocos2d_renderer_AssemblerSprite_proto;
 extern se::Class* __jsb_cocos2d_renderer_AssemblerSprite_class;
@@ -292,6 +320,8 @@ SE_DECLARE_FUNC(js_renderer_MaskAssembler_setClearSubHandle);
 SE_DECLARE_FUNC(js_renderer_MaskAssembler_getMaskInverted);
 SE_DECLARE_FUNC(js_renderer_MaskAssembler_setRenderSubHandle);
 SE_DECLARE_FUNC(js_renderer_MaskAssembler_MaskAssembler);
+SE_DECLARE_FUNC(js_renderer_MaskAssembler_setScissorRect);
+SE_DECLARE_FUNC(js_renderer_MaskAssembler_clearScissorRect);
 
 extern se::Object* __jsb_cocos2d_renderer_TiledMapAssembler_proto;
 extern se::Class* __jsb_cocos2d_renderer_TiledMapAssembler_class;
@@ -301,6 +331,8 @@ bool register_all_renderer(se::Object* obj);
 SE_DECLARE_FUNC(js_renderer_TiledMapAssembler_updateNodes);
 SE_DECLARE_FUNC(js_renderer_TiledMapAssembler_clearNodes);
 SE_DECLARE_FUNC(js_renderer_TiledMapAssembler_TiledMapAssembler);
+SE_DECLARE_FUNC(js_renderer_TiledMapAssembler_setChunkSize);
+SE_DECLARE_FUNC(js_renderer_TiledMapAssembler_getChunkSize);
 
 extern se::Object* __jsb_cocos2d_renderer_SlicedSprite2D_proto;
 extern se::Class* __jsb_cocos2d_renderer_SlicedSprite2D_class;
@@ -343,4 +375,29 @@ SE_DECLARE_FUNC(js_renderer_Particle3DAssembler_setParticleSpace);
 SE_DECLARE_FUNC(js_renderer_Particle3DAssembler_setTrailModuleEnable);
 SE_DECLARE_FUNC(js_renderer_Particle3DAssembler_Particle3DAssembler);
 
+extern se::Object* __jsb_cocos2d_renderer_DynamicAtlasManager_proto;
+extern se::Class* __jsb_cocos2d_renderer_DynamicAtlasManager_class;
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_getInstance);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_setEnabled);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_isEnabled);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_setMaxPageCount);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_getMaxPageCount);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_setMaxFrameSize);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_getMaxFrameSize);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_getPageSize);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_insert);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_isValid);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_getTexture);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_getFrameX);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_getFrameY);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_remapUVs);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_removeTexture);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_reset);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_getPageCount);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_getFrameCount);
+SE_DECLARE_FUNC(js_renderer_DynamicAtlasManager_getEvictionCount);
+
+bool js_register_cocos2d_renderer_DynamicAtlasManager(se::Object* obj);
+bool register_all_renderer(se::Object* obj);
+
 #endif //#if (USE_GFX_RENDERER > 0) && (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID || CC_TARGET_PLATFORM == CC_PLATFORM_IOS || CC_TARGET_PLATFORM == CC_PLATFORM_MAC || CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
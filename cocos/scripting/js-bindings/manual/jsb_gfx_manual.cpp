@@ -178,6 +178,7 @@ static VertexFormat* getVertexFormatFromValue(const se::Value& elementVal)
             se::Value typeVal;
             se::Value numVal;
             se::Value normalizeVal;
+            se::Value streamVal;
             bool normalized = false;
             for (uint32_t i = 0; i < length; ++i)
             {
@@ -191,7 +192,13 @@ static VertexFormat* getVertexFormatFromValue(const se::Value& elementVal)
                         seval_to_boolean(normalizeVal, &normalized);
                     }
 
-                    formatInfos.push_back({ nameVal.toString(), (AttribType)typeVal.toUint16(), numVal.toUint32(), normalized });
+                    uint32_t stream = 0;
+                    if (tmp.toObject()->getProperty("stream", &streamVal) && streamVal.isNumber())
+                    {
+                        stream = streamVal.toUint32();
+                    }
+
+                    formatInfos.push_back({ nameVal.toString(), (AttribType)typeVal.toUint16(), numVal.toUint32(), normalized, stream });
                 }
             }
         }
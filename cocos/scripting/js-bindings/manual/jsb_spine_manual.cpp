@@ -44,6 +44,7 @@
 
 #include "middleware-adapter.h"
 #include "spine-creator-support/SkeletonDataMgr.h"
+#include "spine-creator-support/MappedFile.h"
 #include "spine-creator-support/SkeletonRenderer.h"
 #include "spine-creator-support/spine-cocos2dx.h"
 
@@ -100,38 +101,47 @@ static bool js_register_spine_initSkeletonData (se::State& s)
     ok = seval_to_float(args[4], &scale);
     SE_PRECONDITION2(ok, false, "js_register_spine_initSkeletonData: Invalid scale!");
     
-    // create atlas from preloaded texture
-    
-    _preloadedAtlasTextures = &textures;
-    spine::spAtlasPage_setCustomTextureLoader(_getPreloadedAtlasTexture);
-
-    spine::Atlas* atlas = new (__FILE__, __LINE__) spine::Atlas(atlasText.c_str(), (int)atlasText.size(), "", &textureLoader);
-    
-    _preloadedAtlasTextures = nullptr;
-    spine::spAtlasPage_setCustomTextureLoader(nullptr);
-    
-    spine::AttachmentLoader* attachmentLoader = new (__FILE__, __LINE__) spine::Cocos2dAtlasAttachmentLoader(atlas);
-    spine::SkeletonData* skeletonData = nullptr;
-    
+    // Binary skeleton data is read into its own arena, and freed in one operation with the atlas and attachments.
+    // Json skeleton data is not, since the parsed json document would be kept in the arena too.
     const auto binPos = skeletonDataFile.find(".skel");
+    spine::SpineArena* arena = nullptr;
     if (binPos != std::string::npos) {
-        auto fileUtils = cocos2d::FileUtils::getInstance();
-        if (fileUtils->isFileExist(skeletonDataFile))
-        {
-            cocos2d::Data cocos2dData;
-            const auto fullpath = fileUtils->fullPathForFilename(skeletonDataFile);
-            fileUtils->getContents(fullpath, &cocos2dData);
-            
-            spine::SkeletonBinary binary(attachmentLoader);
-            binary.setScale(scale);
-            skeletonData = binary.readSkeletonData(cocos2dData.getBytes(), (int)cocos2dData.getSize());
-            CCASSERT(skeletonData, !binary.getError().isEmpty() ? binary.getError().buffer() : "Error reading binary skeleton data.");
+        arena = new spine::SpineArena();
+    }
+    spine::Atlas* atlas = nullptr;
+    spine::AttachmentLoader* attachmentLoader = nullptr;
+    spine::SkeletonData* skeletonData = nullptr;
+    {
+        spine::SpineAllocator::ArenaScope arenaScope(arena);
+        
+        // create atlas from preloaded texture
+        
+        _preloadedAtlasTextures = &textures;
+        spine::spAtlasPage_setCustomTextureLoader(_getPreloadedAtlasTexture);
+
+        atlas = new (__FILE__, __LINE__) spine::Atlas(atlasText.c_str(), (int)atlasText.size(), "", &textureLoader);
+        
+        _preloadedAtlasTextures = nullptr;
+        spine::spAtlasPage_setCustomTextureLoader(nullptr);
+        
+        attachmentLoader = new (__FILE__, __LINE__) spine::Cocos2dAtlasAttachmentLoader(atlas);
+        
+        if (binPos != std::string::npos) {
+            // Skeleton is read from the mapped file, without copying the file first.
+            spine::MappedFile file;
+            if (file.open(skeletonDataFile))
+            {
+                spine::SkeletonBinary binary(attachmentLoader);
+                binary.setScale(scale);
+                skeletonData = binary.readSkeletonData(file.getBytes(), (int)file.getSize());
+                CCASSERT(skeletonData, !binary.getError().isEmpty() ? binary.getError().buffer() : "Error reading binary skeleton data.");
+            }
+        } else {
+            spine::SkeletonJson json(attachmentLoader);
+            json.setScale(scale);
+            skeletonData = json.readSkeletonData(skeletonDataFile.c_str());
+            CCASSERT(skeletonData, !json.getError().isEmpty() ? json.getError().buffer() : "Error reading json skeleton data.");
         }
-    } else {
-        spine::SkeletonJson json(attachmentLoader);
-        json.setScale(scale);
-        skeletonData = json.readSkeletonData(skeletonDataFile.c_str());
-        CCASSERT(skeletonData, !json.getError().isEmpty() ? json.getError().buffer() : "Error reading json skeleton data.");
     }
     
     if (skeletonData) {
@@ -140,7 +150,7 @@ static bool js_register_spine_initSkeletonData (se::State& s)
         {
             texturesIndex.push_back(it->second->getRealTextureIndex());
         }
-        mgr->setSkeletonData(uuid, skeletonData, atlas, attachmentLoader, texturesIndex);
+        mgr->setSkeletonData(uuid, skeletonData, atlas, attachmentLoader, texturesIndex, arena);
         native_ptr_to_rooted_seval<spine::SkeletonData>(skeletonData, &s.rval());
     } else {
         if (atlas) {
@@ -151,6 +161,10 @@ static bool js_register_spine_initSkeletonData (se::State& s)
             delete attachmentLoader;
             attachmentLoader = nullptr;
         }
+        if (arena) {
+            delete arena;
+            arena = nullptr;
+        }
     }
     return true;
 }
@@ -0,0 +1,289 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "Benchmark.h"
+#include "dragonbones/armature/Armature.h"
+#include "dragonbones/armature/Bone.h"
+#include "dragonbones/armature/IArmatureProxy.h"
+#include "dragonbones/model/ArmatureData.h"
+#include <string>
+#include <vector>
+
+/**
+ * Bone update of dragonbones armatures, as Armature::advanceTime updates the bones after the animation:
+ * per bone is Bone::update of every bone, pose is Armature::_updateBonePoses which solves the bones in one loop,
+ * reads the parent matrices from the structure of arrays of ArmaturePose and writes the matrices to both.
+ * The armatures are generated, every bone inherits translation, rotation and scale of its parent and the bones
+ * form a binary tree. The animation is replaced by setting the animation pose of the animated bones, all bones,
+ * only the leaf bones or no bone, then the bones of every armature are updated once. The matrices of both
+ * variants are checked to be the same.
+ */
+
+DRAGONBONES_USING_NAME_SPACE;
+
+namespace {
+
+const int ARMATURE_COUNT = 16;
+const int ROUND_COUNT = 8;
+
+struct Size
+{
+    const char* name;
+    int boneCount;
+};
+
+const Size SIZES[] = {
+    { "small", 20 },
+    { "medium", 60 },
+    { "large", 150 },
+};
+
+enum class Animated
+{
+    ALL,
+    LEAVES,
+    NONE,
+};
+
+// The armature is not displayed, the proxy only lets it initialize.
+class NullProxy : public IArmatureProxy
+{
+public:
+    virtual bool hasDBEventListener(const std::string& type) const override { return false; }
+    virtual void dispatchDBEvent(const std::string& type, EventObject* value) override {}
+    virtual void addDBEventListener(const std::string& type, const std::function<void(EventObject*)>& listener) override {}
+    virtual void removeDBEventListener(const std::string& type, const std::function<void(EventObject*)>& listener) override {}
+    virtual void dbInit(Armature* armature) override { _armature = armature; }
+    virtual void dbClear() override { _armature = nullptr; }
+    virtual void dbUpdate() override {}
+    virtual void dbRender() override {}
+    virtual void dispose(bool disposeProxy) override {}
+    virtual Armature* getArmature() const override { return _armature; }
+    virtual Animation* getAnimation() const override { return nullptr; }
+    virtual uint32_t getRenderOrder() const override { return 0; }
+
+private:
+    Armature* _armature = nullptr;
+};
+
+float value(int i, float range)
+{
+    return (float)(i % 7 - 3) * range / 3.0f;
+}
+
+ArmatureData* buildArmatureData(int boneCount)
+{
+    const auto armatureData = BaseObject::borrowObject<ArmatureData>();
+    armatureData->name = "armature";
+
+    for (int i = 0; i < boneCount; i++)
+    {
+        const auto boneData = BaseObject::borrowObject<BoneData>();
+        boneData->name = "bone" + std::to_string(i);
+        boneData->inheritTranslation = true;
+        boneData->inheritRotation = true;
+        boneData->inheritScale = true;
+        boneData->length = 10.0f;
+        boneData->parent = i > 0 ? armatureData->sortedBones[(i - 1) / 2] : nullptr;
+        boneData->transform.x = 10.0f + value(i, 5.0f);
+        boneData->transform.y = value(i + 3, 5.0f);
+        boneData->transform.rotation = value(i + 1, 0.5f);
+        boneData->transform.skew = i % 5 == 0 ? 0.1f : 0.0f;
+        boneData->transform.scaleX = 1.0f + value(i + 2, 0.1f);
+        boneData->transform.scaleY = 1.0f;
+        armatureData->addBone(boneData);
+    }
+
+    return armatureData;
+}
+
+// Same as BaseFactory::_buildArmature without slots and animations.
+Armature* buildArmature(ArmatureData* armatureData, NullProxy* proxy)
+{
+    const auto armature = BaseObject::borrowObject<Armature>();
+    armature->init(armatureData, proxy, nullptr, nullptr);
+
+    for (const auto boneData : armatureData->sortedBones)
+    {
+        const auto bone = BaseObject::borrowObject<Bone>();
+        bone->init(boneData, armature);
+    }
+
+    return armature;
+}
+
+bool isLeaf(const ArmatureData* armatureData, int index)
+{
+    return index * 2 + 1 >= (int)armatureData->sortedBones.size();
+}
+
+void animate(Armature* armature, Animated animated, int frame)
+{
+    if (animated == Animated::NONE)
+    {
+        return;
+    }
+
+    const auto& bones = armature->getBones();
+    for (int i = 0, l = (int)bones.size(); i < l; i++)
+    {
+        if (animated == Animated::LEAVES && !isLeaf(armature->getArmatureData(), i))
+        {
+            continue;
+        }
+
+        const auto bone = bones[i];
+        bone->animationPose.x = value(frame + i, 2.0f);
+        bone->animationPose.rotation = value(frame * 3 + i, 0.3f);
+        bone->animationPose.scaleX = 1.0f + value(frame + i, 0.05f);
+        bone->invalidUpdate();
+    }
+}
+
+void updatePerBone(Armature* armature)
+{
+    for (const auto bone : armature->getBones())
+    {
+        bone->update(-1);
+    }
+}
+
+void updatePose(Armature* armature)
+{
+    BENCHMARK_CHECK(armature->_updateBonePoses(), "the armature is not updated by the pose");
+}
+
+void checkMatrices(Armature* armature, Armature* expected)
+{
+    const auto& bones = armature->getBones();
+    const auto& expectedBones = expected->getBones();
+    for (std::size_t i = 0; i < bones.size(); i++)
+    {
+        const auto& m = bones[i]->globalTransformMatrix;
+        const auto& e = expectedBones[i]->globalTransformMatrix;
+        BENCHMARK_CHECK(m.a == e.a && m.b == e.b && m.c == e.c && m.d == e.d && m.tx == e.tx && m.ty == e.ty,
+            "bone %zu: pose (%f %f %f %f %f %f), per bone (%f %f %f %f %f %f)", i,
+            m.a, m.b, m.c, m.d, m.tx, m.ty, e.a, e.b, e.c, e.d, e.tx, e.ty);
+
+        const auto& g = bones[i]->global;
+        const auto& eg = expectedBones[i]->global;
+        BENCHMARK_CHECK(g.x == eg.x && g.y == eg.y, "bone %zu: global position differs", i);
+    }
+}
+
+template<typename Update>
+double measureFrames(Animated animated, Update update, std::vector<Armature*>& armatures, int& frame)
+{
+    const auto ms = benchmark::measure([&]() {
+        frame++;
+        for (const auto armature : armatures)
+        {
+            animate(armature, animated, frame);
+            update(armature);
+        }
+    }, 5, 50.0);
+
+    float sum = 0.0f;
+    for (const auto armature : armatures)
+    {
+        sum += armature->getBones().back()->globalTransformMatrix.tx;
+    }
+    benchmark::keep(sum);
+    return ms;
+}
+
+void runSize(const Size& size)
+{
+    const auto armatureData = buildArmatureData(size.boneCount);
+    NullProxy proxies[ARMATURE_COUNT * 2];
+    std::vector<Armature*> perBoneArmatures;
+    std::vector<Armature*> poseArmatures;
+    for (int i = 0; i < ARMATURE_COUNT; i++)
+    {
+        perBoneArmatures.push_back(buildArmature(armatureData, &proxies[i * 2]));
+        poseArmatures.push_back(buildArmature(armatureData, &proxies[i * 2 + 1]));
+    }
+
+    // Same frames for both variants, including the first update of every bone.
+    const struct { const char* name; Animated animated; } cases[] = {
+        { "all", Animated::ALL },
+        { "leaves", Animated::LEAVES },
+        { "none", Animated::NONE },
+    };
+    for (int frame = 0; frame < 4; frame++)
+    {
+        const auto& animatedCase = cases[frame % 3];
+        animate(perBoneArmatures[0], animatedCase.animated, frame);
+        animate(poseArmatures[0], animatedCase.animated, frame);
+        updatePerBone(perBoneArmatures[0]);
+        updatePose(poseArmatures[0]);
+        checkMatrices(poseArmatures[0], perBoneArmatures[0]);
+    }
+
+    // The variants are measured in turns, so both see the same load of the machine.
+    const auto count = (std::size_t)size.boneCount * ARMATURE_COUNT;
+    for (const auto& animatedCase : cases)
+    {
+        int perBoneFrame = 0;
+        int poseFrame = 0;
+        auto perBoneMs = 1e30;
+        auto poseMs = 1e30;
+        for (int round = 0; round < ROUND_COUNT; round++)
+        {
+            perBoneMs = std::min(perBoneMs, measureFrames(animatedCase.animated, updatePerBone, perBoneArmatures, perBoneFrame));
+            poseMs = std::min(poseMs, measureFrames(animatedCase.animated, updatePose, poseArmatures, poseFrame));
+        }
+
+        const std::string name = std::string("armature pose ") + size.name + " " + animatedCase.name;
+        benchmark::report(name.c_str(), "per bone", count, perBoneMs);
+        benchmark::report(name.c_str(), "pose", count, poseMs);
+    }
+
+    for (int i = 0; i < ARMATURE_COUNT; i++)
+    {
+        animate(perBoneArmatures[i], Animated::ALL, 0);
+        animate(poseArmatures[i], Animated::ALL, 0);
+        updatePerBone(perBoneArmatures[i]);
+        updatePose(poseArmatures[i]);
+        checkMatrices(poseArmatures[i], perBoneArmatures[i]);
+    }
+
+    for (int i = 0; i < ARMATURE_COUNT; i++)
+    {
+        perBoneArmatures[i]->returnToPool();
+        poseArmatures[i]->returnToPool();
+    }
+    armatureData->returnToPool();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    for (const auto& size : SIZES)
+    {
+        runSize(size);
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <chrono>
+#include <algorithm>
+
+/**
+ * Helpers shared by the benchmarks and tests in this directory.
+ * Every benchmark is a plain executable which prints one line per case, so the output can be diffed between two builds.
+ */
+
+namespace benchmark {
+
+/**
+ *  @brief Runs func until it took at least minMilliseconds and at least minRuns times, returns the best milliseconds of one run.
+ */
+template<typename Func>
+double measure(Func&& func, int minRuns = 5, double minMilliseconds = 200.0)
+{
+    typedef std::chrono::high_resolution_clock Clock;
+    double best = 1e30;
+    double total = 0.0;
+    for (int run = 0; run < minRuns || total < minMilliseconds; run++)
+    {
+        auto begin = Clock::now();
+        func();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+        best = std::min(best, ms);
+        total += ms;
+    }
+    return best;
+}
+
+/**
+ *  @brief Prints one case, count is the amount of items processed by one run.
+ */
+inline void report(const char* name, const char* variant, std::size_t count, double milliseconds)
+{
+    printf("%-28s %-20s %8zu items %10.4f ms %12.1f items/ms\n", name, variant, count, milliseconds, milliseconds > 0.0 ? count / milliseconds : 0.0);
+}
+
+/**
+ *  @brief Keeps the optimizer from dropping the result of a benchmarked loop.
+ */
+inline void keep(float value)
+{
+    static volatile float sink;
+    sink = value;
+    (void)sink;
+}
+
+/**
+ *  @brief Fails the running test with a message, tests exit with a non zero code on the first failure.
+ */
+#define BENCHMARK_CHECK(cond, ...) \
+    do { \
+        if (!(cond)) \
+        { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            fprintf(stderr, __VA_ARGS__); \
+            fprintf(stderr, "\n"); \
+            exit(1); \
+        } \
+    } while (0)
+
+} // namespace benchmark
@@ -0,0 +1,151 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "Benchmark.h"
+#include "renderer/gfx/BufferRing.h"
+#include "renderer/gfx/DeviceGraphics.h"
+#include "renderer/gfx/VertexFormat.h"
+#include "renderer/gfx/GFXNull.h"
+#include "base/CCGLUtils.h"
+
+/**
+ * The allocation and synchronization policy of BufferRing, run on the null GL driver.
+ */
+
+using namespace cocos2d::renderer;
+
+namespace {
+
+VertexFormat* createFormat()
+{
+    VertexFormat* format = new VertexFormat({
+        { ATTRIB_NAME_POSITION, AttribType::FLOAT32, 2 },
+        { ATTRIB_NAME_UV0, AttribType::FLOAT32, 2 },
+        { ATTRIB_NAME_COLOR, AttribType::UINT8, 4, true },
+    });
+    format->autorelease();
+    return format;
+}
+
+void setFenceSyncSupported(bool supported)
+{
+    GFXNull::setFenceSyncSupported(supported);
+    cocos2d::ccInvalidateStateCache();
+}
+
+// Slots rotate, grow and shrink with the ring size, and the vertex buffers of a slot are reused by later frames.
+void testAllocation(DeviceGraphics* device, VertexFormat* format)
+{
+    setFenceSyncSupported(false);
+    uint32_t liveObjects = GFXNull::getLiveObjectCount();
+    {
+        BufferRing ring(device, format);
+        BENCHMARK_CHECK(ring.getSize() == 1 && ring.getIndex() == 0, "a new ring has one slot");
+        BENCHMARK_CHECK(GFXNull::getLiveObjectCount() == liveObjects + 2, "a slot has a vertex buffer and an index buffer");
+        
+        VertexBuffer* first = ring.getVertexBuffer();
+        for (int frame = 1; frame <= 3; frame++)
+        {
+            ring.advance(3);
+            BENCHMARK_CHECK(ring.getIndex() == (std::size_t)frame % 3, "frame %d uses slot %zu", frame, ring.getIndex());
+            BENCHMARK_CHECK(ring.getVertexBufferPos() == 0, "a frame starts at the first vertex buffer of its slot");
+        }
+        BENCHMARK_CHECK(ring.getSize() == 3, "the ring grows to the requested size, it has %zu slots", ring.getSize());
+        BENCHMARK_CHECK(ring.getVertexBuffer() == first, "the ring wraps to the buffers of the first frame");
+        
+        // A frame which overflows one vertex buffer moves to the next one of its slot.
+        VertexBuffer* second = ring.nextVertexBuffer();
+        ring.nextVertexBuffer();
+        BENCHMARK_CHECK(second != first && ring.getVertexBufferPos() == 2, "overflowed vertex buffers are created in the slot");
+        BENCHMARK_CHECK(ring.getVertexBufferCount(0) == 3, "slot 0 has %zu vertex buffers", ring.getVertexBufferCount(0));
+        uint32_t grown = GFXNull::getLiveObjectCount();
+        for (int frame = 0; frame < 3; frame++)
+        {
+            ring.advance(3);
+        }
+        BENCHMARK_CHECK(ring.nextVertexBuffer() == second, "overflowed vertex buffers are reused when the slot comes again");
+        BENCHMARK_CHECK(GFXNull::getLiveObjectCount() == grown, "reusing a slot creates no buffer");
+        
+        ring.advance(1);
+        BENCHMARK_CHECK(ring.getSize() == 1 && ring.getIndex() == 0, "the ring shrinks to the requested size");
+        BENCHMARK_CHECK(GFXNull::getLiveObjectCount() == liveObjects + 4, "buffers of removed slots are deleted");
+        BENCHMARK_CHECK(!ring.isUnsynchronized(), "nothing is unsynchronized without fences");
+    }
+    BENCHMARK_CHECK(GFXNull::getLiveObjectCount() == liveObjects, "the ring deletes its buffers");
+}
+
+// Slots are written without synchronization only after their fences are waited.
+void testFences(DeviceGraphics* device, VertexFormat* format)
+{
+    setFenceSyncSupported(true);
+    GFXNull::resetStats();
+    uint32_t liveObjects = GFXNull::getLiveObjectCount();
+    {
+        BufferRing ring(device, format);
+        BENCHMARK_CHECK(!ring.isUnsynchronized(), "the first slot is written with synchronization");
+        
+        // Below UNSYNCHRONIZED_SIZE nothing is fenced, the wait would block on the frame just issued.
+        ring.advance(BufferRing::UNSYNCHRONIZED_SIZE - 1);
+        ring.advance(BufferRing::UNSYNCHRONIZED_SIZE - 1);
+        BENCHMARK_CHECK(!ring.isUnsynchronized(), "a small ring is synchronized");
+        BENCHMARK_CHECK(GFXNull::getStats().fenceSyncs == 0, "a small ring inserts no fence");
+        
+        // Slot 1 was left without a fence while the ring was small, the new slot 2 has never been drawn.
+        const std::size_t size = BufferRing::UNSYNCHRONIZED_SIZE;
+        ring.advance(size);
+        BENCHMARK_CHECK(ring.getIndex() == 1 && !ring.isUnsynchronized(), "a slot left without a fence is synchronized");
+        ring.advance(size);
+        BENCHMARK_CHECK(ring.getIndex() == 2 && ring.isUnsynchronized(), "a new slot is unsynchronized");
+        
+        GFXNull::resetStats();
+        for (std::size_t frame = 0; frame < size * 4; frame++)
+        {
+            ring.advance(size);
+            BENCHMARK_CHECK(ring.isUnsynchronized(), "a fenced slot is unsynchronized after its fence is waited");
+        }
+        const GFXNullStats& stats = GFXNull::getStats();
+        BENCHMARK_CHECK(stats.fenceSyncs == size * 4, "every advance fences the slot it leaves, %u fences", stats.fenceSyncs);
+        BENCHMARK_CHECK(stats.fenceWaits == size * 4, "every advance waits for the slot it enters, %u waits", stats.fenceWaits);
+        BENCHMARK_CHECK(GFXNull::getLiveObjectCount() == liveObjects + size * 2 + size - 1,
+                        "waited fences are deleted, %u live objects", GFXNull::getLiveObjectCount() - liveObjects);
+    }
+    BENCHMARK_CHECK(GFXNull::getLiveObjectCount() == liveObjects, "the ring deletes its fences");
+    setFenceSyncSupported(false);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    DeviceGraphics* device = DeviceGraphics::getInstance();
+    VertexFormat* format = createFormat();
+    format->retain();
+    
+    testAllocation(device, format);
+    testFences(device, format);
+    
+    format->release();
+    printf("buffer ring: passed\n");
+    return 0;
+}
@@ -1,18 +1,18 @@
 /****************************************************************************
- Copyright (c) 2018 Xiamen Yaji Software Co., Ltd.
- 
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
  http://www.cocos2d-x.org
- 
+
  Permission is hereby granted, free of charge, to any person obtaining a copy
  of this software and associated documentation files (the "Software"), to deal
  in the Software without restriction, including without limitation the rights
  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
  copies of the Software, and to permit persons to whom the Software is
  furnished to do so, subject to the following conditions:
- 
+
  The above copyright notice and this permission notice shall be included in
  all copies or substantial portions of the Software.
- 
+
  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
@@ -22,57 +22,57 @@
  THE SOFTWARE.
  ****************************************************************************/
 
-#pragma once
+#include "platform/CCApplication.h"
+#include "platform/CCFileUtils.h"
+
+/**
+ * The parts of the platform layer which the native renderer calls, for the targets which run it without a window.
+ * Only the view size is kept, the application never starts a main loop.
+ */
+
+NS_CC_BEGIN
+
+Application* Application::_instance = nullptr;
+std::shared_ptr<Scheduler> Application::_scheduler = nullptr;
+
+Application::Application(const std::string& name, int width, int height)
+{
+    Application::_instance = this;
+    _viewSize.x = width;
+    _viewSize.y = height;
+}
+
+Application::~Application()
+{
+    Application::_instance = nullptr;
+}
+
+bool Application::applicationDidFinishLaunching()
+{
+    return true;
+}
+
+void Application::onPause()
+{
+}
 
-#include "../Macro.h"
-#include <vector>
-#include <stdint.h>
-#include <functional>
-#include <thread>
-#include <memory>
-#include <condition_variable>
-#include <mutex>
+void Application::onResume()
+{
+}
 
-RENDERER_BEGIN
+void Application::onCreateView(PixelFormat& pixelformat, DepthFormat& depthFormat, int& multisamplingCount)
+{
+}
 
-class ParallelTask
+const cocos2d::Vec2& Application::getViewSize() const
 {
-public:
-    
-    enum RunFlag{
-        Begin = 0x00,
-        Stop = 0x01,
-    };
-    
-    typedef std::function<void(int)> Task;
-    
-    ParallelTask();
-    virtual ~ParallelTask();
-    
-    void pushTask(int tid, const Task& task);
-    void clearTasks();
-    
-    uint8_t* getRunFlag();
-    
-    void init(int threadNum);
-    void destroy();
-    
-    void waitAllThreads();
-    void stopAllThreads();
-    void beginAllThreads();
-private:
-    void joinThread(int tid);
-    void setThread(int tid);
-private:
-    std::vector<std::vector<Task>> _tasks;
-    std::vector<std::unique_ptr<std::thread>> _threads;
-    
-    uint8_t* _runFlags = nullptr;
-    bool _finished = false;
-    int _threadNum = 0;
-    
-    std::mutex _mutex;
-    std::condition_variable _cv;
-};
-
-RENDERER_END
+    return _viewSize;
+}
+
+// There is no file system, the null driver has no program binary format so the program cache is never created.
+FileUtils* FileUtils::getInstance()
+{
+    return nullptr;
+}
+
+NS_CC_END
@@ -0,0 +1,122 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "Benchmark.h"
+#include "renderer/scene/JobSystem.hpp"
+#include "math/Mat4.h"
+#include "math/Quaternion.h"
+#include <vector>
+#include <thread>
+
+/**
+ * Scaling of JobSystem::parallelFor with node count and worker count.
+ * Every node builds its local matrix from TRS the way RenderFlow did before the math kernel,
+ * with the grain RenderFlow uses for the world matrix stage.
+ */
+
+using namespace cocos2d::renderer;
+
+namespace {
+
+struct Node
+{
+    float x, y, z;
+    cocos2d::Quaternion rotation;
+    float sx, sy, sz;
+    cocos2d::Mat4 local;
+};
+
+const std::size_t Job_Node_Count = 128;
+
+void updateNodes(std::vector<Node>& nodes, std::size_t begin, std::size_t end)
+{
+    cocos2d::Mat4 temp;
+    for (std::size_t i = begin; i < end; i++)
+    {
+        auto& node = nodes[i];
+        node.local.setIdentity();
+        node.local.translate(node.x, node.y, node.z);
+        cocos2d::Mat4::createRotation(node.rotation, &temp);
+        cocos2d::Mat4::multiply(node.local, temp, &node.local);
+        cocos2d::Mat4::createScale(node.sx, node.sy, node.sz, &temp);
+        cocos2d::Mat4::multiply(node.local, temp, &node.local);
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t counts[] = { 1000, 5000, 10000, 20000, 50000, 100000 };
+    // The first argument overrides the largest worker count, it defaults to the hardware concurrency minus the calling thread.
+    int hardwareWorkers = argc > 1 ? atoi(argv[1]) : (int)std::thread::hardware_concurrency() - 1;
+    if (hardwareWorkers < 0) hardwareWorkers = 0;
+    if (hardwareWorkers > JOB_SYSTEM_MAX_WORKER_COUNT) hardwareWorkers = JOB_SYSTEM_MAX_WORKER_COUNT;
+
+    std::vector<int> workerCounts = { 0, 1, 3, 7 };
+    workerCounts.erase(std::remove_if(workerCounts.begin(), workerCounts.end(), [hardwareWorkers](int n) {
+        return n > hardwareWorkers;
+    }), workerCounts.end());
+    if (std::find(workerCounts.begin(), workerCounts.end(), hardwareWorkers) == workerCounts.end())
+    {
+        workerCounts.push_back(hardwareWorkers);
+    }
+
+    printf("hardware concurrency %u\n", std::thread::hardware_concurrency());
+    for (auto count : counts)
+    {
+        std::vector<Node> nodes(count);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            auto& node = nodes[i];
+            node.x = (float)i;
+            node.y = (float)(i % 100);
+            node.z = 0.0f;
+            node.rotation.set(cocos2d::Vec3(0.0f, 0.0f, 1.0f), i * 0.01f);
+            node.sx = node.sy = node.sz = 1.0f + (i % 7) * 0.1f;
+        }
+
+        double serial = benchmark::measure([&nodes, count]() {
+            updateNodes(nodes, 0, count);
+        });
+        benchmark::report("local matrix", "serial", count, serial);
+
+        for (auto workerCount : workerCounts)
+        {
+            JobSystem jobSystem(workerCount);
+            double parallel = benchmark::measure([&nodes, &jobSystem, count]() {
+                jobSystem.parallelFor(0, count, Job_Node_Count, [&nodes](std::size_t begin, std::size_t end) {
+                    updateNodes(nodes, begin, end);
+                });
+            });
+
+            char variant[32];
+            snprintf(variant, sizeof(variant), "%d workers", workerCount);
+            benchmark::report("local matrix", variant, count, parallel);
+        }
+        benchmark::keep(nodes[count - 1].local.m[12]);
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "Benchmark.h"
+#include "renderer/scene/MathKernel.hpp"
+#include "renderer/scene/NodeMemPool.hpp"
+#include "math/Mat4.h"
+#include "math/Quaternion.h"
+#include <vector>
+#include <math.h>
+
+/**
+ * MathKernel against the scalar Mat4 paths it replaced in the render flow.
+ */
+
+using namespace cocos2d::renderer;
+
+namespace {
+
+void fillTRS(std::vector<TRS>& trs, std::vector<uint8_t>& is3D)
+{
+    for (std::size_t i = 0, n = trs.size(); i < n; i++)
+    {
+        auto& t = trs[i];
+        cocos2d::Quaternion q(cocos2d::Vec3(0.3f, 0.2f, 1.0f), i * 0.01f);
+        t.x = (float)(i % 1000);
+        t.y = (float)(i / 1000);
+        t.z = 1.0f;
+        t.qx = q.x; t.qy = q.y; t.qz = q.z; t.qw = q.w;
+        t.sx = 1.0f + (i % 5) * 0.25f;
+        t.sy = 1.0f + (i % 3) * 0.5f;
+        t.sz = 2.0f;
+        is3D[i] = i % 8 == 0;
+    }
+}
+
+// The local matrix path of RenderFlow before MathKernel.
+void composeByMat4(const std::vector<TRS>& trs, const std::vector<uint8_t>& is3D, std::vector<cocos2d::Mat4>& out)
+{
+    cocos2d::Mat4 matTemp;
+    for (std::size_t i = 0, n = trs.size(); i < n; i++)
+    {
+        auto& t = trs[i];
+        auto& localMat = out[i];
+        localMat.setIdentity();
+        localMat.translate(t.x, t.y, is3D[i] ? t.z : 0);
+        cocos2d::Mat4::createRotation(*(const cocos2d::Quaternion*)&t.qx, &matTemp);
+        cocos2d::Mat4::multiply(localMat, matTemp, &localMat);
+        cocos2d::Mat4::createScale(t.sx, t.sy, is3D[i] ? t.sz : 1, &matTemp);
+        cocos2d::Mat4::multiply(localMat, matTemp, &localMat);
+    }
+}
+
+void composeByKernel(const std::vector<TRS>& trs, const std::vector<uint8_t>& is3D, std::vector<cocos2d::Mat4>& out)
+{
+    for (std::size_t i = 0, n = trs.size(); i < n; i++)
+    {
+        MathKernel::composeLocalMatrix(&trs[i], is3D[i] != 0, &out[i]);
+    }
+}
+
+void composeByKernel4(const std::vector<TRS>& trs, const std::vector<uint8_t>& is3D, std::vector<cocos2d::Mat4>& out)
+{
+    const int BATCH_SIZE = MathKernel::BATCH_SIZE;
+    const TRS* batchTRS[BATCH_SIZE];
+    cocos2d::Mat4* batchMat[BATCH_SIZE];
+    std::size_t i = 0, n = trs.size();
+    for (; i + BATCH_SIZE <= n; i += BATCH_SIZE)
+    {
+        for (int k = 0; k < BATCH_SIZE; k++)
+        {
+            batchTRS[k] = &trs[i + k];
+            batchMat[k] = &out[i + k];
+        }
+        MathKernel::composeLocalMatrix4(batchTRS, &is3D[i], batchMat);
+    }
+    for (; i < n; i++)
+    {
+        MathKernel::composeLocalMatrix(&trs[i], is3D[i] != 0, &out[i]);
+    }
+}
+
+float maxError(const std::vector<cocos2d::Mat4>& a, const std::vector<cocos2d::Mat4>& b)
+{
+    float error = 0.0f;
+    for (std::size_t i = 0, n = a.size(); i < n; i++)
+    {
+        for (int k = 0; k < 16; k++)
+        {
+            error = std::max(error, fabsf(a[i].m[k] - b[i].m[k]));
+        }
+    }
+    return error;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+#if MATH_KERNEL_SSE
+    printf("math kernel: sse\n");
+#elif MATH_KERNEL_NEON
+    printf("math kernel: neon\n");
+#else
+    printf("math kernel: scalar\n");
+#endif
+
+    const std::size_t counts[] = { 1000, 10000, 20000, 50000, 100000 };
+    for (auto count : counts)
+    {
+        std::vector<TRS> trs(count);
+        std::vector<uint8_t> is3D(count);
+        std::vector<cocos2d::Mat4> expected(count), actual(count);
+        fillTRS(trs, is3D);
+
+        double mat4 = benchmark::measure([&]() { composeByMat4(trs, is3D, expected); });
+        benchmark::report("compose local matrix", "mat4", count, mat4);
+        double kernel = benchmark::measure([&]() { composeByKernel(trs, is3D, actual); });
+        benchmark::report("compose local matrix", "kernel x1", count, kernel);
+        BENCHMARK_CHECK(maxError(expected, actual) < 1e-3f, "kernel x1 differs from mat4 by %f", maxError(expected, actual));
+        double kernel4 = benchmark::measure([&]() { composeByKernel4(trs, is3D, actual); });
+        benchmark::report("compose local matrix", "kernel x4", count, kernel4);
+        BENCHMARK_CHECK(maxError(expected, actual) < 1e-3f, "kernel x4 differs from mat4 by %f", maxError(expected, actual));
+        benchmark::keep(actual[count - 1].m[12]);
+    }
+    return 0;
+}
@@ -0,0 +1,566 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "Benchmark.h"
+#include "platform/CCApplication.h"
+#include "renderer/gfx/DeviceGraphics.h"
+#include "renderer/gfx/GFXNull.h"
+#include "renderer/gfx/VertexFormat.h"
+#include "renderer/renderer/Camera.h"
+#include "renderer/renderer/Effect.h"
+#include "renderer/renderer/EffectVariant.hpp"
+#include "renderer/renderer/ForwardRenderer.h"
+#include "renderer/renderer/InputAssembler.h"
+#include "renderer/renderer/Model.h"
+#include "renderer/renderer/Pass.h"
+#include "renderer/renderer/Scene.h"
+#include "renderer/renderer/Technique.h"
+#include "renderer/scene/MeshBuffer.hpp"
+#include "renderer/scene/ModelBatcher.hpp"
+#include "renderer/scene/NodeMemPool.hpp"
+#include "renderer/scene/NodeProxy.hpp"
+#include "renderer/scene/RenderFlow.hpp"
+#include "renderer/scene/assembler/Assembler.hpp"
+#include "renderer/scene/assembler/RenderDataList.hpp"
+#include "scripting/js-bindings/jswrapper/SeApi.h"
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+/**
+ * Two-phase batching of ModelBatcher, run on the null GL driver. One synthetic node tree is rendered with the serial fill
+ * and then with the parallel fill, the vertex and index data of every MeshBuffer and the Models with their input assemblers
+ * must be the same byte for byte. Every node has its own quad, runs of nodes use a vertex format split into two streams
+ * or change the effect, so the fills run on the job system across buffer switches and batch breaks.
+ * The large tree overflows a vertex buffer, only the data after the last overflow is compared there.
+ */
+
+using namespace cocos2d;
+using namespace cocos2d::renderer;
+
+namespace {
+
+const std::size_t Unit_Node_Count = 128;
+const int View_Width = 1280;
+const int View_Height = 720;
+const float Sprite_Size = 32.0f;
+const std::size_t Tree_Fanout = 8;
+const std::size_t Effect_Run_Length = 40;
+const std::size_t Format_Run_Length = 25;
+
+const char* Vert_Source =
+    "uniform mat4 cc_matViewProj;\n"
+    "attribute vec3 a_position;\n"
+    "attribute vec2 a_uv0;\n"
+    "attribute vec4 a_color;\n"
+    "varying vec4 v_color;\n"
+    "void main () {\n"
+    "    v_color = a_color;\n"
+    "    gl_Position = cc_matViewProj * vec4(a_position.xy, 0.0, 1.0);\n"
+    "}\n";
+
+const char* Frag_Source =
+    "precision mediump float;\n"
+    "varying vec4 v_color;\n"
+    "void main () {\n"
+    "    gl_FragColor = v_color;\n"
+    "}\n";
+
+// A pseudo random sequence, so every run builds the same tree.
+uint32_t nextRandom(uint32_t& seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+float randomRange(uint32_t& seed, float min, float max)
+{
+    return min + (max - min) * (nextRandom(seed) & 0xffff) / 65535.0f;
+}
+
+se::Object* createArray(se::Object::TypedArrayType type, std::size_t byteLength)
+{
+    return se::Object::createTypedArray(type, nullptr, byteLength);
+}
+
+template<typename T>
+T* getArrayData(se::Object* array)
+{
+    uint8_t* data = nullptr;
+    std::size_t length = 0;
+    array->getTypedArrayData(&data, &length);
+    return (T*)data;
+}
+
+struct Unit
+{
+    std::size_t unitID = 0;
+    uint16_t* common = nullptr;
+    Sign* signs = nullptr;
+    std::size_t usingNum = 0;
+};
+
+struct Node
+{
+    NodeProxy* proxy = nullptr;
+    std::size_t unitID = 0;
+    std::size_t index = 0;
+    int level = 0;
+    TRS* trs = nullptr;
+    uint32_t* dirty = nullptr;
+};
+
+/**
+ * A Model as the forward renderer draws it.
+ */
+struct ModelRecord
+{
+    const NodeProxy* node = nullptr;
+    EffectVariant* effect = nullptr;
+    int cullingMask = 0;
+    Mat4 worldMatrix;
+    VertexBuffer* vertexBuffer = nullptr;
+    IndexBuffer* indexBuffer = nullptr;
+    int start = 0;
+    int count = 0;
+};
+
+/**
+ * The vertex data of every stream and the index data written to one MeshBuffer in a frame.
+ */
+struct BufferRecord
+{
+    std::vector<std::vector<uint8_t>> streams;
+    std::vector<uint16_t> indices;
+};
+
+struct Frame
+{
+    std::vector<BufferRecord> buffers;
+    std::vector<ModelRecord> models;
+    GFXNullStats stats;
+};
+
+class Test
+{
+public:
+    Test();
+    ~Test();
+
+    void run(std::size_t nodeCount);
+private:
+    Unit& requestUnit();
+    Node createNode(const Node* parent);
+    void buildTree(std::size_t nodeCount);
+    void destroyTree();
+    Frame renderFrame(bool parallel, bool dirty);
+    void compareFrames(const char* name, const Frame& serial, const Frame& parallel);
+
+    Application* _application = nullptr;
+    DeviceGraphics* _device = nullptr;
+    NodeMemPool* _pool = nullptr;
+    Scene* _scene = nullptr;
+    ForwardRenderer* _forward = nullptr;
+    RenderFlow* _flow = nullptr;
+    Camera* _camera = nullptr;
+    Effect* _baseEffect = nullptr;
+    EffectVariant* _effects[2] = {};
+    VertexFormat* _splitFormat = nullptr;
+    VertexFormat* _formats[2] = {};
+
+    std::vector<Unit> _units;
+    std::vector<Node> _nodes;
+    std::vector<RenderDataList*> _quads;
+    Node _cameraNode;
+    std::size_t _cameraUnitCount = 0;
+    uint32_t _seed = 1;
+};
+
+Test::Test()
+{
+    _application = new Application("parallel_fill_test", View_Width, View_Height);
+    se::ScriptEngine::getInstance()->start();
+
+    _device = DeviceGraphics::getInstance();
+    _pool = new NodeMemPool();
+    _scene = new Scene();
+
+    std::vector<ProgramLib::Template> templates(1);
+    templates[0].name = "test_sprite";
+    templates[0].vert = Vert_Source;
+    templates[0].frag = Frag_Source;
+    _forward = new ForwardRenderer();
+    _forward->init(_device, templates, nullptr, View_Width, View_Height);
+    _flow = new RenderFlow(_device, _scene, _forward);
+    // The same vertex buffers every frame, so the input assemblers of both fills can be compared.
+    _flow->setBufferRingSize(1);
+
+    Pass* pass = new Pass("test_sprite");
+    pass->setStage("transparent");
+    Vector<Pass*> passes;
+    passes.pushBack(pass);
+    pass->release();
+    Technique* technique = new Technique("transparent", passes);
+    Vector<Technique*> techniques;
+    techniques.pushBack(technique);
+    technique->release();
+    _baseEffect = new Effect();
+    _baseEffect->init(techniques);
+    // Variants of different hashes break the batch.
+    for (int i = 0; i < 2; i++)
+    {
+        _effects[i] = new EffectVariant(_baseEffect);
+        _effects[i]->updateHash(i + 1);
+    }
+
+    // Same packed layout as XY_UV_Color, the position is stored in a stream of its own.
+    _splitFormat = new VertexFormat({
+        { ATTRIB_NAME_POSITION, AttribType::FLOAT32, 2 },
+        { ATTRIB_NAME_UV0, AttribType::FLOAT32, 2, false, 1 },
+        { ATTRIB_NAME_COLOR, AttribType::UINT8, 4, true, 1 },
+    });
+    _formats[0] = VertexFormat::XY_UV_Color;
+    _formats[1] = _splitFormat;
+
+    _cameraNode = createNode(nullptr);
+    _cameraNode.trs->x = View_Width * 0.5f;
+    _cameraNode.trs->y = View_Height * 0.5f;
+    _cameraNode.trs->z = 500.0f;
+    _cameraUnitCount = _units.size();
+
+    _camera = new Camera();
+    _camera->setType(ProjectionType::ORTHOGRAPHIC);
+    _camera->setOrthoHeight(View_Height * 0.5f);
+    _camera->setNear(0.1f);
+    _camera->setFar(1000.0f);
+    _camera->setStages({ "transparent" });
+    _camera->setNode(_cameraNode.proxy);
+    _scene->addCamera(_camera);
+}
+
+Test::~Test()
+{
+    destroyTree();
+    _scene->removeCamera(_camera);
+    RENDERER_SAFE_RELEASE(_camera);
+    _cameraNode.proxy->destroyImmediately();
+    _cameraNode.proxy->release();
+
+    RENDERER_SAFE_RELEASE(_splitFormat);
+    RENDERER_SAFE_RELEASE(_effects[0]);
+    RENDERER_SAFE_RELEASE(_effects[1]);
+    RENDERER_SAFE_RELEASE(_baseEffect);
+    delete _flow;
+    RENDERER_SAFE_RELEASE(_forward);
+    delete _scene;
+    delete _pool;
+    se::ScriptEngine::destroyInstance();
+    delete _application;
+}
+
+Unit& Test::requestUnit()
+{
+    if (!_units.empty() && _units.back().usingNum < Unit_Node_Count)
+    {
+        return _units.back();
+    }
+
+    se::AutoHandleScope hs;
+    Unit unit;
+    unit.unitID = _units.size();
+    std::size_t n = Unit_Node_Count;
+
+    se::Object* common = createArray(se::Object::TypedArrayType::UINT16, sizeof(uint16_t) * 2);
+    se::Object* signs = createArray(se::Object::TypedArrayType::UINT16, sizeof(Sign) * n);
+    unit.common = getArrayData<uint16_t>(common);
+    unit.signs = getArrayData<Sign>(signs);
+    _pool->updateCommonData(unit.unitID, common, signs);
+
+    se::Object* arrays[] = {
+        createArray(se::Object::TypedArrayType::UINT32, sizeof(uint32_t) * n),
+        createArray(se::Object::TypedArrayType::FLOAT32, sizeof(TRS) * n),
+        createArray(se::Object::TypedArrayType::FLOAT32, sizeof(Mat4) * n),
+        createArray(se::Object::TypedArrayType::FLOAT32, sizeof(Mat4) * n),
+        createArray(se::Object::TypedArrayType::UINT32, sizeof(ParentInfo) * n),
+        createArray(se::Object::TypedArrayType::INT32, sizeof(int32_t) * n),
+        createArray(se::Object::TypedArrayType::INT32, sizeof(int32_t) * n),
+        createArray(se::Object::TypedArrayType::UINT8, sizeof(uint8_t) * n),
+        createArray(se::Object::TypedArrayType::UINT8, sizeof(uint8_t) * n),
+        createArray(se::Object::TypedArrayType::FLOAT64, sizeof(uint64_t) * n),
+        createArray(se::Object::TypedArrayType::FLOAT32, sizeof(Skew) * n),
+    };
+    _pool->updateNodeData(unit.unitID, arrays[0], arrays[1], arrays[2], arrays[3], arrays[4], arrays[5],
+                          arrays[6], arrays[7], arrays[8], arrays[9], arrays[10]);
+
+    common->decRef();
+    signs->decRef();
+    for (auto array : arrays)
+    {
+        array->decRef();
+    }
+
+    _units.push_back(unit);
+    return _units.back();
+}
+
+Node Test::createNode(const Node* parent)
+{
+    Unit& unit = requestUnit();
+    std::size_t index = unit.usingNum++;
+    Node node;
+    node.unitID = unit.unitID;
+    node.index = index;
+    unit.signs[index].freeFlag = 1;
+    unit.common[0] = (uint16_t)unit.unitID;
+    unit.common[1] = (uint16_t)unit.usingNum;
+
+    UnitNode* data = _pool->getUnit(unit.unitID);
+    node.trs = data->getTRS(index);
+    node.trs->qw = 1.0f;
+    node.trs->sx = node.trs->sy = node.trs->sz = 1.0f;
+    node.dirty = data->getDirty(index);
+    *data->getOpacity(index) = 255;
+    *data->getCullingMask(index) = 1;
+
+    node.proxy = new NodeProxy(unit.unitID, index, "", "");
+    *node.dirty = RenderFlow::LOCAL_TRANSFORM | RenderFlow::WORLD_TRANSFORM | RenderFlow::OPACITY;
+    if (parent)
+    {
+        node.level = parent->level + 1;
+        ParentInfo* parentInfo = data->getParent(index);
+        parentInfo->unitID = (uint32_t)parent->unitID;
+        parentInfo->index = (uint32_t)parent->index;
+    }
+    node.proxy->notifyUpdateParent();
+    return node;
+}
+
+void Test::buildTree(std::size_t nodeCount)
+{
+    _seed = 1;
+    _nodes.reserve(nodeCount);
+    _nodes.push_back(createNode(nullptr));
+
+    struct Vertex { float x, y, u, v; uint32_t color; };
+    const float half = Sprite_Size * 0.5f;
+    uint16_t indices[6] = { 0, 1, 2, 1, 3, 2 };
+
+    for (std::size_t i = 1; i < nodeCount; i++)
+    {
+        Node node = createNode(&_nodes[(i - 1) / Tree_Fanout]);
+        _nodes.push_back(node);
+
+        TRS* trs = node.trs;
+        float range = View_Width * 0.25f / (1 << node.level);
+        trs->x = randomRange(_seed, -range, range);
+        trs->y = randomRange(_seed, -range, range) * View_Height / View_Width;
+        float angle = randomRange(_seed, -0.5f, 0.5f);
+        trs->qz = sinf(angle * 0.5f);
+        trs->qw = cosf(angle * 0.5f);
+        bool leaf = i * Tree_Fanout + 1 >= nodeCount;
+        if (leaf && nextRandom(_seed) % 5 == 0)
+        {
+            trs->x += trs->x < 0.0f ? -View_Width : View_Width;
+        }
+        UnitNode* data = _pool->getUnit(node.unitID);
+        *data->getOpacity(node.index) = (uint8_t)(128 + nextRandom(_seed) % 128);
+        *node.dirty |= RenderFlow::RENDER;
+
+        // Every node has its own render data, the opacity is written into it before the deferred fill reads it.
+        uint32_t color = 0xff000000 | (nextRandom(_seed) & 0xffffff);
+        Vertex vertices[4] = {
+            { -half, -half, 0.0f, 1.0f, color },
+            {  half, -half, 1.0f, 1.0f, color },
+            { -half,  half, 0.0f, 0.0f, color },
+            {  half,  half, 1.0f, 0.0f, color },
+        };
+
+        se::AutoHandleScope hs;
+        se::Object* verticesObj = se::Object::createTypedArray(se::Object::TypedArrayType::FLOAT32, vertices, sizeof(vertices));
+        se::Object* indicesObj = se::Object::createTypedArray(se::Object::TypedArrayType::UINT16, indices, sizeof(indices));
+        RenderDataList* quad = new RenderDataList();
+        quad->updateMesh(0, verticesObj, indicesObj);
+        verticesObj->decRef();
+        indicesObj->decRef();
+        _quads.push_back(quad);
+
+        se::Object* assemblerDirty = createArray(se::Object::TypedArrayType::UINT32, sizeof(uint32_t));
+        Assembler* assembler = new Assembler();
+        assembler->setDirty(assemblerDirty);
+        assemblerDirty->decRef();
+        assembler->setVertexFormat(_formats[(i / Format_Run_Length) % 3 == 0 ? 1 : 0]);
+        assembler->setRenderDataList(quad);
+        assembler->updateMeshIndex(0, 0);
+        assembler->updateEffect(0, _effects[(i / Effect_Run_Length) % 2]);
+        assembler->setLocalAABB(-half, -half, 0.0f, half, half, 0.0f);
+        node.proxy->setAssembler(assembler);
+        assembler->release();
+    }
+
+    _nodes[0].trs->x = View_Width * 0.5f;
+    _nodes[0].trs->y = View_Height * 0.5f;
+}
+
+void Test::destroyTree()
+{
+    for (auto it = _nodes.rbegin(); it != _nodes.rend(); it++)
+    {
+        it->proxy->destroyImmediately();
+        it->proxy->release();
+    }
+    _nodes.clear();
+
+    for (auto quad : _quads)
+    {
+        quad->release();
+    }
+    _quads.clear();
+
+    while (_units.size() > _cameraUnitCount)
+    {
+        std::size_t unitID = _units.back().unitID;
+        _pool->removeNodeData(unitID);
+        _pool->removeCommonData(unitID);
+        _units.pop_back();
+    }
+}
+
+Frame Test::renderFrame(bool parallel, bool dirty)
+{
+    _flow->setParallelFillEnabled(parallel);
+    if (dirty)
+    {
+        for (std::size_t i = 1; i < _nodes.size(); i++)
+        {
+            *_nodes[i].dirty |= RenderFlow::LOCAL_TRANSFORM | RenderFlow::OPACITY;
+        }
+    }
+
+    GFXNull::resetStats();
+    _flow->render(_nodes[0].proxy, 1.0f / 60);
+
+    Frame frame;
+    frame.stats = GFXNull::getStats();
+
+    // Buffers keep their data after the upload until the next frame resets them.
+    ModelBatcher* batcher = _flow->getModelBatcher();
+    for (auto format : _formats)
+    {
+        MeshBuffer* buffer = batcher->getBuffer(format);
+        frame.buffers.emplace_back();
+        BufferRecord& record = frame.buffers.back();
+        for (uint32_t stream = 0, streamCount = buffer->getStreamCount(); stream < streamCount; ++stream)
+        {
+            const uint8_t* data = buffer->getStreamData(stream);
+            std::size_t bytes = (std::size_t)buffer->getVertexOffset() * format->getStreamBytes(stream);
+            record.streams.emplace_back(data, data + bytes);
+        }
+        record.indices.assign(buffer->iData, buffer->iData + buffer->getIndexOffset());
+    }
+
+    for (auto model : _scene->getModels())
+    {
+        DrawItem item;
+        model->extractDrawItem(item);
+        frame.models.emplace_back();
+        ModelRecord& record = frame.models.back();
+        record.node = model->getNode();
+        record.effect = model->getEffect();
+        record.cullingMask = model->getCullingMask();
+        record.worldMatrix = model->getWorldMatrix();
+        record.vertexBuffer = item.ia->getVertexBuffer();
+        record.indexBuffer = item.ia->getIndexBuffer();
+        record.start = item.ia->getStart();
+        record.count = item.ia->getCount();
+    }
+    return frame;
+}
+
+void Test::compareFrames(const char* name, const Frame& serial, const Frame& parallel)
+{
+    for (std::size_t i = 0; i < serial.buffers.size(); i++)
+    {
+        const BufferRecord& s = serial.buffers[i];
+        const BufferRecord& p = parallel.buffers[i];
+        BENCHMARK_CHECK(s.streams.size() == p.streams.size(), "%s: buffer %zu has %zu streams, %zu in parallel", name, i, s.streams.size(), p.streams.size());
+        for (std::size_t stream = 0; stream < s.streams.size(); stream++)
+        {
+            BENCHMARK_CHECK(s.streams[stream] == p.streams[stream], "%s: buffer %zu stream %zu differs, %zu bytes serial, %zu bytes parallel",
+                            name, i, stream, s.streams[stream].size(), p.streams[stream].size());
+        }
+        BENCHMARK_CHECK(s.indices == p.indices, "%s: indices of buffer %zu differ, %zu serial, %zu parallel", name, i, s.indices.size(), p.indices.size());
+    }
+
+    BENCHMARK_CHECK(serial.models.size() == parallel.models.size(), "%s: %zu models serial, %zu parallel", name, serial.models.size(), parallel.models.size());
+    for (std::size_t i = 0; i < serial.models.size(); i++)
+    {
+        const ModelRecord& s = serial.models[i];
+        const ModelRecord& p = parallel.models[i];
+        BENCHMARK_CHECK(s.node == p.node && s.effect == p.effect && s.cullingMask == p.cullingMask &&
+                        memcmp(s.worldMatrix.m, p.worldMatrix.m, sizeof(s.worldMatrix.m)) == 0,
+                        "%s: model %zu differs", name, i);
+        BENCHMARK_CHECK(s.vertexBuffer == p.vertexBuffer && s.indexBuffer == p.indexBuffer && s.start == p.start && s.count == p.count,
+                        "%s: model %zu draws %d indices from %d, %d from %d in parallel", name, i, s.count, s.start, p.count, p.start);
+    }
+
+    const GFXNullStats& s = serial.stats;
+    const GFXNullStats& p = parallel.stats;
+    BENCHMARK_CHECK(s.drawCalls == p.drawCalls && s.drawElements == p.drawElements, "%s: %u draws serial, %u parallel", name, s.drawCalls, p.drawCalls);
+    BENCHMARK_CHECK(s.bufferUploads == p.bufferUploads && s.uploadedBytes == p.uploadedBytes,
+                    "%s: %u buffer uploads serial, %u parallel", name, s.bufferUploads, p.bufferUploads);
+}
+
+void Test::run(std::size_t nodeCount)
+{
+    buildTree(nodeCount);
+
+    // The first frame compiles the program and creates the buffers.
+    renderFrame(false, true);
+
+    char name[64];
+    for (int dirty = 1; dirty >= 0; dirty--)
+    {
+        Frame serial = renderFrame(false, dirty != 0);
+        Frame parallel = renderFrame(true, dirty != 0);
+        snprintf(name, sizeof(name), "%zu nodes %s", nodeCount, dirty ? "dirty" : "clean");
+        BENCHMARK_CHECK(!serial.models.empty() && serial.stats.drawCalls > 0, "%s: nothing is drawn", name);
+        compareFrames(name, serial, parallel);
+        printf("parallel fill %-20s %zu models, %u draws: same as serial\n", name, serial.models.size(), serial.stats.drawCalls);
+    }
+
+    destroyTree();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    Test* test = new Test();
+    // The large tree overflows the vertex buffer of XY_UV_Color.
+    test->run(2000);
+    test->run(30000);
+    delete test;
+    printf("parallel fill: passed\n");
+    return 0;
+}
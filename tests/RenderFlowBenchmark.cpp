@@ -0,0 +1,482 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "Benchmark.h"
+#include "platform/CCApplication.h"
+#include "renderer/Profiler.h"
+#include "renderer/gfx/DeviceGraphics.h"
+#include "renderer/gfx/GFXNull.h"
+#include "renderer/gfx/VertexFormat.h"
+#include "renderer/renderer/Camera.h"
+#include "renderer/renderer/Effect.h"
+#include "renderer/renderer/EffectVariant.hpp"
+#include "renderer/renderer/ForwardRenderer.h"
+#include "renderer/renderer/Pass.h"
+#include "renderer/renderer/Scene.h"
+#include "renderer/renderer/Technique.h"
+#include "renderer/scene/NodeMemPool.hpp"
+#include "renderer/scene/NodeProxy.hpp"
+#include "renderer/scene/RenderFlow.hpp"
+#include "renderer/scene/assembler/Assembler.hpp"
+#include "renderer/scene/assembler/RenderDataList.hpp"
+#include "scripting/js-bindings/jswrapper/SeApi.h"
+#include <vector>
+
+/**
+ * Frame time of the native render flow with synthetic node trees of 1k to 100k sprites, run on the null GL driver.
+ * Nodes are created the way the JS node memory pool lays them out, every node but the root renders a quad,
+ * a fifth of the leaves are placed out of the view. The "static" variant changes nothing between frames,
+ * the "moving" variant moves a tenth of the nodes every frame. Times are averages of one frame, the stages come from the Profiler.
+ */
+
+using namespace cocos2d;
+using namespace cocos2d::renderer;
+
+namespace {
+
+const std::size_t Unit_Node_Count = 128;
+const int View_Width = 1280;
+const int View_Height = 720;
+const float Sprite_Size = 32.0f;
+const std::size_t Tree_Fanout = 8;
+const int Warmup_Frames = 3;
+const int Min_Frames = 10;
+const double Min_Milliseconds = 500.0;
+
+const char* Vert_Source =
+    "uniform mat4 cc_matViewProj;\n"
+    "attribute vec3 a_position;\n"
+    "attribute vec2 a_uv0;\n"
+    "attribute vec4 a_color;\n"
+    "varying vec4 v_color;\n"
+    "void main () {\n"
+    "    v_color = a_color;\n"
+    "    gl_Position = cc_matViewProj * vec4(a_position.xy, 0.0, 1.0);\n"
+    "}\n";
+
+const char* Frag_Source =
+    "precision mediump float;\n"
+    "varying vec4 v_color;\n"
+    "void main () {\n"
+    "    gl_FragColor = v_color;\n"
+    "}\n";
+
+// A pseudo random sequence, so every run builds the same tree.
+uint32_t nextRandom(uint32_t& seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+float randomRange(uint32_t& seed, float min, float max)
+{
+    return min + (max - min) * (nextRandom(seed) & 0xffff) / 65535.0f;
+}
+
+se::Object* createArray(se::Object::TypedArrayType type, std::size_t byteLength)
+{
+    return se::Object::createTypedArray(type, nullptr, byteLength);
+}
+
+template<typename T>
+T* getArrayData(se::Object* array)
+{
+    uint8_t* data = nullptr;
+    std::size_t length = 0;
+    array->getTypedArrayData(&data, &length);
+    return (T*)data;
+}
+
+/**
+ * One unit of the node memory pool, the arrays are owned by the pool once registered.
+ */
+struct Unit
+{
+    std::size_t unitID = 0;
+    uint16_t* common = nullptr;
+    Sign* signs = nullptr;
+    std::size_t usingNum = 0;
+};
+
+/**
+ * A node with its location in the pool.
+ */
+struct Node
+{
+    NodeProxy* proxy = nullptr;
+    std::size_t unitID = 0;
+    std::size_t index = 0;
+    int level = 0;
+    TRS* trs = nullptr;
+    uint32_t* dirty = nullptr;
+};
+
+class Benchmark
+{
+public:
+    Benchmark();
+    ~Benchmark();
+
+    void run(std::size_t nodeCount);
+private:
+    Unit& requestUnit();
+    Node createNode(const Node* parent);
+    void buildTree(std::size_t nodeCount);
+    void destroyTree();
+    void runVariant(std::size_t nodeCount, const char* variant, bool moving);
+
+    Application* _application = nullptr;
+    DeviceGraphics* _device = nullptr;
+    NodeMemPool* _pool = nullptr;
+    Scene* _scene = nullptr;
+    ForwardRenderer* _forward = nullptr;
+    RenderFlow* _flow = nullptr;
+    Camera* _camera = nullptr;
+    Effect* _baseEffect = nullptr;
+    EffectVariant* _effect = nullptr;
+    RenderDataList* _quad = nullptr;
+
+    std::vector<Unit> _units;
+    std::vector<Node> _nodes;
+    Node _cameraNode;
+    std::size_t _cameraUnitCount = 0;
+    uint32_t _seed = 1;
+};
+
+Benchmark::Benchmark()
+{
+    _application = new Application("render_flow_benchmark", View_Width, View_Height);
+    se::ScriptEngine::getInstance()->start();
+
+    _device = DeviceGraphics::getInstance();
+    _pool = new NodeMemPool();
+    _scene = new Scene();
+
+    std::vector<ProgramLib::Template> templates(1);
+    templates[0].name = "benchmark_sprite";
+    templates[0].vert = Vert_Source;
+    templates[0].frag = Frag_Source;
+    _forward = new ForwardRenderer();
+    _forward->init(_device, templates, nullptr, View_Width, View_Height);
+    _flow = new RenderFlow(_device, _scene, _forward);
+
+    // One effect shared by all sprites, like sprites of one atlas, so the batches only break on buffer overflow.
+    Pass* pass = new Pass("benchmark_sprite");
+    pass->setStage("transparent");
+    pass->setBlend(true, BlendOp::ADD, BlendFactor::SRC_ALPHA, BlendFactor::ONE_MINUS_SRC_ALPHA,
+                   BlendOp::ADD, BlendFactor::ONE, BlendFactor::ONE_MINUS_SRC_ALPHA);
+    Vector<Pass*> passes;
+    passes.pushBack(pass);
+    pass->release();
+    Technique* technique = new Technique("transparent", passes);
+    Vector<Technique*> techniques;
+    techniques.pushBack(technique);
+    technique->release();
+    // The variant does not retain the effect, the JS side owns it.
+    _baseEffect = new Effect();
+    _baseEffect->init(techniques);
+    _effect = new EffectVariant(_baseEffect);
+
+    // One quad shared by all sprites, x y u v color.
+    struct Vertex { float x, y, u, v; uint32_t color; };
+    const float half = Sprite_Size * 0.5f;
+    Vertex vertices[4] = {
+        { -half, -half, 0.0f, 1.0f, 0xffffffff },
+        {  half, -half, 1.0f, 1.0f, 0xffffffff },
+        { -half,  half, 0.0f, 0.0f, 0xffffffff },
+        {  half,  half, 1.0f, 0.0f, 0xffffffff },
+    };
+    uint16_t indices[6] = { 0, 1, 2, 1, 3, 2 };
+    {
+        se::AutoHandleScope hs;
+        se::Object* verticesObj = se::Object::createTypedArray(se::Object::TypedArrayType::FLOAT32, vertices, sizeof(vertices));
+        se::Object* indicesObj = se::Object::createTypedArray(se::Object::TypedArrayType::UINT16, indices, sizeof(indices));
+        _quad = new RenderDataList();
+        _quad->updateMesh(0, verticesObj, indicesObj);
+        verticesObj->decRef();
+        indicesObj->decRef();
+    }
+
+    // The camera node is a root of its own, it stays while the trees are rebuilt.
+    _cameraNode = createNode(nullptr);
+    _cameraNode.trs->x = View_Width * 0.5f;
+    _cameraNode.trs->y = View_Height * 0.5f;
+    _cameraNode.trs->z = 500.0f;
+    _cameraUnitCount = _units.size();
+
+    _camera = new Camera();
+    _camera->setType(ProjectionType::ORTHOGRAPHIC);
+    _camera->setOrthoHeight(View_Height * 0.5f);
+    _camera->setNear(0.1f);
+    _camera->setFar(1000.0f);
+    _camera->setStages({ "transparent" });
+    _camera->setNode(_cameraNode.proxy);
+    _scene->addCamera(_camera);
+}
+
+Benchmark::~Benchmark()
+{
+    destroyTree();
+    _scene->removeCamera(_camera);
+    RENDERER_SAFE_RELEASE(_camera);
+    _cameraNode.proxy->destroyImmediately();
+    _cameraNode.proxy->release();
+
+    RENDERER_SAFE_RELEASE(_quad);
+    RENDERER_SAFE_RELEASE(_effect);
+    RENDERER_SAFE_RELEASE(_baseEffect);
+    delete _flow;
+    RENDERER_SAFE_RELEASE(_forward);
+    delete _scene;
+    delete _pool;
+    se::ScriptEngine::destroyInstance();
+    delete _application;
+}
+
+Unit& Benchmark::requestUnit()
+{
+    if (!_units.empty() && _units.back().usingNum < Unit_Node_Count)
+    {
+        return _units.back();
+    }
+
+    se::AutoHandleScope hs;
+    Unit unit;
+    unit.unitID = _units.size();
+    std::size_t n = Unit_Node_Count;
+
+    se::Object* common = createArray(se::Object::TypedArrayType::UINT16, sizeof(uint16_t) * 2);
+    se::Object* signs = createArray(se::Object::TypedArrayType::UINT16, sizeof(Sign) * n);
+    unit.common = getArrayData<uint16_t>(common);
+    unit.signs = getArrayData<Sign>(signs);
+    _pool->updateCommonData(unit.unitID, common, signs);
+
+    se::Object* arrays[] = {
+        createArray(se::Object::TypedArrayType::UINT32, sizeof(uint32_t) * n),
+        createArray(se::Object::TypedArrayType::FLOAT32, sizeof(TRS) * n),
+        createArray(se::Object::TypedArrayType::FLOAT32, sizeof(Mat4) * n),
+        createArray(se::Object::TypedArrayType::FLOAT32, sizeof(Mat4) * n),
+        createArray(se::Object::TypedArrayType::UINT32, sizeof(ParentInfo) * n),
+        createArray(se::Object::TypedArrayType::INT32, sizeof(int32_t) * n),
+        createArray(se::Object::TypedArrayType::INT32, sizeof(int32_t) * n),
+        createArray(se::Object::TypedArrayType::UINT8, sizeof(uint8_t) * n),
+        createArray(se::Object::TypedArrayType::UINT8, sizeof(uint8_t) * n),
+        createArray(se::Object::TypedArrayType::FLOAT64, sizeof(uint64_t) * n),
+        createArray(se::Object::TypedArrayType::FLOAT32, sizeof(Skew) * n),
+    };
+    _pool->updateNodeData(unit.unitID, arrays[0], arrays[1], arrays[2], arrays[3], arrays[4], arrays[5],
+                          arrays[6], arrays[7], arrays[8], arrays[9], arrays[10]);
+
+    common->decRef();
+    signs->decRef();
+    for (auto array : arrays)
+    {
+        array->decRef();
+    }
+
+    _units.push_back(unit);
+    return _units.back();
+}
+
+Node Benchmark::createNode(const Node* parent)
+{
+    Unit& unit = requestUnit();
+    std::size_t index = unit.usingNum++;
+    Node node;
+    node.unitID = unit.unitID;
+    node.index = index;
+    unit.signs[index].freeFlag = 1;
+    unit.common[0] = (uint16_t)unit.unitID;
+    unit.common[1] = (uint16_t)unit.usingNum;
+
+    UnitNode* data = _pool->getUnit(unit.unitID);
+    node.trs = data->getTRS(index);
+    node.trs->qw = 1.0f;
+    node.trs->sx = node.trs->sy = node.trs->sz = 1.0f;
+    node.dirty = data->getDirty(index);
+    *data->getOpacity(index) = 255;
+    *data->getCullingMask(index) = 1;
+
+    node.proxy = new NodeProxy(unit.unitID, index, "", "");
+    *node.dirty = RenderFlow::LOCAL_TRANSFORM | RenderFlow::WORLD_TRANSFORM | RenderFlow::OPACITY;
+    if (parent)
+    {
+        node.level = parent->level + 1;
+        ParentInfo* parentInfo = data->getParent(index);
+        parentInfo->unitID = (uint32_t)parent->unitID;
+        parentInfo->index = (uint32_t)parent->index;
+    }
+    node.proxy->notifyUpdateParent();
+    return node;
+}
+
+void Benchmark::buildTree(std::size_t nodeCount)
+{
+    _seed = 1;
+    _nodes.reserve(nodeCount);
+    _nodes.push_back(createNode(nullptr));
+
+    // Breadth first, so the levels are full and the world matrices of a level run on the job system.
+    for (std::size_t i = 1; i < nodeCount; i++)
+    {
+        Node node = createNode(&_nodes[(i - 1) / Tree_Fanout]);
+        _nodes.push_back(node);
+
+        // Positions are relative to the parent and centered on the view through the root, deeper levels spread less.
+        TRS* trs = node.trs;
+        float range = View_Width * 0.25f / (1 << node.level);
+        trs->x = randomRange(_seed, -range, range);
+        trs->y = randomRange(_seed, -range, range) * View_Height / View_Width;
+        bool leaf = i * Tree_Fanout + 1 >= nodeCount;
+        if (leaf && nextRandom(_seed) % 5 == 0)
+        {
+            trs->x += trs->x < 0.0f ? -View_Width : View_Width;
+        }
+        *node.dirty |= RenderFlow::RENDER;
+
+        se::AutoHandleScope hs;
+        se::Object* assemblerDirty = createArray(se::Object::TypedArrayType::UINT32, sizeof(uint32_t));
+        Assembler* assembler = new Assembler();
+        assembler->setDirty(assemblerDirty);
+        assemblerDirty->decRef();
+        assembler->setVertexFormat(VertexFormat::XY_UV_Color);
+        assembler->setRenderDataList(_quad);
+        assembler->updateMeshIndex(0, 0);
+        assembler->updateEffect(0, _effect);
+        assembler->setLocalAABB(-Sprite_Size * 0.5f, -Sprite_Size * 0.5f, 0.0f, Sprite_Size * 0.5f, Sprite_Size * 0.5f, 0.0f);
+        node.proxy->setAssembler(assembler);
+        assembler->release();
+    }
+
+    _nodes[0].trs->x = View_Width * 0.5f;
+    _nodes[0].trs->y = View_Height * 0.5f;
+}
+
+void Benchmark::destroyTree()
+{
+    for (auto it = _nodes.rbegin(); it != _nodes.rend(); it++)
+    {
+        it->proxy->destroyImmediately();
+        it->proxy->release();
+    }
+    _nodes.clear();
+
+    while (_units.size() > _cameraUnitCount)
+    {
+        std::size_t unitID = _units.back().unitID;
+        _pool->removeNodeData(unitID);
+        _pool->removeCommonData(unitID);
+        _units.pop_back();
+    }
+}
+
+void Benchmark::runVariant(std::size_t nodeCount, const char* variant, bool moving)
+{
+    Profiler* profiler = Profiler::getInstance();
+    NodeProxy* root = _nodes[0].proxy;
+    std::size_t frame = 0;
+
+    auto renderFrame = [&]() {
+        if (moving)
+        {
+            // A different tenth of the nodes every frame.
+            for (std::size_t i = 1 + frame % 10; i < nodeCount; i += 10)
+            {
+                Node& node = _nodes[i];
+                node.trs->x += (frame & 1) ? 1.0f : -1.0f;
+                *node.dirty |= RenderFlow::LOCAL_TRANSFORM;
+            }
+        }
+        _flow->render(root, 1.0f / 60);
+        frame++;
+    };
+
+    for (int i = 0; i < Warmup_Frames; i++)
+    {
+        renderFrame();
+    }
+
+    typedef std::chrono::high_resolution_clock Clock;
+    double stageTimes[(int)ProfileStage::COUNT] = {};
+    double total = 0.0;
+    int frames = 0;
+    GFXNull::resetStats();
+    profiler->setEnabled(true);
+    // Drops the samples of the warm up frames.
+    profiler->endFrame();
+    while (frames < Min_Frames || total < Min_Milliseconds)
+    {
+        auto begin = Clock::now();
+        renderFrame();
+        total += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+        profiler->endFrame();
+        for (int stage = 0; stage < (int)ProfileStage::COUNT; stage++)
+        {
+            stageTimes[stage] += profiler->getStageTime((ProfileStage)stage);
+        }
+        frames++;
+    }
+    profiler->setEnabled(false);
+
+    char name[64];
+    snprintf(name, sizeof(name), "render flow %zu %s", nodeCount, variant);
+    benchmark::report(name, "wall clock", nodeCount, total / frames);
+    for (int stage = 0; stage < (int)ProfileStage::COUNT; stage++)
+    {
+        benchmark::report(name, Profiler::getStageName((ProfileStage)stage), nodeCount, stageTimes[stage] / frames);
+    }
+
+    const GFXNullStats& stats = GFXNull::getStats();
+    printf("%-28s %u draws %u state changes %u buffer uploads %.1f KB uploaded per frame, %u culled %u submitted\n", name,
+           stats.drawCalls / frames, stats.stateChanges / frames, stats.bufferUploads / frames,
+           stats.uploadedBytes / 1024.0 / frames, _flow->getCulledNodeCount(), _flow->getSubmittedNodeCount());
+}
+
+void Benchmark::run(std::size_t nodeCount)
+{
+    buildTree(nodeCount);
+    runVariant(nodeCount, "static", false);
+    runVariant(nodeCount, "moving", true);
+    destroyTree();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::size_t> counts = { 1000, 10000, 100000 };
+    // The first argument runs a single tree size.
+    if (argc > 1)
+    {
+        counts = { (std::size_t)atol(argv[1]) };
+    }
+
+    Benchmark* bench = new Benchmark();
+    for (auto count : counts)
+    {
+        bench->run(count);
+    }
+    delete bench;
+    return 0;
+}
@@ -0,0 +1,143 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "Benchmark.h"
+#include "renderer/renderer/RadixSort.h"
+#include <vector>
+#include <random>
+#include <string.h>
+
+/**
+ * Sorting of stage items, std::sort over items like the forward renderer did before,
+ * against packed keys sorted by radixSort.
+ */
+
+using namespace cocos2d::renderer;
+
+namespace {
+
+// Same layout as BaseRenderer::StageItem before the packed keys.
+struct LegacyItem
+{
+    void* model = nullptr;
+    void* ia = nullptr;
+    void* effect = nullptr;
+    std::vector<const void*> passes;
+    float sortKey = 0.0f;
+};
+
+bool compareItems(const LegacyItem& a, const LegacyItem& b)
+{
+    size_t pa = a.passes.size();
+    size_t pb = b.passes.size();
+    if (pa != pb)
+    {
+        return pa > pb;
+    }
+    return a.sortKey > b.sortKey;
+}
+
+uint32_t floatToOrderedBits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t counts[] = { 1000, 5000, 10000, 20000, 50000 };
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> depthDistribution(0.0f, 1000.0f);
+    std::uniform_int_distribution<int> passDistribution(1, 2);
+    // Programs and effects of a typical scene.
+    std::uniform_int_distribution<uint32_t> programDistribution(0, 15);
+    std::uniform_int_distribution<uint32_t> effectDistribution(0, 63);
+
+    for (auto count : counts)
+    {
+        std::vector<LegacyItem> source(count);
+        std::vector<SortEntry> entries(count), buffer;
+        std::vector<uint32_t> programs(count), effects(count);
+        std::vector<const LegacyItem*> sorted(count);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            source[i].passes.resize(passDistribution(random));
+            source[i].sortKey = depthDistribution(random);
+            programs[i] = programDistribution(random);
+            effects[i] = effectDistribution(random);
+        }
+
+        std::vector<LegacyItem> items;
+        double legacy = benchmark::measure([&]() {
+            items = source;
+            std::sort(items.begin(), items.end(), compareItems);
+        });
+        // The copy is part of the measured legacy run, measure it alone to subtract it.
+        double copy = benchmark::measure([&]() {
+            items = source;
+        });
+        benchmark::report("sort transparent", "std::sort items", count, legacy - copy);
+
+        double radix = benchmark::measure([&]() {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                uint64_t rank = 3 - std::min(source[i].passes.size(), (size_t)3);
+                entries[i].key = rank << 62 | (uint64_t)(uint32_t)~floatToOrderedBits(source[i].sortKey) << 30 | i;
+                entries[i].index = (uint32_t)i;
+            }
+            radixSort(entries, buffer);
+            for (std::size_t i = 0; i < count; i++)
+            {
+                sorted[i] = &source[entries[i].index];
+            }
+        });
+        benchmark::report("sort transparent", "radix keys", count, radix);
+
+        for (std::size_t i = 1; i < count; i++)
+        {
+            BENCHMARK_CHECK(!compareItems(*sorted[i], *sorted[i - 1]), "radix order differs from compareItems at %zu", i);
+        }
+
+        // Order independent opaque items, state switches in submission order and in key order.
+        uint32_t submissionSwitches = 0, sortedSwitches = 0;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            entries[i].key = (uint64_t)programs[i] << 28 | (uint64_t)effects[i] << 18 | (floatToOrderedBits(source[i].sortKey) >> 22);
+            entries[i].index = (uint32_t)i;
+            if (i > 0 && (programs[i] != programs[i - 1] || effects[i] != effects[i - 1])) submissionSwitches++;
+        }
+        radixSort(entries, buffer);
+        for (std::size_t i = 1; i < count; i++)
+        {
+            uint32_t a = entries[i - 1].index, b = entries[i].index;
+            if (programs[a] != programs[b] || effects[a] != effects[b]) sortedSwitches++;
+        }
+        printf("%-28s %-20s %8zu items %10u submission %10u sorted\n", "opaque state switches", "program, effect", count, submissionSwitches, sortedSwitches);
+    }
+    return 0;
+}
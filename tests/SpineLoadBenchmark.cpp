@@ -0,0 +1,547 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "Benchmark.h"
+#include "spine/spine.h"
+#include "spine-creator-support/SpineAllocator.h"
+#include <string>
+#include <vector>
+#include <string.h>
+#include <stdarg.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Startup cost of one spine skeleton in the formats the engine loads, as jsb_spine_manual.cpp loads them:
+ * json is read by the spine extension and parsed with SkeletonJson, binary is read into memory as FileUtils
+ * does and parsed with SkeletonBinary in an arena, mapped is memory mapped as MappedFile does and parsed the same way.
+ * Mapping only saves the copy of the file, SkeletonBinary makes the same allocations for both binary variants.
+ * Every run loads the skeleton data and releases it. The files are written before, so they are in the page cache.
+ * The skeletons are generated, every bone has a slot with a region attachment and every animation rotates and
+ * translates every bone. The first argument is the directory of the files, it must be an absolute path to be mapped.
+ */
+
+using namespace spine;
+
+// The allocator of the engine, see Cocos2dExtension in spine-cocos2dx.cpp.
+class BenchmarkExtension : public DefaultSpineExtension
+{
+protected:
+    virtual void* _alloc(size_t size, const char* file, int line) override
+    {
+        return SpineAllocator::alloc(size);
+    }
+    virtual void* _calloc(size_t size, const char* file, int line) override
+    {
+        return SpineAllocator::calloc(size);
+    }
+    virtual void* _realloc(void* ptr, size_t size, const char* file, int line) override
+    {
+        return SpineAllocator::realloc(ptr, size);
+    }
+    virtual void _free(void* mem, const char* file, int line) override
+    {
+        SpineAllocator::free(mem);
+    }
+};
+
+SpineExtension* spine::getDefaultExtension()
+{
+    return new BenchmarkExtension();
+}
+
+namespace {
+
+// Attachments without atlas regions, the atlas is not part of the skeleton data file.
+class NullAttachmentLoader : public AttachmentLoader
+{
+public:
+    virtual RegionAttachment* newRegionAttachment(Skin& skin, const String& name, const String& path) override
+    {
+        return new (__FILE__, __LINE__) RegionAttachment(name);
+    }
+    virtual MeshAttachment* newMeshAttachment(Skin& skin, const String& name, const String& path) override
+    {
+        return new (__FILE__, __LINE__) MeshAttachment(name);
+    }
+    virtual BoundingBoxAttachment* newBoundingBoxAttachment(Skin& skin, const String& name) override
+    {
+        return new (__FILE__, __LINE__) BoundingBoxAttachment(name);
+    }
+    virtual PathAttachment* newPathAttachment(Skin& skin, const String& name) override
+    {
+        return new (__FILE__, __LINE__) PathAttachment(name);
+    }
+    virtual PointAttachment* newPointAttachment(Skin& skin, const String& name) override
+    {
+        return new (__FILE__, __LINE__) PointAttachment(name);
+    }
+    virtual ClippingAttachment* newClippingAttachment(Skin& skin, const String& name) override
+    {
+        return new (__FILE__, __LINE__) ClippingAttachment(name);
+    }
+    virtual void configureAttachment(Attachment* attachment) override {}
+};
+
+struct SkeletonSize
+{
+    const char* name;
+    int boneCount;
+    int animationCount;
+    // Keys of every timeline.
+    int frameCount;
+};
+
+const SkeletonSize SIZES[] = {
+    { "small", 20, 4, 8 },
+    { "medium", 60, 12, 12 },
+    { "large", 150, 24, 16 },
+};
+
+// Values in [-range / 2, range / 2] are multiples of 1/4, so the json text and the binary floats are the same numbers.
+float value(int i, int range)
+{
+    return (float)((i * 37) % (range * 4 + 1) - range * 2) * 0.25f;
+}
+
+int getParent(int bone)
+{
+    return (bone - 1) / 2;
+}
+
+// Writer of the subset of the spine 3.8 binary format used by the generated skeletons, see SkeletonBinary.
+class BinaryWriter
+{
+public:
+    void writeByte(unsigned char v) { bytes.push_back(v); }
+    void writeBoolean(bool v) { writeByte(v ? 1 : 0); }
+    void writeInt(uint32_t v)
+    {
+        writeByte((unsigned char)(v >> 24));
+        writeByte((unsigned char)(v >> 16));
+        writeByte((unsigned char)(v >> 8));
+        writeByte((unsigned char)v);
+    }
+    void writeFloat(float v)
+    {
+        uint32_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        writeInt(bits);
+    }
+    void writeVarint(uint32_t v)
+    {
+        while (v >= 0x80)
+        {
+            writeByte((unsigned char)((v & 0x7F) | 0x80));
+            v >>= 7;
+        }
+        writeByte((unsigned char)v);
+    }
+    void writeString(const std::string& v)
+    {
+        writeVarint((uint32_t)v.size() + 1);
+        bytes.insert(bytes.end(), v.begin(), v.end());
+    }
+
+    std::vector<unsigned char> bytes;
+};
+
+std::string boneName(int i) { return i == 0 ? "root" : "bone" + std::to_string(i); }
+std::string slotName(int i) { return "slot" + std::to_string(i); }
+std::string attachmentName(int i) { return "region" + std::to_string(i); }
+std::string animationName(int i) { return "animation" + std::to_string(i); }
+
+void appendf(std::string& out, const char* format, ...)
+{
+    char buf[512];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    out += buf;
+}
+
+std::string writeJson(const SkeletonSize& size)
+{
+    std::string out;
+    appendf(out, "{\"skeleton\":{\"hash\":\"benchmark\",\"spine\":\"3.8.99\",\"x\":-256,\"y\":-256,\"width\":512,\"height\":512},\n");
+
+    out += "\"bones\":[\n";
+    for (int i = 0; i < size.boneCount; i++)
+    {
+        appendf(out, "%s{\"name\":\"%s\"", i ? ",\n" : "", boneName(i).c_str());
+        if (i) appendf(out, ",\"parent\":\"%s\"", boneName(getParent(i)).c_str());
+        appendf(out, ",\"length\":%g,\"rotation\":%g,\"x\":%g,\"y\":%g}", value(i, 40) + 50, value(i + 1, 180), value(i + 2, 30), value(i + 3, 30));
+    }
+
+    out += "],\n\"slots\":[\n";
+    for (int i = 0; i < size.boneCount; i++)
+    {
+        appendf(out, "%s{\"name\":\"%s\",\"bone\":\"%s\",\"attachment\":\"%s\"}", i ? ",\n" : "",
+                slotName(i).c_str(), boneName(i).c_str(), attachmentName(i).c_str());
+    }
+
+    out += "],\n\"skins\":[{\"name\":\"default\",\"attachments\":{\n";
+    for (int i = 0; i < size.boneCount; i++)
+    {
+        appendf(out, "%s\"%s\":{\"%s\":{\"rotation\":%g,\"x\":%g,\"y\":%g,\"width\":%g,\"height\":%g}}", i ? ",\n" : "",
+                slotName(i).c_str(), attachmentName(i).c_str(), value(i, 180), value(i + 1, 20), value(i + 2, 20), value(i, 30) + 40, value(i + 1, 30) + 40);
+    }
+
+    out += "}}],\n\"animations\":{\n";
+    for (int a = 0; a < size.animationCount; a++)
+    {
+        appendf(out, "%s\"%s\":{\"bones\":{\n", a ? ",\n" : "", animationName(a).c_str());
+        for (int i = 0; i < size.boneCount; i++)
+        {
+            appendf(out, "%s\"%s\":{\"rotate\":[", i ? ",\n" : "", boneName(i).c_str());
+            for (int f = 0; f < size.frameCount; f++)
+            {
+                appendf(out, "%s{\"time\":%g,\"angle\":%g", f ? "," : "", f * 0.25f, value(a + i + f, 180));
+                if (f < size.frameCount - 1) appendf(out, ",\"curve\":0.25,\"c2\":0,\"c3\":0.75,\"c4\":1");
+                out += "}";
+            }
+            out += "],\"translate\":[";
+            for (int f = 0; f < size.frameCount; f++)
+            {
+                appendf(out, "%s{\"time\":%g,\"x\":%g,\"y\":%g", f ? "," : "", f * 0.25f, value(a + i + f, 30), value(a + i + f + 1, 30));
+                if (f < size.frameCount - 1) appendf(out, ",\"curve\":0.25,\"c2\":0,\"c3\":0.75,\"c4\":1");
+                out += "}";
+            }
+            out += "]}";
+        }
+        out += "}}";
+    }
+    out += "}}\n";
+    return out;
+}
+
+std::vector<unsigned char> writeBinary(const SkeletonSize& size)
+{
+    // Types of SkeletonBinary.
+    const unsigned char BONE_ROTATE = 0, BONE_TRANSLATE = 1, CURVE_BEZIER = 2, ATTACHMENT_REGION = 0;
+
+    BinaryWriter out;
+    out.writeString("benchmark");
+    out.writeString("3.8.99");
+    out.writeFloat(-256);
+    out.writeFloat(-256);
+    out.writeFloat(512);
+    out.writeFloat(512);
+    // No nonessential data.
+    out.writeBoolean(false);
+
+    // Attachment names are referenced from the string table by index + 1.
+    out.writeVarint(size.boneCount);
+    for (int i = 0; i < size.boneCount; i++) out.writeString(attachmentName(i));
+
+    out.writeVarint(size.boneCount);
+    for (int i = 0; i < size.boneCount; i++)
+    {
+        out.writeString(boneName(i));
+        if (i) out.writeVarint(getParent(i));
+        out.writeFloat(value(i + 1, 180));
+        out.writeFloat(value(i + 2, 30));
+        out.writeFloat(value(i + 3, 30));
+        out.writeFloat(1);
+        out.writeFloat(1);
+        out.writeFloat(0);
+        out.writeFloat(0);
+        out.writeFloat(value(i, 40) + 50);
+        // Normal transform mode, not skin required.
+        out.writeVarint(0);
+        out.writeBoolean(false);
+    }
+
+    out.writeVarint(size.boneCount);
+    for (int i = 0; i < size.boneCount; i++)
+    {
+        out.writeString(slotName(i));
+        out.writeVarint(i);
+        // White, no dark color, normal blend mode.
+        out.writeInt(0xFFFFFFFF);
+        out.writeInt(0xFFFFFFFF);
+        out.writeVarint(i + 1);
+        out.writeVarint(0);
+    }
+
+    // No ik, transform and path constraints.
+    out.writeVarint(0);
+    out.writeVarint(0);
+    out.writeVarint(0);
+
+    // Default skin.
+    out.writeVarint(size.boneCount);
+    for (int i = 0; i < size.boneCount; i++)
+    {
+        out.writeVarint(i);
+        out.writeVarint(1);
+        out.writeVarint(i + 1);
+        // Same name and path as the skin entry.
+        out.writeVarint(0);
+        out.writeByte(ATTACHMENT_REGION);
+        out.writeVarint(0);
+        out.writeFloat(value(i, 180));
+        out.writeFloat(value(i + 1, 20));
+        out.writeFloat(value(i + 2, 20));
+        out.writeFloat(1);
+        out.writeFloat(1);
+        out.writeFloat(value(i, 30) + 40);
+        out.writeFloat(value(i + 1, 30) + 40);
+        out.writeInt(0xFFFFFFFF);
+    }
+
+    // No other skins and events.
+    out.writeVarint(0);
+    out.writeVarint(0);
+
+    out.writeVarint(size.animationCount);
+    for (int a = 0; a < size.animationCount; a++)
+    {
+        out.writeString(animationName(a));
+        // No slot timelines.
+        out.writeVarint(0);
+        out.writeVarint(size.boneCount);
+        for (int i = 0; i < size.boneCount; i++)
+        {
+            out.writeVarint(i);
+            out.writeVarint(2);
+            out.writeByte(BONE_ROTATE);
+            out.writeVarint(size.frameCount);
+            for (int f = 0; f < size.frameCount; f++)
+            {
+                out.writeFloat(f * 0.25f);
+                out.writeFloat(value(a + i + f, 180));
+                if (f < size.frameCount - 1)
+                {
+                    out.writeByte(CURVE_BEZIER);
+                    out.writeFloat(0.25f);
+                    out.writeFloat(0);
+                    out.writeFloat(0.75f);
+                    out.writeFloat(1);
+                }
+            }
+            out.writeByte(BONE_TRANSLATE);
+            out.writeVarint(size.frameCount);
+            for (int f = 0; f < size.frameCount; f++)
+            {
+                out.writeFloat(f * 0.25f);
+                out.writeFloat(value(a + i + f, 30));
+                out.writeFloat(value(a + i + f + 1, 30));
+                if (f < size.frameCount - 1)
+                {
+                    out.writeByte(CURVE_BEZIER);
+                    out.writeFloat(0.25f);
+                    out.writeFloat(0);
+                    out.writeFloat(0.75f);
+                    out.writeFloat(1);
+                }
+            }
+        }
+        // No ik, transform, path, deform, draw order and event timelines.
+        for (int i = 0; i < 6; i++) out.writeVarint(0);
+    }
+    return out.bytes;
+}
+
+bool writeFile(const std::string& path, const void* data, std::size_t size)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool ok = fwrite(data, 1, size, file) == size;
+    return fclose(file) == 0 && ok;
+}
+
+// Reads the file into memory as FileUtils::getDataFromFile does.
+std::vector<unsigned char> readFile(const std::string& path)
+{
+    std::vector<unsigned char> bytes;
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return bytes;
+    fseek(file, 0, SEEK_END);
+    bytes.resize((std::size_t)ftell(file));
+    fseek(file, 0, SEEK_SET);
+    if (fread(bytes.data(), 1, bytes.size(), file) != bytes.size()) bytes.clear();
+    fclose(file);
+    return bytes;
+}
+
+// Skeleton data and the arena it is allocated in, released as SkeletonDataMgr releases them.
+struct LoadedSkeleton
+{
+    SkeletonData* data = nullptr;
+    SpineArena* arena = nullptr;
+
+    void release()
+    {
+        delete data;
+        delete arena;
+        data = nullptr;
+        arena = nullptr;
+    }
+};
+
+LoadedSkeleton loadJson(AttachmentLoader* loader, const std::string& path)
+{
+    LoadedSkeleton loaded;
+    SkeletonJson json(loader);
+    loaded.data = json.readSkeletonDataFile(path.c_str());
+    return loaded;
+}
+
+LoadedSkeleton loadBinary(AttachmentLoader* loader, const unsigned char* bytes, std::size_t size)
+{
+    LoadedSkeleton loaded;
+    loaded.arena = new SpineArena();
+    SpineAllocator::ArenaScope arenaScope(loaded.arena);
+    SkeletonBinary binary(loader);
+    loaded.data = binary.readSkeletonData(bytes, (int)size);
+    return loaded;
+}
+
+LoadedSkeleton loadRead(AttachmentLoader* loader, const std::string& path)
+{
+    std::vector<unsigned char> bytes = readFile(path);
+    return loadBinary(loader, bytes.data(), bytes.size());
+}
+
+// Maps the file as MappedFile does for absolute paths, FileUtils is not part of the benchmark.
+LoadedSkeleton loadMapped(AttachmentLoader* loader, const std::string& path)
+{
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return LoadedSkeleton();
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return LoadedSkeleton();
+    }
+    void* addr = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) return LoadedSkeleton();
+
+    LoadedSkeleton loaded = loadBinary(loader, (const unsigned char*)addr, (std::size_t)st.st_size);
+    munmap(addr, (size_t)st.st_size);
+    return loaded;
+#else
+    return LoadedSkeleton();
+#endif
+}
+
+void checkSkeleton(const SkeletonSize& size, const char* variant, SkeletonData* data, SkeletonData* expected)
+{
+    BENCHMARK_CHECK(data, "%s %s skeleton data can't be read", size.name, variant);
+    BENCHMARK_CHECK(data->getBones().size() == (std::size_t)size.boneCount, "%s %s has %zu bones", size.name, variant, data->getBones().size());
+    BENCHMARK_CHECK(data->getSlots().size() == (std::size_t)size.boneCount, "%s %s has %zu slots", size.name, variant, data->getSlots().size());
+    BENCHMARK_CHECK(data->getAnimations().size() == (std::size_t)size.animationCount, "%s %s has %zu animations", size.name, variant, data->getAnimations().size());
+    int lastSlot = size.boneCount - 1;
+    BENCHMARK_CHECK(data->getDefaultSkin() && data->getDefaultSkin()->getAttachment(lastSlot, attachmentName(lastSlot).c_str()),
+                    "%s %s default skin differs", size.name, variant);
+    if (!expected) return;
+    for (int i = 0; i < size.boneCount; i++)
+    {
+        BoneData* bone = data->getBones()[i];
+        BoneData* expectedBone = expected->getBones()[i];
+        BENCHMARK_CHECK(bone->getName() == expectedBone->getName() && bone->getX() == expectedBone->getX() && bone->getRotation() == expectedBone->getRotation(),
+                        "%s %s bone %d differs", size.name, variant, i);
+    }
+    for (int i = 0; i < size.animationCount; i++)
+    {
+        Animation* animation = data->getAnimations()[i];
+        Animation* expectedAnimation = expected->getAnimations()[i];
+        BENCHMARK_CHECK(animation->getTimelines().size() == expectedAnimation->getTimelines().size() && animation->getDuration() == expectedAnimation->getDuration(),
+                        "%s %s animation %d differs", size.name, variant, i);
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    std::string dir = argc > 1 ? argv[1] : "/tmp";
+    NullAttachmentLoader loader;
+
+    for (auto& size : SIZES)
+    {
+        std::string base = dir + "/spine_load_benchmark_" + size.name;
+        std::string jsonPath = base + ".json";
+        std::string binaryPath = base + ".skel";
+        std::string json = writeJson(size);
+        std::vector<unsigned char> binary = writeBinary(size);
+        BENCHMARK_CHECK(writeFile(jsonPath, json.data(), json.size()) && writeFile(binaryPath, binary.data(), binary.size()),
+                        "can't write the skeletons to %s", dir.c_str());
+        printf("%s skeleton: %d bones, %d animations, json %zu bytes, binary %zu bytes\n", size.name, size.boneCount, size.animationCount, json.size(), binary.size());
+
+        struct Variant
+        {
+            const char* name;
+            LoadedSkeleton (*load)(AttachmentLoader*, const std::string&);
+            const std::string& path;
+        };
+        const Variant variants[] = {
+            { "json", loadJson, jsonPath },
+            { "binary read", loadRead, binaryPath },
+            { "binary mapped", loadMapped, binaryPath },
+        };
+
+        LoadedSkeleton expected = loadJson(&loader, jsonPath);
+        checkSkeleton(size, "json", expected.data, nullptr);
+        for (auto& variant : variants)
+        {
+            uint32_t allocCount = SpineAllocator::getAllocCount();
+            std::size_t liveBytes = SpineAllocator::getBytes();
+            LoadedSkeleton loaded = variant.load(&loader, variant.path);
+            allocCount = SpineAllocator::getAllocCount() - allocCount;
+            liveBytes = SpineAllocator::getBytes() - liveBytes;
+            std::size_t arenaBytes = loaded.arena ? loaded.arena->getBytes() : 0;
+            std::size_t usedBytes = loaded.arena ? loaded.arena->getUsedBytes() : 0;
+            if (!loaded.data && variant.load == loadMapped)
+            {
+                printf("%-28s %-20s files can't be mapped on this platform\n", size.name, variant.name);
+                continue;
+            }
+            checkSkeleton(size, variant.name, loaded.data, expected.data);
+            loaded.release();
+
+            double ms = benchmark::measure([&]() {
+                LoadedSkeleton loaded = variant.load(&loader, variant.path);
+                loaded.release();
+            });
+            benchmark::report(size.name, variant.name, (std::size_t)size.boneCount, ms);
+            printf("%-28s %-20s %8u spine allocations per load\n", size.name, variant.name, allocCount);
+            // Used bytes are the live bytes with a header per block and the blocks freed in the arena.
+            if (arenaBytes) printf("%-28s %-20s %8zu live bytes %10zu used bytes %10zu arena bytes\n", size.name, variant.name, liveBytes, usedBytes, arenaBytes);
+        }
+        expected.release();
+
+        remove(jsonPath.c_str());
+        remove(binaryPath.c_str());
+    }
+    return 0;
+}
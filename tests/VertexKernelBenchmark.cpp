@@ -0,0 +1,174 @@
+/****************************************************************************
+ Copyright (c) 2019 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "Benchmark.h"
+#include "renderer/scene/MathKernel.hpp"
+#include "math/Mat4.h"
+#include "math/Vec3.h"
+#include <vector>
+#include <string.h>
+#include <math.h>
+
+/**
+ * MathKernel::transformPositions and MathKernel::rebaseIndices against the per vertex loops of Assembler::fillBuffers
+ * they replaced. Every run copies the local vertices first, as fillBuffers does.
+ */
+
+using namespace cocos2d::renderer;
+
+namespace {
+
+struct VertexFormat
+{
+    const char* name;
+    // Float count of one vertex and of its position.
+    std::size_t stride;
+    uint32_t num;
+};
+
+// Position, uv and packed color of sprites, two colors of tinted sprites and spine, 3D position of meshes and particles.
+const VertexFormat FORMATS[] = {
+    { "pos2 uv color", 5, 2 },
+    { "pos2 uv color color", 6, 2 },
+    { "pos3 uv color", 6, 3 },
+};
+
+void fillVertices(std::vector<float>& verts, std::size_t stride)
+{
+    for (std::size_t i = 0, n = verts.size(); i < n; i++)
+    {
+        verts[i] = (float)((i * 37) % 211) - 100.0f;
+    }
+    // Keep the float after 2D positions recognizable, it must survive the transform.
+    for (std::size_t i = 2; i < verts.size(); i += stride)
+    {
+        verts[i] = 7.0f;
+    }
+}
+
+void transformByLoop(float* ptrPos, std::size_t stride, std::size_t count, uint32_t num, const cocos2d::Mat4& worldMat)
+{
+    switch (num) {
+        case 3:
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                ((cocos2d::Vec3*)ptrPos)->transformMat4(*((cocos2d::Vec3*)ptrPos), worldMat);
+                ptrPos += stride;
+            }
+            break;
+        case 2:
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                float z = ptrPos[2];
+                ptrPos[2] = 0;
+                worldMat.transformPoint((cocos2d::Vec3*)ptrPos);
+                ptrPos[2] = z;
+                ptrPos += stride;
+            }
+            break;
+    }
+}
+
+void rebaseByLoop(const uint16_t* src, uint16_t* dst, std::size_t count, uint16_t offset)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        dst[i] = offset + src[i];
+    }
+}
+
+float maxError(const std::vector<float>& a, const std::vector<float>& b)
+{
+    float error = 0.0f;
+    for (std::size_t i = 0, n = a.size(); i < n; i++)
+    {
+        error = std::max(error, fabsf(a[i] - b[i]));
+    }
+    return error;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+#if MATH_KERNEL_SSE
+    printf("math kernel: sse\n");
+#elif MATH_KERNEL_NEON
+    printf("math kernel: neon\n");
+#else
+    printf("math kernel: scalar\n");
+#endif
+
+    cocos2d::Mat4 worldMat;
+    cocos2d::Mat4::createRotationZ(0.3f, &worldMat);
+    worldMat.scale(1.5f, 0.75f, 2.0f);
+    worldMat.m[12] = 480.0f;
+    worldMat.m[13] = 320.0f;
+    worldMat.m[14] = -5.0f;
+
+    // Vertex counts of 1k to 25k quads.
+    const std::size_t counts[] = { 4000, 40000, 100000 };
+    for (auto& format : FORMATS)
+    {
+        for (auto count : counts)
+        {
+            std::vector<float> local(count * format.stride), expected(local.size()), actual(local.size());
+            fillVertices(local, format.stride);
+
+            double loop = benchmark::measure([&]() {
+                memcpy(expected.data(), local.data(), local.size() * sizeof(float));
+                transformByLoop(expected.data(), format.stride, count, format.num, worldMat);
+            });
+            benchmark::report(format.name, "loop", count, loop);
+            double kernel = benchmark::measure([&]() {
+                memcpy(actual.data(), local.data(), local.size() * sizeof(float));
+                MathKernel::transformPositions(actual.data(), format.stride, count, format.num, worldMat);
+            });
+            benchmark::report(format.name, "kernel", count, kernel);
+            BENCHMARK_CHECK(maxError(expected, actual) < 1e-3f, "%s kernel differs from loop by %f", format.name, maxError(expected, actual));
+            benchmark::keep(actual[actual.size() - 1]);
+        }
+    }
+
+    // Six indices per quad, rebased to the vertex offset of the batch.
+    const std::size_t indexCounts[] = { 6000, 60000, 150000 };
+    for (auto count : indexCounts)
+    {
+        std::vector<uint16_t> src(count), expected(count), actual(count);
+        const uint16_t quad[] = { 0, 1, 2, 1, 3, 2 };
+        for (std::size_t i = 0; i < count; i++)
+        {
+            src[i] = (uint16_t)((i / 6) * 4 + quad[i % 6]);
+        }
+        const uint16_t offset = 1234;
+
+        double loop = benchmark::measure([&]() { rebaseByLoop(src.data(), expected.data(), count, offset); });
+        benchmark::report("rebase indices", "loop", count, loop);
+        double kernel = benchmark::measure([&]() { MathKernel::rebaseIndices(src.data(), actual.data(), count, offset); });
+        benchmark::report("rebase indices", "kernel", count, kernel);
+        BENCHMARK_CHECK(expected == actual, "rebased indices differ");
+        benchmark::keep(actual[count - 1]);
+    }
+    return 0;
+}